@@ -0,0 +1,214 @@
+/*******************************************************************************
+  Aquisio das amostras do ensaio GB - alvo host
+
+  File Name:
+    aquisicao_gb_host.c
+
+  Summary:
+    Implementao de aquisicao_gb.h sem ADCHS, DMA nem timers.
+
+  Description:
+    Os blocos vm de uma fonte escolhida pelo teste (HOST_GbFonte), por
+    exemplo uma gravao carregada com HOST_GbGravacaoCarrega. Cada
+    HOST_GbBloco faz o papel da interrupo de meio buffer do DMA: monta
+    AQUISICAO_GB_AMOSTRAS_BLOCO amostras, dispara o zero-cross nos instantes
+    que a fonte indicar, avana o core timer e o tick do RTOS at a ltima
+    amostra e chama o consumidor registrado em contexto de interrupo.
+
+    Formato da gravao (texto, uma amostra por linha, em ordem):
+        # comentrio
+        <tenso> <corrente>     cdigos do ADC (0..4095)
+        z <ticks>               borda do zero-cross 'ticks' do core timer
+                                antes da prxima amostra
+    A gravao  reproduzida em loop enquanto a aquisio estiver ligada.
+*******************************************************************************/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "aquisicao_gb.h"
+#include "definitions.h"
+
+// Ticks do core timer entre duas amostras
+#define AQUISICAO_GB_HOST_CORE_AMOSTRA \
+    ((uint64_t)AQUISICAO_GB_TICKS_AMOSTRA * CORE_TIMER_FREQUENCY / AQUISICAO_GB_CLOCK_HZ)
+
+#define AQUISICAO_GB_HOST_CORE_TICK   (CORE_TIMER_FREQUENCY / configTICK_RATE_HZ)
+
+static AQUISICAO_GB_CALLBACK g_callback = NULL;
+static uintptr_t g_context = 0;
+static bool g_rodando = false;
+static AQUISICAO_GB_ESTATISTICAS g_estat;
+
+static HOST_GB_FONTE g_fonte = NULL;
+static uint32_t g_amostra = 0;          // amostras entregues desde o Start
+static uint32_t g_coreInicio = 0;
+static TickType_t g_tickInicio = 0;
+
+static HOST_GB_GRAVACAO g_gravacao;
+
+// *****************************************************************************
+// Gravao
+// *****************************************************************************
+
+static bool AQUISICAO_GB_HOST_Gravacao(uint32_t k, uint16_t *tensao, uint16_t *corrente,
+                                       uint32_t *zc_antes)
+{
+    const HOST_GB_AMOSTRA *a = &g_gravacao.amostras[k % g_gravacao.n];
+
+    *tensao = a->tensao;
+    *corrente = a->corrente;
+    *zc_antes = a->zc_antes;
+    return a->zc;
+}
+
+bool HOST_GbGravacaoCarrega(const char *arquivo)
+{
+    FILE *f = fopen(arquivo, "r");
+    char linha[128];
+    uint32_t cap = 0, zc = 0, v, i;
+    bool temZc = false;
+
+    if (f == NULL)
+        return false;
+
+    free(g_gravacao.amostras);
+    memset(&g_gravacao, 0, sizeof(g_gravacao));
+
+    while (fgets(linha, sizeof(linha), f) != NULL)
+    {
+        if ((linha[0] == '#') || (linha[0] == '\n') || (linha[0] == '\r'))
+            continue;
+
+        if (linha[0] == 'z')
+        {
+            temZc = (sscanf(linha + 1, "%u", &zc) == 1);
+            if (!temZc)
+                break;
+            continue;
+        }
+
+        if ((sscanf(linha, "%u %u", &v, &i) != 2) || (v > 4095U) || (i > 4095U))
+            break;
+
+        if (g_gravacao.n == cap)
+        {
+            cap = (cap == 0U) ? 4096U : (cap * 2U);
+            g_gravacao.amostras = realloc(g_gravacao.amostras, cap * sizeof(HOST_GB_AMOSTRA));
+        }
+        g_gravacao.amostras[g_gravacao.n].tensao = (uint16_t)v;
+        g_gravacao.amostras[g_gravacao.n].corrente = (uint16_t)i;
+        g_gravacao.amostras[g_gravacao.n].zc = temZc;
+        g_gravacao.amostras[g_gravacao.n].zc_antes = zc;
+        g_gravacao.n++;
+        temZc = false;
+    }
+
+    // Linha invlida no meio do arquivo: no reproduz gravao pela metade
+    if (!feof(f) || (g_gravacao.n == 0U))
+    {
+        fclose(f);
+        free(g_gravacao.amostras);
+        memset(&g_gravacao, 0, sizeof(g_gravacao));
+        return false;
+    }
+
+    fclose(f);
+    g_fonte = AQUISICAO_GB_HOST_Gravacao;
+    return true;
+}
+
+const HOST_GB_GRAVACAO *HOST_GbGravacao(void)
+{
+    return &g_gravacao;
+}
+
+// *****************************************************************************
+// Entrega dos blocos
+// *****************************************************************************
+
+void HOST_GbFonte(HOST_GB_FONTE fonte)
+{
+    g_fonte = fonte;
+}
+
+bool HOST_GbBloco(void)
+{
+    uint16_t tensao[AQUISICAO_GB_AMOSTRAS_BLOCO];
+    uint16_t corrente[AQUISICAO_GB_AMOSTRAS_BLOCO];
+    uint32_t k, zc_antes, t = g_coreInicio;
+    uint64_t decorrido = 0;
+    uint64_t t0;
+    TickType_t tick;
+
+    if (!g_rodando || (g_fonte == NULL))
+        return false;
+
+    for (k = 0; k < AQUISICAO_GB_AMOSTRAS_BLOCO; k++, g_amostra++)
+    {
+        decorrido = (uint64_t)g_amostra * AQUISICAO_GB_HOST_CORE_AMOSTRA;
+        t = g_coreInicio + (uint32_t)decorrido;
+        if (g_fonte(g_amostra, &tensao[k], &corrente[k], &zc_antes))
+        {
+            HOST_CoreTimerSet(t - zc_antes);
+            (void)HOST_PinoDispara(HOST_PINO_ZERO_CROSS);
+        }
+    }
+
+    // Interrupo de bloco completo, no instante da ltima amostra
+    HOST_CoreTimerSet(t);
+    tick = g_tickInicio + (TickType_t)(decorrido / AQUISICAO_GB_HOST_CORE_TICK);
+    if ((int32_t)(tick - xTaskGetTickCount()) > 0)
+        HOST_TickAvanca(tick - xTaskGetTickCount());
+
+    t0 = HOST_Relogio();
+    HOST_ISR_ENTRA();
+    if (g_callback != NULL)
+    {
+        g_callback(tensao, corrente, AQUISICAO_GB_AMOSTRAS_BLOCO, g_context);
+        g_estat.blocos++;
+    }
+    HOST_ISR_SAI();
+
+    // Custo em unidades do relgio do host (ver HOST_Relogio)
+    g_estat.isr_ciclos = (uint32_t)(HOST_Relogio() - t0);
+    if (g_estat.isr_ciclos > g_estat.isr_ciclos_max)
+        g_estat.isr_ciclos_max = g_estat.isr_ciclos;
+    return true;
+}
+
+// *****************************************************************************
+// aquisicao_gb.h
+// *****************************************************************************
+
+void AQUISICAO_GB_Initialize(void)
+{
+    g_callback = NULL;
+    g_rodando = false;
+    memset(&g_estat, 0, sizeof(g_estat));
+}
+
+void AQUISICAO_GB_CallbackRegister(AQUISICAO_GB_CALLBACK callback, uintptr_t context)
+{
+    g_callback = callback;
+    g_context = context;
+}
+
+void AQUISICAO_GB_Start(void)
+{
+    memset(&g_estat, 0, sizeof(g_estat));
+    g_amostra = 0;
+    g_coreInicio = HOST_CoreTimer();
+    g_tickInicio = xTaskGetTickCount();
+    g_rodando = true;
+}
+
+void AQUISICAO_GB_Stop(void)
+{
+    g_rodando = false;
+}
+
+void AQUISICAO_GB_EstatisticasGet(AQUISICAO_GB_ESTATISTICAS *estat)
+{
+    *estat = g_estat;
+}
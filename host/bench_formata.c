@@ -0,0 +1,326 @@
+/*******************************************************************************
+  Conferncia e benchmark da formatao do LCD
+
+  File Name:
+    bench_formata.c
+
+  Summary:
+    FORMATA_Uint/Int/Fixo de formata.c contra casos conhecidos e snprintf.
+
+  Description:
+    Trs conferncias:
+    - casos de referncia escritos  mo (os exemplos de formata.h, zeros,
+      limites de 32 bits, negativos e estouro);
+    - comparao com snprintf ("%*u", "%0*u", "%*ld" e o ponto fixo montado
+      com "%u,%0*u") em todas as larguras de 0 a 12, sobre valores de todos
+      os tamanhos. Quando o snprintf passa da largura, o campo esperado 
+      uma sequncia de FORMATA_ESTOURO;
+    - nenhuma funo escreve fora do campo: bytes de guarda antes e depois
+      e o ponteiro devolvido logo aps o ltimo caractere.
+
+    O benchmark mede o custo mdio de uma linha tpica do LCD
+    ("A= 25,3 V=123") montada com FORMATA_* e com snprintf, no relgio do
+    host.
+*******************************************************************************/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "definitions.h"
+#include "formata.h"
+
+#define BENCH_GUARDA        0xA5
+#define BENCH_CAMPO_MAX     24U
+#define BENCH_N_VALORES     4096U
+#define BENCH_REPETICOES    200U
+
+static uint64_t g_semente = 0x2545F4914F6CDD1DULL;
+
+static uint64_t bench_aleatorio(void)
+{
+    g_semente ^= g_semente << 13;
+    g_semente ^= g_semente >> 7;
+    g_semente ^= g_semente << 17;
+    return g_semente;
+}
+
+// Valor de 1 a 10 dgitos, com peso igual para cada tamanho
+static uint32_t bench_valor(void)
+{
+    static const uint32_t limite[] =
+    {
+        10U, 100U, 1000U, 10000U, 100000U, 1000000U, 10000000U,
+        100000000U, 1000000000U, 0xFFFFFFFFU
+    };
+    uint64_t r = bench_aleatorio();
+
+    return (uint32_t)((r >> 8) % limite[r % 10U]);
+}
+
+// *****************************************************************************
+// Conferncia de um campo
+// *****************************************************************************
+
+typedef enum
+{
+    BENCH_UINT = 0,
+    BENCH_UINT_ZEROS,
+    BENCH_INT,
+    BENCH_FIXO
+} BENCH_FUNCAO;
+
+static const char *const bench_nomes[] = { "Uint", "Uint '0'", "Int", "Fixo" };
+
+static uint32_t g_erros;
+
+static char *bench_chama(BENCH_FUNCAO f, char *dst, uint32_t valor, uint8_t decimais, uint8_t largura)
+{
+    switch (f)
+    {
+        case BENCH_UINT:        return FORMATA_Uint(dst, valor, largura, ' ');
+        case BENCH_UINT_ZEROS:  return FORMATA_Uint(dst, valor, largura, '0');
+        case BENCH_INT:         return FORMATA_Int(dst, (int32_t)valor, largura);
+        default:                return FORMATA_Fixo(dst, valor, decimais, largura);
+    }
+}
+
+// Chama a funo entre bytes de guarda e compara com 'esperado'
+static void bench_confere(BENCH_FUNCAO f, uint32_t valor, uint8_t decimais, uint8_t largura,
+                          const char *esperado)
+{
+    char buf[BENCH_CAMPO_MAX + 2U];
+    char *campo = &buf[1], *fim;
+    size_t n = strlen(esperado), k;
+    bool ok;
+
+    memset(buf, BENCH_GUARDA, sizeof(buf));
+    fim = bench_chama(f, campo, valor, decimais, largura);
+
+    ok = (fim == campo + n) && (memcmp(campo, esperado, n) == 0) &&
+         ((uint8_t)buf[0] == BENCH_GUARDA);
+    for (k = n; ok && (k < BENCH_CAMPO_MAX + 1U); k++)
+        ok = ((uint8_t)campo[k] == BENCH_GUARDA);
+
+    if (!ok && (g_erros++ < 20U))
+    {
+        printf("%s(%ld, dec %u, larg %u): \"%.*s\", esperado \"%s\"\n", bench_nomes[f],
+               (f == BENCH_INT) ? (long)(int32_t)valor : (long)valor, (unsigned)decimais,
+               (unsigned)largura, (int)((fim > campo) ? (fim - campo) : 0), campo, esperado);
+    }
+}
+
+// *****************************************************************************
+// Casos de referncia
+// *****************************************************************************
+
+typedef struct
+{
+    BENCH_FUNCAO f;
+    uint32_t valor;
+    uint8_t decimais;
+    uint8_t largura;
+    const char *esperado;
+} BENCH_CASO;
+
+static const BENCH_CASO bench_casos[] =
+{
+    // Exemplos de formata.h
+    { BENCH_FIXO,       253,         1, 5, " 25,3" },
+    { BENCH_FIXO,       45,          3, 0, "0,045" },
+    // Zeros
+    { BENCH_UINT,       0,           0, 0, "0" },
+    { BENCH_UINT,       0,           0, 3, "  0" },
+    { BENCH_UINT_ZEROS, 0,           0, 3, "000" },
+    { BENCH_INT,        0,           0, 0, "0" },
+    { BENCH_FIXO,       0,           1, 0, "0,0" },
+    { BENCH_FIXO,       0,           3, 6, " 0,000" },
+    // Limites de 32 bits
+    { BENCH_UINT,       4294967295U, 0, 0, "4294967295" },
+    { BENCH_UINT,       4294967295U, 0, 12, "  4294967295" },
+    { BENCH_INT,        0x80000000U, 0, 0, "-2147483648" },
+    { BENCH_INT,        0x7FFFFFFFU, 0, 11, " 2147483647" },
+    { BENCH_FIXO,       4294967295U, 9, 0, "4,294967295" },
+    { BENCH_FIXO,       4294967295U, 3, 0, "4294967,295" },
+    // Negativos, com e sem largura
+    { BENCH_INT,        (uint32_t)-1, 0, 0, "-1" },
+    { BENCH_INT,        (uint32_t)-45, 0, 5, "  -45" },
+    // Estouro: o campo inteiro vira '*'
+    { BENCH_UINT,       1000,        0, 3, "***" },
+    { BENCH_UINT_ZEROS, 12345,       0, 4, "****" },
+    { BENCH_INT,        (uint32_t)-100, 0, 3, "***" },
+    { BENCH_FIXO,       12345,       3, 5, "*****" },
+    { BENCH_FIXO,       9999,        1, 5, "999,9" },
+    // Linhas do menu
+    { BENCH_FIXO,       12,          3, 6, " 0,012" },
+    { BENCH_FIXO,       250,         1, 4, "25,0" },
+    { BENCH_UINT,       7,           0, 3, "  7" },
+    { BENCH_UINT_ZEROS, 7,           0, 3, "007" },
+};
+
+#define BENCH_N_CASOS   (sizeof(bench_casos) / sizeof(bench_casos[0]))
+
+static void bench_casos_confere(void)
+{
+    uint32_t k;
+
+    for (k = 0; k < BENCH_N_CASOS; k++)
+    {
+        const BENCH_CASO *c = &bench_casos[k];
+
+        bench_confere(c->f, c->valor, c->decimais, c->largura, c->esperado);
+    }
+}
+
+// *****************************************************************************
+// Comparao com snprintf
+// *****************************************************************************
+
+// Campo esperado para 'largura': o texto do snprintf ou FORMATA_ESTOURO
+// se ele no cabe
+static void bench_campo(char *esperado, const char *impresso, uint8_t largura)
+{
+    size_t n = strlen(impresso);
+
+    if ((largura != 0U) && (n > largura))
+    {
+        memset(esperado, FORMATA_ESTOURO, largura);
+        esperado[largura] = '\0';
+    }
+    else
+    {
+        strcpy(esperado, impresso);
+    }
+}
+
+static void bench_snprintf(uint32_t valor)
+{
+    static const uint32_t potencia[] =
+    {
+        1U, 10U, 100U, 1000U, 10000U, 100000U, 1000000U, 10000000U,
+        100000000U, 1000000000U
+    };
+    char impresso[64], fixo[64], esperado[64];
+    uint8_t largura, decimais;
+
+    for (largura = 0; largura <= 12U; largura++)
+    {
+        snprintf(impresso, sizeof(impresso), "%*u", largura, (unsigned)valor);
+        bench_campo(esperado, impresso, largura);
+        bench_confere(BENCH_UINT, valor, 0, largura, esperado);
+
+        snprintf(impresso, sizeof(impresso), "%0*u", largura, (unsigned)valor);
+        bench_campo(esperado, impresso, largura);
+        bench_confere(BENCH_UINT_ZEROS, valor, 0, largura, esperado);
+
+        snprintf(impresso, sizeof(impresso), "%*ld", largura, (long)(int32_t)valor);
+        bench_campo(esperado, impresso, largura);
+        bench_confere(BENCH_INT, valor, 0, largura, esperado);
+
+        for (decimais = 1; decimais <= 9U; decimais++)
+        {
+            snprintf(fixo, sizeof(fixo), "%u%c%0*u", (unsigned)(valor / potencia[decimais]),
+                     FORMATA_SEPARADOR, decimais, (unsigned)(valor % potencia[decimais]));
+            snprintf(impresso, sizeof(impresso), "%*s", largura, fixo);
+            bench_campo(esperado, impresso, largura);
+            bench_confere(BENCH_FIXO, valor, decimais, largura, esperado);
+        }
+    }
+}
+
+// *****************************************************************************
+// Benchmark
+// *****************************************************************************
+
+// Linha de corrente e tenso do ensaio GB, como em ENSAIO_GB_DrawEnsaiando
+static __attribute__((noinline)) void bench_linha_formata(char *linha, uint32_t corrente, uint32_t tensao)
+{
+    char *p;
+
+    p = FORMATA_Texto(linha, "A=", 0);
+    p = FORMATA_Fixo(p, corrente, 1, 4);
+    p = FORMATA_Texto(p, " V=", 0);
+    FORMATA_Uint(p, tensao, 3, ' ');
+}
+
+static __attribute__((noinline)) void bench_linha_snprintf(char *linha, uint32_t corrente, uint32_t tensao)
+{
+    char tmp[21];
+    int n;
+
+    n = snprintf(tmp, sizeof(tmp), "A=%2u,%u V=%3u", (unsigned)(corrente / 10U),
+                 (unsigned)(corrente % 10U), (unsigned)tensao);
+    memcpy(linha, tmp, (size_t)n);
+}
+
+static double bench_mede(void (*linha)(char *, uint32_t, uint32_t), const uint32_t *valores,
+                         uint32_t *soma)
+{
+    static char lcd[20];
+    uint64_t t0, melhor = UINT64_MAX;
+    uint32_t rep, k;
+
+    // Melhor de vrias passadas, para tirar as preempes do host
+    for (rep = 0; rep < BENCH_REPETICOES; rep++)
+    {
+        t0 = HOST_Relogio();
+        for (k = 0; k < BENCH_N_VALORES; k++)
+        {
+            linha(lcd, valores[k] % 1000U, valores[k] % 4096U / 10U);
+            *soma += (uint8_t)lcd[3];
+        }
+        t0 = HOST_Relogio() - t0;
+        if (t0 < melhor)
+            melhor = t0;
+    }
+    return (double)melhor / BENCH_N_VALORES;
+}
+
+int main(void)
+{
+    static uint32_t valores[BENCH_N_VALORES];
+    uint32_t k, erros_casos, soma = 0;
+    char a[20], b[20];
+    double formata, impresso;
+
+    bench_casos_confere();
+    erros_casos = g_erros;
+    printf("casos de referencia (%u): %u erros\n", (unsigned)BENCH_N_CASOS, (unsigned)erros_casos);
+
+    // Limites e vizinhos de cada potncia de 10, e valores aleatrios
+    for (k = 1; k <= 1000000000U; k *= 10U)
+    {
+        bench_snprintf(k - 1U);
+        bench_snprintf(k);
+        bench_snprintf(k + 1U);
+    }
+    bench_snprintf(0x7FFFFFFFU);
+    bench_snprintf(0x80000000U);
+    bench_snprintf(0xFFFFFFFFU);
+    for (k = 0; k < 20000U; k++)
+        bench_snprintf(bench_valor());
+    printf("contra snprintf (larguras 0..12, 0..9 decimais): %u erros\n",
+           (unsigned)(g_erros - erros_casos));
+
+    // As duas verses da linha tm de dar o mesmo texto
+    for (k = 0; k < BENCH_N_VALORES; k++)
+    {
+        valores[k] = (uint32_t)bench_aleatorio();
+        memset(a, ' ', sizeof(a));
+        memset(b, ' ', sizeof(b));
+        bench_linha_formata(a, valores[k] % 1000U, valores[k] % 4096U / 10U);
+        bench_linha_snprintf(b, valores[k] % 1000U, valores[k] % 4096U / 10U);
+        if ((memcmp(a, b, sizeof(a)) != 0) && (g_erros++ < 20U))
+            printf("linha \"%.20s\", snprintf \"%.20s\"\n", a, b);
+    }
+
+    formata = bench_mede(bench_linha_formata, valores, &soma);
+    impresso = bench_mede(bench_linha_snprintf, valores, &soma);
+    printf("\ncusto da linha \"A= 25,3 V=123\" em %s do host (melhor de %u passadas)\n",
+           HOST_RELOGIO_UNIDADE, (unsigned)BENCH_REPETICOES);
+    printf("  snprintf  %7.1f\n", impresso);
+    printf("  FORMATA_* %7.1f  (%.1fx)\n", formata, impresso / formata);
+    printf("(checksum %u)\n", (unsigned)soma);
+
+    printf("\n%s\n", (g_erros == 0U) ? "OK" : "FALHOU");
+    return (g_erros == 0U) ? 0 : 1;
+}
@@ -0,0 +1,184 @@
+/*******************************************************************************
+  Conferncia e benchmark da raiz inteira
+
+  File Name:
+    bench_isqrt.c
+
+  Summary:
+    isqrt32/isqrt64 de utils.c contra a verso bit a bit anterior.
+
+  Description:
+    Conferncia exaustiva de isqrt32 contra a verso bit a bit (cpia
+    abaixo, como estava antes da tabela + Newton) em toda a faixa exata
+    0..2^24-1, e por amostragem de 2^24 a 2^32-1, onde as duas saturam
+    em 4095. isqrt64  conferida pela definio (r^2 <= n < (r+1)^2) em
+    quadrados perfeitos e vizinhos e em valores pseudoaleatrios.
+
+    O benchmark mede o custo mdio por chamada das duas verses sobre
+    valores na faixa de um RMS de 12 bits (0..4095^2), no relgio do host.
+*******************************************************************************/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include "definitions.h"
+#include "utils.h"
+
+#define BENCH_N_VALORES     4096U
+#define BENCH_REPETICOES    2000U
+
+// Verso bit a bit anterior, referncia da conferncia
+static __attribute__((noinline)) uint32_t isqrt32_bit(uint32_t n)
+{
+    uint32_t root, remainder, place;
+
+    root = 0;
+    remainder = n;
+    place = 0x400000;
+
+    while (place > remainder)
+        place = place >> 2;
+
+    while (place)
+    {
+        if (remainder >= root + place)
+        {
+            remainder = remainder - root - place;
+            root = root + (place << 1);
+        }
+        root = root >> 1;
+        place = place >> 2;
+    }
+    return root;
+}
+
+static uint64_t g_semente = 0x2545F4914F6CDD1DULL;
+
+static uint64_t bench_aleatorio(void)
+{
+    g_semente ^= g_semente << 13;
+    g_semente ^= g_semente >> 7;
+    g_semente ^= g_semente << 17;
+    return g_semente;
+}
+
+static bool bench_raiz_ok(uint64_t n, uint32_t r)
+{
+    unsigned __int128 r2 = (unsigned __int128)r * r;
+    unsigned __int128 r12 = (unsigned __int128)(r + 1ULL) * (r + 1ULL);
+
+    return (r2 <= n) && (r12 > n);
+}
+
+static uint32_t confere_isqrt32(void)
+{
+    uint64_t n;
+    uint32_t erros = 0;
+
+    // Faixa exata, todos os valores
+    for (n = 0; n < 0x1000000ULL; n++)
+    {
+        if (isqrt32((uint32_t)n) != isqrt32_bit((uint32_t)n))
+        {
+            if (erros++ < 10U)
+                printf("isqrt32(%llu) = %u, bit a bit = %u\n", (unsigned long long)n,
+                       (unsigned)isqrt32((uint32_t)n), (unsigned)isqrt32_bit((uint32_t)n));
+        }
+    }
+
+    // Faixa saturada, por amostragem (passo primo) e no limite
+    for (n = 0x1000000ULL; n <= 0xFFFFFFFFULL; n += 251U)
+    {
+        if (isqrt32((uint32_t)n) != isqrt32_bit((uint32_t)n))
+            erros++;
+    }
+    if (isqrt32(0xFFFFFFFFU) != isqrt32_bit(0xFFFFFFFFU))
+        erros++;
+
+    return erros;
+}
+
+static uint32_t confere_isqrt64(void)
+{
+    uint64_t r, n;
+    uint32_t k, erros = 0;
+
+    // Quadrados perfeitos e vizinhos em toda a faixa de 32 bits da raiz
+    for (r = 1; r <= 0xFFFFFFFFULL; r += (r >> 6) + 1U)
+    {
+        n = r * r;
+        if (!bench_raiz_ok(n, isqrt64(n)) || !bench_raiz_ok(n - 1U, isqrt64(n - 1U)))
+            erros++;
+        if ((r < 0xFFFFFFFFULL) && !bench_raiz_ok(n + 2U * r, isqrt64(n + 2U * r)))
+            erros++;
+    }
+
+    // Valores pseudoaleatrios de todos os tamanhos
+    for (k = 0; k < 4000000U; k++)
+    {
+        n = bench_aleatorio() >> (k & 63U);
+        if (!bench_raiz_ok(n, isqrt64(n)))
+        {
+            if (erros++ < 10U)
+                printf("isqrt64(%llu) = %u\n", (unsigned long long)n, (unsigned)isqrt64(n));
+        }
+    }
+    if (!bench_raiz_ok(UINT64_MAX, isqrt64(UINT64_MAX)))
+        erros++;
+
+    return erros;
+}
+
+// Custo mdio por chamada sobre a mesma tabela de valores
+static double bench_mede(uint32_t (*raiz)(uint32_t), const uint32_t *valores, uint32_t *soma)
+{
+    uint64_t t0, melhor = UINT64_MAX;
+    uint32_t rep, k, acc = 0;
+
+    // Melhor de vrias passadas, para tirar as preempes do host
+    for (rep = 0; rep < BENCH_REPETICOES; rep++)
+    {
+        t0 = HOST_Relogio();
+        for (k = 0; k < BENCH_N_VALORES; k++)
+            acc += raiz(valores[k]);
+        t0 = HOST_Relogio() - t0;
+        if (t0 < melhor)
+            melhor = t0;
+    }
+    *soma += acc;
+    return (double)melhor / BENCH_N_VALORES;
+}
+
+static uint32_t isqrt64_baixo(uint32_t n)
+{
+    return isqrt64(n);
+}
+
+int main(void)
+{
+    static uint32_t valores[BENCH_N_VALORES];
+    uint32_t k, erros32, erros64, soma = 0;
+    double bit, novo, novo64;
+
+    erros32 = confere_isqrt32();
+    erros64 = confere_isqrt64();
+    printf("isqrt32 contra a versao bit a bit (0..2^24 completo, acima por amostragem): %u erros\n",
+           (unsigned)erros32);
+    printf("isqrt64 pela definicao (quadrados, vizinhos e aleatorios): %u erros\n", (unsigned)erros64);
+
+    // Quadrados de RMS de 12 bits, como chegam de calcula_rms
+    for (k = 0; k < BENCH_N_VALORES; k++)
+        valores[k] = (uint32_t)(bench_aleatorio() % (4095U * 4095U + 1U));
+
+    bit = bench_mede(isqrt32_bit, valores, &soma);
+    novo = bench_mede(isqrt32, valores, &soma);
+    novo64 = bench_mede(isqrt64_baixo, valores, &soma);
+    printf("\ncusto por chamada em %s do host (0..4095^2, melhor de %u passadas)\n",
+           HOST_RELOGIO_UNIDADE, (unsigned)BENCH_REPETICOES);
+    printf("  isqrt32 bit a bit   %6.1f\n", bit);
+    printf("  isqrt32 tabela      %6.1f  (%.1fx)\n", novo, bit / novo);
+    printf("  isqrt64             %6.1f\n", novo64);
+    printf("(checksum %u)\n", (unsigned)soma);
+
+    printf("\n%s\n", ((erros32 == 0U) && (erros64 == 0U)) ? "OK" : "FALHOU");
+    return ((erros32 == 0U) && (erros64 == 0U)) ? 0 : 1;
+}
@@ -0,0 +1,98 @@
+/*******************************************************************************
+  Ensaio GB completo no host
+
+  File Name:
+    host_ensaio_gb.c
+
+  Summary:
+    Roda MEDIDA_GB_RunTestTask e MEDIDA_GB_Tasks sobre a aquisio do host.
+
+  Description:
+    MEDIDA_GB_IniciaEnsaio acorda a MEDIDA_GB_TesteTask, que liga a
+    aquisio e dorme at o fim do ensaio. Enquanto ela dorme, o gancho de
+    espera faz o papel do resto do sistema: a interrupo de aquisio
+    (HOST_GbBloco) entrega um bloco a cada 8,33ms e a MEDIDA_GB_Tasks roda
+    sempre que  notificada, consumindo o anel. Um teste que tenha outras
+    tasks (o menu, por exemplo) as roda entre dois blocos com
+    HOST_GbEnsaioOutras.
+*******************************************************************************/
+
+#include "definitions.h"
+
+static void (*g_outras)(void) = NULL;
+
+static void HOST_GbMedida(void *param)
+{
+    (void)param;
+    for (;;)
+        MEDIDA_GB_Tasks();
+}
+
+static void HOST_GbTeste(void *param)
+{
+    (void)param;
+    MEDIDA_GB_RunTestTask(NULL);
+}
+
+void HOST_GbEspera(TaskHandle_t tarefa, TickType_t ticks)
+{
+    TickType_t inicio = xTaskGetTickCount();
+
+    // A MEDIDA_GB_Tasks roda daqui: quando ela dorme, volta para o lao
+    if (tarefa == xMEDIDA_GB_Tasks)
+        return;
+
+    while (tarefa->notificacoes == 0U)
+    {
+        if ((ticks != portMAX_DELAY) && ((xTaskGetTickCount() - inicio) >= ticks))
+            return;
+
+        if (!HOST_GbBloco())
+        {
+            // Aquisio parada: s o tempo passa
+            if (ticks != portMAX_DELAY)
+                HOST_TickAvanca(ticks - (xTaskGetTickCount() - inicio));
+            return;
+        }
+
+        if (xMEDIDA_GB_Tasks->notificacoes != 0U)
+            (void)HOST_TarefaRoda(xMEDIDA_GB_Tasks, HOST_GbMedida, NULL);
+        if (g_outras != NULL)
+            g_outras();
+    }
+}
+
+void HOST_GbEnsaioOutras(void (*roda)(void))
+{
+    g_outras = roda;
+}
+
+void HOST_GbEnsaioPrepara(void)
+{
+    AQUISICAO_GB_Initialize();
+    MEDIDA_GB_Initialize();
+    HOST_EsperaGancho(HOST_GbEspera);
+
+    // Primeira volta da MEDIDA_GB_Tasks: INIT e dorme esperando blocos
+    (void)HOST_TarefaRoda(xMEDIDA_GB_Tasks, HOST_GbMedida, NULL);
+}
+
+bool HOST_GbEnsaioAtende(TickType_t *duracao)
+{
+    TickType_t inicio = xTaskGetTickCount();
+
+    if (xMEDIDA_GB_TesteTask->notificacoes == 0U)
+        return false;
+
+    (void)HOST_TarefaRoda(xMEDIDA_GB_TesteTask, HOST_GbTeste, NULL);
+    *duracao = xTaskGetTickCount() - inicio;
+    return true;
+}
+
+bool HOST_GbEnsaioRoda(TickType_t *duracao)
+{
+    if (!MEDIDA_GB_IniciaEnsaio())
+        return false;
+
+    return HOST_GbEnsaioAtende(duracao);
+}
@@ -0,0 +1,214 @@
+/*******************************************************************************
+  FreeRTOS do alvo host
+
+  File Name:
+    host_freertos.c
+
+  Summary:
+    Ticks, notificaes de task e filas para os programas de teste.
+
+  Description:
+    Ver stubs/task.h e stubs/host.h. Os handles das tasks criadas em
+    config/default/tasks.c so definidos aqui, cada um com o seu contador.
+*******************************************************************************/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "definitions.h"
+
+volatile UBaseType_t uxInterruptNesting = 0;
+
+static TickType_t g_tick = 0;
+static TaskHandle_t g_atual = NULL;
+static HOST_GANCHO_ESPERA g_gancho = NULL;
+
+// Tasks de config/default/tasks.c
+static struct HOST_TAREFA g_tarefas[] =
+{
+    { "USB_HOST_TASKS",     0, 0, NULL },
+    { "APP_Tasks",          0, 0, NULL },
+    { "APP_USB_Tasks",      0, 0, NULL },
+    { "MENU_DISPLAY_Tasks", 0, 0, NULL },
+    { "MEDIDA_GB_Tasks",    0, 0, NULL },
+    { "MEDIDA_GB",          0, 0, NULL },
+    { "DIAG_SIS_Tasks",     0, 0, NULL },
+};
+
+TaskHandle_t xUSB_HOST_Tasks      = &g_tarefas[0];
+TaskHandle_t xAPP_Tasks           = &g_tarefas[1];
+TaskHandle_t xAPP_USB_Tasks       = &g_tarefas[2];
+TaskHandle_t xMENU_DISPLAY_Tasks  = &g_tarefas[3];
+TaskHandle_t xMEDIDA_GB_Tasks     = &g_tarefas[4];
+TaskHandle_t xMEDIDA_GB_TesteTask = &g_tarefas[5];
+TaskHandle_t xDIAG_SIS_Tasks      = &g_tarefas[6];
+
+void HOST_EsperaGancho(HOST_GANCHO_ESPERA gancho)
+{
+    g_gancho = gancho;
+}
+
+bool HOST_TarefaRoda(TaskHandle_t tarefa, void (*corpo)(void *), void *param)
+{
+    TaskHandle_t anterior = g_atual;
+    jmp_buf *paradaAnterior = tarefa->parada;
+    jmp_buf parada;
+    bool terminou = false;
+
+    g_atual = tarefa;
+    tarefa->parada = &parada;
+    if (setjmp(parada) == 0)
+    {
+        corpo(param);
+        terminou = true;
+    }
+    tarefa->parada = paradaAnterior;
+    g_atual = anterior;
+
+    return terminou;
+}
+
+void HOST_TickAvanca(TickType_t ticks)
+{
+    g_tick += ticks;
+}
+
+TickType_t xTaskGetTickCount(void)
+{
+    return g_tick;
+}
+
+TaskHandle_t xTaskGetCurrentTaskHandle(void)
+{
+    return g_atual;
+}
+
+BaseType_t xTaskNotifyGive(TaskHandle_t tarefa)
+{
+    tarefa->notificacoes++;
+    tarefa->acordadas++;
+    return pdPASS;
+}
+
+void vTaskNotifyGiveFromISR(TaskHandle_t tarefa, BaseType_t *pxHigherPriorityTaskWoken)
+{
+    (void)xTaskNotifyGive(tarefa);
+    if (pxHigherPriorityTaskWoken != NULL)
+        *pxHigherPriorityTaskWoken = pdTRUE;
+}
+
+uint32_t ulTaskNotifyTake(BaseType_t xClearCountOnExit, TickType_t xTicksToWait)
+{
+    TaskHandle_t tarefa = g_atual;
+    uint32_t n;
+
+    if (tarefa == NULL)
+    {
+        fprintf(stderr, "ulTaskNotifyTake fora de HOST_TarefaRoda\n");
+        abort();
+    }
+
+    if ((tarefa->notificacoes == 0U) && (xTicksToWait != 0U))
+    {
+        if (g_gancho != NULL)
+            g_gancho(tarefa, xTicksToWait);
+        else if (xTicksToWait != portMAX_DELAY)
+            g_tick += xTicksToWait;
+
+        // Ningum vai acordar esta task: volta para quem a ps para rodar
+        if ((tarefa->notificacoes == 0U) && (xTicksToWait == portMAX_DELAY))
+            longjmp(*tarefa->parada, 1);
+    }
+
+    n = tarefa->notificacoes;
+    if (n != 0U)
+        tarefa->notificacoes = (xClearCountOnExit != pdFALSE) ? 0U : (n - 1U);
+    return n;
+}
+
+void vTaskDelay(TickType_t xTicksToDelay)
+{
+    g_tick += xTicksToDelay;
+}
+
+// *****************************************************************************
+// Filas
+// *****************************************************************************
+
+QueueHandle_t xQueueCreateStatic(UBaseType_t uxQueueLength, UBaseType_t uxItemSize,
+                                 uint8_t *pucQueueStorage, StaticQueue_t *pxQueueBuffer)
+{
+    pxQueueBuffer->area = pucQueueStorage;
+    pxQueueBuffer->tamanho = uxQueueLength;
+    pxQueueBuffer->item = uxItemSize;
+    pxQueueBuffer->leitura = 0;
+    pxQueueBuffer->quantos = 0;
+    return pxQueueBuffer;
+}
+
+// Espera da task atual at a fila mudar (ver ulTaskNotifyTake)
+static bool host_fila_espera(QueueHandle_t fila, bool cheia, TickType_t ticks)
+{
+    TaskHandle_t tarefa = g_atual;
+
+    if (ticks == 0U)
+        return false;
+    if (tarefa == NULL)
+    {
+        fprintf(stderr, "espera em fila fora de HOST_TarefaRoda\n");
+        abort();
+    }
+
+    if (g_gancho != NULL)
+        g_gancho(tarefa, ticks);
+    else if (ticks != portMAX_DELAY)
+        g_tick += ticks;
+
+    if (cheia ? (fila->quantos < fila->tamanho) : (fila->quantos != 0U))
+        return true;
+    if (ticks == portMAX_DELAY)
+        longjmp(*tarefa->parada, 1);
+    return false;
+}
+
+BaseType_t xQueueSend(QueueHandle_t fila, const void *item, TickType_t xTicksToWait)
+{
+    if ((fila->quantos == fila->tamanho) && !host_fila_espera(fila, true, xTicksToWait))
+        return errQUEUE_FULL;
+
+    memcpy(&fila->area[((fila->leitura + fila->quantos) % fila->tamanho) * fila->item],
+           item, fila->item);
+    fila->quantos++;
+    return pdPASS;
+}
+
+BaseType_t xQueueSendFromISR(QueueHandle_t fila, const void *item,
+                             BaseType_t *pxHigherPriorityTaskWoken)
+{
+    if (fila->quantos == fila->tamanho)
+        return errQUEUE_FULL;
+    if (pxHigherPriorityTaskWoken != NULL)
+        *pxHigherPriorityTaskWoken = pdTRUE;
+    return xQueueSend(fila, item, 0);
+}
+
+BaseType_t xQueueReceive(QueueHandle_t fila, void *item, TickType_t xTicksToWait)
+{
+    if ((fila->quantos == 0U) && !host_fila_espera(fila, false, xTicksToWait))
+        return errQUEUE_EMPTY;
+
+    memcpy(item, &fila->area[fila->leitura * fila->item], fila->item);
+    fila->leitura = (fila->leitura + 1U) % fila->tamanho;
+    fila->quantos--;
+    return pdPASS;
+}
+
+UBaseType_t uxQueueMessagesWaiting(QueueHandle_t fila)
+{
+    return fila->quantos;
+}
+
+UBaseType_t uxQueueSpacesAvailable(QueueHandle_t fila)
+{
+    return fila->tamanho - fila->quantos;
+}
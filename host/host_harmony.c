@@ -0,0 +1,43 @@
+/*******************************************************************************
+  Servios do sistema do Harmony no alvo host
+
+  File Name:
+    host_harmony.c
+
+  Summary:
+    SYS_TIME, SYS_DEBUG e SYS_CONSOLE usados pelos fontes da pilha USB.
+
+  Description:
+    Compilado com os headers reais do Harmony (ver HARMONY_CPPFLAGS no
+    Makefile). O contador do SYS_TIME  o tick do FreeRTOS do host e as
+    mensagens do SYS_DEBUG saem no stdout, com o nvel de configuration.h.
+*******************************************************************************/
+
+#include <stdio.h>
+#include <stdbool.h>
+#include "configuration.h"
+#include "system/debug/sys_debug.h"
+#include "system/console/sys_console.h"
+#include "system/time/sys_time.h"
+#include "task.h"
+
+uint32_t SYS_TIME_CounterGet(void)
+{
+    return xTaskGetTickCount();
+}
+
+SYS_ERROR_LEVEL SYS_DEBUG_ErrorLevelGet(void)
+{
+    return SYS_DEBUG_GLOBAL_ERROR_LEVEL;
+}
+
+SYS_MODULE_INDEX SYS_DEBUG_ConsoleInstanceGet(void)
+{
+    return 0;
+}
+
+void SYS_CONSOLE_Message(const SYS_CONSOLE_HANDLE handle, const char *message)
+{
+    (void)handle;
+    printf("%s\n", message);
+}
@@ -0,0 +1,260 @@
+/*******************************************************************************
+  Perifricos do alvo host
+
+  File Name:
+    host_perifericos.c
+
+  Summary:
+    Pinos, core timer, TMR3, TMR6 e TMR7 dos plibs do Harmony, no host.
+
+  Description:
+    Ver stubs/host.h.
+*******************************************************************************/
+
+#include "definitions.h"
+
+// Botes com pull-up: soltos leem 1
+static uint32_t g_pinos[HOST_PINO_QUANT] =
+{
+    [HOST_PINO_BTN_BACK] = 1U, [HOST_PINO_BTN_ENTER] = 1U,
+    [HOST_PINO_BTN_CIMA] = 1U, [HOST_PINO_BTN_BAIXO] = 1U,
+};
+static bool g_pinoInterrupcao[HOST_PINO_QUANT];
+static GPIO_PIN_CALLBACK g_pinoCallback[HOST_PINO_QUANT];
+static uintptr_t g_pinoContext[HOST_PINO_QUANT];
+
+static uint32_t g_coreTimer = 0;
+
+static void (*g_coreObservador)(uint32_t agora) = NULL;
+
+static HOST_TMR g_tmr3;
+static TMR_CALLBACK g_tmr3Callback = NULL;
+static uintptr_t g_tmr3Context = 0;
+
+static HOST_TMR g_tmr6;
+static TMR_CALLBACK g_tmr6Callback = NULL;
+static uintptr_t g_tmr6Context = 0;
+
+static HOST_TMR g_tmr7;
+static TMR_CALLBACK g_tmr7Callback = NULL;
+static uintptr_t g_tmr7Context = 0;
+
+// *****************************************************************************
+// Pinos
+// *****************************************************************************
+
+void HOST_PinoEscreve(HOST_PINO pino, uint32_t valor)
+{
+    g_pinos[pino] = (valor != 0U) ? 1U : 0U;
+}
+
+uint32_t HOST_PinoLe(HOST_PINO pino)
+{
+    return g_pinos[pino];
+}
+
+void HOST_PinoInterrupcao(HOST_PINO pino, bool habilita)
+{
+    g_pinoInterrupcao[pino] = habilita;
+}
+
+bool HOST_PinoDispara(HOST_PINO pino)
+{
+    if (!g_pinoInterrupcao[pino] || (g_pinoCallback[pino] == NULL))
+        return false;
+
+    HOST_ISR_ENTRA();
+    g_pinoCallback[pino]((GPIO_PIN)pino, g_pinoContext[pino]);
+    HOST_ISR_SAI();
+    return true;
+}
+
+bool GPIO_PinInterruptCallbackRegister(GPIO_PIN pin, GPIO_PIN_CALLBACK callback, uintptr_t context)
+{
+    if (pin >= (GPIO_PIN)HOST_PINO_QUANT)
+        return false;
+
+    g_pinoCallback[pin] = callback;
+    g_pinoContext[pin] = context;
+    return true;
+}
+
+// *****************************************************************************
+// Core timer
+// *****************************************************************************
+
+uint32_t HOST_CoreTimer(void)
+{
+    if (g_coreObservador != NULL)
+        g_coreObservador(g_coreTimer);
+    return g_coreTimer++;
+}
+
+void HOST_CoreTimerObservador(void (*observador)(uint32_t agora))
+{
+    g_coreObservador = observador;
+}
+
+void HOST_CoreTimerSet(uint32_t agora)
+{
+    g_coreTimer = agora;
+}
+
+uint32_t CORETIMER_FrequencyGet(void)
+{
+    return CORE_TIMER_FREQUENCY;
+}
+
+// *****************************************************************************
+// TMR3
+// *****************************************************************************
+
+const HOST_TMR *HOST_Tmr3(void)
+{
+    return &g_tmr3;
+}
+
+bool HOST_Tmr3Dispara(void)
+{
+    if (!g_tmr3.rodando || !g_tmr3.interrupcao || (g_tmr3Callback == NULL))
+        return false;
+
+    HOST_ISR_ENTRA();
+    g_tmr3Callback(0, g_tmr3Context);
+    HOST_ISR_SAI();
+    return true;
+}
+
+void TMR3_Start(void)
+{
+    g_tmr3.rodando = true;
+}
+
+void TMR3_Stop(void)
+{
+    g_tmr3.rodando = false;
+}
+
+void TMR3_InterruptEnable(void)
+{
+    g_tmr3.interrupcao = true;
+}
+
+void TMR3_InterruptDisable(void)
+{
+    g_tmr3.interrupcao = false;
+}
+
+void TMR3_CallbackRegister(TMR_CALLBACK callback, uintptr_t context)
+{
+    g_tmr3Callback = callback;
+    g_tmr3Context = context;
+}
+
+// *****************************************************************************
+// TMR6
+// *****************************************************************************
+
+const HOST_TMR *HOST_Tmr6(void)
+{
+    return &g_tmr6;
+}
+
+bool HOST_Tmr6Dispara(void)
+{
+    if (!g_tmr6.rodando || !g_tmr6.interrupcao || (g_tmr6Callback == NULL))
+        return false;
+
+    HOST_ISR_ENTRA();
+    g_tmr6Callback(0, g_tmr6Context);
+    HOST_ISR_SAI();
+    return true;
+}
+
+void TMR6_Start(void)
+{
+    g_tmr6.rodando = true;
+}
+
+void TMR6_Stop(void)
+{
+    g_tmr6.rodando = false;
+}
+
+void TMR6_CounterSet(uint16_t count)
+{
+    (void)count;
+}
+
+void TMR6_PeriodSet(uint16_t period)
+{
+    g_tmr6.periodo = period;
+    g_tmr6.programacoes++;
+}
+
+uint32_t TMR6_FrequencyGet(void)
+{
+    return HOST_TMR6_FREQUENCIA;
+}
+
+void TMR6_InterruptEnable(void)
+{
+    g_tmr6.interrupcao = true;
+}
+
+void TMR6_InterruptDisable(void)
+{
+    g_tmr6.interrupcao = false;
+}
+
+void TMR6_CallbackRegister(TMR_CALLBACK callback, uintptr_t context)
+{
+    g_tmr6Callback = callback;
+    g_tmr6Context = context;
+}
+
+// *****************************************************************************
+// TMR7
+// *****************************************************************************
+
+const HOST_TMR *HOST_Tmr7(void)
+{
+    return &g_tmr7;
+}
+
+bool HOST_Tmr7Dispara(void)
+{
+    if (!g_tmr7.rodando || (g_tmr7Callback == NULL))
+        return false;
+
+    HOST_ISR_ENTRA();
+    g_tmr7Callback(0, g_tmr7Context);
+    HOST_ISR_SAI();
+
+    // Os pinos como ficaram na sada da ISR (ltimo pulso de EN)
+    if (g_coreObservador != NULL)
+        g_coreObservador(g_coreTimer);
+    return true;
+}
+
+void TMR7_Start(void)
+{
+    g_tmr7.rodando = true;
+}
+
+void TMR7_Stop(void)
+{
+    g_tmr7.rodando = false;
+}
+
+void TMR7_PeriodSet(uint16_t period)
+{
+    g_tmr7.periodo = period;
+    g_tmr7.programacoes++;
+}
+
+void TMR7_CallbackRegister(TMR_CALLBACK callback, uintptr_t context)
+{
+    g_tmr7Callback = callback;
+    g_tmr7Context = context;
+}
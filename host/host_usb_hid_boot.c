@@ -0,0 +1,141 @@
+/*******************************************************************************
+  Camada HID do Harmony no alvo host, com o mapa de campos do teclado boot
+
+  File Name:
+    host_usb_hid_boot.c
+
+  Summary:
+    O que o driver do teclado (usb_host_hid_keyboard.c) usa da camada HID.
+
+  Description:
+    Compilado com os headers reais do Harmony (ver HARMONY_CPPFLAGS no
+    Makefile), como o driver do teclado. No lugar do descritor de relatrio
+    lido do dispositivo, o USB_HOST_HID_FieldMapGet entrega sempre o mapa do
+    teclado do protocolo boot (HID 1.11, apndice B.1):
+
+      entrada  bits  0..7   modificadores, uma usage por bit (0xE0..0xE7)
+      entrada  bits  8..15  constante
+      entrada  bits 16..63  6 teclas, uma usage por byte (0x00..0x65)
+      sada    bits  0..4   LEDs (0x01..0x05)
+      sada    bits  5..7   constante
+
+    O relatrio de sada  o mnimo para o driver rodar: s  contado. Os
+    servios do sistema ficam em host_harmony.c.
+*******************************************************************************/
+
+#include <stdbool.h>
+#include <string.h>
+#include "usb/usb_host_hid.h"
+
+// Flags dos itens Main: Data/Constant, Array/Variable, Absolute/Relative
+#define HOST_HID_CONSTANTE      0x01U
+#define HOST_HID_VARIAVEL       0x02U
+
+static const USB_HOST_HID_FIELD g_camposBoot[] =
+{
+    {
+        .tag = (uint8_t)USB_HID_MAIN_ITEM_TAG_INPUT, .reportSize = 1, .reportCount = 8,
+        .bitOffset = 0, .usageMinMaxValid = true,
+        .data = { .data4Bytes = HOST_HID_VARIAVEL },
+        .usagePage = USB_HID_USAGE_PAGE_KEYBOARD_KEYPAD, .usageMin = 0xE0, .usageMax = 0xE7,
+        .logicalMinimum = 0, .logicalMaximum = 1
+    },
+    {
+        .tag = (uint8_t)USB_HID_MAIN_ITEM_TAG_INPUT, .reportSize = 8, .reportCount = 1,
+        .bitOffset = 8, .usageMinMaxValid = false,
+        .data = { .data4Bytes = HOST_HID_CONSTANTE },
+        .usagePage = USB_HID_USAGE_PAGE_KEYBOARD_KEYPAD
+    },
+    {
+        .tag = (uint8_t)USB_HID_MAIN_ITEM_TAG_OUTPUT, .reportSize = 1, .reportCount = 5,
+        .bitOffset = 0, .usageMinMaxValid = true,
+        .data = { .data4Bytes = HOST_HID_VARIAVEL },
+        .usagePage = USB_HID_USAGE_PAGE_LEDS, .usageMin = 0x01, .usageMax = 0x05,
+        .logicalMinimum = 0, .logicalMaximum = 1
+    },
+    {
+        .tag = (uint8_t)USB_HID_MAIN_ITEM_TAG_OUTPUT, .reportSize = 3, .reportCount = 1,
+        .bitOffset = 5, .usageMinMaxValid = false,
+        .data = { .data4Bytes = HOST_HID_CONSTANTE },
+        .usagePage = USB_HID_USAGE_PAGE_LEDS
+    },
+    {
+        .tag = (uint8_t)USB_HID_MAIN_ITEM_TAG_INPUT, .reportSize = 8, .reportCount = 6,
+        .bitOffset = 16, .usageMinMaxValid = true,
+        .data = { .data4Bytes = 0U },
+        .usagePage = USB_HID_USAGE_PAGE_KEYBOARD_KEYPAD, .usageMin = 0x00, .usageMax = 0x65,
+        .logicalMinimum = 0, .logicalMaximum = 0x65
+    },
+};
+
+// Relatrios de sada pedidos pelo driver (LEDs)
+uint32_t HOST_HidRelatoriosSaida = 0;
+
+USB_HOST_HID_RESULT USB_HOST_HID_FieldMapGet
+(
+    USB_HOST_HID_OBJ_HANDLE handle,
+    USB_HOST_HID_FIELD *fields,
+    uint8_t maxFields,
+    uint8_t *nFields
+)
+{
+    uint8_t n = (uint8_t)(sizeof(g_camposBoot) / sizeof(g_camposBoot[0]));
+
+    if ((handle == USB_HOST_HID_OBJ_HANDLE_INVALID) || (fields == NULL) || (nFields == NULL))
+        return USB_HOST_HID_RESULT_PARAMETER_INVALID;
+
+    if (n > maxFields)
+        n = maxFields;
+    memcpy(fields, g_camposBoot, (size_t)n * sizeof(USB_HOST_HID_FIELD));
+    *nFields = n;
+    return USB_HOST_HID_RESULT_SUCCESS;
+}
+
+// Mesma extrao de usb_host_hid.c, para elementos de at 8 bits (os do mapa
+// boot)
+uint32_t USB_HOST_HID_FieldValueGet
+(
+    const USB_HOST_HID_FIELD *field,
+    const uint8_t *report,
+    size_t length,
+    uint32_t element
+)
+{
+    uint32_t bit, valor;
+
+    if ((field == NULL) || (report == NULL) || (field->reportSize == 0U) || (field->reportSize > 8U))
+        return 0;
+
+    bit = (uint32_t)field->bitOffset + (element * (uint32_t)field->reportSize);
+    if (field->reportID != 0U)
+        bit += 8U;
+    if ((bit + field->reportSize) > ((uint32_t)length * 8U))
+        return 0;
+
+    valor = report[bit / 8U];
+    if (((bit % 8U) + field->reportSize) > 8U)
+        valor |= (uint32_t)report[(bit / 8U) + 1U] << 8;
+    return (valor >> (bit % 8U)) & ((1UL << field->reportSize) - 1U);
+}
+
+USB_HOST_HID_RESULT USB_HOST_HID_ReportSend
+(
+    USB_HOST_HID_OBJ_HANDLE handle,
+    USB_HID_REPORT_TYPE reportType,
+    uint8_t reportID,
+    uint16_t reportLength,
+    USB_HOST_HID_REQUEST_HANDLE *requestHandle,
+    const void *report
+)
+{
+    (void)handle;
+    (void)reportType;
+    (void)reportID;
+    (void)reportLength;
+    (void)report;
+
+    HOST_HidRelatoriosSaida++;
+    if (requestHandle != NULL)
+        *requestHandle = (USB_HOST_HID_REQUEST_HANDLE)HOST_HidRelatoriosSaida;
+    return USB_HOST_HID_RESULT_SUCCESS;
+}
@@ -0,0 +1,248 @@
+/*******************************************************************************
+  LCD HD44780 virtual do alvo host
+
+  File Name:
+    lcd_hd44780.c
+
+  Summary:
+    Modelo do controlador HD44780 ligado em 4 bits aos pinos PINO_LCD_*.
+
+  Description:
+    O modelo olha os pinos (HOST_LcdPinos) a cada leitura do core timer e
+    na sada de cada ISR do TMR7 (ver HOST_CoreTimerObservador). Na borda
+    de descida de EN l RS e D4..D7, monta o byte (dois nibbles no modo de
+    4 bits, um nibble no alto do byte no modo de 8 bits) e executa o
+    comando ou a escrita na DDRAM/CGRAM como o controlador.
+
+    Tambm confere a temporizao contra o core timer:
+    - EN alto por pelo menos 450ns (PW_EH) e 1us entre duas subidas (tcycE);
+    - nenhuma escrita antes de terminar a anterior: 37us por comando ou
+      dado, 1,52ms para clear e return home.
+    Os comandos que o firmware no usa (shift do display, leitura) contam
+    como erro de protocolo, porque o modelo no os simula.
+*******************************************************************************/
+
+#include <string.h>
+#include "definitions.h"
+
+// Tempos do HD44780 em ticks do core timer (60MHz)
+#define LCD_MODELO_PW_EH        27U         // 450ns
+#define LCD_MODELO_TCYC_E       60U         // 1us
+#define LCD_MODELO_EXEC         2220U       // 37us
+#define LCD_MODELO_EXEC_LENTO   91200U      // 1,52ms
+
+volatile uint8_t HOST_LcdPinos[HOST_LCD_PINOS];
+
+static HOST_LCD g_lcd;
+static bool g_en = false;               // EN na ltima amostra
+static bool g_subiu = false;            // j houve uma subida de EN
+static uint32_t g_subida = 0;           // instante da ltima subida
+static uint32_t g_livre = 0;            // fim da execuo da ltima escrita
+
+// Endereo DDRAM do incio de cada linha do 20x4
+static const uint8_t g_enderecoLinha[4] = { 0x00, 0x40, 0x14, 0x54 };
+
+// *****************************************************************************
+// Execuo
+// *****************************************************************************
+
+// Avana o contador de endereo da DDRAM no modo de duas linhas
+// (0x00..0x27 e 0x40..0x67)
+static uint8_t lcd_modelo_proximo(uint8_t ac, bool incrementa)
+{
+    if (incrementa)
+    {
+        if (ac == 0x27U)
+            return 0x40U;
+        if (ac == 0x67U)
+            return 0x00U;
+        return (uint8_t)(ac + 1U);
+    }
+
+    if (ac == 0x00U)
+        return 0x67U;
+    if (ac == 0x40U)
+        return 0x27U;
+    return (uint8_t)(ac - 1U);
+}
+
+static uint32_t lcd_modelo_comando(uint8_t cmd)
+{
+    g_lcd.comandos++;
+
+    if (cmd == 0x01U)
+    {
+        // Clear display
+        memset(g_lcd.ddram, ' ', sizeof(g_lcd.ddram));
+        g_lcd.ac = 0;
+        g_lcd.cgram_sel = false;
+        g_lcd.incrementa = true;
+        return LCD_MODELO_EXEC_LENTO;
+    }
+    if (cmd <= 0x03U)
+    {
+        // Return home
+        g_lcd.ac = 0;
+        g_lcd.cgram_sel = false;
+        return LCD_MODELO_EXEC_LENTO;
+    }
+    if (cmd <= 0x07U)
+    {
+        // Entry mode set: o shift do display no  simulado
+        g_lcd.incrementa = ((cmd & 0x02U) != 0U);
+        if ((cmd & 0x01U) != 0U)
+            g_lcd.erros_protocolo++;
+    }
+    else if (cmd <= 0x0FU)
+    {
+        // Display on/off control
+        g_lcd.ligado = ((cmd & 0x04U) != 0U);
+    }
+    else if (cmd <= 0x1FU)
+    {
+        // Cursor/display shift: no usado pelo firmware
+        g_lcd.erros_protocolo++;
+    }
+    else if (cmd <= 0x3FU)
+    {
+        // Function set
+        g_lcd.modo4 = ((cmd & 0x10U) == 0U);
+        g_lcd.duas_linhas = ((cmd & 0x08U) != 0U);
+    }
+    else if (cmd <= 0x7FU)
+    {
+        g_lcd.ac = cmd & 0x3FU;
+        g_lcd.cgram_sel = true;
+    }
+    else
+    {
+        g_lcd.ac = cmd & 0x7FU;
+        g_lcd.cgram_sel = false;
+        // Fora das duas linhas de 40 posies
+        if ((g_lcd.ac & 0x3FU) > 0x27U)
+            g_lcd.erros_protocolo++;
+    }
+
+    return LCD_MODELO_EXEC;
+}
+
+static uint32_t lcd_modelo_dado(uint8_t dado)
+{
+    g_lcd.dados++;
+
+    if (g_lcd.cgram_sel)
+    {
+        // A CGRAM guarda 5 bits por linha
+        g_lcd.cgram[g_lcd.ac & 0x3FU] = dado & 0x1FU;
+        g_lcd.ac = (uint8_t)((g_lcd.incrementa ? (g_lcd.ac + 1U) : (g_lcd.ac - 1U)) & 0x3FU);
+    }
+    else
+    {
+        g_lcd.ddram[g_lcd.ac & 0x7FU] = dado;
+        g_lcd.ac = lcd_modelo_proximo(g_lcd.ac, g_lcd.incrementa);
+    }
+
+    return LCD_MODELO_EXEC;
+}
+
+// Borda de descida de EN: um nibble nas linhas D4..D7
+static void lcd_modelo_nibble(uint32_t agora)
+{
+    uint8_t nibble, byte;
+    bool rs = (HOST_LcdPinos[HOST_LCD_RS] != 0U);
+
+    nibble = (uint8_t)(((HOST_LcdPinos[HOST_LCD_D4] & 1U) << 0) |
+                       ((HOST_LcdPinos[HOST_LCD_D5] & 1U) << 1) |
+                       ((HOST_LcdPinos[HOST_LCD_D6] & 1U) << 2) |
+                       ((HOST_LcdPinos[HOST_LCD_D7] & 1U) << 3));
+
+    if (HOST_LcdPinos[HOST_LCD_RW] != 0U)
+    {
+        // Leitura (busy flag): o firmware s escreve
+        g_lcd.erros_protocolo++;
+        return;
+    }
+
+    // O controlador s aceita a escrita seguinte depois de executar a
+    // anterior. No modo de 4 bits vale para o primeiro nibble.
+    if (!g_lcd.meio_byte && ((int32_t)(g_livre - agora) > 0))
+        g_lcd.erros_tempo++;
+
+    if (g_lcd.modo4 && !g_lcd.meio_byte)
+    {
+        g_lcd.nibble_alto = nibble;
+        g_lcd.meio_byte = true;
+        return;
+    }
+
+    if (g_lcd.modo4)
+        byte = (uint8_t)((g_lcd.nibble_alto << 4) | nibble);
+    else
+        byte = (uint8_t)(nibble << 4);      // D0..D3 no esto ligados
+    g_lcd.meio_byte = false;
+
+    g_livre = agora + (rs ? lcd_modelo_dado(byte) : lcd_modelo_comando(byte));
+}
+
+// *****************************************************************************
+// host.h
+// *****************************************************************************
+
+void HOST_LcdInicia(uint8_t lixo)
+{
+    // Estado depois do reset de power-on: 8 bits, uma linha, display
+    // desligado e a RAM com o que sobrou
+    memset(&g_lcd, 0, sizeof(g_lcd));
+    memset(g_lcd.ddram, lixo, sizeof(g_lcd.ddram));
+    memset(g_lcd.cgram, lixo & 0x1FU, sizeof(g_lcd.cgram));
+    g_lcd.incrementa = true;
+
+    g_en = (HOST_LcdPinos[HOST_LCD_EN] != 0U);
+    g_subiu = false;
+    g_livre = HOST_CoreTimer();
+    HOST_CoreTimerObservador(HOST_LcdAmostra);
+}
+
+const HOST_LCD *HOST_Lcd(void)
+{
+    return &g_lcd;
+}
+
+void HOST_LcdAmostra(uint32_t agora)
+{
+    bool en = (HOST_LcdPinos[HOST_LCD_EN] != 0U);
+
+    if (en && !g_en)
+    {
+        if (g_subiu && ((agora - g_subida) < LCD_MODELO_TCYC_E))
+            g_lcd.erros_pulso++;
+        g_subida = agora;
+        g_subiu = true;
+    }
+    else if (!en && g_en)
+    {
+        if ((agora - g_subida) < LCD_MODELO_PW_EH)
+            g_lcd.erros_pulso++;
+        lcd_modelo_nibble(agora);
+    }
+    g_en = en;
+}
+
+uint8_t HOST_LcdCelula(uint8_t linha, uint8_t col)
+{
+    return g_lcd.ddram[(g_enderecoLinha[linha & 3U] + col) & 0x7FU];
+}
+
+int32_t HOST_LcdPixels(uint8_t linha, uint8_t col, uint8_t linha_pixel)
+{
+    uint8_t c = HOST_LcdCelula(linha, col);
+
+    // 0..7 e 8..15 so os mesmos 8 caracteres da CGRAM
+    if (c < 16U)
+        return g_lcd.cgram[((c & 7U) * 8U) + (linha_pixel & 7U)];
+    if (c == ' ')
+        return 0;
+    if (c == 0xFFU)
+        return 0x1F;
+    return -1;
+}
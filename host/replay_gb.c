@@ -0,0 +1,162 @@
+/*******************************************************************************
+  Reproduo de gravaes do ensaio GB no host
+
+  File Name:
+    replay_gb.c
+
+  Summary:
+    Ensaio GB completo alimentado por uma gravao de amostras.
+
+  Description:
+    Roda o ensaio como no firmware (host_ensaio_gb.c): cada bloco da
+    gravao  entregue pela interrupo simulada de aquisicao_gb_host.c a
+    MEDIDA_GB_BlocoCallback, e a MEDIDA_GB_Tasks roda sempre que 
+    notificada.
+
+    Confere que:
+    - todo bloco entregue passou pelo anel e virou amostras processadas;
+    - as leituras publicadas batem com o RMS da gravao inteira (a
+      gravao  estacionria);
+    - o ensaio termina (assentado ou no tempo mximo) e deixa TRIAC, rel,
+      MUX, zero-cross e aquisio desligados.
+
+    Uso: replay_gb [gravao]   (padro: gravacoes/gb_60hz_25a.txt)
+*******************************************************************************/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <math.h>
+#include "definitions.h"
+
+#define REPLAY_GRAVACAO_PADRAO  "gravacoes/gb_60hz_25a.txt"
+
+// Tolerncia das leituras contra o RMS da gravao inteira
+#define REPLAY_TOL_TENSAO       4.0     // cdigos do ADC
+#define REPLAY_TOL_CORRENTE     3.0     // A*10
+#define REPLAY_TOL_R            2.0     // mOhm
+#define REPLAY_JANELAS_IGNORA   4U      // at o zero-cross medir a rede
+
+MENU_DISPLAY_DATA menu_displayData;
+
+void ACTION_SendEventFromTask(ACTION_ID id, ACTION_EVENT_TYPE type)
+{
+    (void)id;
+    (void)type;
+}
+
+typedef struct
+{
+    uint32_t publicadas;
+    uint32_t conferidas;
+    double erro_v, erro_i, erro_r;
+    double ref_v, ref_i, ref_r;
+} REPLAY_RESULTADO;
+
+static REPLAY_RESULTADO g_res;
+
+static double replay_abs(double x)
+{
+    return (x < 0.0) ? -x : x;
+}
+
+// Cada janela publicada, comparada com o RMS da gravao
+static void replay_leitura(uint32_t seq, uintptr_t context)
+{
+    MEDIDA_GB_LEITURA leitura;
+    double erro;
+
+    (void)seq;
+    (void)context;
+
+    if (!MEDIDA_GB_LeituraGet(&leitura))
+        return;
+    if (++g_res.publicadas <= REPLAY_JANELAS_IGNORA)
+        return;
+    g_res.conferidas++;
+
+    erro = replay_abs((double)leitura.tensao - g_res.ref_v);
+    if (erro > g_res.erro_v)
+        g_res.erro_v = erro;
+    erro = replay_abs((double)leitura.corrente - g_res.ref_i);
+    if (erro > g_res.erro_i)
+        g_res.erro_i = erro;
+    erro = replay_abs((double)leitura.resistencia - g_res.ref_r);
+    if (erro > g_res.erro_r)
+        g_res.erro_r = erro;
+}
+
+static void replay_referencia(const HOST_GB_GRAVACAO *grav)
+{
+    double soma_v = 0.0, soma_i = 0.0, v_rms, i_rms;
+    uint32_t k;
+
+    for (k = 0; k < grav->n; k++)
+    {
+        soma_v += (double)grav->amostras[k].tensao * grav->amostras[k].tensao;
+        soma_i += (double)grav->amostras[k].corrente * grav->amostras[k].corrente;
+    }
+    v_rms = sqrt(soma_v / grav->n);
+    i_rms = sqrt(soma_i / grav->n);
+
+    g_res.ref_v = v_rms;
+    g_res.ref_i = i_rms * 1129.0 / 8192.0;
+    g_res.ref_r = v_rms * 1335.0 / i_rms / 8.0;
+}
+
+int main(int argc, char **argv)
+{
+    const char *arquivo = (argc > 1) ? argv[1] : REPLAY_GRAVACAO_PADRAO;
+    AQUISICAO_GB_ESTATISTICAS estat;
+    TickType_t duracao;
+    uint32_t amostras;
+    bool ok;
+
+    if (!HOST_GbGravacaoCarrega(arquivo))
+    {
+        printf("nao consegui ler a gravacao %s\n", arquivo);
+        return 1;
+    }
+    replay_referencia(HOST_GbGravacao());
+
+    HOST_GbEnsaioPrepara();
+    (void)MEDIDA_GB_Assina(replay_leitura, 0, 0);
+    if (!HOST_GbEnsaioRoda(&duracao))
+    {
+        printf("MEDIDA_GB_IniciaEnsaio recusou o ensaio\n");
+        return 1;
+    }
+
+    AQUISICAO_GB_EstatisticasGet(&estat);
+    amostras = estat.blocos * AQUISICAO_GB_AMOSTRAS_BLOCO;
+
+    printf("Gravacao %s: %u amostras (%.2f s), RMS V %.1f, I %.1f, R %.1f mOhm\n",
+           arquivo, (unsigned)HOST_GbGravacao()->n,
+           (double)HOST_GbGravacao()->n * AQUISICAO_GB_TICKS_AMOSTRA / AQUISICAO_GB_CLOCK_HZ,
+           g_res.ref_v, g_res.ref_i, g_res.ref_r);
+    printf("ensaio: %u ms, %s, %u blocos entregues, rede %uHz, janela %u amostras\n",
+           (unsigned)duracao,
+           medida_gbData.estavel ? "assentou" :
+           (medida_gbData.sobrecorrente ? "sobrecorrente" : "tempo maximo"),
+           (unsigned)estat.blocos, (unsigned)medida_gbData.freq_rede,
+           (unsigned)medida_gbData.amostras_janela);
+    printf("janelas: %u publicadas, %u conferidas; erro max V %.2f, I %.2f, R %.2f\n",
+           (unsigned)g_res.publicadas, (unsigned)g_res.conferidas,
+           g_res.erro_v, g_res.erro_i, g_res.erro_r);
+    printf("custo da interrupcao de bloco: max %u %s do host\n",
+           (unsigned)estat.isr_ciclos_max, HOST_RELOGIO_UNIDADE);
+
+    ok = (estat.blocos > 0U) && (g_res.conferidas > 0U) &&
+         // Nenhum bloco perdido no anel: as janelas fechadas cobrem tudo
+         // o que foi entregue, menos a janela aberta no fim
+         ((g_res.publicadas + 1U) * medida_gbData.amostras_janela > amostras) &&
+         (g_res.publicadas * medida_gbData.amostras_janela <= amostras) &&
+         (g_res.erro_v <= REPLAY_TOL_TENSAO) && (g_res.erro_i <= REPLAY_TOL_CORRENTE) &&
+         (g_res.erro_r <= REPLAY_TOL_R) &&
+         (duracao <= pdMS_TO_TICKS(5000) + 10U) &&
+         (HOST_PinoLe(HOST_PINO_TRIAC_GB) == 0U) && (HOST_PinoLe(HOST_PINO_RELE2_TAP) == 0U) &&
+         (HOST_PinoLe(HOST_PINO_MUX_A) == 0U) && (HOST_PinoLe(HOST_PINO_MUX_B) == 0U) &&
+         !HOST_GbBloco();
+
+    printf("\n%s\n", ok ? "OK" : "FALHOU");
+    return ok ? 0 : 1;
+}
@@ -0,0 +1,490 @@
+/*******************************************************************************
+  Reproduo de rajadas do leitor de cdigo de barras
+
+  File Name:
+    replay_leitor.c
+
+  Summary:
+    Rajadas de relatrios HID, na taxa mxima do USB, pela APP_USB_Tasks.
+
+  Description:
+    Os relatrios da gravao, um por ms, passam pelo driver do teclado do
+    Harmony (usb_host_hid_keyboard.c) como no firmware: a interrupo do fim
+    da transferncia IN entrega o relatrio ao handler registrado na camada
+    HID (APP_USB_HIDKeyboardEventHandler, que o pe na fila do driver) e avisa
+    a task do host; a task do host roda o USB_HOST_HID_KEYBOARD_Task uma vez
+    por aviso, que decodifica um relatrio da fila pelo mapa de campos (o do
+    protocolo boot, host_usb_hid_boot.c) e chama o
+    APP_USBHostHIDKeyboardEventHandler. A APP_USB_Tasks roda como em tasks.c
+    (acorda por notificao) e entrega as linhas pelo APP_USB_LinhaAssina.
+    Cada linha entregue  comparada com a esperada na gravao: nenhuma tecla
+    pode se perder, nem na fila do driver (droppedReports) nem no anel da
+    APP_USB.
+
+    A gravao  reproduzida vrias vezes, mudando quando a task do host e
+    a APP_USB_Tasks conseguem rodar:
+    - atraso: a task s ganha a CPU a cada N ms (ocupada com outra coisa ou
+      atrs de tasks de prioridade maior); com atraso maior que a rajada o
+      anel guarda a rajada inteira;
+    - host: a task do host s ganha a CPU a cada N ms; a fila do driver
+      (USB_HOST_HID_KEYBOARD_BUFFER_QUEUE_SIZE relatrios) guarda o que
+      chegou nesse tempo;
+    - preempo: quando a task termina uma linha (ACTION_SendEventFromTask,
+      depois de esvaziar o anel) chegam os prximos relatrios, at o resto
+      da rajada, e a task do host os entrega antes da task voltar a esperar
+      notificao. As teclas que chegam a s saem se a notificao delas
+      fizer a task esvaziar o anel de novo.
+
+    Formato da gravao: ver o cabealho de gravacoes/leitor_rajadas.txt.
+
+    Uso: replay_leitor [gravao]   (padro: gravacoes/leitor_rajadas.txt)
+*******************************************************************************/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "definitions.h"
+
+// Dados da APP_USB (definidos em app_usb.c)
+extern APP_USB_DATA app_usbData;
+
+#define REPLAY_GRAVACAO_PADRAO  "gravacoes/leitor_rajadas.txt"
+
+#define REPLAY_COMANDOS_MAX     4096U
+#define REPLAY_RAJADA           UINT32_MAX
+
+typedef enum
+{
+    REPLAY_RELATORIO,
+    REPLAY_ESPERADA,
+    REPLAY_PAUSA,
+    REPLAY_LEITOR,
+    REPLAY_LAYOUT
+} REPLAY_TIPO;
+
+typedef struct
+{
+    REPLAY_TIPO tipo;
+    uint32_t linha;                     // linha da gravao
+    uint32_t valor;                     // pausa (ms), prefixo ou layout
+    uint8_t relatorio[8];
+    char texto[APP_USB_LINHA_MAX + 1U];
+} REPLAY_COMANDO;
+
+typedef struct
+{
+    uint32_t atraso;                    // ms entre duas vezes que a task roda
+    uint32_t atrasoHost;                // o mesmo para a task do host
+    uint32_t preempcao;                 // relatrios entregues no fim da linha
+} REPLAY_PASSADA;
+
+// A fila do driver tem 15 relatrios: a task do host pode ficar at 14 ms
+// sem rodar
+static const REPLAY_PASSADA g_passadas[] =
+{
+    {    0U,  0U, 0U            },
+    {    0U,  0U, 2U            },
+    {    0U,  0U, REPLAY_RAJADA },
+    {    1U,  0U, 2U            },
+    {    8U,  0U, REPLAY_RAJADA },
+    { 1000U,  0U, 0U            },      // s roda nas pausas
+    {    0U, 14U, 0U            },
+    {    8U, 14U, REPLAY_RAJADA },
+};
+
+static const char *g_arquivo;
+static REPLAY_COMANDO g_comandos[REPLAY_COMANDOS_MAX];
+static uint32_t g_nComandos;
+static uint32_t g_proximo;              // prximo comando da passada
+
+static const REPLAY_PASSADA *g_passada;
+static bool g_rajada;                   // relatrios chegando
+static bool g_preemptando;
+static uint32_t g_relatorios, g_preempcoes;
+static TickType_t g_ultimaHost;         // ltima vez que a task do host rodou
+
+static uint32_t g_linhas[REPLAY_COMANDOS_MAX];  // comandos '=', em ordem
+static uint32_t g_nLinhas;
+static uint32_t g_esperadas;            // linhas j lidas na passada
+static uint32_t g_entregues;            // linhas entregues pela APP_USB
+static uint32_t g_falhas;
+
+// *****************************************************************************
+// Pilha USB: a camada HID embaixo do driver do teclado e a camada de host
+// *****************************************************************************
+
+static USB_HOST_HID_INTERFACE_EVENT_NOTIFY g_hidAviso = NULL;
+static bool g_hidConectado = false;     // driver de uso com o handle
+
+#define REPLAY_HANDLE           ((USB_HOST_HID_OBJ_HANDLE)0x1234U)
+
+void USB_HOST_HID_InterfaceEventNotifySet(USB_HOST_HID_INTERFACE_EVENT_NOTIFY notify)
+{
+    g_hidAviso = notify;
+}
+
+USB_HOST_RESULT USB_HOST_EventHandlerSet(USB_HOST_EVENT_HANDLER eventHandler, uintptr_t context)
+{
+    (void)eventHandler;
+    (void)context;
+    return USB_HOST_RESULT_SUCCESS;
+}
+
+USB_HOST_RESULT USB_HOST_BusEnable(USB_HOST_BUS bus)
+{
+    (void)bus;
+    return USB_HOST_RESULT_SUCCESS;
+}
+
+USB_HOST_RESULT USB_HOST_BusIsEnabled(USB_HOST_BUS bus)
+{
+    (void)bus;
+    return USB_HOST_RESULT_TRUE;
+}
+
+// Interrupo do fim da transferncia IN: o que a camada HID faz em
+// F_USB_HOST_HID_InterfaceEventHandler com o relatrio de 8 bytes do
+// protocolo boot no buffer de 64 bytes do pedido IN
+static void replay_relatorio(const uint8_t relatorio[8])
+{
+    uint8_t buffer[64];
+
+    memset(buffer, 0, sizeof(buffer));
+    memcpy(buffer, relatorio, 8);
+
+    g_relatorios++;
+    HOST_ISR_ENTRA();
+    APP_USB_HIDKeyboardEventHandler(REPLAY_HANDLE, USB_HOST_HID_EVENT_REPORT_RECEIVED, buffer);
+    if (g_hidAviso != NULL)
+        g_hidAviso();
+    HOST_ISR_SAI();
+}
+
+// Attach e detach da interface, avisados pela task do host. Depois do
+// detach a camada HID no roda mais o driver de uso com o handle.
+static void replay_hid_conecta(bool conectado)
+{
+    USB_HOST_HID_EVENT evento = conectado ? USB_HOST_HID_EVENT_ATTACH : USB_HOST_HID_EVENT_DETACH;
+
+    APP_USB_HIDKeyboardEventHandler(REPLAY_HANDLE, evento, NULL);
+    g_hidConectado = conectado;
+}
+
+// Corpo da task do host em tasks.c, com o teclado j enumerado: uma passada
+// por aviso, e em cada passada a camada HID roda o driver do teclado
+static void replay_host(void *param)
+{
+    (void)param;
+    for (;;)
+    {
+        (void)ulTaskNotifyTake(pdFALSE, portMAX_DELAY);
+        if (g_hidConectado)
+            USB_HOST_HID_KEYBOARD_Task(REPLAY_HANDLE);
+    }
+}
+
+// Roda a task do host at ela esperar aviso sem nenhum pendente
+static void replay_host_roda(void)
+{
+    g_ultimaHost = xTaskGetTickCount();
+    (void)HOST_TarefaRoda(xUSB_HOST_Tasks, replay_host, NULL);
+}
+
+// *****************************************************************************
+// O que a APP_USB usa das outras aplicaes
+// *****************************************************************************
+
+// Prximo relatrio da gravao, um por ms
+static bool replay_entrega(void)
+{
+    if ((g_proximo >= g_nComandos) || (g_comandos[g_proximo].tipo != REPLAY_RELATORIO))
+        return false;
+
+    HOST_TickAvanca(1);
+    replay_relatorio(g_comandos[g_proximo].relatorio);
+    g_proximo++;
+    if ((TickType_t)(xTaskGetTickCount() - g_ultimaHost) >= g_passada->atrasoHost)
+        replay_host_roda();
+    return true;
+}
+
+void ACTION_SendEventFromTask(ACTION_ID id, ACTION_EVENT_TYPE type)
+{
+    uint32_t i;
+
+    (void)id;
+    (void)type;
+
+    // O host passa na frente antes da APP_USB voltar a esperar
+    if (!g_rajada || g_preemptando)
+        return;
+    g_preemptando = true;
+    for (i = 0; (i < g_passada->preempcao) && replay_entrega(); i++)
+        g_preempcoes++;
+    g_preemptando = false;
+}
+
+static void replay_linha(const char *linha, uint32_t tamanho, uintptr_t context)
+{
+    const REPLAY_COMANDO *esperada;
+
+    (void)context;
+
+    if (g_entregues >= g_nLinhas)
+    {
+        g_falhas++;
+        printf("  linha a mais: \"%.*s\"\n", (int)tamanho, linha);
+        return;
+    }
+
+    esperada = &g_comandos[g_linhas[g_entregues++]];
+    if ((tamanho != strlen(esperada->texto)) || (memcmp(linha, esperada->texto, tamanho) != 0))
+    {
+        g_falhas++;
+        printf("  %s:%u: esperado \"%s\", entregue \"%.*s\"\n", g_arquivo,
+               (unsigned)esperada->linha, esperada->texto, (int)tamanho, linha);
+    }
+}
+
+// *****************************************************************************
+// Task
+// *****************************************************************************
+
+// Corpo da task em config/default/tasks.c
+static void replay_app(void *param)
+{
+    (void)param;
+    for (;;)
+    {
+        APP_USB_Tasks();
+        (void)ulTaskNotifyTake(pdTRUE, APP_USB_Espera());
+    }
+}
+
+// Roda a APP_USB_Tasks at ela esperar notificao sem nenhuma pendente
+static void replay_app_roda(void)
+{
+    (void)HOST_TarefaRoda(xAPP_USB_Tasks, replay_app, NULL);
+}
+
+// *****************************************************************************
+// Gravao
+// *****************************************************************************
+
+static bool replay_carrega(const char *arquivo)
+{
+    char linha[160];
+    unsigned b[8];
+    char c;
+    FILE *f;
+    REPLAY_COMANDO *cmd;
+    uint32_t n = 0;
+    size_t tam;
+
+    f = fopen(arquivo, "r");
+    if (f == NULL)
+        return false;
+
+    g_nComandos = 0;
+    g_nLinhas = 0;
+    while (fgets(linha, sizeof(linha), f) != NULL)
+    {
+        n++;
+        linha[strcspn(linha, "\r\n")] = '\0';
+        if ((linha[0] == '\0') || (linha[0] == '#'))
+            continue;
+
+        if (g_nComandos >= REPLAY_COMANDOS_MAX)
+        {
+            printf("%s:%u: comandos demais\n", arquivo, (unsigned)n);
+            fclose(f);
+            return false;
+        }
+        cmd = &g_comandos[g_nComandos];
+        memset(cmd, 0, sizeof(*cmd));
+        cmd->linha = n;
+
+        if (sscanf(linha, "r %x %x %x %x %x %x %x %x",
+                   &b[0], &b[1], &b[2], &b[3], &b[4], &b[5], &b[6], &b[7]) == 8)
+        {
+            cmd->tipo = REPLAY_RELATORIO;
+            for (tam = 0; tam < 8U; tam++)
+                cmd->relatorio[tam] = (uint8_t)b[tam];
+        }
+        else if ((strncmp(linha, "= ", 2) == 0) && ((tam = strlen(&linha[2])) <= APP_USB_LINHA_MAX) &&
+                 (g_nLinhas < REPLAY_COMANDOS_MAX))
+        {
+            cmd->tipo = REPLAY_ESPERADA;
+            memcpy(cmd->texto, &linha[2], tam + 1U);
+            g_linhas[g_nLinhas++] = g_nComandos;
+        }
+        else if (sscanf(linha, "pausa %u", &b[0]) == 1)
+        {
+            cmd->tipo = REPLAY_PAUSA;
+            cmd->valor = b[0];
+        }
+        else if ((sscanf(linha, "leitor %c", &c) == 1) && (linha[8] == '\0'))
+        {
+            cmd->tipo = REPLAY_LEITOR;
+            cmd->valor = (c == '-') ? 0U : (uint8_t)c;
+        }
+        else if (strcmp(linha, "layout us") == 0)
+        {
+            cmd->tipo = REPLAY_LAYOUT;
+            cmd->valor = TECLADO_LAYOUT_US;
+        }
+        else if (strcmp(linha, "layout abnt2") == 0)
+        {
+            cmd->tipo = REPLAY_LAYOUT;
+            cmd->valor = TECLADO_LAYOUT_ABNT2;
+        }
+        else
+        {
+            printf("%s:%u: linha invalida: %s\n", arquivo, (unsigned)n, linha);
+            fclose(f);
+            return false;
+        }
+        g_nComandos++;
+    }
+
+    fclose(f);
+    return true;
+}
+
+// Confere, com o barramento parado, se todas as linhas j lidas saram
+static void replay_confere(const REPLAY_COMANDO *cmd)
+{
+    if (g_entregues == g_esperadas)
+        return;
+
+    g_falhas++;
+    printf("  %s:%u: %u linhas esperadas, %u entregues\n", g_arquivo, (unsigned)cmd->linha,
+           (unsigned)g_esperadas, (unsigned)g_entregues);
+    g_entregues = g_esperadas;
+}
+
+static void replay_passada(const REPLAY_PASSADA *passada)
+{
+    const REPLAY_COMANDO *cmd;
+    uint32_t falhas = g_falhas, relatorios = g_relatorios, descartados;
+    TickType_t inicio, ultima;
+
+    g_passada = passada;
+    g_proximo = 0;
+    g_esperadas = 0;
+    g_entregues = 0;
+    g_preempcoes = 0;
+
+    // Host habilitado e teclado (leitor) conectado: a camada HID avisa o
+    // attach da task do host
+    APP_USB_Initialize();
+    replay_app_roda();
+    replay_hid_conecta(true);
+    replay_host_roda();
+    replay_app_roda();
+    inicio = xTaskGetTickCount();
+    ultima = inicio;
+
+    while (g_proximo < g_nComandos)
+    {
+        cmd = &g_comandos[g_proximo];
+
+        if (cmd->tipo == REPLAY_RELATORIO)
+        {
+            g_rajada = true;
+            (void)replay_entrega();
+            if ((TickType_t)(xTaskGetTickCount() - ultima) >= passada->atraso)
+            {
+                ultima = xTaskGetTickCount();
+                replay_app_roda();
+            }
+            continue;
+        }
+
+        g_rajada = false;
+        g_proximo++;
+        switch (cmd->tipo)
+        {
+            case REPLAY_ESPERADA:
+                g_esperadas++;
+                break;
+
+            case REPLAY_PAUSA:
+                // Barramento parado: as tasks com certeza rodam
+                HOST_TickAvanca(cmd->valor);
+                ultima = xTaskGetTickCount();
+                replay_host_roda();
+                replay_app_roda();
+                replay_confere(cmd);
+                break;
+
+            case REPLAY_LEITOR:
+                APP_USB_LeitorModoSet(true, (char)cmd->valor);
+                break;
+
+            case REPLAY_LAYOUT:
+                TECLADO_LayoutSet((TECLADO_LAYOUT)cmd->valor);
+                break;
+
+            default:
+                break;
+        }
+    }
+
+    replay_host_roda();
+    replay_app_roda();
+    if (g_entregues != g_nLinhas)
+    {
+        g_falhas++;
+        printf("  fim: %u linhas esperadas, %u entregues\n", (unsigned)g_nLinhas, (unsigned)g_entregues);
+    }
+    if (app_usbData.linhasLongas != 0U)
+    {
+        g_falhas++;
+        printf("  %u linhas cortadas\n", (unsigned)app_usbData.linhasLongas);
+    }
+    descartados = USB_HOST_HID_KEYBOARD_DroppedReportsGet((USB_HOST_HID_KEYBOARD_HANDLE)REPLAY_HANDLE);
+    if (descartados != 0U)
+    {
+        g_falhas++;
+        printf("  %u relatorios descartados pelo driver do teclado\n", (unsigned)descartados);
+    }
+
+    printf("  atraso %4u ms, host %2u ms, ", (unsigned)passada->atraso, (unsigned)passada->atrasoHost);
+    if (passada->preempcao == REPLAY_RAJADA)
+        printf("preempcao rajada");
+    else
+        printf("preempcao %6u", (unsigned)passada->preempcao);
+    printf(": %u relatorios em %u ms, %u linhas, %u na preempcao -> %s\n",
+           (unsigned)(g_relatorios - relatorios), (unsigned)(xTaskGetTickCount() - inicio),
+           (unsigned)g_entregues, (unsigned)g_preempcoes, (g_falhas == falhas) ? "ok" : "FALHOU");
+
+    replay_hid_conecta(false);
+    replay_host_roda();
+    replay_app_roda();
+}
+
+int main(int argc, char **argv)
+{
+    uint32_t k;
+
+    g_arquivo = (argc > 1) ? argv[1] : REPLAY_GRAVACAO_PADRAO;
+    if (!replay_carrega(g_arquivo))
+    {
+        printf("nao consegui ler a gravacao %s\n", g_arquivo);
+        return 1;
+    }
+
+    printf("Gravacao %s: %u comandos, %u linhas\n", g_arquivo,
+           (unsigned)g_nComandos, (unsigned)g_nLinhas);
+
+    APP_USB_LinhaAssina(replay_linha, 0);
+    for (k = 0; k < sizeof(g_passadas) / sizeof(g_passadas[0]); k++)
+        replay_passada(&g_passadas[k]);
+
+    // Contadores de perda da APP_USB (anel de teclas)
+    APP_USB_ImprimeConsole();
+
+    printf("\n%s\n", (g_falhas == 0U) ? "OK" : "FALHOU");
+    return (g_falhas == 0U) ? 0 : 1;
+}
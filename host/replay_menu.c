@@ -0,0 +1,414 @@
+/*******************************************************************************
+  Reproduo de roteiros de botes no menu
+
+  File Name:
+    replay_menu.c
+
+  Summary:
+    MENU_DISPLAY_Tasks e menu_telas[] dirigidos por um roteiro de botes.
+
+  Description:
+    Os botes entram pelo mesmo caminho do firmware: o roteiro muda o nvel
+    dos pinos (com repique), a interrupo de mudana chama switch_handler e
+    o TMR3 de 1ms faz o debounce e o auto-repeat e pe os eventos na fila do
+    menu. A MENU_DISPLAY_Tasks roda sempre que h evento na fila; os quadros
+    que ela entrega a atualiza_lcd ficam guardados para as conferncias.
+
+    Formato do roteiro (texto, um comando por linha, '#' comenta):
+        aperta <BACK|ENTER|CIMA|BAIXO> [ms]   aperta, segura (padro 80ms)
+                                              e solta, com 2ms de repique
+        espera <ms>
+        estado <MENU_DISPLAY_STATES>          confere o estado do menu
+        item <n>                              confere o item selecionado
+        alvo <n>                              confere a corrente alvo (A*10)
+        linha <0..3> "<texto>"                confere a linha do ltimo
+                                              quadro (completada com espaos)
+        ensaio                                roda o ensaio GB pedido pelo
+                                              menu, sobre a gravao
+        mostra                                imprime o ltimo quadro
+    As conferncias valem com a fila do menu vazia e os botes parados.
+
+    Uso: replay_menu [roteiro]   (padro: roteiros/menu.txt)
+*******************************************************************************/
+
+#include <stdarg.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "definitions.h"
+
+#define REPLAY_ROTEIRO_PADRAO   "roteiros/menu.txt"
+#define REPLAY_GRAVACAO         "gravacoes/gb_60hz_25a.txt"
+
+#define REPLAY_SEGURA_MS        80U     // aperto padro
+#define REPLAY_REPIQUE_MS       2U
+#define REPLAY_ACOES            8U
+#define REPLAY_PARADO_MAX_MS    10000U  // TMR3 rodando sem boto no roteiro
+
+// Task e fila do menu (declaradas em tasks.c e menu_display.c)
+extern TaskHandle_t xMENU_DISPLAY_Tasks;
+extern QueueHandle_t xActionEventQueue;
+
+// O que o menu usa das outras aplicaes
+APP_USB_DATA app_usbData;
+
+void ISR_LAT_ImprimeConsole(void)
+{
+}
+
+typedef struct
+{
+    TickType_t quando;
+    HOST_PINO pino;
+    uint32_t nivel;
+} REPLAY_ACAO;
+
+static FILE *g_roteiro;
+static const char *g_arquivo;
+static uint32_t g_linha;                    // linha atual do roteiro
+static uint32_t g_comandos, g_conferencias, g_falhas;
+
+static REPLAY_ACAO g_acoes[REPLAY_ACOES];   // mudanas de pino agendadas
+static uint32_t g_nAcoes, g_proxAcao;
+static TickType_t g_esperaAte;
+static uint32_t g_parado;                   // ms seguidos s com o TMR3
+
+static char g_lcd[4][20];                   // ltimo quadro entregue
+static uint32_t g_quadros;
+static uint32_t g_quadrosEnsaio;
+static bool g_ensaio;                       // ensaio rodando
+
+// *****************************************************************************
+// Display
+// *****************************************************************************
+
+void atualiza_lcd(char *x_lcd)
+{
+    memcpy(g_lcd, x_lcd, sizeof(g_lcd));
+    g_quadros++;
+    if (g_ensaio)
+        g_quadrosEnsaio++;
+}
+
+static void replay_mostra(void)
+{
+    uint32_t l, c;
+
+    for (l = 0; l < 4U; l++)
+    {
+        printf("    |");
+        // Glifos da CGRAM e bloco cheio aparecem como '#'
+        for (c = 0; c < 20U; c++)
+            putchar(((g_lcd[l][c] >= ' ') && (g_lcd[l][c] < 0x7F)) ? g_lcd[l][c] : '#');
+        printf("|\n");
+    }
+}
+
+// *****************************************************************************
+// Tasks
+// *****************************************************************************
+
+static void replay_menu(void *param)
+{
+    (void)param;
+    for (;;)
+        MENU_DISPLAY_Tasks();
+}
+
+// Entre dois blocos do ensaio: o menu consome o que as outras tasks mandaram
+static void replay_menu_ensaio(void)
+{
+    if (uxQueueMessagesWaiting(xActionEventQueue) != 0U)
+        (void)HOST_TarefaRoda(xMENU_DISPLAY_Tasks, replay_menu, NULL);
+}
+
+// *****************************************************************************
+// Roteiro
+// *****************************************************************************
+
+static void replay_falha(const char *fmt, ...)
+{
+    va_list ap;
+
+    g_falhas++;
+    printf("  %s:%u: ", g_arquivo, (unsigned)g_linha);
+    va_start(ap, fmt);
+    vprintf(fmt, ap);
+    va_end(ap);
+    printf("\n");
+}
+
+static bool replay_botao(const char *nome, HOST_PINO *pino)
+{
+    static const struct { const char *nome; HOST_PINO pino; } botoes[] =
+    {
+        { "BACK",  HOST_PINO_BTN_BACK  },
+        { "ENTER", HOST_PINO_BTN_ENTER },
+        { "CIMA",  HOST_PINO_BTN_CIMA  },
+        { "BAIXO", HOST_PINO_BTN_BAIXO },
+    };
+    uint32_t k;
+
+    for (k = 0; k < sizeof(botoes) / sizeof(botoes[0]); k++)
+    {
+        if (strcmp(nome, botoes[k].nome) == 0)
+        {
+            *pino = botoes[k].pino;
+            return true;
+        }
+    }
+    return false;
+}
+
+static const char *replay_estado_nome(MENU_DISPLAY_STATES estado)
+{
+    static const char *const nomes[] =
+    {
+        [MENU_DISPLAY_STATE_INIT]    = "MENU_DISPLAY_STATE_INIT",
+        [MENU_DISPLAY_STATE_TECLADO] = "MENU_DISPLAY_STATE_TECLADO",
+        [MENU_DISPLAY_STATE_HP]      = "MENU_DISPLAY_STATE_HP",
+        [MENU_DISPLAY_STATE_GB]      = "MENU_DISPLAY_STATE_GB",
+        [MENU_DISPLAY_STATE_TF]      = "MENU_DISPLAY_STATE_TF",
+        [ENSAIO_GB_STATE_ENSAIANDO]  = "ENSAIO_GB_STATE_ENSAIANDO",
+        [MENU_DISPLAY_STATE_DIAG_GB] = "MENU_DISPLAY_STATE_DIAG_GB",
+    };
+
+    if (((uint32_t)estado < sizeof(nomes) / sizeof(nomes[0])) && (nomes[estado] != NULL))
+        return nomes[estado];
+    return "?";
+}
+
+static void replay_agenda(TickType_t quando, HOST_PINO pino, uint32_t nivel)
+{
+    g_acoes[g_nAcoes].quando = quando;
+    g_acoes[g_nAcoes].pino = pino;
+    g_acoes[g_nAcoes].nivel = nivel;
+    g_nAcoes++;
+}
+
+// Aperto com repique na descida e na subida: cada borda  uma interrupo
+static void replay_aperta(HOST_PINO pino, uint32_t ms)
+{
+    TickType_t t = xTaskGetTickCount() + 1U;
+
+    g_nAcoes = 0;
+    g_proxAcao = 0;
+    replay_agenda(t, pino, 0U);
+    replay_agenda(t + 1U, pino, 1U);
+    replay_agenda(t + REPLAY_REPIQUE_MS, pino, 0U);
+    t += REPLAY_REPIQUE_MS + ms;
+    replay_agenda(t, pino, 1U);
+    replay_agenda(t + 1U, pino, 0U);
+    replay_agenda(t + REPLAY_REPIQUE_MS, pino, 1U);
+}
+
+static void replay_confere_u(const char *o_que, uint32_t esperado, uint32_t obtido)
+{
+    g_conferencias++;
+    if (esperado != obtido)
+        replay_falha("%s: esperado %u, obtido %u", o_que, (unsigned)esperado, (unsigned)obtido);
+}
+
+static void replay_confere_linha(uint32_t n, const char *texto, size_t tam)
+{
+    char esperado[21], obtido[21];
+
+    g_conferencias++;
+    if ((n > 3U) || (tam > 20U))
+    {
+        replay_falha("linha %u invalida", (unsigned)n);
+        return;
+    }
+
+    memset(esperado, ' ', 20);
+    memcpy(esperado, texto, tam);
+    esperado[20] = '\0';
+    memcpy(obtido, g_lcd[n], 20);
+    obtido[20] = '\0';
+
+    if (memcmp(esperado, obtido, 20) != 0)
+        replay_falha("esperado \"%s\", obtido \"%s\"", esperado, obtido);
+}
+
+static void replay_ensaio(void)
+{
+    TickType_t duracao;
+    uint32_t antes = g_quadros;
+
+    g_conferencias++;
+    g_quadrosEnsaio = 0;
+    g_ensaio = true;
+    if (!HOST_GbEnsaioAtende(&duracao))
+    {
+        g_ensaio = false;
+        replay_falha("ensaio: o menu nao pediu ensaio");
+        return;
+    }
+    g_ensaio = false;
+
+    printf("  ensaio: %u ms, %s, %u quadros durante o ensaio (%u no total)\n",
+           (unsigned)duracao,
+           medida_gbData.estavel ? "assentou" :
+           (medida_gbData.sobrecorrente ? "sobrecorrente" : "tempo maximo"),
+           (unsigned)g_quadrosEnsaio, (unsigned)(g_quadros - antes));
+    if (g_quadrosEnsaio == 0U)
+        replay_falha("ensaio: nenhum quadro desenhado durante o ensaio");
+    replay_mostra();
+}
+
+// Executa a prxima linha do roteiro. Retorna false no fim.
+static bool replay_passo(void)
+{
+    char linha[160], cmd[16], arg[40];
+    const char *aspas, *fim;
+    unsigned n;
+    int campos;
+    HOST_PINO pino;
+
+    for (;;)
+    {
+        if (fgets(linha, sizeof(linha), g_roteiro) == NULL)
+            return false;
+        g_linha++;
+
+        campos = sscanf(linha, "%15s %39s", cmd, arg);
+        if ((campos < 1) || (cmd[0] == '#'))
+            continue;
+        break;
+    }
+    g_comandos++;
+
+    if ((strcmp(cmd, "aperta") == 0) && (campos == 2) && replay_botao(arg, &pino))
+    {
+        if (sscanf(linha, "%*s %*s %u", &n) != 1)
+            n = REPLAY_SEGURA_MS;
+        replay_aperta(pino, n);
+    }
+    else if ((strcmp(cmd, "espera") == 0) && (sscanf(linha, "%*s %u", &n) == 1))
+    {
+        g_esperaAte = xTaskGetTickCount() + n;
+    }
+    else if ((strcmp(cmd, "estado") == 0) && (campos == 2))
+    {
+        g_conferencias++;
+        if (strcmp(arg, replay_estado_nome(menu_displayData.state)) != 0)
+            replay_falha("estado: esperado %s, obtido %s", arg, replay_estado_nome(menu_displayData.state));
+    }
+    else if ((strcmp(cmd, "item") == 0) && (sscanf(linha, "%*s %u", &n) == 1))
+    {
+        replay_confere_u("item", n, menu_displayData.currentItem);
+    }
+    else if ((strcmp(cmd, "alvo") == 0) && (sscanf(linha, "%*s %u", &n) == 1))
+    {
+        replay_confere_u("alvo", n, medida_gbData.corrente_alvo);
+    }
+    else if ((strcmp(cmd, "linha") == 0) && (sscanf(linha, "%*s %u", &n) == 1) &&
+             ((aspas = strchr(linha, '"')) != NULL) && ((fim = strrchr(linha, '"')) > aspas))
+    {
+        replay_confere_linha(n, aspas + 1, (size_t)(fim - aspas - 1));
+    }
+    else if (strcmp(cmd, "ensaio") == 0)
+    {
+        replay_ensaio();
+    }
+    else if (strcmp(cmd, "mostra") == 0)
+    {
+        printf("  %s:%u:\n", g_arquivo, (unsigned)g_linha);
+        replay_mostra();
+    }
+    else
+    {
+        linha[strcspn(linha, "\r\n")] = '\0';
+        replay_falha("comando invalido: %s", linha);
+        return false;
+    }
+    return true;
+}
+
+// Um ms do sistema: pinos agendados, tick do RTOS e TMR3
+static void replay_ms(void)
+{
+    HOST_TickAvanca(1);
+
+    while ((g_proxAcao < g_nAcoes) && ((int32_t)(g_acoes[g_proxAcao].quando - xTaskGetTickCount()) <= 0))
+    {
+        HOST_PinoEscreve(g_acoes[g_proxAcao].pino, g_acoes[g_proxAcao].nivel);
+        (void)HOST_PinoDispara(g_acoes[g_proxAcao].pino);
+        g_proxAcao++;
+    }
+
+    (void)HOST_Tmr3Dispara();
+}
+
+static void replay_espera(TaskHandle_t tarefa, TickType_t ticks)
+{
+    // Tasks do ensaio: sistema simulado por host_ensaio_gb.c
+    if (tarefa != xMENU_DISPLAY_Tasks)
+    {
+        HOST_GbEspera(tarefa, ticks);
+        return;
+    }
+
+    // Menu rodando entre dois blocos do ensaio: volta para o ensaio
+    if (g_ensaio)
+        return;
+
+    while (uxQueueMessagesWaiting(xActionEventQueue) == 0U)
+    {
+        if ((g_proxAcao < g_nAcoes) || ((int32_t)(g_esperaAte - xTaskGetTickCount()) > 0))
+        {
+            g_parado = 0;
+            replay_ms();
+        }
+        else if (HOST_Tmr3()->rodando && (++g_parado < REPLAY_PARADO_MAX_MS))
+        {
+            // Debounce ou auto-repeat ainda correndo
+            replay_ms();
+        }
+        else
+        {
+            if (g_parado >= REPLAY_PARADO_MAX_MS)
+            {
+                replay_falha("TMR3 nao parou sem botao apertado");
+                return;
+            }
+            if (!replay_passo())
+                return;
+        }
+    }
+}
+
+int main(int argc, char **argv)
+{
+    g_arquivo = (argc > 1) ? argv[1] : REPLAY_ROTEIRO_PADRAO;
+    g_roteiro = fopen(g_arquivo, "r");
+    if (g_roteiro == NULL)
+    {
+        printf("nao consegui ler o roteiro %s\n", g_arquivo);
+        return 1;
+    }
+    if (!HOST_GbGravacaoCarrega(REPLAY_GRAVACAO))
+    {
+        printf("nao consegui ler a gravacao %s\n", REPLAY_GRAVACAO);
+        return 1;
+    }
+
+    // Ensaio pronto para ser pedido pelo menu; o menu assina as leituras
+    HOST_GbEnsaioPrepara();
+    HOST_GbEnsaioOutras(replay_menu_ensaio);
+    HOST_EsperaGancho(replay_espera);
+    MENU_DISPLAY_Initialize();
+
+    printf("Roteiro %s\n", g_arquivo);
+
+    // Volta quando o roteiro acaba e o menu fica esperando evento
+    (void)HOST_TarefaRoda(xMENU_DISPLAY_Tasks, replay_menu, NULL);
+    fclose(g_roteiro);
+
+    printf("%u comandos, %u conferencias, %u ms simulados, %u quadros desenhados, %u suprimidos\n",
+           (unsigned)g_comandos, (unsigned)g_conferencias, (unsigned)xTaskGetTickCount(),
+           (unsigned)menu_displayData.quadros_desenhados, (unsigned)menu_displayData.quadros_suprimidos);
+
+    printf("\n%s\n", (g_falhas == 0U) ? "OK" : "FALHOU");
+    return (g_falhas == 0U) ? 0 : 1;
+}
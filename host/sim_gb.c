@@ -0,0 +1,254 @@
+/*******************************************************************************
+  Simulao da cadeia de medida GB no host
+
+  File Name:
+    sim_gb.c
+
+  Summary:
+    Formas de onda sintticas de 50/60Hz passando por MEDIDA_GB_ProcessaAmostra.
+
+  Description:
+    Para cada forma de onda (rudo, harmnicas, offset DC, 50 ou 60Hz) gera
+    as amostras de tenso e corrente na taxa da aquisio (7,68kHz), dispara
+    o zero-cross nos instantes certos (a janela RMS acompanha a rede medida)
+    e passa cada par de amostras por MEDIDA_GB_ProcessaAmostra, que chama
+    calcula_rms, isqrt64/isqrt32, i_gb_calcula e r_gb_calcula.
+
+    A cada janela fechada compara tenso, corrente e resistncia publicadas
+    com a mesma conta feita em double sobre o sinal analgico (antes da
+    quantizao do ADC). Tambm mostra o desvio em relao ao valor nominal
+    (sem rudo, harmnicas e offset), que  o efeito das perturbaes.
+
+    Modelo do sinal: o condicionamento entrega ao ADC o mdulo do sinal (a
+    cadeia soma os quadrados sem tirar a mdia), mais offset e rudo, com
+    saturao em 0 e 4095.
+
+    Sai com erro se alguma janela passar das tolerncias de SIM_TOL_*.
+*******************************************************************************/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <math.h>
+#include "definitions.h"
+#include "utils.h"
+
+// Tolerncias da conta inteira contra a referncia double
+#define SIM_TOL_TENSAO      1.5     // cdigos do ADC
+#define SIM_TOL_CORRENTE    1.5     // A*10
+#define SIM_TOL_R           1.5     // mOhm (r_gb_calcula trunca em 1 mOhm)
+
+#define SIM_DURACAO_S       2.0
+#define SIM_JANELAS_IGNORA  4U      // at o zero-cross medir a rede
+#define SIM_CORE_AMOSTRA    ((uint64_t)AQUISICAO_GB_TICKS_AMOSTRA * CORE_TIMER_FREQUENCY / AQUISICAO_GB_CLOCK_HZ)
+
+// O ensaio no roda aqui: o que medida_gb.c usa do menu fica parado
+MENU_DISPLAY_DATA menu_displayData;
+
+void ACTION_SendEventFromTask(ACTION_ID id, ACTION_EVENT_TYPE type)
+{
+    (void)id;
+    (void)type;
+}
+
+typedef struct
+{
+    const char *nome;
+    double freq;        // Hz
+    double v_pico;      // cdigos do ADC
+    double i_pico;
+    double h3, h5;      // 3 e 5 harmnicas (frao da fundamental)
+    double ruido;       // desvio padro (cdigos)
+    double offset;      // nvel DC (cdigos)
+} SIM_FORMA;
+
+static const SIM_FORMA sim_formas[] =
+{
+    //  nome                    Hz    Vpico   Ipico   h3    h5    rudo offset
+    { "60Hz limpa",             60.0, 1400.0, 2560.0, 0.00, 0.00, 0.0,  0.0  },
+    { "50Hz limpa",             50.0, 1400.0, 2560.0, 0.00, 0.00, 0.0,  0.0  },
+    { "60Hz ruido",             60.0, 1400.0, 2560.0, 0.00, 0.00, 8.0,  0.0  },
+    { "50Hz harmonicas",        50.0, 1400.0, 2400.0, 0.10, 0.05, 0.0,  0.0  },
+    { "60Hz offset DC",         60.0, 1400.0, 2560.0, 0.00, 0.00, 0.0,  20.0 },
+    { "59,5Hz tudo junto",      59.5, 1400.0, 2400.0, 0.08, 0.04, 6.0,  12.0 },
+    { "50Hz corrente baixa",    50.0,  120.0,  220.0, 0.03, 0.00, 3.0,  4.0  },
+};
+
+#define SIM_N_FORMAS    (sizeof(sim_formas) / sizeof(sim_formas[0]))
+
+// Rudo gaussiano reprodutvel (xorshift + Box-Muller)
+static uint64_t g_semente = 0x9E3779B97F4A7C15ULL;
+
+static double sim_uniforme(void)
+{
+    g_semente ^= g_semente << 13;
+    g_semente ^= g_semente >> 7;
+    g_semente ^= g_semente << 17;
+    return ((double)(g_semente >> 11) + 0.5) / 9007199254740992.0;
+}
+
+static double sim_gauss(void)
+{
+    return sqrt(-2.0 * log(sim_uniforme())) * cos(2.0 * M_PI * sim_uniforme());
+}
+
+// Valor analgico que chega ao ADC e a amostra quantizada
+static double sim_analogico(double pico, const SIM_FORMA *f, double fase)
+{
+    double x = sin(fase) + f->h3 * sin(3.0 * fase) + f->h5 * sin(5.0 * fase);
+    double ruido = (f->ruido > 0.0) ? f->ruido * sim_gauss() : 0.0;
+
+    return fabs(pico * x) + f->offset + ruido;
+}
+
+static uint32_t sim_adc(double analogico)
+{
+    if (analogico <= 0.0)
+        return 0U;
+    if (analogico >= 4095.0)
+        return 4095U;
+    return (uint32_t)lround(analogico);
+}
+
+static double sim_abs(double x)
+{
+    return (x < 0.0) ? -x : x;
+}
+
+typedef struct
+{
+    uint32_t janelas;
+    double erro_v, erro_i, erro_r;            // mximos contra a referncia
+    double soma_erro_r;
+    double desvio_i_pct, desvio_r_pct;        // mximos contra o nominal
+    uint64_t ciclos_amostras, amostras;       // amostras que no fecham janela
+    uint64_t ciclos_janelas, janelas_fechadas;
+} SIM_RESULTADO;
+
+static void sim_roda(const SIM_FORMA *f, SIM_RESULTADO *res)
+{
+    const double rms_forma = sqrt((1.0 + f->h3 * f->h3 + f->h5 * f->h5) / 2.0);
+    const double nominal_i = (f->i_pico * rms_forma) * 1129.0 / 8192.0;
+    const double nominal_r = (f->v_pico / f->i_pico) * 1335.0 / 8.0;
+    const uint64_t meio_ciclo = (uint64_t)llround((double)CORE_TIMER_FREQUENCY / (2.0 * f->freq));
+    const uint64_t fim = (uint64_t)(SIM_DURACAO_S * CORE_TIMER_FREQUENCY);
+    uint64_t t_amostra = 0, t_zc = meio_ciclo / 3U;     // zero-cross fora de fase com a amostragem
+    double soma_v = 0.0, soma_i = 0.0;
+    uint32_t n_janela = 0, seq = 0;
+    MEDIDA_GB_LEITURA leitura;
+
+    memset(res, 0, sizeof(*res));
+
+    // Estado de um ensaio novo
+    MEDIDA_GB_Initialize();
+    HOST_PinoInterrupcao(HOST_PINO_ZERO_CROSS, true);
+
+    while (t_amostra < fim)
+    {
+        double fase, v, i, ref_v, ref_i, ref_r, erro;
+        uint32_t adc_v, adc_i;
+        uint64_t t0, ciclos;
+
+        if (t_zc <= t_amostra)
+        {
+            HOST_CoreTimerSet((uint32_t)t_zc);
+            (void)HOST_PinoDispara(HOST_PINO_ZERO_CROSS);
+            t_zc += meio_ciclo;
+            continue;
+        }
+
+        // Fase medida a partir do zero-cross (t_zc - meio_ciclo  o ltimo)
+        fase = M_PI * (double)(t_amostra + meio_ciclo - t_zc) / (double)meio_ciclo;
+        v = sim_analogico(f->v_pico, f, fase);
+        i = sim_analogico(f->i_pico, f, fase);
+        adc_v = sim_adc(v);
+        adc_i = sim_adc(i);
+        soma_v += v * v;
+        soma_i += i * i;
+        n_janela++;
+
+        t0 = HOST_Relogio();
+        MEDIDA_GB_ProcessaAmostra(adc_v, adc_i);
+        ciclos = HOST_Relogio() - t0;
+        t_amostra += SIM_CORE_AMOSTRA;
+
+        if (medida_gbData.cont_ciclos != 0U)
+        {
+            res->ciclos_amostras += ciclos;
+            res->amostras++;
+            continue;
+        }
+
+        // Janela fechada nesta amostra: RMS, converses e publicao
+        res->ciclos_janelas += ciclos;
+        res->janelas_fechadas++;
+
+        ref_v = sqrt(soma_v / n_janela);
+        ref_i = sqrt(soma_i / n_janela);
+        soma_v = 0.0;
+        soma_i = 0.0;
+        n_janela = 0;
+
+        if ((++seq <= SIM_JANELAS_IGNORA) || !MEDIDA_GB_LeituraGet(&leitura))
+            continue;
+
+        ref_r = (ref_i > 0.0) ? (ref_v * 1335.0 / ref_i / 8.0) : 0.0;
+        res->janelas++;
+
+        erro = sim_abs((double)leitura.tensao - ref_v);
+        if (erro > res->erro_v)
+            res->erro_v = erro;
+        erro = sim_abs((double)leitura.corrente - ref_i * 1129.0 / 8192.0);
+        if (erro > res->erro_i)
+            res->erro_i = erro;
+        erro = sim_abs((double)leitura.resistencia - ref_r);
+        if (erro > res->erro_r)
+            res->erro_r = erro;
+        res->soma_erro_r += erro;
+
+        erro = 100.0 * sim_abs((double)leitura.corrente - nominal_i) / nominal_i;
+        if (erro > res->desvio_i_pct)
+            res->desvio_i_pct = erro;
+        erro = 100.0 * sim_abs((double)leitura.resistencia - nominal_r) / nominal_r;
+        if (erro > res->desvio_r_pct)
+            res->desvio_r_pct = erro;
+    }
+}
+
+int main(void)
+{
+    SIM_RESULTADO res;
+    uint32_t k;
+    int falhas = 0;
+
+    printf("Cadeia de medida GB: conta inteira x referencia double (%u amostras/janela a 60Hz)\n",
+           (unsigned)(CORE_TIMER_FREQUENCY / 60U / SIM_CORE_AMOSTRA));
+    printf("erro V em codigos, I em A*10, R em mOhm; desvio = %% do valor nominal\n");
+    printf("custo medio em %s do host por chamada de MEDIDA_GB_ProcessaAmostra\n\n", HOST_RELOGIO_UNIDADE);
+    printf("%-20s %4s | %6s %6s %6s %6s | %7s %7s | %7s %7s\n",
+           "forma", "jan", "erro V", "erro I", "erro R", "med R",
+           "desv I%", "desv R%", "amostra", "janela");
+
+    for (k = 0; k < SIM_N_FORMAS; k++)
+    {
+        const SIM_FORMA *f = &sim_formas[k];
+        bool ok;
+
+        sim_roda(f, &res);
+        ok = (res.janelas > 0U) && (res.erro_v <= SIM_TOL_TENSAO) &&
+             (res.erro_i <= SIM_TOL_CORRENTE) && (res.erro_r <= SIM_TOL_R);
+
+        printf("%-20s %4u | %6.2f %6.2f %6.2f %6.2f | %7.2f %7.2f | %7.1f %7.1f %s\n",
+               f->nome, (unsigned)res.janelas,
+               res.erro_v, res.erro_i, res.erro_r,
+               (res.janelas != 0U) ? (res.soma_erro_r / res.janelas) : 0.0,
+               res.desvio_i_pct, res.desvio_r_pct,
+               (double)res.ciclos_amostras / (double)res.amostras,
+               (double)res.ciclos_janelas / (double)res.janelas_fechadas,
+               ok ? "" : "FALHOU");
+        if (!ok)
+            falhas++;
+    }
+
+    printf("\n%s\n", (falhas == 0) ? "OK" : "FALHOU");
+    return (falhas == 0) ? 0 : 1;
+}
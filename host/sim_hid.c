@@ -0,0 +1,598 @@
+/*******************************************************************************
+  Mapa de campos da camada HID do Harmony
+
+  File Name:
+    sim_hid.c
+
+  Summary:
+    USB_HOST_HID_FieldMapGet e USB_HOST_HID_FieldValueGet com descritores
+    de relatrio conhecidos.
+
+  Description:
+    Liga a camada HID do Harmony (usb_host_hid.c) a uma camada de host de
+    mentira: o teste conecta um teclado pelo USB_HOST_HID_INTERFACE
+    (interfaceAssign e interfaceTasks, como a camada de host faz), responde
+    os pedidos de controle (SET IDLE, SET PROTOCOL e o GET DESCRIPTOR do
+    descritor de relatrio) e espera o attach no driver de uso. Com o handle
+    do attach monta o mapa de campos e confere, campo a campo, tipo, Report
+    ID, tamanho, deslocamento e usages, e depois decodifica relatrios
+    conhecidos com USB_HOST_HID_FieldValueGet, como o driver do teclado faz.
+
+    Dispositivos:
+    - teclado boot: o descritor do apndice B.1 do HID 1.11;
+    - teclado com Report ID: o mesmo teclado no relatrio 1, um mapa de bits
+      de teclas e dois campos de 12 bits (fora do alinhamento de byte) no
+      relatrio 2, e um segundo top level usage (Consumer Control, relatrio
+      3) que no pode entrar no mapa do teclado;
+    - teclado boot de novo: o mapa vem do cache de descritores.
+*******************************************************************************/
+
+#include <stdio.h>
+#include <stdbool.h>
+#include <string.h>
+#include "usb/usb_host_hid.h"
+#include "usb/usb_host_client_driver.h"
+
+#define SIM_DISPOSITIVO         ((USB_HOST_DEVICE_OBJ_HANDLE)0x100U)
+#define SIM_INTERFACE           ((USB_HOST_DEVICE_INTERFACE_HANDLE)0x200U)
+#define SIM_PIPE_CONTROLE       ((USB_HOST_CONTROL_PIPE_HANDLE)0x300U)
+#define SIM_PIPE_IN             ((USB_HOST_PIPE_HANDLE)0x301U)
+
+#define SIM_PASSADAS_MAX        50U
+#define SIM_CAMPOS_MAX          16U
+
+// Flags dos itens Main
+#define SIM_CONSTANTE           0x01U
+#define SIM_VARIAVEL            0x02U
+
+// Usage estendido (pgina nos 16 bits de cima), como a camada HID guarda
+// usageMin e usageMax
+#define SIM_USAGE(pagina, id)   (((uint32_t)(pagina) << 16) | (uint32_t)(id))
+
+typedef struct
+{
+    uint8_t tag;
+    uint8_t reportID;
+    uint8_t reportSize;
+    uint8_t reportCount;
+    uint16_t bitOffset;
+    uint8_t flags;
+    bool usageMinMaxValid;
+    uint32_t usagePage;
+    uint32_t usageMin;
+    uint32_t usageMax;
+    int32_t logicalMinimum;
+    int32_t logicalMaximum;
+} SIM_CAMPO;
+
+typedef struct
+{
+    const char *nome;
+    uint16_t idProduct;
+    uint8_t subclasse;                  // 1 = boot
+    uint8_t protocolo;                  // 1 = teclado
+    const uint8_t *relatorio;           // descritor de relatrio
+    uint16_t tamanho;
+    const SIM_CAMPO *campos;            // mapa esperado
+    uint8_t nCampos;
+} SIM_DISPOSITIVO_DESC;
+
+// *****************************************************************************
+// Descritores e mapas esperados
+// *****************************************************************************
+
+static const uint8_t g_descBoot[] =
+{
+    0x05, 0x01, 0x09, 0x06, 0xA1, 0x01,             // Generic Desktop, Keyboard, Application
+    0x05, 0x07, 0x19, 0xE0, 0x29, 0xE7,             //   Keyboard, E0..E7
+    0x15, 0x00, 0x25, 0x01, 0x75, 0x01, 0x95, 0x08, //   0..1, 8 x 1 bit
+    0x81, 0x02,                                     //   Input (Data, Var, Abs)
+    0x95, 0x01, 0x75, 0x08, 0x81, 0x01,             //   Input (Const): 1 x 8 bits
+    0x95, 0x05, 0x75, 0x01, 0x05, 0x08,             //   LEDs, 5 x 1 bit
+    0x19, 0x01, 0x29, 0x05, 0x91, 0x02,             //   01..05, Output (Data, Var, Abs)
+    0x95, 0x01, 0x75, 0x03, 0x91, 0x01,             //   Output (Const): 1 x 3 bits
+    0x95, 0x06, 0x75, 0x08, 0x15, 0x00, 0x25, 0x65, //   6 x 8 bits, 0..0x65
+    0x05, 0x07, 0x19, 0x00, 0x29, 0x65,             //   Keyboard, 00..0x65
+    0x81, 0x00,                                     //   Input (Data, Array)
+    0xC0
+};
+
+static const SIM_CAMPO g_camposBoot[] =
+{
+    { USB_HID_MAIN_ITEM_TAG_INPUT,    0,  1,  8,  0,  SIM_VARIAVEL,  true,  0x07,   SIM_USAGE(0x07, 0xE0), SIM_USAGE(0x07, 0xE7), 0, 1     },
+    { USB_HID_MAIN_ITEM_TAG_INPUT,    0,  8,  1,  8,  SIM_CONSTANTE, false, 0x07,   0,                     0,                     0, 1     },
+    { USB_HID_MAIN_ITEM_TAG_OUTPUT,   0,  1,  5,  0,  SIM_VARIAVEL,  true,  0x08,   SIM_USAGE(0x08, 0x01), SIM_USAGE(0x08, 0x05), 0, 1     },
+    { USB_HID_MAIN_ITEM_TAG_OUTPUT,   0,  3,  1,  5,  SIM_CONSTANTE, false, 0x08,   0,                     0,                     0, 1     },
+    { USB_HID_MAIN_ITEM_TAG_INPUT,    0,  8,  6,  16, 0,             true,  0x07,   SIM_USAGE(0x07, 0x00), SIM_USAGE(0x07, 0x65), 0, 0x65  },
+};
+
+static const uint8_t g_descID[] =
+{
+    0x05, 0x01, 0x09, 0x06, 0xA1, 0x01,             // Generic Desktop, Keyboard, Application
+    0x85, 0x01,                                     //   Report ID 1
+    0x05, 0x07, 0x19, 0xE0, 0x29, 0xE7,             //   Keyboard, E0..E7
+    0x15, 0x00, 0x25, 0x01, 0x75, 0x01, 0x95, 0x08, //   0..1, 8 x 1 bit
+    0x81, 0x02,                                     //   Input (Data, Var, Abs)
+    0x95, 0x01, 0x75, 0x08, 0x81, 0x01,             //   Input (Const): 1 x 8 bits
+    0x95, 0x05, 0x75, 0x01, 0x05, 0x08,             //   LEDs, 5 x 1 bit
+    0x19, 0x01, 0x29, 0x05, 0x91, 0x02,             //   01..05, Output (Data, Var, Abs)
+    0x95, 0x01, 0x75, 0x03, 0x91, 0x01,             //   Output (Const): 1 x 3 bits
+    0x95, 0x06, 0x75, 0x08, 0x15, 0x00,             //   6 x 8 bits
+    0x26, 0xFF, 0x00,                               //   0..0xFF
+    0x05, 0x07, 0x19, 0x00, 0x2A, 0xFF, 0x00,       //   Keyboard, 00..0xFF
+    0x81, 0x00,                                     //   Input (Data, Array)
+    0x85, 0x02,                                     //   Report ID 2
+    0x05, 0x07, 0x19, 0x04, 0x29, 0x1D,             //   Keyboard, 04..1D (a..z)
+    0x15, 0x00, 0x25, 0x01, 0x75, 0x01, 0x95, 0x1A, //   0..1, 26 x 1 bit
+    0x81, 0x02,                                     //   Input (Data, Var, Abs)
+    0x75, 0x06, 0x95, 0x01, 0x81, 0x01,             //   Input (Const): 1 x 6 bits
+    0x06, 0x00, 0xFF, 0x09, 0x01,                   //   Vendor 0xFF00, usage 1
+    0x15, 0x00, 0x26, 0xFF, 0x0F,                   //   0..0xFFF
+    0x75, 0x0C, 0x95, 0x02, 0x81, 0x02,             //   2 x 12 bits, Input (Data, Var, Abs)
+    0xC0,
+    0x05, 0x0C, 0x09, 0x01, 0xA1, 0x01,             // Consumer, Consumer Control, Application
+    0x85, 0x03,                                     //   Report ID 3
+    0x15, 0x00, 0x26, 0xFF, 0x03,                   //   0..0x3FF
+    0x19, 0x00, 0x2A, 0xFF, 0x03,                   //   00..0x3FF
+    0x75, 0x10, 0x95, 0x01, 0x81, 0x00,             //   1 x 16 bits, Input (Data, Array)
+    0xC0
+};
+
+static const SIM_CAMPO g_camposID[] =
+{
+    { USB_HID_MAIN_ITEM_TAG_INPUT,    1,  1,  8,  0,  SIM_VARIAVEL,  true,  0x07,   SIM_USAGE(0x07, 0xE0), SIM_USAGE(0x07, 0xE7), 0, 1     },
+    { USB_HID_MAIN_ITEM_TAG_INPUT,    1,  8,  1,  8,  SIM_CONSTANTE, false, 0x07,   0,                     0,                     0, 1     },
+    { USB_HID_MAIN_ITEM_TAG_OUTPUT,   1,  1,  5,  0,  SIM_VARIAVEL,  true,  0x08,   SIM_USAGE(0x08, 0x01), SIM_USAGE(0x08, 0x05), 0, 1     },
+    { USB_HID_MAIN_ITEM_TAG_OUTPUT,   1,  3,  1,  5,  SIM_CONSTANTE, false, 0x08,   0,                     0,                     0, 1     },
+    { USB_HID_MAIN_ITEM_TAG_INPUT,    1,  8,  6,  16, 0,             true,  0x07,   SIM_USAGE(0x07, 0x00), SIM_USAGE(0x07, 0xFF), 0, 0xFF  },
+    { USB_HID_MAIN_ITEM_TAG_INPUT,    2,  1,  26, 0,  SIM_VARIAVEL,  true,  0x07,   SIM_USAGE(0x07, 0x04), SIM_USAGE(0x07, 0x1D), 0, 1     },
+    { USB_HID_MAIN_ITEM_TAG_INPUT,    2,  6,  1,  26, SIM_CONSTANTE, false, 0x07,   0,                     0,                     0, 1     },
+    { USB_HID_MAIN_ITEM_TAG_INPUT,    2,  12, 2,  32, SIM_VARIAVEL,  false, 0xFF00, 0,                     0,                     0, 0xFFF },
+};
+
+static const SIM_DISPOSITIVO_DESC g_boot =
+{
+    "teclado boot", 0x0001, 1, 1, g_descBoot, sizeof(g_descBoot),
+    g_camposBoot, sizeof(g_camposBoot) / sizeof(g_camposBoot[0])
+};
+
+static const SIM_DISPOSITIVO_DESC g_comID =
+{
+    "teclado com Report ID", 0x0002, 0, 0, g_descID, sizeof(g_descID),
+    g_camposID, sizeof(g_camposID) / sizeof(g_camposID[0])
+};
+
+// *****************************************************************************
+// Camada de host
+// *****************************************************************************
+
+static const SIM_DISPOSITIVO_DESC *g_disp;
+static uint32_t g_falhas;
+
+// Interface (9 bytes) seguida do descritor HID (9 bytes)
+static uint8_t g_descInterface[18];
+
+static const USB_ENDPOINT_DESCRIPTOR g_endpointIn =
+{
+    .bLength = sizeof(USB_ENDPOINT_DESCRIPTOR),
+    .bDescriptorType = USB_DESCRIPTOR_ENDPOINT,
+    .bEndpointAddress = 0x81,
+    .bmAttributes = USB_TRANSFER_TYPE_INTERRUPT,
+    .wMaxPacketSize = 8,
+    .bInterval = 10
+};
+
+// Pedido de controle em andamento: termina na prxima passada da camada de
+// host, como no USB_HOST_Tasks
+static USB_HOST_DEVICE_CONTROL_REQUEST_COMPLETE_CALLBACK g_controleCallback;
+static uintptr_t g_controleContext;
+static size_t g_controleTamanho;
+
+USB_HOST_CONTROL_PIPE_HANDLE USB_HOST_DeviceControlPipeOpen(USB_HOST_DEVICE_OBJ_HANDLE deviceObjHandle)
+{
+    (void)deviceObjHandle;
+    return SIM_PIPE_CONTROLE;
+}
+
+USB_HOST_RESULT USB_HOST_DeviceControlTransfer
+(
+    USB_HOST_CONTROL_PIPE_HANDLE pipeHandle,
+    USB_HOST_TRANSFER_HANDLE * transferHandle,
+    USB_SETUP_PACKET * setupPacket,
+    void * data,
+    USB_HOST_DEVICE_CONTROL_REQUEST_COMPLETE_CALLBACK callback,
+    uintptr_t context
+)
+{
+    (void)pipeHandle;
+
+    if (g_controleCallback != NULL)
+        return USB_HOST_RESULT_REQUEST_BUSY;
+
+    g_controleTamanho = 0;
+    if ((setupPacket->bRequest == USB_REQUEST_GET_DESCRIPTOR) &&
+        ((setupPacket->wValue >> 8) == (uint16_t)USB_HID_DESCRIPTOR_TYPES_REPORT))
+    {
+        g_controleTamanho = (setupPacket->wLength < g_disp->tamanho) ? setupPacket->wLength : g_disp->tamanho;
+        memcpy(data, g_disp->relatorio, g_controleTamanho);
+    }
+
+    *transferHandle = (USB_HOST_TRANSFER_HANDLE)1U;
+    g_controleCallback = callback;
+    g_controleContext = context;
+    return USB_HOST_RESULT_SUCCESS;
+}
+
+static void sim_controle_termina(void)
+{
+    USB_HOST_DEVICE_CONTROL_REQUEST_COMPLETE_CALLBACK callback = g_controleCallback;
+
+    if (callback == NULL)
+        return;
+    g_controleCallback = NULL;
+    callback(SIM_DISPOSITIVO, (USB_HOST_REQUEST_HANDLE)1U, USB_HOST_RESULT_SUCCESS,
+             g_controleTamanho, g_controleContext);
+}
+
+USB_HOST_RESULT USB_HOST_DeviceDescriptorGet(USB_HOST_DEVICE_OBJ_HANDLE deviceObjHandle,
+                                             USB_DEVICE_DESCRIPTOR * deviceDescriptor)
+{
+    (void)deviceObjHandle;
+    memset(deviceDescriptor, 0, sizeof(*deviceDescriptor));
+    deviceDescriptor->bLength = sizeof(USB_DEVICE_DESCRIPTOR);
+    deviceDescriptor->bDescriptorType = USB_DESCRIPTOR_DEVICE;
+    deviceDescriptor->idVendor = 0x04D8;
+    deviceDescriptor->idProduct = g_disp->idProduct;
+    deviceDescriptor->bcdDevice = 0x0100;
+    return USB_HOST_RESULT_SUCCESS;
+}
+
+void USB_HOST_DeviceEndpointQueryContextClear(USB_HOST_ENDPOINT_DESCRIPTOR_QUERY * query)
+{
+    query->context = 0;
+}
+
+// Uma interface s com o endpoint IN de interrupo
+USB_ENDPOINT_DESCRIPTOR * USB_HOST_DeviceEndpointDescriptorQuery(USB_INTERFACE_DESCRIPTOR * interface,
+                                                                 USB_HOST_ENDPOINT_DESCRIPTOR_QUERY * query)
+{
+    (void)interface;
+    if ((query->direction != USB_DATA_DIRECTION_DEVICE_TO_HOST) || (query->context != 0U))
+        return NULL;
+    query->context = 1U;
+    return (USB_ENDPOINT_DESCRIPTOR *)&g_endpointIn;
+}
+
+USB_HOST_PIPE_HANDLE USB_HOST_DevicePipeOpen(USB_HOST_DEVICE_INTERFACE_HANDLE deviceInterfaceHandle,
+                                             USB_ENDPOINT_ADDRESS endpointAddress)
+{
+    (void)deviceInterfaceHandle;
+    (void)endpointAddress;
+    return SIM_PIPE_IN;
+}
+
+USB_HOST_RESULT USB_HOST_DevicePipeClose(USB_HOST_PIPE_HANDLE pipeHandle)
+{
+    (void)pipeHandle;
+    return USB_HOST_RESULT_SUCCESS;
+}
+
+USB_HOST_RESULT USB_HOST_DevicePipeHaltClear(USB_HOST_PIPE_HANDLE pipeHandle,
+                                             USB_HOST_REQUEST_HANDLE * requestHandle, uintptr_t context)
+{
+    (void)pipeHandle;
+    (void)requestHandle;
+    (void)context;
+    return USB_HOST_RESULT_FAILURE;
+}
+
+// O pedido IN fica pendente: o teste no entrega relatrios pela interrupo
+USB_HOST_RESULT USB_HOST_DeviceTransfer(USB_HOST_PIPE_HANDLE pipeHandle,
+                                        USB_HOST_TRANSFER_HANDLE * transferHandle,
+                                        void * data, size_t size, uintptr_t context)
+{
+    (void)pipeHandle;
+    (void)data;
+    (void)size;
+    (void)context;
+    *transferHandle = (USB_HOST_TRANSFER_HANDLE)2U;
+    return USB_HOST_RESULT_SUCCESS;
+}
+
+USB_HOST_RESULT USB_HOST_DeviceInterfaceRelease(USB_HOST_DEVICE_INTERFACE_HANDLE interfaceHandle)
+{
+    (void)interfaceHandle;
+    return USB_HOST_RESULT_SUCCESS;
+}
+
+void USB_HOST_EnumerationStageStamp(USB_HOST_ENUMERATION_STAGE stage)
+{
+    (void)stage;
+}
+
+// *****************************************************************************
+// Driver de uso (teclado)
+// *****************************************************************************
+
+static USB_HOST_HID_OBJ_HANDLE g_handle = USB_HOST_HID_OBJ_HANDLE_INVALID;
+
+static void sim_teclado_evento(USB_HOST_HID_OBJ_HANDLE handle, USB_HOST_HID_EVENT event, void * eventData)
+{
+    (void)eventData;
+    if (event == USB_HOST_HID_EVENT_ATTACH)
+        g_handle = handle;
+    else if (event == USB_HOST_HID_EVENT_DETACH)
+        g_handle = USB_HOST_HID_OBJ_HANDLE_INVALID;
+}
+
+static void sim_teclado_task(USB_HOST_HID_OBJ_HANDLE handle)
+{
+    (void)handle;
+}
+
+static USB_HOST_HID_USAGE_DRIVER_INTERFACE g_tecladoInterface =
+{
+    .initialize = NULL,
+    .deinitialize = NULL,
+    .usageDriverEventHandler = sim_teclado_evento,
+    .usageDriverTask = sim_teclado_task
+};
+
+// Mesma tabela de usb_host_init_data.c
+static USB_HOST_HID_USAGE_DRIVER_TABLE_ENTRY g_tabela[1] =
+{
+    {
+        .usage = (USB_HID_USAGE_PAGE_GENERIC_DESKTOP_CONTROLS << 16) | USB_HID_GENERIC_DESKTOP_KEYBOARD,
+        .initializeData = NULL,
+        .interface = &g_tecladoInterface
+    },
+};
+
+static USB_HOST_HID_INIT g_hidInit =
+{
+    .nUsageDriver = 1,
+    .usageDriverTable = g_tabela
+};
+
+// *****************************************************************************
+// Conferncia
+// *****************************************************************************
+
+static void sim_falha(const char *formato, uint32_t a, uint32_t b)
+{
+    g_falhas++;
+    printf("  ");
+    printf(formato, (unsigned)a, (unsigned)b);
+    printf("\n");
+}
+
+// Conecta o dispositivo e roda a camada HID at o attach no driver de uso
+static bool sim_conecta(const SIM_DISPOSITIVO_DESC *disp)
+{
+    USB_HOST_DEVICE_INTERFACE_HANDLE interfaces[1] = { SIM_INTERFACE };
+    USB_HOST_CLIENT_DRIVER *hid = USB_HOST_HID_INTERFACE;
+    uint32_t n;
+
+    g_disp = disp;
+    g_handle = USB_HOST_HID_OBJ_HANDLE_INVALID;
+
+    memset(g_descInterface, 0, sizeof(g_descInterface));
+    g_descInterface[0] = 9;                                 // bLength
+    g_descInterface[1] = USB_DESCRIPTOR_INTERFACE;
+    g_descInterface[4] = 1;                                 // bNumEndpoints
+    g_descInterface[5] = 0x03;                              // HID
+    g_descInterface[6] = disp->subclasse;
+    g_descInterface[7] = disp->protocolo;
+    g_descInterface[9] = 9;
+    g_descInterface[10] = USB_HID_DESCRIPTOR_TYPES_HID;
+    g_descInterface[11] = 0x11;                             // bcdHID 1.11
+    g_descInterface[12] = 0x01;
+    g_descInterface[14] = 1;                                // bNumDescriptors
+    g_descInterface[15] = USB_HID_DESCRIPTOR_TYPES_REPORT;
+    g_descInterface[16] = (uint8_t)disp->tamanho;
+    g_descInterface[17] = (uint8_t)(disp->tamanho >> 8);
+
+    hid->interfaceAssign(interfaces, SIM_DISPOSITIVO, 1, g_descInterface);
+    for (n = 0; (n < SIM_PASSADAS_MAX) && (g_handle == USB_HOST_HID_OBJ_HANDLE_INVALID); n++)
+    {
+        hid->interfaceTasks(SIM_INTERFACE);
+        sim_controle_termina();
+    }
+
+    if (g_handle == USB_HOST_HID_OBJ_HANDLE_INVALID)
+    {
+        sim_falha("sem attach depois de %u passadas%.0u", n, 0);
+        return false;
+    }
+    return true;
+}
+
+static void sim_desconecta(void)
+{
+    USB_HOST_CLIENT_DRIVER *hid = USB_HOST_HID_INTERFACE;
+
+    hid->interfaceRelease(SIM_INTERFACE);
+    if (g_handle != USB_HOST_HID_OBJ_HANDLE_INVALID)
+        sim_falha("sem detach no driver de uso%.0u%.0u", 0, 0);
+}
+
+// Confere o mapa de campos montado pela camada HID com o esperado
+static void sim_confere_mapa(const SIM_DISPOSITIVO_DESC *disp, USB_HOST_HID_FIELD *campos, uint8_t *nCampos)
+{
+    const SIM_CAMPO *e;
+    const USB_HOST_HID_FIELD *c;
+    uint32_t falhas = g_falhas;
+    uint8_t i;
+
+    if (USB_HOST_HID_FieldMapGet(g_handle, campos, SIM_CAMPOS_MAX, nCampos) != USB_HOST_HID_RESULT_SUCCESS)
+    {
+        sim_falha("USB_HOST_HID_FieldMapGet falhou%.0u%.0u", 0, 0);
+        *nCampos = 0;
+        return;
+    }
+    if (*nCampos != disp->nCampos)
+        sim_falha("%u campos, esperados %u", *nCampos, disp->nCampos);
+
+    for (i = 0; (i < *nCampos) && (i < disp->nCampos); i++)
+    {
+        e = &disp->campos[i];
+        c = &campos[i];
+        if ((c->tag != e->tag) || (c->reportID != e->reportID))
+            sim_falha("campo %u: tipo/Report ID errados (%u)", i, ((uint32_t)c->tag << 8) | c->reportID);
+        if ((c->reportSize != e->reportSize) || (c->reportCount != e->reportCount))
+            sim_falha("campo %u: %u elementos", i, ((uint32_t)c->reportCount << 8) | c->reportSize);
+        if (c->bitOffset != e->bitOffset)
+            sim_falha("campo %u: deslocamento %u", i, c->bitOffset);
+        if ((c->data.data4Bytes & (SIM_CONSTANTE | SIM_VARIAVEL)) != e->flags)
+            sim_falha("campo %u: flags 0x%02x", i, c->data.data4Bytes);
+        if (c->usageMinMaxValid != e->usageMinMaxValid)
+            sim_falha("campo %u: usageMinMaxValid %u", i, c->usageMinMaxValid);
+        if ((e->usageMinMaxValid) && ((c->usageMin != e->usageMin) || (c->usageMax != e->usageMax)))
+            sim_falha("campo %u: usages errados (min 0x%x)", i, c->usageMin);
+        if ((e->flags & SIM_CONSTANTE) != 0U)
+            continue;
+        if ((uint32_t)c->usagePage != e->usagePage)
+            sim_falha("campo %u: usage page 0x%x", i, c->usagePage);
+        if ((c->logicalMinimum != e->logicalMinimum) || (c->logicalMaximum != e->logicalMaximum))
+            sim_falha("campo %u: logical maximum %u", i, (uint32_t)c->logicalMaximum);
+    }
+
+    printf("  mapa: %u campos -> %s\n", *nCampos, (g_falhas == falhas) ? "ok" : "FALHOU");
+}
+
+// Teclas do relatrio como o driver do teclado decodifica: modificadores
+// (bits 0xE0..0xE7) e as usages do campo de array do Report ID
+static void sim_decodifica(const USB_HOST_HID_FIELD *campos, uint8_t nCampos, const uint8_t *relatorio,
+                           size_t tamanho, uint8_t *modificadores, uint8_t teclas[6])
+{
+    const USB_HOST_HID_FIELD *c;
+    uint32_t k, u, valor, n = 0;
+    uint8_t i;
+
+    *modificadores = 0;
+    memset(teclas, 0, 6);
+    for (i = 0; i < nCampos; i++)
+    {
+        c = &campos[i];
+        if ((c->tag != USB_HID_MAIN_ITEM_TAG_INPUT) || (c->data.inputOptionalData.isConstant != 0U) ||
+            (c->usagePage != USB_HID_USAGE_PAGE_KEYBOARD_KEYPAD) ||
+            ((c->reportID != 0U) && (c->reportID != relatorio[0])))
+            continue;
+
+        for (k = 0; k < c->reportCount; k++)
+        {
+            valor = USB_HOST_HID_FieldValueGet(c, relatorio, tamanho, k);
+            if (c->data.inputOptionalData.isVariable != 0U)
+            {
+                u = (c->usageMin + k) & 0xFFFFU;
+                if ((valor != 0U) && (u >= 0xE0U) && (u <= 0xE7U))
+                    *modificadores |= (uint8_t)(1U << (u - 0xE0U));
+                continue;
+            }
+            valor = ((uint32_t)((int32_t)valor - c->logicalMinimum) + c->usageMin) & 0xFFFFU;
+            if ((valor != 0U) && (n < 6U))
+                teclas[n++] = (uint8_t)valor;
+        }
+    }
+}
+
+static void sim_confere_teclas(const USB_HOST_HID_FIELD *campos, uint8_t nCampos, const uint8_t *relatorio,
+                               size_t tamanho, uint8_t modificadores, const uint8_t teclas[6])
+{
+    uint8_t mod, t[6];
+    uint32_t i;
+
+    sim_decodifica(campos, nCampos, relatorio, tamanho, &mod, t);
+    if (mod != modificadores)
+        sim_falha("modificadores 0x%02x, esperados 0x%02x", mod, modificadores);
+    for (i = 0; i < 6U; i++)
+    {
+        if (t[i] != teclas[i])
+            sim_falha("tecla %u: 0x%02x", i, t[i]);
+    }
+}
+
+static void sim_confere_valor(const USB_HOST_HID_FIELD *campos, uint8_t nCampos, uint8_t campo,
+                              const uint8_t *relatorio, size_t tamanho, uint32_t elemento, uint32_t esperado)
+{
+    uint32_t valor;
+
+    if (campo >= nCampos)
+        return;
+    valor = USB_HOST_HID_FieldValueGet(&campos[campo], relatorio, tamanho, elemento);
+    if (valor != esperado)
+        sim_falha("campo %u: 0x%x", ((uint32_t)campo << 8) | elemento, valor);
+}
+
+static void sim_teclado_boot(const char *nome)
+{
+    // Shift esquerdo + 'a' 'b' e Ctrl direito + Alt esquerdo + 'z'
+    static const uint8_t r1[8] = { 0x02, 0x00, 0x04, 0x05, 0x00, 0x00, 0x00, 0x00 };
+    static const uint8_t t1[6] = { 0x04, 0x05 };
+    static const uint8_t r2[8] = { 0x14, 0x00, 0x1D, 0x00, 0x00, 0x00, 0x00, 0x00 };
+    static const uint8_t t2[6] = { 0x1D };
+    USB_HOST_HID_FIELD campos[SIM_CAMPOS_MAX];
+    uint8_t nCampos;
+    uint32_t falhas = g_falhas;
+
+    printf("%s\n", nome);
+    if (!sim_conecta(&g_boot))
+        return;
+    sim_confere_mapa(&g_boot, campos, &nCampos);
+    sim_confere_teclas(campos, nCampos, r1, sizeof(r1), 0x02, t1);
+    sim_confere_teclas(campos, nCampos, r2, sizeof(r2), 0x14, t2);
+    // Sexta tecla no ltimo byte; fora do relatrio o valor  0
+    sim_confere_valor(campos, nCampos, 4, (const uint8_t[8]){ 0, 0, 0, 0, 0, 0, 0, 0x27 }, 8, 5, 0x27);
+    sim_confere_valor(campos, nCampos, 4, (const uint8_t[8]){ 0, 0, 0, 0, 0, 0, 0, 0x27 }, 7, 5, 0);
+    printf("  relatorios -> %s\n", (g_falhas == falhas) ? "ok" : "FALHOU");
+    sim_desconecta();
+}
+
+static void sim_teclado_com_id(void)
+{
+    // Relatrio 1: Shift direito + '1' '2'
+    static const uint8_t r1[9] = { 0x01, 0x20, 0x00, 0x1E, 0x1F, 0x00, 0x00, 0x00, 0x00 };
+    static const uint8_t t1[6] = { 0x1E, 0x1F };
+    // Relatrio 2: 'a' e 'z' no mapa de bits, 0xABC e 0x123 nos campos de
+    // 12 bits (a partir do bit 32: BC 3A 12)
+    static const uint8_t r2[8] = { 0x02, 0x01, 0x00, 0x00, 0x02, 0xBC, 0x3A, 0x12 };
+    // Relatrio 3 (Consumer Control): nenhum campo do teclado
+    static const uint8_t r3[3] = { 0x03, 0xE9, 0x00 };
+    static const uint8_t nenhuma[6] = { 0 };
+    USB_HOST_HID_FIELD campos[SIM_CAMPOS_MAX];
+    uint8_t nCampos;
+    uint32_t falhas = g_falhas;
+
+    printf("%s\n", g_comID.nome);
+    if (!sim_conecta(&g_comID))
+        return;
+    sim_confere_mapa(&g_comID, campos, &nCampos);
+    sim_confere_teclas(campos, nCampos, r1, sizeof(r1), 0x20, t1);
+    sim_confere_teclas(campos, nCampos, r3, sizeof(r3), 0x00, nenhuma);
+    sim_confere_valor(campos, nCampos, 5, r2, sizeof(r2), 0, 1);
+    sim_confere_valor(campos, nCampos, 5, r2, sizeof(r2), 1, 0);
+    sim_confere_valor(campos, nCampos, 5, r2, sizeof(r2), 25, 1);
+    sim_confere_valor(campos, nCampos, 7, r2, sizeof(r2), 0, 0xABC);
+    sim_confere_valor(campos, nCampos, 7, r2, sizeof(r2), 1, 0x123);
+    sim_confere_valor(campos, nCampos, 7, r2, sizeof(r2) - 1U, 1, 0);
+    printf("  relatorios -> %s\n", (g_falhas == falhas) ? "ok" : "FALHOU");
+    sim_desconecta();
+}
+
+int main(void)
+{
+    uint32_t hits, misses;
+
+    (USB_HOST_HID_INTERFACE)->initialize(&g_hidInit);
+
+    sim_teclado_boot(g_boot.nome);
+    sim_teclado_com_id();
+    sim_teclado_boot("teclado boot (cache)");
+
+    USB_HOST_HID_DescriptorCacheStatsGet(&hits, &misses);
+    if ((hits != 1U) || (misses != 2U))
+        sim_falha("cache: %u acertos, %u faltas (esperados 1 e 2)", hits, misses);
+
+    printf("\n%s\n", (g_falhas == 0U) ? "OK" : "FALHOU");
+    return (g_falhas == 0U) ? 0 : 1;
+}
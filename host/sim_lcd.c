@@ -0,0 +1,430 @@
+/*******************************************************************************
+  Escritor do LCD contra um HD44780 virtual
+
+  File Name:
+    sim_lcd.c
+
+  Summary:
+    APP_DISPLAY_Tasks e a ISR do TMR7 escrevendo no modelo de lcd_hd44780.c.
+
+  Description:
+    A task do display roda como no firmware: lcd_init, depois um quadro por
+    atualiza_lcd. Enquanto ela dorme, o gancho de espera dispara o TMR7 no
+    perodo programado (e o tick do RTOS a cada 1ms), e quando a fila de
+    transmisso esvazia confere o que chegou ao LCD e entrega o prximo
+    quadro do roteiro.
+
+    Confere que:
+    - o init deixa o LCD em 4 bits, duas linhas, ligado, e sobe para a CGRAM
+      exatamente os glifos de DISPLAY_GRAF_Glifos (a RAM comea com lixo);
+    - a DDRAM fica igual a cada quadro, s com os trechos alterados enviados;
+    - as barras de DISPLAY_GRAF_Barra acendem, em todas as linhas de pixel,
+      um prefixo de colunas igual a valor/maximo arredondado, e cada coluna
+      de DISPLAY_GRAF_Tendencia tem 2*nvel linhas acesas a partir de baixo
+      (contas em double, independentes de display_graficos.c);
+    - a temporizao (EN, 37us, 1,52ms)  respeitada;
+    - reconfigura_lcd sobe os glifos de novo depois de o LCD perder a RAM.
+*******************************************************************************/
+
+#include <stdio.h>
+#include <math.h>
+#include "definitions.h"
+#include "app_display.h"
+#include "display_graficos.h"
+
+#define SIM_LCD_CORE_TMR7       (CORE_TIMER_FREQUENCY / HOST_TMR7_FREQUENCIA)
+#define SIM_LCD_TENDENCIA       20U
+
+static struct HOST_TAREFA g_display = { "APP_DISPLAY_Tasks", 0, 0, NULL };
+
+typedef struct
+{
+    const char *texto;          // linha 0
+    uint32_t barra, barra_max;  // linha 1, largura toda
+    const char *rotulo;         // linha 2: rtulo e barra de 10 clulas
+    uint32_t barra2, barra2_max;
+    uint16_t tendencia[SIM_LCD_TENDENCIA];  // linha 3
+    uint16_t tendencia_max;
+} SIM_LCD_QUADRO;
+
+static const SIM_LCD_QUADRO sim_quadros[] =
+{
+    { "I 25.0A   R 012mOhm", 0, 100, "Alvo", 250, 350,
+      { 0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15, 16, 17, 18, 19 }, 19 },
+    { "I 25.1A   R 012mOhm", 1, 100, "Alvo", 350, 350,
+      { 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15, 16, 17, 18, 19, 20 }, 19 },
+    { "I 24.9A   R 013mOhm", 50, 100, "Alvo", 0, 350,
+      { 100, 0, 100, 0, 100, 0, 100, 0, 100, 0, 100, 0, 100, 0, 100, 0, 100, 0, 100, 0 }, 100 },
+    { "I 24.9A   R 013mOhm", 99, 100, "Alvo", 7, 9,
+      { 12, 13, 37, 38, 62, 63, 87, 88, 99, 100, 101, 0, 1, 50, 49, 51, 74, 76, 24, 26 }, 100 },
+    { "Sobrecorrente!", 333, 1000, "Pico", 1000, 999,
+      { 5, 5, 5, 5, 5, 5, 5, 5, 5, 5, 5, 5, 5, 5, 5, 5, 5, 5, 5, 5 }, 0 },
+    { "", 100, 100, "", 0, 0,
+      { 0 }, 1 },
+};
+
+#define SIM_LCD_N_QUADROS   (sizeof(sim_quadros) / sizeof(sim_quadros[0]))
+
+static uint32_t g_tempo;            // core timer no tick atual do TMR7
+static uint32_t g_subtick;
+static uint32_t g_isr;              // interrupes do TMR7
+static uint32_t g_passo;
+static uint32_t g_falhas;
+static char g_quadro[4][20];        // ltimo quadro entregue
+static uint32_t g_bytes0, g_isr0;
+
+// *****************************************************************************
+// Sistema enquanto a task do display dorme
+// *****************************************************************************
+
+static void sim_lcd_tick_tmr7(void)
+{
+    g_tempo += ((uint32_t)HOST_Tmr7()->periodo + 1U) * SIM_LCD_CORE_TMR7;
+    HOST_CoreTimerSet(g_tempo);
+    if (++g_subtick == (HOST_TMR7_FREQUENCIA / ((uint32_t)HOST_Tmr7()->periodo + 1U) / configTICK_RATE_HZ))
+    {
+        g_subtick = 0;
+        HOST_TickAvanca(1);
+    }
+    if (HOST_Tmr7Dispara())
+        g_isr++;
+}
+
+static bool sim_lcd_passo(void);
+
+static void sim_lcd_espera(TaskHandle_t tarefa, TickType_t ticks)
+{
+    TickType_t fim = xTaskGetTickCount() + ticks;
+
+    if (tarefa != &g_display)
+        return;
+
+    while (tarefa->notificacoes == 0U)
+    {
+        if (HOST_Tmr7()->rodando)
+        {
+            sim_lcd_tick_tmr7();
+            if ((ticks != portMAX_DELAY) && ((int32_t)(xTaskGetTickCount() - fim) >= 0))
+                return;
+        }
+        else if (ticks != portMAX_DELAY)
+        {
+            HOST_TickAvanca(fim - xTaskGetTickCount());
+            return;
+        }
+        else if (!sim_lcd_passo())
+        {
+            return;
+        }
+    }
+}
+
+static void sim_lcd_display(void *param)
+{
+    (void)param;
+    APP_DISPLAY_Tasks();
+}
+
+// *****************************************************************************
+// Conferncia
+// *****************************************************************************
+
+static void sim_lcd_falha(const char *o_que, uint32_t linha, uint32_t col)
+{
+    if (g_falhas++ < 20U)
+        printf("  FALHA: %s (linha %u, coluna %u)\n", o_que, (unsigned)linha, (unsigned)col);
+}
+
+static void sim_lcd_confere_estado(void)
+{
+    const HOST_LCD *lcd = HOST_Lcd();
+    uint32_t k;
+
+    if (!lcd->modo4 || !lcd->duas_linhas || !lcd->ligado || !lcd->incrementa)
+        sim_lcd_falha("modo do LCD depois do init", 0, 0);
+    for (k = 0; k < sizeof(lcd->cgram); k++)
+    {
+        if (lcd->cgram[k] != (DISPLAY_GRAF_Glifos[k / 8U][k % 8U] & 0x1FU))
+            sim_lcd_falha("CGRAM diferente de DISPLAY_GRAF_Glifos (glifo, linha)", k / 8U, k % 8U);
+    }
+    if ((lcd->erros_tempo != 0U) || (lcd->erros_pulso != 0U) || (lcd->erros_protocolo != 0U))
+    {
+        printf("  erros: %u de tempo, %u de pulso de EN, %u de protocolo\n",
+               (unsigned)lcd->erros_tempo, (unsigned)lcd->erros_pulso,
+               (unsigned)lcd->erros_protocolo);
+        sim_lcd_falha("temporizacao ou protocolo", 0, 0);
+    }
+}
+
+// Colunas de pixel acesas de uma barra, conferindo que formam um prefixo
+// contnuo igual em todas as linhas de pixel
+static uint32_t sim_lcd_barra_pixels(uint8_t linha, uint8_t col, uint8_t largura)
+{
+    uint32_t acesas = 0, p, c, b;
+    int32_t px;
+
+    for (p = 0; p < 8U; p++)
+    {
+        uint32_t n = 0;
+        bool apagou = false;
+
+        for (c = col; c < (uint32_t)col + largura; c++)
+        {
+            px = HOST_LcdPixels(linha, (uint8_t)c, (uint8_t)p);
+            if (px < 0)
+            {
+                sim_lcd_falha("caractere da ROM no meio da barra", linha, c);
+                return UINT32_MAX;
+            }
+            for (b = 0; b < DISPLAY_GRAF_PIXELS_CELULA; b++)
+            {
+                if ((px & (0x10 >> b)) != 0)
+                {
+                    if (apagou)
+                        sim_lcd_falha("barra com buraco", linha, c);
+                    n++;
+                }
+                else
+                {
+                    apagou = true;
+                }
+            }
+        }
+        if ((p != 0U) && (n != acesas))
+            sim_lcd_falha("barra diferente entre linhas de pixel", linha, p);
+        acesas = n;
+    }
+    return acesas;
+}
+
+static void sim_lcd_confere_barra(uint8_t linha, uint8_t col, uint8_t largura,
+                                  uint32_t valor, uint32_t maximo)
+{
+    uint32_t total = (uint32_t)largura * DISPLAY_GRAF_PIXELS_CELULA;
+    uint32_t esperado, acesas;
+
+    if (maximo == 0U)
+        esperado = 0;
+    else if (valor >= maximo)
+        esperado = total;
+    else
+        esperado = (uint32_t)lround((double)valor * total / maximo);
+
+    acesas = sim_lcd_barra_pixels(linha, col, largura);
+    if (acesas != esperado)
+    {
+        printf("  barra %u/%u: %u colunas acesas, esperado %u\n", (unsigned)valor,
+               (unsigned)maximo, (unsigned)acesas, (unsigned)esperado);
+        sim_lcd_falha("barra", linha, col);
+    }
+}
+
+static void sim_lcd_confere_tendencia(uint8_t linha, const uint16_t *amostras, uint16_t maximo)
+{
+    uint32_t c, p, altura, esperado;
+    int32_t px;
+
+    for (c = 0; c < SIM_LCD_TENDENCIA; c++)
+    {
+        if (maximo == 0U)
+            esperado = 0;
+        else if (amostras[c] >= maximo)
+            esperado = 8;
+        else
+            esperado = 2U * (uint32_t)lround(4.0 * amostras[c] / maximo);
+
+        // Altura: linhas acesas a partir de baixo, com as 5 colunas
+        altura = 0;
+        for (p = 8; p > 0U; p--)
+        {
+            px = HOST_LcdPixels(linha, (uint8_t)c, (uint8_t)(p - 1U));
+            if (px < 0)
+            {
+                sim_lcd_falha("caractere da ROM na tendencia", linha, c);
+                return;
+            }
+            if (px == 0x1F)
+            {
+                if (altura != (8U - p))
+                    sim_lcd_falha("tendencia com buraco", linha, c);
+                altura++;
+            }
+            else if (px != 0)
+            {
+                sim_lcd_falha("tendencia com coluna parcial", linha, c);
+            }
+        }
+        if (altura != esperado)
+        {
+            printf("  tendencia %u/%u: altura %u, esperado %u\n", (unsigned)amostras[c],
+                   (unsigned)maximo, (unsigned)altura, (unsigned)esperado);
+            sim_lcd_falha("tendencia", linha, c);
+        }
+    }
+}
+
+static void sim_lcd_confere_quadro(const SIM_LCD_QUADRO *q)
+{
+    uint32_t l, c;
+
+    for (l = 0; l < 4U; l++)
+    {
+        for (c = 0; c < 20U; c++)
+        {
+            if (HOST_LcdCelula((uint8_t)l, (uint8_t)c) != (uint8_t)g_quadro[l][c])
+                sim_lcd_falha("DDRAM diferente do quadro", l, c);
+        }
+    }
+
+    if (q != NULL)
+    {
+        sim_lcd_confere_barra(1, 0, 20, q->barra, q->barra_max);
+        sim_lcd_confere_barra(2, 10, 10, q->barra2, q->barra2_max);
+        sim_lcd_confere_tendencia(3, q->tendencia, q->tendencia_max);
+    }
+    sim_lcd_confere_estado();
+}
+
+// Texto Latin-1 (leitor USB) mapeado para a ROM A00: s ASCII sem '\\' e
+// '~', ou os caracteres da ROM que existem no Latin-1
+static void sim_lcd_confere_latin1(void)
+{
+    static const uint8_t rom[] = { 0x5C, 0xA5, 0xDF, 0xE1, 0xE2, 0xE4, 0xEE, 0xEF, 0xF5, 0xFD };
+    static const struct { uint8_t de, para; } pares[] =
+    {
+        { 'A', 'A' }, { 0xE7, 'c' }, { 0xE3, 'a' }, { 0xC9, 'E' }, { 0xB0, 0xDF },
+        { 0xFC, 0xF5 }, { 0xF1, 0xEE }, { 0xA5, 0x5C }, { '\\', '/' }, { 0x0A, ' ' },
+    };
+    char linha[1];
+    uint32_t c, i;
+    bool ok;
+
+    for (c = 0; c < 256U; c++)
+    {
+        linha[0] = (char)c;
+        DISPLAY_GRAF_Latin1(linha, 1);
+        ok = ((uint8_t)linha[0] >= 0x20U) && ((uint8_t)linha[0] < 0x7EU) && (linha[0] != '\\');
+        for (i = 0; i < sizeof(rom); i++)
+            ok = ok || ((uint8_t)linha[0] == rom[i]);
+        // 0x5C s vem do 
+        if (ok && (linha[0] == '\\') && (c != 0xA5U))
+            ok = false;
+        if (!ok)
+        {
+            printf("  Latin-1 0x%02X -> 0x%02X\n", (unsigned)c, (unsigned)(uint8_t)linha[0]);
+            sim_lcd_falha("Latin-1 fora da ROM A00", 0, c);
+        }
+    }
+    for (i = 0; i < sizeof(pares) / sizeof(pares[0]); i++)
+    {
+        linha[0] = (char)pares[i].de;
+        DISPLAY_GRAF_Latin1(linha, 1);
+        if ((uint8_t)linha[0] != pares[i].para)
+            sim_lcd_falha("Latin-1 mapeado errado", 0, pares[i].de);
+    }
+}
+
+// *****************************************************************************
+// Roteiro
+// *****************************************************************************
+
+static void sim_lcd_entrega(const SIM_LCD_QUADRO *q)
+{
+    memset(g_quadro, ' ', sizeof(g_quadro));
+    memcpy(g_quadro[0], q->texto, strlen(q->texto));
+    DISPLAY_GRAF_Barra(g_quadro[1], 0, 20, q->barra, q->barra_max);
+    memcpy(g_quadro[2], q->rotulo, strlen(q->rotulo));
+    DISPLAY_GRAF_Barra(g_quadro[2], 10, 10, q->barra2, q->barra2_max);
+    DISPLAY_GRAF_Tendencia(g_quadro[3], 0, q->tendencia, SIM_LCD_TENDENCIA, q->tendencia_max);
+
+    g_bytes0 = HOST_Lcd()->comandos + HOST_Lcd()->dados;
+    g_isr0 = g_isr;
+    atualiza_lcd((char *)g_quadro);
+}
+
+static void sim_lcd_relata(const char *nome)
+{
+    printf("  %-22s %4u bytes, %4u interrupcoes do TMR7\n", nome,
+           (unsigned)(HOST_Lcd()->comandos + HOST_Lcd()->dados - g_bytes0),
+           (unsigned)(g_isr - g_isr0));
+}
+
+// Chamado com a fila do TMR7 vazia e a task esperando quadro novo.
+// Retorna false no fim do roteiro.
+static bool sim_lcd_passo(void)
+{
+    uint32_t passo = g_passo++;
+
+    if (passo == 0U)
+    {
+        sim_lcd_relata("init");
+        memset(g_quadro, ' ', sizeof(g_quadro));
+        sim_lcd_confere_quadro(NULL);
+    }
+    else if (passo <= SIM_LCD_N_QUADROS)
+    {
+        char nome[32];
+
+        snprintf(nome, sizeof(nome), "quadro %u", (unsigned)passo);
+        sim_lcd_relata(nome);
+        sim_lcd_confere_quadro(&sim_quadros[passo - 1U]);
+    }
+    else if (passo == SIM_LCD_N_QUADROS + 1U)
+    {
+        sim_lcd_relata("reconfigura_lcd");
+        memset(g_quadro, ' ', sizeof(g_quadro));
+        sim_lcd_confere_quadro(NULL);
+    }
+    else
+    {
+        sim_lcd_relata("quadro 1 de novo");
+        sim_lcd_confere_quadro(&sim_quadros[0]);
+        return false;
+    }
+
+    if (passo < SIM_LCD_N_QUADROS)
+    {
+        sim_lcd_entrega(&sim_quadros[passo]);
+    }
+    else if (passo == SIM_LCD_N_QUADROS)
+    {
+        // O LCD perde a RAM (glitch na alimentao): reconfigura_lcd
+        // refaz o init e sobe os glifos de novo
+        HOST_LcdInicia(0xA5);
+        g_bytes0 = 0;
+        g_isr0 = g_isr;
+        reconfigura_lcd();
+    }
+    else
+    {
+        sim_lcd_entrega(&sim_quadros[0]);
+    }
+    return true;
+}
+
+int main(void)
+{
+    bool parou;
+
+    printf("Escritor do LCD (TMR7) contra o HD44780 virtual\n");
+
+    sim_lcd_confere_latin1();
+
+    HOST_LcdInicia(0x5A);
+    g_tempo = HOST_CoreTimer();
+    HOST_EsperaGancho(sim_lcd_espera);
+
+    APP_DISPLAY_Initialize();
+    printf("  TMR7 PR %u: tick de %.1fus\n", (unsigned)HOST_Tmr7()->periodo,
+           ((double)HOST_Tmr7()->periodo + 1.0) * 1e6 / HOST_TMR7_FREQUENCIA);
+
+    // Volta quando o roteiro acaba e a task fica esperando quadro novo
+    parou = !HOST_TarefaRoda(&g_display, sim_lcd_display, NULL);
+
+    if (!parou || (g_passo != SIM_LCD_N_QUADROS + 3U))
+        sim_lcd_falha("roteiro interrompido (passo)", g_passo, 0);
+    printf("  %u ms simulados\n", (unsigned)xTaskGetTickCount());
+
+    printf("\n%s\n", (g_falhas == 0U) ? "OK" : "FALHOU");
+    return (g_falhas == 0U) ? 0 : 1;
+}
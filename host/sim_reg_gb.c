@@ -0,0 +1,307 @@
+/*******************************************************************************
+  Regulador de corrente do ensaio GB contra um modelo da planta
+
+  File Name:
+    sim_reg_gb.c
+
+  Summary:
+    Regresso de KI, rampa, limite e assentamento de MEDIDA_GB_Regula.
+
+  Description:
+    A planta  uma carga resistiva atrs do TRIAC: a cada zero-cross pega a
+    potncia que o regulador pediu (medida_gbData.potencia_mp), acha o
+    atraso de disparo que entrega essa frao da potncia (invertendo
+    P(d) = 1 - d + sen(2*pi*d) / (2*pi) em double, independente da tabela
+    do firmware) e gera a senoide cortada at esse atraso. A tenso medida
+     a queda na resistncia de aterramento. As amostras entram pela
+    aquisio do host e o ensaio roda completo (host_ensaio_gb.c).
+
+    Cada janela publicada  conferida:
+    - a sada nunca sobe mais que REG_GB_RAMPA_MAX por janela;
+    - 'estavel' liga exatamente na REG_GB_JANELAS_ESTAVEL-sima janela
+      seguida dentro da tolerncia;
+    - o alvo mximo assenta sem chegar ao corte por sobrecorrente;
+    - a corrente nunca passa do alvo mais que SIM_SOBRESSINAL_PCT, em
+      qualquer alvo (o ganho e a rampa escalam com ele);
+    - um curto com a sada em 100% corta o TRIAC;
+    - o tempo at assentar com a carga nominal no piora (KI e rampa).
+*******************************************************************************/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <math.h>
+#include "definitions.h"
+
+#define SIM_CORE_AMOSTRA    ((uint64_t)AQUISICAO_GB_TICKS_AMOSTRA * CORE_TIMER_FREQUENCY / AQUISICAO_GB_CLOCK_HZ)
+#define SIM_RUIDO           3.0     // cdigos do ADC
+#define SIM_V_POR_I         0.55    // cdigo de tenso por cdigo de corrente (~91 mOhm)
+#define SIM_SOBRESSINAL_PCT 10U     // corrente mxima aceita acima do alvo
+
+MENU_DISPLAY_DATA menu_displayData;
+
+void ACTION_SendEventFromTask(ACTION_ID id, ACTION_EVENT_TYPE type)
+{
+    (void)id;
+    (void)type;
+}
+
+typedef enum
+{
+    SIM_FIM_ASSENTOU = 0,
+    SIM_FIM_TEMPO,
+    SIM_FIM_SOBRECORRENTE
+} SIM_FIM;
+
+typedef struct
+{
+    const char *nome;
+    double freq;            // Hz
+    double i_cheia;         // RMS da corrente com 100% de potncia (cdigos)
+    uint32_t alvo;          // pedido a MEDIDA_GB_CorrenteAlvoSet (A*10)
+    double ganho_degrau;    // fator na carga aps 'degrau_s' (curto)
+    double degrau_s;
+    SIM_FIM fim;            // como o ensaio tem de terminar
+    uint32_t janelas_max;   // assentamento: no mximo isto (0 = no confere)
+} SIM_CASO;
+
+static const SIM_CASO sim_casos[] =
+{
+    //  nome              Hz    I 100%  alvo  degrau     fim                    janelas
+    { "nominal 60Hz",     60.0, 2540.0, 250U, 1.0, 0.0, SIM_FIM_ASSENTOU,      90U },
+    { "nominal 50Hz",     50.0, 2540.0, 250U, 1.0, 0.0, SIM_FIM_ASSENTOU,      90U },
+    { "alvo maximo",      60.0, 2800.0, 999U, 1.0, 0.0, SIM_FIM_ASSENTOU,      0U  },
+    { "alvo medio",       60.0, 2540.0, 100U, 1.0, 0.0, SIM_FIM_ASSENTOU,      0U  },
+    { "alvo baixo",       60.0, 2540.0, 50U,  1.0, 0.0, SIM_FIM_ASSENTOU,      0U  },
+    { "alvo minimo",      50.0, 2540.0, 20U,  1.0, 0.0, SIM_FIM_ASSENTOU,      0U  },
+    { "carga fraca",      60.0, 1500.0, 250U, 1.0, 0.0, SIM_FIM_TEMPO,         0U  },
+    { "curto no ensaio",  60.0, 1500.0, 250U, 2.5, 2.0, SIM_FIM_SOBRECORRENTE, 0U  },
+};
+
+#define SIM_N_CASOS     (sizeof(sim_casos) / sizeof(sim_casos[0]))
+
+// *****************************************************************************
+// Planta
+// *****************************************************************************
+
+static const SIM_CASO *g_caso;
+static double g_meioCiclo;          // ticks do core timer
+static double g_zc0;                // primeiro zero-cross
+static double g_atraso = 1.0;       // frao do semiciclo sem conduo
+static int64_t g_semiciclo = -1;
+static uint64_t g_semente = 0x9E3779B97F4A7C15ULL;
+
+static double sim_gauss(void)
+{
+    double u1, u2;
+
+    g_semente ^= g_semente << 13;
+    g_semente ^= g_semente >> 7;
+    g_semente ^= g_semente << 17;
+    u1 = ((double)(g_semente >> 11) + 0.5) / 9007199254740992.0;
+    g_semente ^= g_semente << 13;
+    g_semente ^= g_semente >> 7;
+    g_semente ^= g_semente << 17;
+    u2 = ((double)(g_semente >> 11) + 0.5) / 9007199254740992.0;
+    return sqrt(-2.0 * log(u1)) * cos(2.0 * M_PI * u2);
+}
+
+// Atraso (frao do semiciclo) que entrega 'potencia' (0..1) da potncia
+static double sim_atraso(double potencia)
+{
+    double baixo = 0.0, alto = 1.0, d, p;
+    uint32_t k;
+
+    if (potencia <= 0.0)
+        return 1.0;
+    for (k = 0; k < 50U; k++)
+    {
+        d = (baixo + alto) / 2.0;
+        p = 1.0 - d + sin(2.0 * M_PI * d) / (2.0 * M_PI);
+        if (p > potencia)
+            baixo = d;
+        else
+            alto = d;
+    }
+    return (baixo + alto) / 2.0;
+}
+
+static uint16_t sim_adc(double x)
+{
+    if (x <= 0.0)
+        return 0U;
+    if (x >= 4095.0)
+        return 4095U;
+    return (uint16_t)lround(x);
+}
+
+static bool sim_planta(uint32_t k, uint16_t *tensao, uint16_t *corrente, uint32_t *zc_antes)
+{
+    double t = (double)((uint64_t)k * SIM_CORE_AMOSTRA);
+    double fase, i, ganho = 1.0;
+    int64_t n = (int64_t)floor((t - g_zc0) / g_meioCiclo);
+    bool zc = false;
+
+    // Borda do zero-cross: o TRIAC passa a usar a potncia pedida agora
+    if (n != g_semiciclo)
+    {
+        g_semiciclo = n;
+        if (n >= 0)
+        {
+            zc = true;
+            *zc_antes = (uint32_t)lround(t - (g_zc0 + (double)n * g_meioCiclo));
+        }
+        g_atraso = sim_atraso((double)medida_gbData.potencia_mp / REG_GB_SAIDA_MAX);
+    }
+
+    if (t >= g_caso->degrau_s * CORE_TIMER_FREQUENCY)
+        ganho = g_caso->ganho_degrau;
+
+    fase = (t - (g_zc0 + (double)n * g_meioCiclo)) / g_meioCiclo;
+    i = (fase >= g_atraso) ? (g_caso->i_cheia * ganho * M_SQRT2 * sin(M_PI * fase)) : 0.0;
+
+    *corrente = sim_adc(i + SIM_RUIDO * sim_gauss());
+    *tensao = sim_adc(i * SIM_V_POR_I + SIM_RUIDO * sim_gauss());
+    return zc;
+}
+
+// *****************************************************************************
+// Conferncia das janelas
+// *****************************************************************************
+
+typedef struct
+{
+    uint32_t janelas;
+    uint32_t seguidas;          // janelas seguidas dentro da tolerncia
+    uint32_t assentou_em;       // janela em que 'estavel' ligou (0 = no)
+    uint32_t seguidas_ao_assentar;
+    int32_t potencia_anterior;
+    int32_t subida_max;         // maior aumento da sada numa janela
+    uint32_t corrente_max;
+    uint32_t corrente_final;
+    uint32_t falhas;            // 'estavel' fora da contagem certa
+} SIM_RESULTADO;
+
+static SIM_RESULTADO g_res;
+
+static void sim_leitura(uint32_t seq, uintptr_t context)
+{
+    MEDIDA_GB_LEITURA leitura;
+    uint32_t alvo = medida_gbData.corrente_alvo;
+    uint32_t tolerancia = (alvo * REG_GB_TOLERANCIA_PCT) / 100U;
+    uint32_t erro;
+
+    (void)seq;
+    (void)context;
+
+    if (!medida_gbData.regulando && !medida_gbData.sobrecorrente)
+        return;
+    if (!MEDIDA_GB_LeituraGet(&leitura))
+        return;
+
+    g_res.janelas++;
+    if (tolerancia == 0U)
+        tolerancia = 1U;
+    erro = (leitura.corrente > alvo) ? (leitura.corrente - alvo) : (alvo - leitura.corrente);
+    if (erro <= tolerancia)
+        g_res.seguidas++;
+    else
+        g_res.seguidas = 0;
+
+    if (leitura.estavel && (g_res.assentou_em == 0U))
+    {
+        g_res.assentou_em = g_res.janelas;
+        g_res.seguidas_ao_assentar = g_res.seguidas;
+    }
+    if (leitura.estavel != (g_res.seguidas >= REG_GB_JANELAS_ESTAVEL))
+        g_res.falhas++;
+
+    if ((leitura.potencia_mp - g_res.potencia_anterior) > g_res.subida_max)
+        g_res.subida_max = leitura.potencia_mp - g_res.potencia_anterior;
+    g_res.potencia_anterior = leitura.potencia_mp;
+
+    if (leitura.corrente > g_res.corrente_max)
+        g_res.corrente_max = leitura.corrente;
+    g_res.corrente_final = leitura.corrente;
+}
+
+static const char *sim_fim_nome(SIM_FIM fim)
+{
+    switch (fim)
+    {
+        case SIM_FIM_ASSENTOU:      return "assentou";
+        case SIM_FIM_TEMPO:         return "tempo maximo";
+        default:                    return "sobrecorrente";
+    }
+}
+
+int main(void)
+{
+    TickType_t duracao;
+    uint32_t k;
+    int falhas = 0;
+
+    printf("Regulador GB: KI %d, rampa %d mp/janela, tolerancia %u%%, %u janelas para assentar\n",
+           REG_GB_KI, REG_GB_RAMPA_MAX, REG_GB_TOLERANCIA_PCT, REG_GB_JANELAS_ESTAVEL);
+    printf("alvo max %u, corte %u (A*10), sobressinal max %u%%\n\n", REG_GB_ALVO_MAX,
+           REG_GB_CORRENTE_LIMITE, SIM_SOBRESSINAL_PCT);
+    printf("%-16s %5s | %-13s %6s %6s %6s %7s %6s %6s %6s\n",
+           "caso", "alvo", "fim", "ms", "jan", "assent", "subida", "I max", "I fim", "pot %");
+
+    HOST_GbEnsaioPrepara();
+    HOST_GbFonte(sim_planta);
+    (void)MEDIDA_GB_Assina(sim_leitura, 0, 0);
+
+    for (k = 0; k < SIM_N_CASOS; k++)
+    {
+        const SIM_CASO *c = &sim_casos[k];
+        SIM_FIM fim;
+        bool ok;
+
+        g_caso = c;
+        g_meioCiclo = (double)CORE_TIMER_FREQUENCY / (2.0 * c->freq);
+        g_zc0 = g_meioCiclo / 3.0;
+        g_semiciclo = -1;
+        g_atraso = 1.0;             // TRIAC desligado no fim do caso anterior
+        memset(&g_res, 0, sizeof(g_res));
+
+        MEDIDA_GB_CorrenteAlvoSet(c->alvo);
+        if (!HOST_GbEnsaioRoda(&duracao))
+        {
+            printf("%-16s ensaio recusado\n", c->nome);
+            falhas++;
+            continue;
+        }
+
+        fim = medida_gbData.estavel ? SIM_FIM_ASSENTOU :
+              (medida_gbData.sobrecorrente ? SIM_FIM_SOBRECORRENTE : SIM_FIM_TEMPO);
+
+        ok = (fim == c->fim) && (g_res.falhas == 0U) &&
+             (g_res.subida_max <= REG_GB_RAMPA_MAX) &&
+             (medida_gbData.corrente_alvo <= REG_GB_ALVO_MAX) &&
+             (HOST_PinoLe(HOST_PINO_TRIAC_GB) == 0U);
+        if (fim == SIM_FIM_ASSENTOU)
+            ok = ok && (g_res.seguidas_ao_assentar == REG_GB_JANELAS_ESTAVEL) &&
+                 (g_res.corrente_max <= REG_GB_CORRENTE_LIMITE) &&
+                 ((c->janelas_max == 0U) || (g_res.assentou_em <= c->janelas_max));
+        // O curto passa do alvo de propsito; o corte  o que se confere
+        if (fim != SIM_FIM_SOBRECORRENTE)
+            ok = ok && ((g_res.corrente_max * 100U) <=
+                        (medida_gbData.corrente_alvo * (100U + SIM_SOBRESSINAL_PCT)));
+        if (fim == SIM_FIM_SOBRECORRENTE)
+            ok = ok && (medida_gbData.potencia_mp == 0);
+        if (fim == SIM_FIM_TEMPO)
+            ok = ok && (medida_gbData.potencia_mp == REG_GB_SAIDA_MAX);
+
+        printf("%-16s %5u | %-13s %6u %6u %6u %7d %6u %6u %6.1f %s\n",
+               c->nome, (unsigned)medida_gbData.corrente_alvo, sim_fim_nome(fim),
+               (unsigned)duracao, (unsigned)g_res.janelas, (unsigned)g_res.assentou_em,
+               (int)g_res.subida_max, (unsigned)g_res.corrente_max,
+               (unsigned)g_res.corrente_final, medida_gbData.potencia_mp / 1000.0,
+               ok ? "" : "FALHOU");
+        if (!ok)
+            falhas++;
+    }
+
+    printf("\n%s\n", (falhas == 0) ? "OK" : "FALHOU");
+    return (falhas == 0) ? 0 : 1;
+}
@@ -0,0 +1,51 @@
+/*******************************************************************************
+  FreeRTOS do alvo host
+
+  File Name:
+    FreeRTOS.h
+
+  Summary:
+    Tipos e macros do FreeRTOS usados pelos mdulos, sem kernel.
+
+  Description:
+    No host no h escalonador: cada programa de teste roda os mdulos numa
+    thread s e decide quando cada "task" roda (ver host.h). Aqui ficam s os
+    tipos, as constantes de FreeRTOSConfig.h que os mdulos usam e as sees
+    crticas, que viram nada.
+*******************************************************************************/
+
+#ifndef _HOST_FREERTOS_H
+#define _HOST_FREERTOS_H
+
+#include <stdint.h>
+#include <stddef.h>
+#include <stdbool.h>
+#include <assert.h>
+
+typedef uint32_t TickType_t;
+typedef long BaseType_t;
+typedef unsigned long UBaseType_t;
+typedef uint32_t StackType_t;
+
+#define pdFALSE                 ((BaseType_t)0)
+#define pdTRUE                  ((BaseType_t)1)
+#define pdPASS                  pdTRUE
+#define pdFAIL                  pdFALSE
+#define portMAX_DELAY           ((TickType_t)0xFFFFFFFFU)
+
+// Mesmos valores de config/default/FreeRTOSConfig.h
+#define configTICK_RATE_HZ      ((TickType_t)1000)
+#define configMAX_PRIORITIES    (5UL)
+#define pdMS_TO_TICKS(ms)       ((TickType_t)(((TickType_t)(ms) * configTICK_RATE_HZ) / (TickType_t)1000U))
+
+#define configASSERT(x)         assert(x)
+
+// Uma thread s: no h o que travar nem quem preemptar
+#define taskENTER_CRITICAL()    do { } while (0)
+#define taskEXIT_CRITICAL()     do { } while (0)
+#define portEND_SWITCHING_ISR(x) ((void)(x))
+
+// Aninhamento de interrupo (port MIPS); o teste liga ao simular uma ISR
+extern volatile UBaseType_t uxInterruptNesting;
+
+#endif /* _HOST_FREERTOS_H */
@@ -0,0 +1,29 @@
+/*******************************************************************************
+  GPIO do alvo host
+
+  File Name:
+    plib_gpio.h
+
+  Summary:
+    Pinos do LCD como variveis do modelo do HD44780 (host.h).
+
+  Description:
+    No firmware os pinos do LCD so bits de LATx escritos direto
+    (PINO_LCD_EN = 1). Aqui so posies de HOST_LcdPinos, que o modelo l
+    a cada leitura do core timer e na sada de cada ISR do TMR7.
+*******************************************************************************/
+
+#ifndef PLIB_GPIO_H
+#define PLIB_GPIO_H
+
+#include "definitions.h"
+
+#define PINO_LCD_RS                     HOST_LcdPinos[HOST_LCD_RS]
+#define PINO_LCD_RW                     HOST_LcdPinos[HOST_LCD_RW]
+#define PINO_LCD_EN                     HOST_LcdPinos[HOST_LCD_EN]
+#define PINO_LCD_D4_OUT                 HOST_LcdPinos[HOST_LCD_D4]
+#define PINO_LCD_D5_OUT                 HOST_LcdPinos[HOST_LCD_D5]
+#define PINO_LCD_D6_OUT                 HOST_LcdPinos[HOST_LCD_D6]
+#define PINO_LCD_D7_OUT                 HOST_LcdPinos[HOST_LCD_D7]
+
+#endif // PLIB_GPIO_H
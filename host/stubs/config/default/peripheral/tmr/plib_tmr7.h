@@ -0,0 +1,17 @@
+/*******************************************************************************
+  TMR7 do alvo host
+
+  File Name:
+    plib_tmr7.h
+
+  Summary:
+    TMR7 (relgio do escritor do LCD) ligado ao modelo de timers do host.
+*******************************************************************************/
+
+#ifndef PLIB_TMR7_H
+#define PLIB_TMR7_H
+
+// TMR7_* esto declaradas em definitions.h do host
+#include "definitions.h"
+
+#endif // PLIB_TMR7_H
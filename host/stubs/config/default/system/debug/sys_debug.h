@@ -0,0 +1,14 @@
+/*******************************************************************************
+  SYS_DEBUG do alvo host
+
+  File Name:
+    sys_debug.h
+
+  Summary:
+    Vazio: os mdulos s incluem, no usam.
+*******************************************************************************/
+
+#ifndef SYS_DEBUG_H
+#define SYS_DEBUG_H
+
+#endif // SYS_DEBUG_H
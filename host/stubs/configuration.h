@@ -0,0 +1,22 @@
+/*******************************************************************************
+  Configurao do alvo host
+
+  File Name:
+    configuration.h
+
+  Summary:
+    Substitui config/default/configuration.h na compilao para o host.
+
+  Description:
+    Os mdulos de aplicao no usam nada da configurao do Harmony
+    diretamente; o que eles precisam vem de definitions.h.
+*******************************************************************************/
+
+#ifndef _HOST_CONFIGURATION_H
+#define _HOST_CONFIGURATION_H
+
+#include <stdint.h>
+#include <stddef.h>
+#include <stdbool.h>
+
+#endif /* _HOST_CONFIGURATION_H */
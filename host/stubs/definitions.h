@@ -0,0 +1,124 @@
+/*******************************************************************************
+  Definies do alvo host
+
+  File Name:
+    definitions.h
+
+  Summary:
+    Substitui config/default/definitions.h na compilao para o host.
+
+  Description:
+    Declara a parte dos plibs do Harmony (GPIO, TMR, core timer, console) que
+    os mdulos de aplicao usam, ligada ao modelo de hardware do host
+    (host.h), e inclui os cabealhos das aplicaes na mesma ordem do
+    definitions.h do firmware.
+*******************************************************************************/
+
+#ifndef _HOST_DEFINITIONS_H
+#define _HOST_DEFINITIONS_H
+
+#include <stdint.h>
+#include <stddef.h>
+#include <stdbool.h>
+#include <stdio.h>
+#include <string.h>
+#include "FreeRTOS.h"
+#include "task.h"
+#include "queue.h"
+#include "host.h"
+#include "usb/usb_host.h"
+#include "usb/usb_host_hid_keyboard.h"
+
+// *****************************************************************************
+// Ncleo: core timer (SYSCLK/2) e interrupes
+// *****************************************************************************
+
+#define CORE_TIMER_FREQUENCY            (60000000U)
+#define _CP0_GET_COUNT()                HOST_CoreTimer()
+
+#define __builtin_disable_interrupts()  (1U)
+#define __builtin_enable_interrupts()   do { } while (0)
+
+uint32_t CORETIMER_FrequencyGet(void);
+
+// *****************************************************************************
+// GPIO
+// *****************************************************************************
+
+typedef uint32_t GPIO_PIN;
+typedef void (*GPIO_PIN_CALLBACK)(GPIO_PIN pin, uintptr_t context);
+
+bool GPIO_PinInterruptCallbackRegister(GPIO_PIN pin, GPIO_PIN_CALLBACK callback, uintptr_t context);
+
+#define PINO_TRIAC_GB_Set()                 HOST_PinoEscreve(HOST_PINO_TRIAC_GB, 1U)
+#define PINO_TRIAC_GB_Clear()               HOST_PinoEscreve(HOST_PINO_TRIAC_GB, 0U)
+#define PINO_RELE2_TAP_Set()                HOST_PinoEscreve(HOST_PINO_RELE2_TAP, 1U)
+#define PINO_RELE2_TAP_Clear()              HOST_PinoEscreve(HOST_PINO_RELE2_TAP, 0U)
+#define PINO_MUX_A_Set()                    HOST_PinoEscreve(HOST_PINO_MUX_A, 1U)
+#define PINO_MUX_A_Clear()                  HOST_PinoEscreve(HOST_PINO_MUX_A, 0U)
+#define PINO_MUX_B_Set()                    HOST_PinoEscreve(HOST_PINO_MUX_B, 1U)
+#define PINO_MUX_B_Clear()                  HOST_PinoEscreve(HOST_PINO_MUX_B, 0U)
+
+#define PINO_ZERO_CROSS_PIN                 ((GPIO_PIN)HOST_PINO_ZERO_CROSS)
+#define PINO_ZERO_CROSS_InterruptEnable()   HOST_PinoInterrupcao(HOST_PINO_ZERO_CROSS, true)
+#define PINO_ZERO_CROSS_InterruptDisable()  HOST_PinoInterrupcao(HOST_PINO_ZERO_CROSS, false)
+
+// Botes do painel: pull-up, 0 = apertado
+#define PINO_BTN_BACK_Get()                 HOST_PinoLe(HOST_PINO_BTN_BACK)
+#define PINO_BTN_BACK_PIN                   ((GPIO_PIN)HOST_PINO_BTN_BACK)
+#define PINO_BTN_BACK_InterruptEnable()     HOST_PinoInterrupcao(HOST_PINO_BTN_BACK, true)
+#define PINO_BTN_ENTER_Get()                HOST_PinoLe(HOST_PINO_BTN_ENTER)
+#define PINO_BTN_ENTER_PIN                  ((GPIO_PIN)HOST_PINO_BTN_ENTER)
+#define PINO_BTN_ENTER_InterruptEnable()    HOST_PinoInterrupcao(HOST_PINO_BTN_ENTER, true)
+#define PINO_BTN_CIMA_Get()                 HOST_PinoLe(HOST_PINO_BTN_CIMA)
+#define PINO_BTN_CIMA_PIN                   ((GPIO_PIN)HOST_PINO_BTN_CIMA)
+#define PINO_BTN_CIMA_InterruptEnable()     HOST_PinoInterrupcao(HOST_PINO_BTN_CIMA, true)
+#define PINO_BTN_BAIXO_Get()                HOST_PinoLe(HOST_PINO_BTN_BAIXO)
+#define PINO_BTN_BAIXO_PIN                  ((GPIO_PIN)HOST_PINO_BTN_BAIXO)
+#define PINO_BTN_BAIXO_InterruptEnable()    HOST_PinoInterrupcao(HOST_PINO_BTN_BAIXO, true)
+
+// *****************************************************************************
+// Timers
+// *****************************************************************************
+
+typedef void (*TMR_CALLBACK)(uint32_t status, uintptr_t context);
+
+void TMR3_Start(void);
+void TMR3_Stop(void);
+void TMR3_InterruptEnable(void);
+void TMR3_InterruptDisable(void);
+void TMR3_CallbackRegister(TMR_CALLBACK callback, uintptr_t context);
+
+void TMR6_Start(void);
+void TMR6_Stop(void);
+void TMR6_CounterSet(uint16_t count);
+void TMR6_PeriodSet(uint16_t period);
+uint32_t TMR6_FrequencyGet(void);
+void TMR6_InterruptEnable(void);
+void TMR6_InterruptDisable(void);
+void TMR6_CallbackRegister(TMR_CALLBACK callback, uintptr_t context);
+
+void TMR7_Start(void);
+void TMR7_Stop(void);
+void TMR7_PeriodSet(uint16_t period);
+void TMR7_CallbackRegister(TMR_CALLBACK callback, uintptr_t context);
+
+// *****************************************************************************
+// Console
+// *****************************************************************************
+
+#define SYS_CONSOLE_PRINT(...)      ((void)printf(__VA_ARGS__))
+
+// *****************************************************************************
+// Aplicaes (mesma ordem do definitions.h do firmware)
+// *****************************************************************************
+
+#include "app_display.h"
+#include "app_usb.h"
+#include "menu_display.h"
+#include "medida_gb.h"
+#include "aquisicao_gb.h"
+#include "diag_gb.h"
+#include "isr_latencia.h"
+
+#endif /* _HOST_DEFINITIONS_H */
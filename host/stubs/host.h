@@ -0,0 +1,251 @@
+/*******************************************************************************
+  Modelo do hardware e das tasks no host
+
+  File Name:
+    host.h
+
+  Summary:
+    O que os programas de teste do host usam para simular o PIC32MK.
+
+  Description:
+    Os plibs do Harmony declarados em definitions.h caem aqui:
+    - pinos: guardam o nvel escrito e chamam o callback de interrupo
+      registrado quando o teste "dispara" o pino;
+    - core timer: contador que o teste posiciona; cada leitura avana um
+      tick, para esperas ativas terminarem;
+    - TMR3, TMR6 e TMR7: guardam perodo e estado e chamam o callback quando o
+      teste dispara o timer;
+    - LCD: os pinos PINO_LCD_* alimentam um HD44780 virtual (lcd_hd44780.c);
+    - filas: anel de itens; esperar numa fila usa o mesmo gancho de espera;
+    - tasks: cada handle  um contador de notificaes. O teste escolhe que
+      task roda (HOST_TarefaRoda) e, enquanto ela dorme, o gancho de espera
+      simula o resto do sistema.
+*******************************************************************************/
+
+#ifndef _HOST_H
+#define _HOST_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <setjmp.h>
+#include "FreeRTOS.h"
+#include "task.h"
+
+// *****************************************************************************
+// Pinos
+// *****************************************************************************
+
+typedef enum
+{
+    HOST_PINO_TRIAC_GB = 0,
+    HOST_PINO_RELE2_TAP,
+    HOST_PINO_MUX_A,
+    HOST_PINO_MUX_B,
+    HOST_PINO_ZERO_CROSS,
+    HOST_PINO_BTN_BACK,         // botes: pull-up, comeam em 1 (soltos)
+    HOST_PINO_BTN_ENTER,
+    HOST_PINO_BTN_CIMA,
+    HOST_PINO_BTN_BAIXO,
+    HOST_PINO_QUANT
+
+} HOST_PINO;
+
+void HOST_PinoEscreve(HOST_PINO pino, uint32_t valor);
+uint32_t HOST_PinoLe(HOST_PINO pino);
+void HOST_PinoInterrupcao(HOST_PINO pino, bool habilita);
+
+// Borda no pino: chama o callback registrado (como ISR) se a interrupo
+// do pino est habilitada. Retorna false se no chamou.
+bool HOST_PinoDispara(HOST_PINO pino);
+
+// *****************************************************************************
+// Core timer
+// *****************************************************************************
+
+uint32_t HOST_CoreTimer(void);
+void HOST_CoreTimerSet(uint32_t agora);
+
+// Chamado a cada leitura do core timer (esperas ativas): o modelo do LCD
+// v ali os pinos no meio de uma ISR
+void HOST_CoreTimerObservador(void (*observador)(uint32_t agora));
+
+// *****************************************************************************
+// TMR3 (tick de 1ms dos botes), TMR6 e TMR7 (PBCLK3 60MHz com prescaler 1:8)
+// *****************************************************************************
+
+#define HOST_TMR6_FREQUENCIA    7500000U
+#define HOST_TMR7_FREQUENCIA    7500000U
+
+typedef struct
+{
+    bool rodando;
+    bool interrupcao;
+    uint16_t periodo;
+    uint32_t programacoes;      // chamadas de PeriodSet
+} HOST_TMR;
+
+const HOST_TMR *HOST_Tmr3(void);
+bool HOST_Tmr3Dispara(void);
+
+const HOST_TMR *HOST_Tmr6(void);
+
+// Fim do perodo: chama o callback (como ISR) se o timer roda com a
+// interrupo habilitada. Retorna false se no chamou.
+bool HOST_Tmr6Dispara(void);
+
+const HOST_TMR *HOST_Tmr7(void);
+bool HOST_Tmr7Dispara(void);
+
+// *****************************************************************************
+// LCD HD44780 20x4 em 4 bits (lcd_hd44780.c)
+// *****************************************************************************
+
+typedef enum
+{
+    HOST_LCD_RS = 0,
+    HOST_LCD_RW,
+    HOST_LCD_EN,
+    HOST_LCD_D4,
+    HOST_LCD_D5,
+    HOST_LCD_D6,
+    HOST_LCD_D7,
+    HOST_LCD_PINOS
+
+} HOST_LCD_PINO;
+
+extern volatile uint8_t HOST_LcdPinos[HOST_LCD_PINOS];
+
+typedef struct
+{
+    uint8_t ddram[0x80];
+    uint8_t cgram[0x40];
+    uint8_t ac;                 // contador de endereo
+    bool cgram_sel;             // ac aponta a CGRAM
+    bool modo4;                 // interface de 4 bits
+    bool duas_linhas;
+    bool ligado;                // display ON
+    bool incrementa;            // entry mode I/D
+    bool meio_byte;             // nibble alto recebido, falta o baixo
+    uint8_t nibble_alto;
+    uint32_t comandos;
+    uint32_t dados;
+    uint32_t erros_tempo;       // escrita antes de o LCD terminar a anterior
+    uint32_t erros_pulso;       // EN alto por menos de 450ns
+    uint32_t erros_protocolo;   // RW=1, shift de display etc.
+} HOST_LCD;
+
+// Liga o modelo (pinos, core timer) com a RAM em 'lixo', como na partida
+void HOST_LcdInicia(uint8_t lixo);
+const HOST_LCD *HOST_Lcd(void);
+
+// L os pinos: detecta a borda de descida de EN
+void HOST_LcdAmostra(uint32_t agora);
+
+// Cdigo do caractere na clula e as 5 colunas de pixel de uma das 8
+// linhas da clula: CGRAM para os cdigos 0..15, bloco cheio (0xFF) e
+// espao. Retorna -1 para os demais caracteres da ROM.
+uint8_t HOST_LcdCelula(uint8_t linha, uint8_t col);
+int32_t HOST_LcdPixels(uint8_t linha, uint8_t col, uint8_t linha_pixel);
+
+// *****************************************************************************
+// Tasks
+// *****************************************************************************
+
+struct HOST_TAREFA
+{
+    const char *nome;
+    uint32_t notificacoes;      // pendentes
+    uint32_t acordadas;         // notificaes recebidas no total
+    jmp_buf *parada;            // volta para HOST_TarefaRoda
+};
+
+// Simula o sistema enquanto 'tarefa' dorme at 'ticks' (portMAX_DELAY =
+// sem prazo). Volta quando a task foi notificada ou o prazo passou.
+typedef void (*HOST_GANCHO_ESPERA)(TaskHandle_t tarefa, TickType_t ticks);
+
+void HOST_EsperaGancho(HOST_GANCHO_ESPERA gancho);
+
+// Roda 'corpo' como a task 'tarefa'. Retorna true se o corpo terminou e
+// false se a task ficou esperando sem prazo sem nada para acord-la.
+bool HOST_TarefaRoda(TaskHandle_t tarefa, void (*corpo)(void *), void *param);
+
+void HOST_TickAvanca(TickType_t ticks);
+
+// *****************************************************************************
+// Aquisio do GB (aquisicao_gb_host.c)
+// *****************************************************************************
+
+// Amostra 'k' desde o AQUISICAO_GB_Start. Retorna true se houve borda do
+// zero-cross 'zc_antes' ticks do core timer antes dela.
+typedef bool (*HOST_GB_FONTE)(uint32_t k, uint16_t *tensao, uint16_t *corrente,
+                              uint32_t *zc_antes);
+
+typedef struct
+{
+    uint16_t tensao;
+    uint16_t corrente;
+    bool zc;
+    uint32_t zc_antes;
+} HOST_GB_AMOSTRA;
+
+typedef struct
+{
+    HOST_GB_AMOSTRA *amostras;
+    uint32_t n;
+} HOST_GB_GRAVACAO;
+
+void HOST_GbFonte(HOST_GB_FONTE fonte);
+
+// Carrega uma gravao (formato em aquisicao_gb_host.c) e passa a us-la
+// como fonte, em loop
+bool HOST_GbGravacaoCarrega(const char *arquivo);
+const HOST_GB_GRAVACAO *HOST_GbGravacao(void);
+
+// Interrupo de um bloco completo: entrega o prximo bloco da fonte ao
+// consumidor registrado. Retorna false com a aquisio parada.
+bool HOST_GbBloco(void);
+
+// Ensaio GB completo (host_ensaio_gb.c). Prepara inicializa a aquisio e
+// a medida e deixa a MEDIDA_GB_Tasks esperando blocos; Roda pede um ensaio
+// e volta quando a MEDIDA_GB_TesteTask termina (false se foi recusado).
+void HOST_GbEnsaioPrepara(void);
+bool HOST_GbEnsaioRoda(TickType_t *duracao);
+
+// Para testes com outras tasks: Atende roda a MEDIDA_GB_TesteTask se algum
+// j pediu o ensaio (false se no h pedido); 'roda'  chamada a cada bloco
+// entregue durante o ensaio; HOST_GbEspera  o gancho de espera do ensaio,
+// para um gancho prprio repassar as tasks do ensaio
+bool HOST_GbEnsaioAtende(TickType_t *duracao);
+void HOST_GbEnsaioOutras(void (*roda)(void));
+void HOST_GbEspera(TaskHandle_t tarefa, TickType_t ticks);
+
+// *****************************************************************************
+// Custo de execuo
+// *****************************************************************************
+
+// Contador de ciclos do host (TSC no x86, ns nos demais). S serve para
+// comparar verses e acompanhar regresses: no  o custo no PIC32MK.
+#if defined(__x86_64__) || defined(__i386__)
+#include <x86intrin.h>
+#define HOST_RELOGIO_UNIDADE    "ciclos"
+static inline uint64_t HOST_Relogio(void)
+{
+    return __rdtsc();
+}
+#else
+#include <time.h>
+#define HOST_RELOGIO_UNIDADE    "ns"
+static inline uint64_t HOST_Relogio(void)
+{
+    struct timespec t;
+
+    clock_gettime(CLOCK_MONOTONIC, &t);
+    return ((uint64_t)t.tv_sec * 1000000000ULL) + (uint64_t)t.tv_nsec;
+}
+#endif
+
+// Contexto de interrupo para o cdigo que consulta uxInterruptNesting
+#define HOST_ISR_ENTRA()        (uxInterruptNesting++)
+#define HOST_ISR_SAI()          (uxInterruptNesting--)
+
+#endif /* _HOST_H */
@@ -0,0 +1,45 @@
+/*******************************************************************************
+  FreeRTOS do alvo host
+
+  File Name:
+    queue.h
+
+  Summary:
+    Filas estticas do FreeRTOS, sem escalonador.
+
+  Description:
+    A fila  um anel de itens copiados, como no FreeRTOS. Receber de uma
+    fila vazia (ou enviar para uma cheia) com espera chama o gancho de
+    espera da task atual (host.h); se a espera  portMAX_DELAY e nada
+    mudou, o controle volta para quem chamou HOST_TarefaRoda.
+*******************************************************************************/
+
+#ifndef _HOST_QUEUE_H
+#define _HOST_QUEUE_H
+
+#include "FreeRTOS.h"
+
+typedef struct
+{
+    uint8_t *area;
+    UBaseType_t tamanho;        // itens
+    UBaseType_t item;           // bytes por item
+    UBaseType_t leitura;
+    UBaseType_t quantos;
+} StaticQueue_t;
+
+typedef StaticQueue_t *QueueHandle_t;
+
+#define errQUEUE_FULL           ((BaseType_t)0)
+#define errQUEUE_EMPTY          ((BaseType_t)0)
+
+QueueHandle_t xQueueCreateStatic(UBaseType_t uxQueueLength, UBaseType_t uxItemSize,
+                                 uint8_t *pucQueueStorage, StaticQueue_t *pxQueueBuffer);
+BaseType_t xQueueSend(QueueHandle_t fila, const void *item, TickType_t xTicksToWait);
+BaseType_t xQueueSendFromISR(QueueHandle_t fila, const void *item,
+                             BaseType_t *pxHigherPriorityTaskWoken);
+BaseType_t xQueueReceive(QueueHandle_t fila, void *item, TickType_t xTicksToWait);
+UBaseType_t uxQueueMessagesWaiting(QueueHandle_t fila);
+UBaseType_t uxQueueSpacesAvailable(QueueHandle_t fila);
+
+#endif /* _HOST_QUEUE_H */
@@ -0,0 +1,19 @@
+/*******************************************************************************
+  Semforos do FreeRTOS no alvo host
+
+  File Name:
+    semphr.h
+
+  Summary:
+    S o tipo do handle: os mdulos compilados no host s incluem, e o
+    osal_freertos.h dos fontes do Harmony declara os tipos da OSAL com ele.
+*******************************************************************************/
+
+#ifndef _HOST_SEMPHR_H
+#define _HOST_SEMPHR_H
+
+#include "FreeRTOS.h"
+
+typedef void * SemaphoreHandle_t;
+
+#endif /* _HOST_SEMPHR_H */
@@ -0,0 +1,39 @@
+/*******************************************************************************
+  FreeRTOS do alvo host
+
+  File Name:
+    task.h
+
+  Summary:
+    Notificaes de task e contagem de ticks, sem escalonador.
+
+  Description:
+    Cada TaskHandle_t aponta para um contador de notificaes. Quem roda 
+    sempre a "task atual" escolhida pelo teste (HOST_TarefaRoda, em host.h).
+    ulTaskNotifyTake sem notificao pendente chama o gancho de espera do
+    teste, que simula o que acontece enquanto a task dorme; se a espera 
+    portMAX_DELAY e nada chegou, a task ficaria parada para sempre e o
+    controle volta para quem chamou HOST_TarefaRoda.
+*******************************************************************************/
+
+#ifndef _HOST_TASK_H
+#define _HOST_TASK_H
+
+#include "FreeRTOS.h"
+
+typedef struct HOST_TAREFA *TaskHandle_t;
+typedef void (*TaskFunction_t)(void *);
+
+typedef struct
+{
+    uint32_t reservado;
+} StaticTask_t;
+
+TickType_t xTaskGetTickCount(void);
+TaskHandle_t xTaskGetCurrentTaskHandle(void);
+BaseType_t xTaskNotifyGive(TaskHandle_t tarefa);
+void vTaskNotifyGiveFromISR(TaskHandle_t tarefa, BaseType_t *pxHigherPriorityTaskWoken);
+uint32_t ulTaskNotifyTake(BaseType_t xClearCountOnExit, TickType_t xTicksToWait);
+void vTaskDelay(TickType_t xTicksToDelay);
+
+#endif /* _HOST_TASK_H */
@@ -0,0 +1,60 @@
+/*******************************************************************************
+  Camada de host USB no alvo host
+
+  File Name:
+    usb_host.h
+
+  Summary:
+    Tipos e funes de usb_host.h do Harmony usados por app_usb.c.
+
+  Description:
+    Mesmos nomes e valores do Harmony. As funes so definidas pelo
+    programa de teste que liga app_usb.c, que faz o papel da pilha USB.
+*******************************************************************************/
+
+#ifndef _HOST_USB_HOST_H
+#define _HOST_USB_HOST_H
+
+#include <stdint.h>
+
+typedef uint8_t USB_HOST_BUS;
+
+#define USB_HOST_BUS_ALL ((USB_HOST_BUS)(0xFF))
+
+typedef enum
+{
+    USB_HOST_RESULT_FAILURE = -1,
+    USB_HOST_RESULT_FALSE = 0,
+    USB_HOST_RESULT_TRUE = 1,
+    USB_HOST_RESULT_SUCCESS = USB_HOST_RESULT_TRUE
+
+} USB_HOST_RESULT;
+
+typedef enum
+{
+    USB_HOST_EVENT_DEVICE_REJECTED_INSUFFICIENT_POWER,
+    USB_HOST_EVENT_DEVICE_UNSUPPORTED,
+    USB_HOST_EVENT_HUB_TIER_LEVEL_EXCEEDED,
+    USB_HOST_EVENT_PORT_OVERCURRENT_DETECTED,
+    USB_HOST_EVENT_DEVICE_DETACHED
+
+} USB_HOST_EVENT;
+
+typedef enum
+{
+    USB_HOST_EVENT_RESPONSE_NONE = 0
+
+} USB_HOST_EVENT_RESPONSE;
+
+typedef USB_HOST_EVENT_RESPONSE (*USB_HOST_EVENT_HANDLER)
+(
+    USB_HOST_EVENT event,
+    void * eventData,
+    uintptr_t context
+);
+
+USB_HOST_RESULT USB_HOST_EventHandlerSet(USB_HOST_EVENT_HANDLER eventHandler, uintptr_t context);
+USB_HOST_RESULT USB_HOST_BusEnable(USB_HOST_BUS bus);
+USB_HOST_RESULT USB_HOST_BusIsEnabled(USB_HOST_BUS bus);
+
+#endif /* _HOST_USB_HOST_H */
@@ -0,0 +1,119 @@
+/*******************************************************************************
+  Teclado HID do host USB no alvo host
+
+  File Name:
+    usb_host_hid_keyboard.h
+
+  Summary:
+    Tipos de usb_hid.h, usb_host_hid.h e usb_host_hid_keyboard.h do Harmony.
+
+  Description:
+    S o que app_usb.c e teclado.c usam, com os mesmos nomes, valores e
+    estruturas do Harmony, para os mdulos compilarem sem a pilha USB. As
+    funes do driver do teclado so as de usb_host_hid_keyboard.c, compilado
+    com os headers reais (ver HARMONY_CPPFLAGS no Makefile); as da camada HID
+    so definidas pelo programa de teste que liga app_usb.c.
+*******************************************************************************/
+
+#ifndef _HOST_USB_HOST_HID_KEYBOARD_H
+#define _HOST_USB_HOST_HID_KEYBOARD_H
+
+#include <stdint.h>
+#include <stddef.h>
+
+// usb_hid.h
+typedef enum
+{
+    USB_HID_KEY_RELEASED = 0,
+    USB_HID_KEY_PRESSED
+
+} USB_HID_KEY_EVENT;
+
+typedef uint8_t USB_HID_KEYBOARD_KEYPAD;
+
+#define USB_HID_KEYBOARD_KEYPAD_KEYBOARD_CAPS_LOCK          ((USB_HID_KEYBOARD_KEYPAD)0x39)
+#define USB_HID_KEYBOARD_KEYPAD_KEYBOARD_SCROLL_LOCK        ((USB_HID_KEYBOARD_KEYPAD)0x47)
+#define USB_HID_KEYBOARD_KEYPAD_KEYPAD_NUM_LOCK_AND_CLEAR   ((USB_HID_KEYBOARD_KEYPAD)0x53)
+
+// usb_host_hid.h
+typedef uintptr_t USB_HOST_HID_OBJ_HANDLE;
+
+typedef enum
+{
+    USB_HOST_HID_EVENT_ATTACH,
+    USB_HOST_HID_EVENT_DETACH,
+    USB_HOST_HID_EVENT_REPORT_RECEIVED,
+    USB_HOST_HID_EVENT_REPORT_SENT
+
+} USB_HOST_HID_EVENT;
+
+typedef void (*USB_HOST_HID_INTERFACE_EVENT_NOTIFY)(void);
+
+void USB_HOST_HID_InterfaceEventNotifySet(USB_HOST_HID_INTERFACE_EVENT_NOTIFY notify);
+
+// usb_host_hid_keyboard.h
+typedef uintptr_t USB_HOST_HID_KEYBOARD_HANDLE;
+
+typedef enum
+{
+    USB_HOST_HID_KEYBOARD_EVENT_ATTACH = 0,
+    USB_HOST_HID_KEYBOARD_EVENT_DETACH,
+    USB_HOST_HID_KEYBOARD_EVENT_REPORT_RECEIVED
+
+} USB_HOST_HID_KEYBOARD_EVENT;
+
+typedef enum
+{
+    USB_HOST_HID_KEYBOARD_RESULT_FAILURE = -50,
+    USB_HOST_HID_KEYBOARD_RESULT_INVALID_PARAMETER,
+    USB_HOST_HID_KEYBOARD_RESULT_REQUEST_BUSY,
+    USB_HOST_HID_KEYBOARD_RESULT_SUCCESS = 0
+
+} USB_HOST_HID_KEYBOARD_RESULT;
+
+typedef void (*USB_HOST_HID_KEYBOARD_EVENT_HANDLER)
+(
+    USB_HOST_HID_KEYBOARD_HANDLE handle,
+    USB_HOST_HID_KEYBOARD_EVENT event,
+    void * data
+);
+
+typedef struct
+{
+    USB_HID_KEY_EVENT event;
+    USB_HID_KEYBOARD_KEYPAD keyCode;
+    uint64_t sysCount;
+
+} USB_HOST_HID_KEYBOARD_NON_MODIFIER_KEYS_DATA;
+
+typedef struct
+{
+    uint8_t leftControl :1;
+    uint8_t leftShift :1;
+    uint8_t leftAlt :1;
+    uint8_t leftGui :1;
+    uint8_t rightControl :1;
+    uint8_t rightShift :1;
+    uint8_t rightAlt :1;
+    uint8_t rightGui :1;
+
+} USB_HID_KEYBOARD_MODIFIER_KEYS_DATA;
+
+typedef struct
+{
+    USB_HID_KEYBOARD_MODIFIER_KEYS_DATA modifierKeysData;
+    size_t nNonModifierKeysData;
+    USB_HOST_HID_KEYBOARD_NON_MODIFIER_KEYS_DATA nonModifierKeysData[6];
+
+} USB_HOST_HID_KEYBOARD_DATA;
+
+void USB_HOST_HID_KEYBOARD_EventHandler(USB_HOST_HID_OBJ_HANDLE handle,
+        USB_HOST_HID_EVENT event, void * eventData);
+USB_HOST_HID_KEYBOARD_RESULT USB_HOST_HID_KEYBOARD_EventHandlerSet(
+        USB_HOST_HID_KEYBOARD_EVENT_HANDLER appKeyboardEventHandler);
+USB_HOST_HID_KEYBOARD_RESULT USB_HOST_HID_KEYBOARD_ReportSend(
+        USB_HOST_HID_KEYBOARD_HANDLE handle, uint8_t outputReport);
+uint32_t USB_HOST_HID_KEYBOARD_DroppedReportsGet(USB_HOST_HID_KEYBOARD_HANDLE handle);
+void USB_HOST_HID_KEYBOARD_Task(USB_HOST_HID_OBJ_HANDLE handle);
+
+#endif /* _HOST_USB_HOST_HID_KEYBOARD_H */
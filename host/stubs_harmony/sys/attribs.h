@@ -0,0 +1,15 @@
+/*******************************************************************************
+  sys/attribs.h do alvo host
+
+  File Name:
+    attribs.h
+
+  Summary:
+    Vazio: o device.h do Harmony inclui, os fontes da pilha USB compilados
+    no host no declaram ISRs.
+*******************************************************************************/
+
+#ifndef _HOST_SYS_ATTRIBS_H
+#define _HOST_SYS_ATTRIBS_H
+
+#endif /* _HOST_SYS_ATTRIBS_H */
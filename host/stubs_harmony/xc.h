@@ -0,0 +1,15 @@
+/*******************************************************************************
+  xc.h do alvo host
+
+  File Name:
+    xc.h
+
+  Summary:
+    Vazio: o device.h do Harmony inclui, os fontes da pilha USB compilados
+    no host no mexem em registradores.
+*******************************************************************************/
+
+#ifndef _HOST_XC_H
+#define _HOST_XC_H
+
+#endif /* _HOST_XC_H */
@@ -28,8 +28,9 @@
 // *****************************************************************************
 #include <string.h>
 #include "app_display.h"
+#include "display_graficos.h"
 #include "config/default/peripheral/gpio/plib_gpio.h"
-#include "config/default/peripheral/coretimer/plib_coretimer.h"
+#include "config/default/peripheral/tmr/plib_tmr7.h"
 #include "FreeRTOS.h"
 #include "semphr.h"
 
@@ -40,10 +41,53 @@
 // Section: Global Data Definitions
 // *****************************************************************************
 // *****************************************************************************
-QueueHandle_t xLcdQueue;
-char lcd[4][20];
+// Dois quadros: os produtores (atualiza_lcd) sempre escrevem no traseiro e a
+// task do display desenha o frontal. Quando h quadro novo a task troca os
+// dois. Quadros intermedirios so simplesmente sobrescritos: s o mais
+// recente  desenhado e quem atualiza nunca fica bloqueado.
+static char lcd_quadros[2][4][20];
+static uint8_t lcd_traseiro = 0;        // ndice do quadro traseiro
+static bool lcd_novo_quadro = false;    // traseiro tem quadro ainda no desenhado
+
+// Cpia do que est escrito no vidro do LCD. S os caracteres que diferem
+// dela so enviados (cada byte ocupa ~50us do LCD)
+static char lcd_vidro[4][20];
+
+// Endereo DDRAM do incio de cada linha do LCD 20x4
+static const unsigned char lcd_endereco_linha[4] = { 0x00, 0x40, 0x14, 0x54 };
+
+// Fila de transmisso para o LCD, consumida pela ISR do TMR7.
+// Cada item: bits 0..7 = byte (ou ms de espera), mais as flags abaixo.
+// Um produtor (task do display) e um consumidor (ISR). LCD_TX_TAM tem de ser
+// potncia de 2 e no mximo 256 (ndices de 8 bits).
+#define LCD_TX_TAM              128U
+#define LCD_TX_RS               0x0100U     // dado (RS=1); sem ela  comando
+#define LCD_TX_NIBBLE           0x0200U     // s um nibble (init em 8 bits)
+#define LCD_TX_ESPERA           0x0400U     // no envia, espera bits 0..7 em ms
+#define LCD_TX_LENTO            0x0800U     // comando lento (clear/home)
+
+// TMR7 a 7,5MHz: PR7 = 299 d um tick de 40us, o tempo de execuo de um
+// comando (37us). Cada tick envia um byte inteiro.
+#define LCD_TX_PR7              299U
+#define LCD_TX_TICKS_MS         25U
+#define LCD_TX_TICKS_LENTO      38U         // +1 tick do prximo byte: 1,56ms > 1,52ms
+
+// Largura do pulso de EN e intervalo entre os dois pulsos de um byte, em
+// ticks do core timer (60MHz): 500ns > 450ns (PW_EH com VCC < 4,5V) e
+// ciclo de EN de 1us (tcycE)
+#define LCD_TX_EN_CORE          30U
+
+static uint16_t lcd_tx_fila[LCD_TX_TAM];
+static volatile uint8_t lcd_tx_escrita = 0;    // s a task altera
+static volatile uint8_t lcd_tx_leitura = 0;    // s a ISR altera
+static volatile bool lcd_tx_parado = true;     // TMR7 parado (fila vazia)
+static volatile bool lcd_tx_esperando = false; // task esperando a ISR
+static uint16_t lcd_tx_espera = 0;             // ticks at o prximo item
 
 bool reiniciar_lcd; 
+
+TaskHandle_t xAPP_DISPLAY_Tasks;    // Handle do lcd. Usado por atualiza_lcd (quadro novo) e pela
+				    // ISR do TMR7 (fila de transmisso liberada) para notificar a task.
 // *****************************************************************************
 /* Application Data
 
@@ -67,8 +111,8 @@ bool reiniciar_lcd;
 // *****************************************************************************
 // *****************************************************************************
 
-/* TODO:  Add any necessary callback functions.
-*/
+// Tick do escritor do LCD (TMR7)
+static void LCD_TMR7Callback(uint32_t status, uintptr_t context);
 
 // *****************************************************************************
 // *****************************************************************************
@@ -98,10 +142,184 @@ bool reiniciar_lcd;
 void APP_DISPLAY_Initialize ( void )
 {
     reiniciar_lcd = false;
-    memset(lcd, ' ', sizeof(lcd));
-    // Cria a fila de eventos de atualizao do display
-    xLcdQueue = xQueueCreate(10, sizeof(lcd));
-    configASSERT(xLcdQueue != NULL);
+    memset(lcd_quadros, ' ', sizeof(lcd_quadros));
+    memset(lcd_vidro, ' ', sizeof(lcd_vidro));
+    lcd_traseiro = 0;
+    lcd_novo_quadro = false;
+
+    // TMR7  o relgio do escritor do LCD. S roda enquanto h o que enviar
+    TMR7_Stop();
+    TMR7_PeriodSet(LCD_TX_PR7);
+    TMR7_CallbackRegister(LCD_TMR7Callback, 0);
+    lcd_tx_parado = true;
+}
+
+/* lcd_pega_quadro()
+ * Se h quadro novo, troca frontal/traseiro e retorna o frontal (que a task
+ * pode ler sem trava). Retorna NULL se no h nada novo.
+ */
+static char (*lcd_pega_quadro(void))[20]
+{
+    char (*frontal)[20] = NULL;
+
+    taskENTER_CRITICAL();
+    if (lcd_novo_quadro)
+    {
+        frontal = lcd_quadros[lcd_traseiro];
+        lcd_traseiro ^= 1U;
+        lcd_novo_quadro = false;
+    }
+    taskEXIT_CRITICAL();
+
+    return frontal;
+}
+
+/* lcd_tx_poe()
+ * Coloca um item na fila de transmisso do LCD e liga o TMR7 se ele estava
+ * parado. Se a fila estiver cheia, a task espera o TMR7 consumir.
+ */
+static void lcd_tx_poe(uint16_t item)
+{
+    while ((uint8_t)(lcd_tx_escrita - lcd_tx_leitura) >= LCD_TX_TAM)
+    {
+        lcd_tx_esperando = true;
+        (void)ulTaskNotifyTake(pdTRUE, pdMS_TO_TICKS(10));
+    }
+
+    // Seo crtica mascara o TMR7 (prioridade 2, abaixo de
+    // configMAX_SYSCALL_INTERRUPT_PRIORITY)
+    taskENTER_CRITICAL();
+    lcd_tx_fila[lcd_tx_escrita & (LCD_TX_TAM - 1U)] = item;
+    lcd_tx_escrita++;
+    if (lcd_tx_parado)
+    {
+        lcd_tx_parado = false;
+        TMR7_Start();
+    }
+    taskEXIT_CRITICAL();
+}
+
+/* lcd_tx_espera_vazio()
+ * Espera o TMR7 terminar de enviar tudo o que est na fila.
+ */
+static void lcd_tx_espera_vazio(void)
+{
+    while (!lcd_tx_parado)
+    {
+        lcd_tx_esperando = true;
+        (void)ulTaskNotifyTake(pdTRUE, pdMS_TO_TICKS(10));
+    }
+}
+
+/* lcd_tx_linhas_dados()
+ * Coloca um nibble (4 bits menos significativos) nas linhas D4..D7.
+ */
+static void lcd_tx_linhas_dados(uint8_t n)
+{
+	PINO_LCD_D4_OUT=(n&0x01);
+	PINO_LCD_D5_OUT=(n&0x02)>>1;
+	PINO_LCD_D6_OUT=(n&0x04)>>2;
+	PINO_LCD_D7_OUT=(n&0x08)>>3;
+}
+
+/* lcd_tx_aguarda_core()
+ * Espera ativa de alguns ticks do core timer (fraes de microssegundo).
+ */
+static void lcd_tx_aguarda_core(uint32_t ticks)
+{
+    uint32_t inicio = _CP0_GET_COUNT();
+
+    while ((_CP0_GET_COUNT() - inicio) < ticks)
+    {
+    }
+}
+
+/* lcd_tx_pulso_en()
+ * Nibble nas linhas D4..D7 e um pulso de EN: o LCD l na borda de descida.
+ */
+static void lcd_tx_pulso_en(uint8_t nibble)
+{
+    lcd_tx_linhas_dados(nibble);
+    PINO_LCD_EN = 1;
+    lcd_tx_aguarda_core(LCD_TX_EN_CORE);
+    PINO_LCD_EN = 0;
+}
+
+/* LCD_TMR7Callback()
+ * Escritor HD44780 em 4 bits. A cada tick do TMR7 (40us) envia um item da
+ * fila inteiro: RS, nibble alto com pulso de EN, nibble baixo com pulso de
+ * EN. O prximo tick j respeita o tempo de execuo do LCD (37us); clear,
+ * home e as esperas do init pulam ticks. Com a fila vazia o TMR7 para.
+ *
+ * Custo: uma interrupo de ~2us (dois pulsos de 500ns, o intervalo de 500ns
+ * entre eles e a entrada/sada da ISR) por byte. Um quadro inteiro (80
+ * caracteres + 4 endereos) sai em 3,4ms com ~170us de CPU; antes eram 7
+ * interrupes por byte, uma a cada 10us. O tempo real aparece no comando
+ * 'isr' do console (vetor TMR7).
+ */
+static void LCD_TMR7Callback(uint32_t status, uintptr_t context)
+{
+    BaseType_t xHigherPriorityTaskWoken = pdFALSE;
+    uint16_t item;
+
+    (void)status;
+    (void)context;
+
+    if (lcd_tx_espera != 0U)
+    {
+        lcd_tx_espera--;
+        return;
+    }
+
+    if (lcd_tx_leitura == lcd_tx_escrita)
+    {
+        // Nada mais a enviar: para o timer e acorda quem espera
+        TMR7_Stop();
+        lcd_tx_parado = true;
+        if (lcd_tx_esperando)
+        {
+            lcd_tx_esperando = false;
+            vTaskNotifyGiveFromISR(xAPP_DISPLAY_Tasks, &xHigherPriorityTaskWoken);
+        }
+        portEND_SWITCHING_ISR(xHigherPriorityTaskWoken);
+        return;
+    }
+
+    item = lcd_tx_fila[lcd_tx_leitura & (LCD_TX_TAM - 1U)];
+    lcd_tx_leitura++;
+
+    // Libera espao para a task assim que houver
+    if (lcd_tx_esperando)
+    {
+        lcd_tx_esperando = false;
+        vTaskNotifyGiveFromISR(xAPP_DISPLAY_Tasks, &xHigherPriorityTaskWoken);
+    }
+
+    if ((item & LCD_TX_ESPERA) != 0U)
+    {
+        lcd_tx_espera = (uint16_t)(item & 0xFFU) * LCD_TX_TICKS_MS;
+    }
+    else
+    {
+        PINO_LCD_RS = ((item & LCD_TX_RS) != 0U);   //RS=0 - Escreve um endereo / RS=1 - Escreve um dado
+        PINO_LCD_RW = 0;                            //RW=0 - Escrita
+        if ((item & LCD_TX_NIBBLE) != 0U)
+        {
+            lcd_tx_pulso_en(item & 0x0FU);
+        }
+        else
+        {
+            lcd_tx_pulso_en((item >> 4) & 0x0FU);
+            lcd_tx_aguarda_core(LCD_TX_EN_CORE);
+            lcd_tx_pulso_en(item & 0x0FU);
+        }
+
+        // Clear display e return home: 1,52ms de execuo
+        if ((item & LCD_TX_LENTO) != 0U)
+            lcd_tx_espera = LCD_TX_TICKS_LENTO;
+    }
+
+    portEND_SWITCHING_ISR(xHigherPriorityTaskWoken);
 }
 
 /*
@@ -113,98 +331,67 @@ void APP_DISPLAY_Initialize ( void )
 */
 void lcd_send_nibble(char n) 
 {
-	PINO_LCD_D4_OUT=(n&0x01);
-	PINO_LCD_D5_OUT=(n&0x02)>>1;
-	PINO_LCD_D6_OUT=(n&0x04)>>2;
-	PINO_LCD_D7_OUT=(n&0x08)>>3;
-
-	//delay_us(10);
-	CORETIMER_DelayUs(6);	// Alterei depois de corrigir a preciso do tempo de delay
-   
-	PINO_LCD_EN=1;
-	//delay_us(20);	
-	CORETIMER_DelayUs(12);	// Alterei depois de corrigir a preciso do tempo de delay
- 	PINO_LCD_EN=0;
+	lcd_tx_poe(LCD_TX_NIBBLE | ((uint8_t)n & 0x0FU));
 }
 
 /*
    lcd_send_byte(char _rs, char n)
    
-   Envia um byte (um nibble por vez) ao LCD
+   Envia um byte (um nibble por vez) ao LCD. S coloca na fila: quem envia
+    o TMR7 (LCD_TMR7Callback)
    
    _rs: Valor a ser enviado ao pino RS
    n: O byte
 */
 void lcd_send_byte(char _rs, char n)
 {
-	unsigned char lsn,msn;
+	uint16_t item = (uint8_t)n;
 
 	// Se for um null character, troca por um espao em branco
 	if (n=='\0')
-	    n=' ';
-
-	CORETIMER_DelayUs(64);	// Alterei depois de corrigir a preciso do tempo de delay
-	PINO_LCD_EN=0;
-	PINO_LCD_RS=_rs;	//RS=0 - Escreve um endereo / RS=1 - Escreve um dado
-	PINO_LCD_RW=0;		//RW=0 - Escrita
-	
-	// Espera Tas = 30ns
-	DELAY_25NS();
-	DELAY_25NS();
-	
-	// Manda nibble menos significativo
-	lsn=n >> 4;
-	PINO_LCD_D4_OUT=(lsn&0x01);
-	PINO_LCD_D5_OUT=(lsn&0x02)>>1;
-	PINO_LCD_D6_OUT=(lsn&0x04)>>2;
-	PINO_LCD_D7_OUT=(lsn&0x08)>>3;
-	PINO_LCD_EN=1;
-
-	// Espera Tpw = 150ns 
-	DELAY_250NS();	// Mudei de 200ns para 400ns para ficar igual ao pulso que aparece no HGI7000 de 250ns - Assim ele funciona com o WINSTAR WH2004L-YYH-JTE#
-	
-	PINO_LCD_EN=0;
-
-	// Antes de iniciar o prximo ciclo, espera at completar Tc=400ns
-	DELAY_200NS();
-	DELAY_200NS();
-	
-	// Manda nibble mais significativo
-	msn=n & 0xf;
-	PINO_LCD_D4_OUT=(msn&0x01);
-	PINO_LCD_D5_OUT=(msn&0x02)>>1;
-	PINO_LCD_D6_OUT=(msn&0x04)>>2;
-	PINO_LCD_D7_OUT=(msn&0x08)>>3;
-	PINO_LCD_EN=1;
-
-	// Espera Tpw = 150ns
-	DELAY_250NS();	// Mudei de 200ns para 400ns para ficar igual ao pulso que aparece no HGI7000 de 250ns - Assim ele funciona com o WINSTAR WH2004L-YYH-JTE#
-	
-	PINO_LCD_EN=0;
-
-	// Antes de iniciar o prximo ciclo, espera at completar Tc=400ns
-	DELAY_200NS();
-	DELAY_200NS();
+	    item = ' ';
+
+	if (_rs)
+	    item |= LCD_TX_RS;
+	// Clear display e return home demoram 1,52ms
+	else if ((uint8_t)n <= 0x03U)
+	    item |= LCD_TX_LENTO;
+
+	lcd_tx_poe(item);
+}
+
+/* lcd_espera_ms()
+ * Espera 'ms' entre dois itens da fila (no bloqueia a task).
+ */
+static void lcd_espera_ms(uint8_t ms)
+{
+	lcd_tx_poe(LCD_TX_ESPERA | ms);
 }
 
 /*
    lcd_init()
    
-   Inicia o LCD no modo 4 bits
+   Inicia o LCD no modo 4 bits. A sequncia inteira vai para a fila do TMR7
+   (com as esperas como itens da fila), ento a funo retorna logo.
 */
 void lcd_init()
 {
+    uint32_t i;
+
+    // No mexe nos pinos no meio de uma transmisso
+    lcd_tx_espera_vazio();
+
     PINO_LCD_RS=0;
     PINO_LCD_EN=0;
     PINO_LCD_RW=0;
-    CORETIMER_DelayMs(10);
+    lcd_espera_ms(10);
 
     lcd_send_nibble(3);
-    CORETIMER_DelayMs(5);
+    lcd_espera_ms(5);
     lcd_send_nibble(3);
-    CORETIMER_DelayMs(5);
+    lcd_espera_ms(5);
     lcd_send_nibble(3);
-    CORETIMER_DelayMs(5);
+    lcd_espera_ms(5);
 
     lcd_send_nibble(2);
 
@@ -214,8 +401,69 @@ void lcd_init()
     lcd_send_byte(0, 0x1);	// Clear display
     lcd_send_byte(0, 0x6);	// shift right
 
+    // Glifos dos grficos na CGRAM (endereo 0, 8 caracteres de 8 linhas).
+    // Vai em todo lcd_init para sobreviver a uma reinicializao do LCD.
+    // Direto na fila: lcd_send_byte trocaria as linhas 0x00 por espao.
+    lcd_send_byte(0, 0x40);
+    for (i = 0; i < sizeof(DISPLAY_GRAF_Glifos); i++)
+        lcd_tx_poe(LCD_TX_RS | DISPLAY_GRAF_Glifos[i / 8U][i % 8U]);
+    lcd_send_byte(0, 0x80);	// volta para a DDRAM
+
     // Espera um pouco antes de poder escrever
-    CORETIMER_DelayMs(10);
+    lcd_espera_ms(10);
+
+    // Clear: nada escrito no vidro
+    memset(lcd_vidro, ' ', sizeof(lcd_vidro));
+}
+
+/* lcd_atualiza_diferencas()
+ * Compara o quadro novo com lcd_vidro e envia, linha a linha, s os trechos
+ * que mudaram: um comando de endereo DDRAM e depois os caracteres. Trechos
+ * separados por um nico caractere igual so enviados juntos, que custa o
+ * mesmo que um novo endereo.
+ */
+static void lcd_atualiza_diferencas(char novo[4][20])
+{
+    unsigned char linha, col, fim;
+
+    for (linha = 0; linha < 4; linha++)
+    {
+        // '\0' aparece como espao (ver lcd_send_byte)
+        for (col = 0; col < 20; col++)
+        {
+            if (novo[linha][col] == '\0')
+                novo[linha][col] = ' ';
+        }
+
+        col = 0;
+        while (col < 20)
+        {
+            if (novo[linha][col] == lcd_vidro[linha][col])
+            {
+                col++;
+                continue;
+            }
+
+            // Acha o fim do trecho alterado (tolerando 1 caractere igual)
+            fim = col + 1U;
+            while (fim < 20)
+            {
+                if (novo[linha][fim] != lcd_vidro[linha][fim])
+                    fim++;
+                else if ((fim + 1U < 20U) && (novo[linha][fim + 1U] != lcd_vidro[linha][fim + 1U]))
+                    fim += 2U;
+                else
+                    break;
+            }
+
+            lcd_send_byte(0, 0x80 | (lcd_endereco_linha[linha] + col));
+            for (; col < fim; col++)
+            {
+                lcd_send_byte(1, novo[linha][col]);
+                lcd_vidro[linha][col] = novo[linha][col];
+            }
+        }
+    }
 }
 
 /******************************************************************************
@@ -226,15 +474,12 @@ void lcd_init()
     See prototype in app_display.h.
  */
 
-TaskHandle_t xAPP_DISPLAY_Tasks;    // Handle do lcd. Posso usar para notificao ou identificao da task.
-				    // At o momento sem uso.
-
 void APP_DISPLAY_Tasks ( void )
 {
     // Guarda o handle desta task para outra poder notific-la
     xAPP_DISPLAY_Tasks = xTaskGetCurrentTaskHandle();
     
-    unsigned char loop;
+    char (*quadro)[20];
 
     // Configura o lcd
     lcd_init();
@@ -247,34 +492,35 @@ void APP_DISPLAY_Tasks ( void )
             reiniciar_lcd = false;
             lcd_init();
         }
-        if (xQueueReceive(xLcdQueue, lcd, portMAX_DELAY) == pdTRUE)
+        quadro = lcd_pega_quadro();
+        if (quadro != NULL)
         {
-            lcd_send_byte(0, 0x28);	
-
-            for (loop=0 ; loop<20 ; loop++)
-            lcd_send_byte(1, lcd[0][loop]);
-
-            for (loop=0 ; loop<20 ; loop++)
-            lcd_send_byte(1, lcd[2][loop]);
-
-            for (loop=0 ; loop<20 ; loop++)
-            lcd_send_byte(1, lcd[1][loop]);
-
-            for (loop=0 ; loop<20 ; loop++)
-            lcd_send_byte(1, lcd[3][loop]);
+            // S envia o que mudou em relao ao que j est no vidro
+            lcd_atualiza_diferencas(quadro);
+        }
+        else
+        {
+            // Dorme at atualiza_lcd avisar que h quadro novo
+            (void)ulTaskNotifyTake(pdTRUE, portMAX_DELAY);
         }
     }
 }
 
 /* atualiza_lcd()
- * Coloca uma atualizao na fila de atualizaes do lcd.
- * Assim no gera concorrncia caso mais de uma task tente
- * atualizar.
+ * Copia o quadro para o buffer traseiro e avisa a task do display.
+ * No bloqueia: se a task ainda no desenhou o quadro anterior, ele 
+ * substitudo por este. A cpia  feita em seo crtica, ento mais de uma
+ * task pode atualizar sem concorrncia.
  */
 void atualiza_lcd(char* x_lcd)
 {
-    // Coloca a atualizao do lcd na fila
-    xQueueSend(xLcdQueue, x_lcd, portMAX_DELAY);
+    taskENTER_CRITICAL();
+    memcpy(lcd_quadros[lcd_traseiro], x_lcd, sizeof(lcd_quadros[0]));
+    lcd_novo_quadro = true;
+    taskEXIT_CRITICAL();
+
+    if (xAPP_DISPLAY_Tasks != NULL)
+        xTaskNotifyGive(xAPP_DISPLAY_Tasks);
     return;
 }
 
@@ -39,80 +39,6 @@ static uint8_t  s_lastKey = 0;
 static uint32_t s_lastKeyTime = 0;
 static const uint32_t KBD_DEBOUNCE_MS = 200U;   // mnimo entre ?toques?
 
-/* Usage ID to Key map table */
-const char *keyValue[] = { 
-                          "No event indicated",
-                          "ErrorRoll Over",
-                          "POSTFail",
-                          "Error Undefined",
-                          "a",
-                          "b",
-                          "c",
-                          "d",
-                          "e",
-                          "f",
-                          "g",
-                          "h",
-                          "i",
-                          "j",
-                          "k",
-                          "l",
-                          "m",
-                          "n",
-                          "o",
-                          "p",
-                          "q",
-                          "r",
-                          "s",
-                          "t",
-                          "u",
-                          "v",
-                          "w",
-                          "x",
-                          "y",
-                          "z",
-                          "1",
-                          "2",
-                          "3",
-                          "4",
-                          "5",
-                          "6",
-                          "7",
-                          "8",
-                          "9",
-                          "0",
-                          "ENTER",
-                          "ESCAPE",
-                          "BACKSPACE",
-                          "TAB",
-                          "SPACEBAR",
-                          "-",
-                          "=",
-                          "[",
-                          "]",
-                          "\\0",
-                          "~",
-                          ";",
-                          "'",
-                          "GRAVE ACCENT",
-                          ",",
-                          ".",
-                          "/",
-                          "CAPS LOCK",
-                          "F1",
-                          "F2",
-                          "F3",
-                          "F4",
-                          "F5",
-                          "F6",
-                          "F7",
-                          "F8",
-                          "F9",
-                          "F10",
-                          "F11",
-                          "F12"
-                      };
-
 // *****************************************************************************
 /* Application Data
 
@@ -130,6 +56,30 @@ const char *keyValue[] = {
 
 APP_USB_DATA app_usbData;
 
+// Servio do host USB por eventos (ver app_usb.h). 'g_usbConexao' pede uma
+// janela de servio nova; 'g_usbEnumerando' estica a janela at o teclado
+// aparecer (ou o dispositivo ser recusado)
+static volatile bool g_usbConexao = true;
+static volatile bool g_usbEnumerando = false;
+static TickType_t g_usbJanelaInicio;    // s a task do host usa
+
+// Anel de teclas (ver app_usb.h): o callback do teclado, na task do host, s
+// avana g_teclaEscrita e a APP_USB_Tasks s avana g_teclaLeitura. Os
+// ndices correm livres e o anel tem tamanho potncia de 2.
+static APP_USB_TECLA g_teclas[APP_USB_TECLAS_ANEL];
+static volatile uint32_t g_teclaEscrita = 0;
+static volatile uint32_t g_teclaLeitura = 0;
+static volatile uint32_t g_teclasPerdidas = 0;
+static uint8_t g_teclasAntes[6];        // apertadas no relatrio anterior
+
+// Barreira de compilador entre a tecla e o ndice (ncleo nico)
+#define APP_USB_BARREIRA()      __asm__ volatile ("" ::: "memory")
+
+// Quem recebe as linhas do leitor
+static APP_USB_LINHA_CALLBACK g_linhaCallback = NULL;
+static uintptr_t g_linhaContext = 0;
+
+
 // *****************************************************************************
 // *****************************************************************************
 // Section: Application Callback Functions
@@ -139,11 +89,116 @@ APP_USB_DATA app_usbData;
  * USB HOST Layer Events - Host Event Handler
  *******************************************************/
 
+/* APP_USB_Acorda()
+ * Notifica a task, de dentro ou de fora de interrupo.
+ */
+static void APP_USB_Acorda(TaskHandle_t tarefa)
+{
+    BaseType_t xHigherPriorityTaskWoken = pdFALSE;
+
+    if (tarefa == NULL)
+        return;
+
+    if (uxInterruptNesting != 0U)
+    {
+        vTaskNotifyGiveFromISR(tarefa, &xHigherPriorityTaskWoken);
+        portEND_SWITCHING_ISR(xHigherPriorityTaskWoken);
+    }
+    else
+    {
+        (void)xTaskNotifyGive(tarefa);
+    }
+}
+
+/* APP_USB_HostEvento()
+ * Abre uma janela de servio da task do host (mudana no barramento).
+ */
+static void APP_USB_HostEvento(void)
+{
+    g_usbConexao = true;
+    APP_USB_Acorda(xUSB_HOST_Tasks);
+}
+
+void APP_USB_HostAcordaFromISR(uint32_t flags)
+{
+    if ((flags & APP_USB_INT_ATTACH) != 0U)
+        g_usbEnumerando = true;
+    if ((flags & APP_USB_INT_DETACH) != 0U)
+        g_usbEnumerando = false;
+
+    APP_USB_HostEvento();
+}
+
+TickType_t APP_USB_HostEspera(void)
+{
+    TickType_t agora = xTaskGetTickCount();
+    TickType_t janela;
+
+    if (g_usbConexao)
+    {
+        g_usbConexao = false;
+        g_usbJanelaInicio = agora;
+    }
+
+    janela = g_usbEnumerando ? pdMS_TO_TICKS(APP_USB_ENUMERACAO_MS) : pdMS_TO_TICKS(APP_USB_JANELA_MS);
+    if ((agora - g_usbJanelaInicio) < janela)
+        return pdMS_TO_TICKS(APP_USB_PERIODO_MS);
+
+    // Janela vencida (inclusive enumerao que no terminou no prazo):
+    // espera o prximo attach/detach
+    return portMAX_DELAY;
+}
+
+TickType_t APP_USB_Espera(void)
+{
+    switch (app_usbData.state)
+    {
+        // Esperando teclado ou relatrio: s acorda por notificao
+        case APP_USB_STATE_WAIT_FOR_DEVICE_ATTACH:
+        case APP_USB_STATE_WAIT_FOR_REPORT:
+        case APP_USB_STATE_ERROR:
+            return portMAX_DELAY;
+
+        default:
+            return pdMS_TO_TICKS(APP_USB_PERIODO_MS);
+    }
+}
+
+/* APP_USB_HidInterfaceEvento()
+ * Chamada pela camada HID ao fim de cada transferncia e de cada limpeza de
+ * halt, s vezes de dentro da ISR USB. Depois de um STALL a interface passa
+ * por INTERRUPT_IN_ENDPOINT_CLEAR e volta a READY sem evento nenhum no
+ * driver do teclado: sem esta notificao o pedido IN s seria reenviado
+ * no prximo attach.
+ */
+static void APP_USB_HidInterfaceEvento(void)
+{
+    APP_USB_Acorda(xUSB_HOST_Tasks);
+}
+
+void APP_USB_HIDKeyboardEventHandler(USB_HOST_HID_OBJ_HANDLE handle,
+        USB_HOST_HID_EVENT event, void * eventData)
+{
+    USB_HOST_HID_KEYBOARD_EventHandler(handle, event, eventData);
+
+    // Teclado pronto ou removido: termina a enumerao, mas a camada HID
+    // ainda precisa de algumas passadas (primeiro pedido IN, limpeza)
+    if ((event == USB_HOST_HID_EVENT_ATTACH) || (event == USB_HOST_HID_EVENT_DETACH))
+    {
+        g_usbEnumerando = false;
+        g_usbConexao = true;
+    }
+
+    APP_USB_Acorda(xUSB_HOST_Tasks);
+}
+
 USB_HOST_EVENT_RESPONSE APP_USBHostEventHandler (USB_HOST_EVENT event, void * eventData, uintptr_t context)
 {
     switch(event)
     {
         case USB_HOST_EVENT_DEVICE_UNSUPPORTED:
+            // Dispositivo que no  teclado: no h o que esperar
+            g_usbEnumerando = false;
             break;
         default:
             break;
@@ -151,6 +206,55 @@ USB_HOST_EVENT_RESPONSE APP_USBHostEventHandler (USB_HOST_EVENT event, void * ev
     return USB_HOST_EVENT_RESPONSE_NONE;
 }
 
+/* APP_USB_TeclasEnfileira()
+ * Pe no anel, na ordem, as teclas que o relatrio traz apertadas e que no
+ * estavam no relatrio anterior (uma tecla segura no se repete). Com o anel
+ * cheio a tecla  contada em g_teclasPerdidas e descartada: as que j esto
+ * no anel no so sobrescritas.
+ */
+static void APP_USB_TeclasEnfileira(const USB_HOST_HID_KEYBOARD_DATA *dados)
+{
+    APP_USB_TECLA *tecla;
+    uint8_t agora[6] = {0};
+    uint8_t keyCode;
+    uint8_t modificadores = 0;
+    uint32_t i, j, n = 0;
+
+    if ((dados->modifierKeysData.leftShift != 0U) || (dados->modifierKeysData.rightShift != 0U))
+        modificadores |= TECLADO_MOD_SHIFT;
+    if (dados->modifierKeysData.rightAlt != 0U)
+        modificadores |= TECLADO_MOD_ALTGR;
+
+    for (i = 0; i < dados->nNonModifierKeysData; i++)
+    {
+        if (dados->nonModifierKeysData[i].event != USB_HID_KEY_PRESSED)
+            continue;
+        keyCode = (uint8_t)dados->nonModifierKeysData[i].keyCode;
+        if (n < sizeof(agora))
+            agora[n++] = keyCode;
+
+        for (j = 0; j < sizeof(g_teclasAntes); j++)
+        {
+            if (g_teclasAntes[j] == keyCode)
+                break;
+        }
+        if (j < sizeof(g_teclasAntes))
+            continue;
+
+        if ((uint32_t)(g_teclaEscrita - g_teclaLeitura) >= APP_USB_TECLAS_ANEL)
+        {
+            g_teclasPerdidas++;
+            continue;
+        }
+        tecla = &g_teclas[g_teclaEscrita & (APP_USB_TECLAS_ANEL - 1U)];
+        tecla->keyCode = keyCode;
+        tecla->modificadores = modificadores;
+        APP_USB_BARREIRA();
+        g_teclaEscrita++;
+    }
+    memcpy(g_teclasAntes, agora, sizeof(g_teclasAntes));
+}
+
 /*******************************************************
  * USB HOST HID Layer Events - Application Event Handler
  *******************************************************/
@@ -158,7 +262,6 @@ USB_HOST_EVENT_RESPONSE APP_USBHostEventHandler (USB_HOST_EVENT event, void * ev
 void APP_USBHostHIDKeyboardEventHandler(USB_HOST_HID_KEYBOARD_HANDLE handle, 
         USB_HOST_HID_KEYBOARD_EVENT event, void * pData)
 {   
-    UART2_Write("\r\nest11", 7);
     switch ( event)
     {
         case USB_HOST_HID_KEYBOARD_EVENT_ATTACH:
@@ -173,6 +276,10 @@ void APP_USBHostHIDKeyboardEventHandler(USB_HOST_HID_KEYBOARD_HANDLE handle,
             app_usbData.scrollLockPressed = false;
             app_usbData.numLockPressed = false;
             app_usbData.outputReport = 0;
+            app_usbData.linhaTam = 0;
+            app_usbData.prefixoVisto = false;
+            memset(g_teclasAntes, 0, sizeof(g_teclasAntes));
+            TECLADO_Reset();
 //			LED1_On();
             break;
 
@@ -189,19 +296,25 @@ void APP_USBHostHIDKeyboardEventHandler(USB_HOST_HID_KEYBOARD_HANDLE handle,
             app_usbData.scrollLockPressed = false;
             app_usbData.numLockPressed = false;
             app_usbData.outputReport = 0;
+            memset(g_teclasAntes, 0, sizeof(g_teclasAntes));
+            TECLADO_Reset();
 //			LED1_Off();
             break;
 
         case USB_HOST_HID_KEYBOARD_EVENT_REPORT_RECEIVED:
+            // O estado  da APP_USB_Tasks: aqui o relatrio s entra no anel
             app_usbData.handle = handle;
-            app_usbData.state = APP_USB_STATE_READ_HID;
             /* Keyboard Data from device */
             memcpy(&app_usbData.data, pData, sizeof(app_usbData.data));
+            APP_USB_TeclasEnfileira(&app_usbData.data);
             break;
 
         default:
             break;
     }
+
+    // Chamado na task do host: passa o evento para a APP_USB_Tasks
+    APP_USB_Acorda(xAPP_USB_Tasks);
     return;
 }
 
@@ -210,97 +323,226 @@ void APP_USBHostHIDKeyboardEventHandler(USB_HOST_HID_KEYBOARD_HANDLE handle,
 // Section: Application Local Functions
 // *****************************************************************************
 // *****************************************************************************
-void APP_MapKeyToUsage(USB_HID_KEYBOARD_KEYPAD keyCode)
+void APP_MapKeyToUsage(USB_HID_KEYBOARD_KEYPAD keyCode, uint8_t modificadores)
 {
     uint8_t outputReport = 0;
+    char c[TECLADO_CARACTERES_MAX];
+    uint32_t i, n;
     
     outputReport = app_usbData.outputReport;
     
-    if((keyCode >= USB_HID_KEYBOARD_KEYPAD_KEYBOARD_A &&
-            keyCode <= USB_HID_KEYBOARD_KEYPAD_KEYBOARD_0_AND_CLOSE_PARENTHESIS) || 
-            (keyCode == USB_HID_KEYBOARD_KEYPAD_KEYBOARD_CAPS_LOCK) || 
+    if((keyCode == USB_HID_KEYBOARD_KEYPAD_KEYBOARD_CAPS_LOCK) || 
             (keyCode == USB_HID_KEYBOARD_KEYPAD_KEYBOARD_SCROLL_LOCK) || 
             (keyCode == USB_HID_KEYBOARD_KEYPAD_KEYPAD_NUM_LOCK_AND_CLEAR))
     {
-        if(keyCode >= USB_HID_KEYBOARD_KEYPAD_KEYBOARD_A &&
-            keyCode <= USB_HID_KEYBOARD_KEYPAD_KEYBOARD_0_AND_CLOSE_PARENTHESIS)
+        if(keyCode == USB_HID_KEYBOARD_KEYPAD_KEYBOARD_CAPS_LOCK)
         {
-            memcpy(&app_usbData.string[app_usbData.currentOffset], keyValue[keyCode],
-                            strlen(keyValue[keyCode]));
+            /* CAPS LOCK pressed */
+            if(app_usbData.capsLockPressed == false)
+            {
+                app_usbData.capsLockPressed = true;
+                outputReport = outputReport | 0x2;
+            }
+            else
+            {
+                app_usbData.capsLockPressed = false;
+                outputReport = outputReport & 0xFD;
+            }
         }
-        else
+        if(keyCode == USB_HID_KEYBOARD_KEYPAD_KEYBOARD_SCROLL_LOCK)
         {
-            if(keyCode == USB_HID_KEYBOARD_KEYPAD_KEYBOARD_CAPS_LOCK)
+            /* SCROLL LOCK pressed */
+            if(app_usbData.scrollLockPressed == false)
             {
-                /* CAPS LOCK pressed */
-                if(app_usbData.capsLockPressed == false)
-                {
-                    app_usbData.capsLockPressed = true;
-                    outputReport = outputReport | 0x2;
-                }
-                else
-                {
-                    app_usbData.capsLockPressed = false;
-                    outputReport = outputReport & 0xFD;
-                }
+                app_usbData.scrollLockPressed = true;
+                outputReport = outputReport | 0x4;
             }
-            if(keyCode == USB_HID_KEYBOARD_KEYPAD_KEYBOARD_SCROLL_LOCK)
+            else
             {
-                /* SCROLL LOCK pressed */
-                if(app_usbData.scrollLockPressed == false)
-                {
-                    app_usbData.scrollLockPressed = true;
-                    outputReport = outputReport | 0x4;
-                }
-                else
-                {
-                    app_usbData.scrollLockPressed = false;
-                    outputReport = outputReport & 0xFB;
-                }
+                app_usbData.scrollLockPressed = false;
+                outputReport = outputReport & 0xFB;
+            }
+        }
+        if(keyCode == USB_HID_KEYBOARD_KEYPAD_KEYPAD_NUM_LOCK_AND_CLEAR)
+        {
+            /* NUM LOCK pressed */
+            if(app_usbData.numLockPressed == false)
+            {
+                app_usbData.numLockPressed = true;
+                outputReport = outputReport | 0x1;
             }
-            if(keyCode == USB_HID_KEYBOARD_KEYPAD_KEYPAD_NUM_LOCK_AND_CLEAR)
+            else
             {
-                /* NUM LOCK pressed */
-                if(app_usbData.numLockPressed == false)
-                {
-                    app_usbData.numLockPressed = true;
-                    outputReport = outputReport | 0x1;
-                }
-                else
-                {
-                    app_usbData.numLockPressed = false;
-                    outputReport = outputReport & 0xFE;
-                }
+                app_usbData.numLockPressed = false;
+                outputReport = outputReport & 0xFE;
             }
-            
-            /* Store the changes */
-            app_usbData.outputReport = outputReport;
-            /* Send the OUTPUT Report */
-            USB_HOST_HID_KEYBOARD_ReportSend(app_usbData.handle, outputReport);
         }
-        if(app_usbData.capsLockPressed && (app_usbData.data.modifierKeysData.leftShift ||
-                app_usbData.data.modifierKeysData.rightShift))
+        
+        /* Store the changes */
+        app_usbData.outputReport = outputReport;
+        /* Send the OUTPUT Report */
+        USB_HOST_HID_KEYBOARD_ReportSend(app_usbData.handle, outputReport);
+        /* O SET_REPORT termina na task do host */
+        APP_USB_HostEvento();
+        return;
+    }
+    
+    // Caracteres do layout atual (CAPS LOCK e acentos tratados na tabela).
+    // BACKSPACE apaga; os outros controles no aparecem na tela
+    n = TECLADO_Traduz((uint8_t)keyCode, modificadores, app_usbData.capsLockPressed, c);
+    for (i = 0; i < n; i++)
+    {
+        if (c[i] == TECLADO_BACKSPACE)
         {
-            /* Small case should be displayed */
+            if (app_usbData.currentOffset > 0U)
+                app_usbData.currentOffset--;
         }
-        /* Check if it is within a - z */
-        else if((app_usbData.capsLockPressed || app_usbData.data.modifierKeysData.leftShift ||
-                app_usbData.data.modifierKeysData.rightShift) &&
-                (keyCode >= USB_HID_KEYBOARD_KEYPAD_KEYBOARD_A &&
-                keyCode <= USB_HID_KEYBOARD_KEYPAD_KEYBOARD_Z))
+        else if (((uint8_t)c[i] >= (uint8_t)' ') &&
+                 (app_usbData.currentOffset < (sizeof(app_usbData.string) - 1U)))
         {
-            app_usbData.string[app_usbData.currentOffset] = app_usbData.string[app_usbData.currentOffset] - 32;
-        }        
-        //app_usbData.currentOffset = app_usbData.currentOffset + sizeof(keyValue[keyCode]);
-        
-        //GPT
-        app_usbData.currentOffset += strlen(keyValue[keyCode]);
-        if (app_usbData.currentOffset >= sizeof(app_usbData.string) - 1)
-            app_usbData.currentOffset = sizeof(app_usbData.string) - 1;
-        app_usbData.string[app_usbData.currentOffset] = '\0';
+            app_usbData.string[app_usbData.currentOffset++] = c[i];
+        }
     }
+    app_usbData.string[app_usbData.currentOffset] = '\0';
+}
+
+
+/* APP_USB_LinhaEntrega()
+ * Linha terminada: copia para a tela "Teclado" e entrega ao assinante.
+ */
+static void APP_USB_LinhaEntrega(void)
+{
+    if (app_usbData.linhaTam > APP_USB_LINHA_MAX)
+        app_usbData.linhaTam = APP_USB_LINHA_MAX;     // linha cortada
+    app_usbData.linha[app_usbData.linhaTam] = '\0';
+    app_usbData.linhas++;
+
+    memcpy(app_usbData.string, app_usbData.linha, app_usbData.linhaTam + 1U);
+    app_usbData.currentOffset = (uint16_t)app_usbData.linhaTam;
+    app_usbData.stringSize = app_usbData.linhaTam;
+
+    if (g_linhaCallback != NULL)
+        g_linhaCallback(app_usbData.linha, app_usbData.linhaTam, g_linhaContext);
+
+    app_usbData.linhaTam = 0;
+    app_usbData.prefixoVisto = false;
 }
 
+/* APP_USB_LeitorCaractere()
+ * Monta a linha do leitor: prefixo (se houver), caracteres e ENTER.
+ */
+static void APP_USB_LeitorCaractere(char c)
+{
+    if (c == TECLADO_ENTER)
+    {
+        // ENTER sem prefixo ou sem nada lido no  uma leitura
+        if ((app_usbData.linhaTam != 0U) &&
+            ((app_usbData.prefixo == 0) || app_usbData.prefixoVisto))
+        {
+            APP_USB_LinhaEntrega();
+        }
+        app_usbData.linhaTam = 0;
+        app_usbData.prefixoVisto = false;
+        return;
+    }
+
+    // Os outros controles (TAB, ESC, BACKSPACE) no entram na linha
+    if ((uint8_t)c < (uint8_t)' ')
+        return;
+
+    if ((app_usbData.prefixo != 0) && !app_usbData.prefixoVisto)
+    {
+        // Antes do prefixo tudo  descartado
+        if (c == app_usbData.prefixo)
+        {
+            app_usbData.prefixoVisto = true;
+            app_usbData.linhaTam = 0;
+        }
+        return;
+    }
+
+    if (app_usbData.linhaTam < APP_USB_LINHA_MAX)
+    {
+        app_usbData.linha[app_usbData.linhaTam++] = c;
+    }
+    else if (app_usbData.linhaTam == APP_USB_LINHA_MAX)
+    {
+        // Conta a linha cortada uma vez s; o resto at o ENTER se perde
+        app_usbData.linhasLongas++;
+        app_usbData.linhaTam++;
+    }
+}
+
+/* APP_USB_LeitorTecla()
+ * Passa os caracteres da tecla, no layout atual, para a linha do leitor.
+ */
+static void APP_USB_LeitorTecla(const APP_USB_TECLA *tecla)
+{
+    char c[TECLADO_CARACTERES_MAX];
+    uint32_t i, n;
+
+    n = TECLADO_Traduz(tecla->keyCode, tecla->modificadores, app_usbData.capsLockPressed, c);
+    for (i = 0; i < n; i++)
+        APP_USB_LeitorCaractere(c[i]);
+}
+
+/* APP_USB_TeclasProcessa()
+ * Esvazia o anel de teclas.
+ */
+static void APP_USB_TeclasProcessa(void)
+{
+    APP_USB_TECLA tecla;
+    uint32_t linhas = app_usbData.linhas;
+
+    while (g_teclaLeitura != g_teclaEscrita)
+    {
+        APP_USB_BARREIRA();
+        tecla = g_teclas[g_teclaLeitura & (APP_USB_TECLAS_ANEL - 1U)];
+        APP_USB_BARREIRA();
+        g_teclaLeitura++;
+
+        if (app_usbData.modoLeitor)
+            APP_USB_LeitorTecla(&tecla);
+        else
+            APP_MapKeyToUsage((USB_HID_KEYBOARD_KEYPAD)tecla.keyCode, tecla.modificadores);
+    }
+
+    // Linha nova: a tela "Teclado" mostra a ltima leitura
+    if (app_usbData.linhas != linhas)
+        ACTION_SendEventFromTask(ACT_NONE, ACT_EVENT_DISPLAY_UPDATE);
+}
+
+void APP_USB_LeitorModoSet(bool ligado, char prefixo)
+{
+    // Chamada pelo console (outra task): uma leitura em andamento se perde
+    app_usbData.prefixo = prefixo;
+    app_usbData.modoLeitor = ligado;
+    app_usbData.linhaTam = 0;
+    app_usbData.prefixoVisto = false;
+}
+
+void APP_USB_LinhaAssina(APP_USB_LINHA_CALLBACK callback, uintptr_t context)
+{
+    g_linhaCallback = NULL;
+    g_linhaContext = context;
+    g_linhaCallback = callback;
+}
+
+void APP_USB_ImprimeConsole(void)
+{
+    uint32_t relatorios = 0;
+
+    if (app_usbData.handle != 0U)
+        relatorios = USB_HOST_HID_KEYBOARD_DroppedReportsGet(app_usbData.handle);
+
+    SYS_CONSOLE_PRINT("leitor %s prefixo %c | linhas %lu (longas %lu)\r\n",
+                      app_usbData.modoLeitor ? "on" : "off",
+                      (app_usbData.prefixo != 0) ? app_usbData.prefixo : '-',
+                      (unsigned long)app_usbData.linhas,
+                      (unsigned long)app_usbData.linhasLongas);
+    SYS_CONSOLE_PRINT("perdidas: teclas %lu | relatorios %lu\r\n",
+                      (unsigned long)g_teclasPerdidas, (unsigned long)relatorios);
+}
 
 // *****************************************************************************
 // *****************************************************************************
@@ -356,9 +598,11 @@ void APP_USB_Tasks ( void )
         case APP_USB_STATE_INIT:
             USB_HOST_EventHandlerSet(APP_USBHostEventHandler, 0);
             USB_HOST_HID_KEYBOARD_EventHandlerSet(APP_USBHostHIDKeyboardEventHandler);
+            USB_HOST_HID_InterfaceEventNotifySet(APP_USB_HidInterfaceEvento);
             
 			USB_HOST_BusEnable(USB_HOST_BUS_ALL);
 			app_usbData.state = APP_USB_STATE_WAIT_FOR_HOST_ENABLE;
+            APP_USB_HostEvento();
             break;
 			
 		case APP_USB_STATE_WAIT_FOR_HOST_ENABLE:
@@ -369,6 +613,11 @@ void APP_USB_Tasks ( void )
                  * move on to the next state */
                 app_usbData.state = APP_USB_STATE_HOST_ENABLE_DONE;
             }
+            else
+            {
+                /* A task do host precisa continuar rodando at habilitar */
+                APP_USB_HostEvento();
+            }
             break;
         case APP_USB_STATE_HOST_ENABLE_DONE:
             app_usbData.state = APP_USB_STATE_WAIT_FOR_DEVICE_ATTACH;
@@ -385,21 +634,12 @@ void APP_USB_Tasks ( void )
             memset(&app_usbData.string, 0, sizeof(app_usbData.string));
             app_usbData.currentOffset = 0;
             app_usbData.stringSize    = 0;
-            app_usbData.state = APP_USB_STATE_READ_HID;
+            app_usbData.state = APP_USB_STATE_WAIT_FOR_REPORT;
             break;
-            
-        case APP_USB_STATE_READ_HID:
-        {
-           // Processa apenas as teclas no-modificadoras recm-pressionadas
-            for (size_t i = 0; i < app_usbData.data.nNonModifierKeysData; i++)
-            {
-                if (app_usbData.data.nonModifierKeysData[i].event == USB_HID_KEY_PRESSED)
-                {
-                    APP_MapKeyToUsage(app_usbData.data.nonModifierKeysData[i].keyCode);
-                }
-            }
+
+        case APP_USB_STATE_WAIT_FOR_REPORT:
+            // As teclas so processadas depois do switch
             break;
-        }
 
 /*
         case APP_USB_STATE_READ_HID:
@@ -525,13 +765,10 @@ void APP_USB_Tasks ( void )
             break;
 */
         case APP_USB_STATE_DEVICE_DETACHED:
-            UART2_Write("\r\nest7", 6);
             app_usbData.state = APP_USB_STATE_HOST_ENABLE_DONE;
             break;
 
         case APP_USB_STATE_ERROR:
-            UART2_Write("\r\nest8", 6);
-
             /* The application comes here when the demo
              * has failed. Provide LED indication .*/
 
@@ -541,6 +778,12 @@ void APP_USB_Tasks ( void )
         default:
             break;
     }
+
+    // Teclas de todos os relatrios que chegaram desde a ltima vez, na
+    // ordem. Roda toda vez que a task acorda, em qualquer estado: uma
+    // notificao que chega enquanto o anel  esvaziado acorda a task de
+    // novo e as teclas dela so processadas na volta seguinte.
+    APP_USB_TeclasProcessa();
 }
 
 /*******************************************************************************
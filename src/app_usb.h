@@ -34,6 +34,7 @@
 #include <string.h>
 #include "configuration.h"
 #include "definitions.h"
+#include "teclado.h"
 
 // DOM-IGNORE-BEGIN
 #ifdef __cplusplus  // Provide C++ Compatibility
@@ -70,6 +71,7 @@ typedef enum
     APP_USB_STATE_WAIT_FOR_DEVICE_ATTACH,
     APP_USB_STATE_DEVICE_ATTACHED,
     APP_USB_STATE_READ_HID,
+    APP_USB_STATE_WAIT_FOR_REPORT,
     APP_USB_STATE_DEVICE_DETACHED,
     APP_USB_STATE_CHANGE_DEVICE_PARAMETERS,
 //    APP_USB_USART_STATE_DRIVER_OPEN,
@@ -80,6 +82,40 @@ typedef enum
 } APP_USB_STATES;
 
 
+// *****************************************************************************
+/* Modo leitor de cdigo de barras
+
+  Summary:
+    Teclas em anel sem trava e entrega de linhas inteiras.
+
+  Description:
+    O leitor de cdigo de barras USB se apresenta como teclado e manda as
+    teclas em rajadas, bem mais rpido que uma pessoa digitando. Por isso as
+    teclas pressionadas no passam mais por uma cpia nica do relatrio: o
+    callback do driver do teclado (task do host) pe cada tecla num anel de
+    um produtor e um consumidor, e a APP_USB_Tasks esvazia o anel inteiro a
+    cada vez que acorda.
+
+    No modo leitor os caracteres formam uma linha, terminada por ENTER, que 
+    entregue inteira a quem assinou com APP_USB_LinhaAssina. Se houver
+    prefixo configurado, o que vier antes dele  descartado (rudo ou
+    digitao fora de uma leitura) e o prefixo no entra na linha. Fora do
+    modo leitor as teclas continuam indo para a tela "Teclado". Nos dois
+    casos os caracteres saem do layout escolhido em teclado.h.
+*/
+
+#define APP_USB_TECLAS_ANEL     128U    // teclas no anel (potncia de 2)
+#define APP_USB_LINHA_MAX       48U     // caracteres por linha lida
+
+typedef struct
+{
+    uint8_t keyCode;            // USB_HID_KEYBOARD_KEYPAD
+    uint8_t modificadores;      // TECLADO_MOD_SHIFT / TECLADO_MOD_ALTGR
+} APP_USB_TECLA;
+
+// Linha completa do leitor. Roda na APP_USB_Tasks: no pode bloquear
+typedef void (*APP_USB_LINHA_CALLBACK)(const char *linha, uint32_t tamanho, uintptr_t context);
+
 typedef struct
 {
     /* Application last data buffer */
@@ -139,6 +175,15 @@ typedef struct
     /* Flag used to select NUMLOCK sequence */
     bool numLockPressed;
     
+    /* Modo leitor de cdigo de barras e linha em montagem */
+    bool modoLeitor;
+    bool prefixoVisto;
+    char prefixo;               // 0 = sem prefixo
+    char linha[APP_USB_LINHA_MAX + 1U];
+    uint32_t linhaTam;
+    uint32_t linhas;            // linhas entregues
+    uint32_t linhasLongas;      // linhas cortadas em APP_USB_LINHA_MAX
+    
     /* Holds the output Report*/
     uint8_t outputReport;
 
@@ -152,6 +197,35 @@ typedef struct
 
 } APP_USB_DATA;
 
+// *****************************************************************************
+/* Servio do host USB por eventos
+
+  Summary:
+    Quando as tasks do host USB e da APP_USB precisam rodar.
+
+  Description:
+    F_USB_HOST_Tasks (tasks.c) e APP_USB_Tasks dormem em notificao. A task
+    do host  acordada pela ISR USB no attach/detach e pelo driver HID do
+    teclado a cada relatrio recebido; a APP_USB_Tasks  acordada pelo
+    callback do teclado. S enquanto o barramento muda de estado (attach,
+    enumerao, detach) as duas rodam a cada APP_USB_PERIODO_MS, porque a
+    camada de host conta os seus tempos nessas chamadas. Sem dispositivo, ou
+    com o teclado parado, nenhuma das duas acorda.
+*/
+
+#define APP_USB_PERIODO_MS      10U     // servio durante attach/enumerao/detach
+#define APP_USB_JANELA_MS       300U    // depois de um evento de conexo
+#define APP_USB_ENUMERACAO_MS   5000U   // limite da enumerao depois do attach
+
+// Flags de U1IR (modo host) que abrem a janela de servio
+#define APP_USB_INT_DETACH      0x01U   // DETACHIF
+#define APP_USB_INT_ATTACH      0x40U   // ATTACHIF
+#define APP_USB_INT_CONEXAO     (APP_USB_INT_ATTACH | APP_USB_INT_DETACH)
+
+// Handles das tasks (declarados em tasks.c)
+extern TaskHandle_t xUSB_HOST_Tasks;
+extern TaskHandle_t xAPP_USB_Tasks;
+
 // *****************************************************************************
 // *****************************************************************************
 // Section: Application Callback Routines
@@ -160,6 +234,44 @@ typedef struct
 /* These routines are called by drivers when certain events occur.
 */
 
+/* APP_USB_HostAcordaFromISR()
+ * Chamada pela ISR USB com as flags de U1IR (j mascaradas com U1IE) que
+ * estavam ativas antes do driver tratar a interrupo.
+ */
+void APP_USB_HostAcordaFromISR(uint32_t flags);
+
+/* APP_USB_HIDKeyboardEventHandler()
+ * Handler do driver de uso "teclado" registrado na camada HID
+ * (usb_host_init_data.c): repassa ao driver do teclado e acorda a task do
+ * host, que processa o relatrio e reenvia o pedido IN.
+ */
+void APP_USB_HIDKeyboardEventHandler(USB_HOST_HID_OBJ_HANDLE handle,
+        USB_HOST_HID_EVENT event, void * eventData);
+
+/* APP_USB_HostEspera() / APP_USB_Espera()
+ * Tempo mximo que a task do host / da APP_USB pode dormir esperando
+ * notificao: APP_USB_PERIODO_MS durante mudanas no barramento, seno
+ * portMAX_DELAY.
+ */
+TickType_t APP_USB_HostEspera(void);
+TickType_t APP_USB_Espera(void);
+
+/* APP_USB_LeitorModoSet()
+ * Liga ou desliga o modo leitor. 'prefixo' = 0 aceita qualquer linha.
+ * A linha em montagem  descartada.
+ */
+void APP_USB_LeitorModoSet(bool ligado, char prefixo);
+
+/* APP_USB_LinhaAssina()
+ * Registra quem recebe as linhas do leitor (NULL desliga).
+ */
+void APP_USB_LinhaAssina(APP_USB_LINHA_CALLBACK callback, uintptr_t context);
+
+/* APP_USB_ImprimeConsole()
+ * Modo, contadores de linhas e teclas/relatrios perdidos no console.
+ */
+void APP_USB_ImprimeConsole(void);
+
 // *****************************************************************************
 // *****************************************************************************
 // Section: Application Initialization and State Machine Functions
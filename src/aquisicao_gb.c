@@ -0,0 +1,294 @@
+/*******************************************************************************
+  Aquisio das amostras do ensaio GB
+
+  File Name:
+    aquisicao_gb.c
+
+  Summary:
+    Aquisio de tenso/corrente do ensaio GB em blocos (DMA ou TMR2).
+
+  Description:
+    Modo DMA (AQUISICAO_GB_USA_DMA = 1):
+    - TMR5 conta a 7,68kHz e o "match" dele  o trigger de scan do ADCHS
+      (STRGSRC). AN1 e AN2 usam o trigger de scan (STRIG), ento a converso
+      comea por hardware, sem CPU.
+    - O fim do scan (ADC_EOS) dispara os canais 0 e 1 do DMA, que copiam
+      ADCDATA1 (tenso) e ADCDATA2 (corrente) para buffers de 2 blocos.
+      O canal 0 tem prioridade maior, ento quando o canal 1 termina uma
+      clula a tenso correspondente j foi copiada.
+    - O canal 1 interrompe na metade (CHDHIF) e no fim (CHBCIF) do buffer,
+      ou seja, uma interrupo por bloco. Com CHAEN o DMA recomea sozinho.
+
+    Modo TMR2 (AQUISICAO_GB_USA_DMA = 0):
+    - Uma interrupo do TMR2 por amostra, que l ADCDATA1/ADCDATA2 e dispara
+      a prxima converso por software, como era feito antes.
+
+    Mapa ADCHS:
+    CH1 -> AN1 (RB0) -> ADCDATA1 -> tenso
+    CH2 -> AN2 (RA1) -> ADCDATA2 -> corrente
+ *******************************************************************************/
+
+// *****************************************************************************
+// *****************************************************************************
+// Section: Included Files
+// *****************************************************************************
+// *****************************************************************************
+
+#include <sys/kmem.h>
+#include "aquisicao_gb.h"
+#include "definitions.h"
+
+// *****************************************************************************
+// *****************************************************************************
+// Section: Global Data Definitions
+// *****************************************************************************
+// *****************************************************************************
+
+// Fontes de trigger do ADCHS (campos TRGSRCx e STRGSRC)
+#define AQUISICAO_GB_TRG_GSWTRG         1U      // global por software
+#define AQUISICAO_GB_TRG_STRIG          3U      // trigger de scan
+#define AQUISICAO_GB_TRG_TMR5           7U      // "match" do TMR5
+
+// Prioridade das interrupes de aquisio (esquema em isr_latencia.h).
+// Precisa ser <= configMAX_SYSCALL_INTERRUPT_PRIORITY porque o callback
+// notifica uma task.
+#define AQUISICAO_GB_PRIORIDADE_ISR     ISR_PRIO_AQUISICAO
+
+#define AQUISICAO_GB_CONTADOR_CICLOS()  _CP0_GET_COUNT()
+
+// Buffers ping-pong: bloco 0 = primeira metade, bloco 1 = segunda metade
+static uint16_t g_tensao[2U * AQUISICAO_GB_AMOSTRAS_BLOCO];
+static uint16_t g_corrente[2U * AQUISICAO_GB_AMOSTRAS_BLOCO];
+
+static AQUISICAO_GB_CALLBACK g_callback = NULL;
+static uintptr_t g_context = 0;
+
+static volatile AQUISICAO_GB_ESTATISTICAS g_estat;
+
+#if (AQUISICAO_GB_USA_DMA == 0)
+static uint32_t g_amostraIdx = 0;   // posio no buffer ping-pong (ISR)
+#endif
+
+// *****************************************************************************
+// *****************************************************************************
+// Section: Local Functions
+// *****************************************************************************
+// *****************************************************************************
+
+/* AQUISICAO_GB_EntregaBloco()
+ * Passa um bloco completo para o consumidor e atualiza as estatsticas.
+ */
+static void AQUISICAO_GB_EntregaBloco(uint32_t bloco, uint32_t inicio)
+{
+    uint32_t ciclos;
+    uint32_t offset = bloco * AQUISICAO_GB_AMOSTRAS_BLOCO;
+
+    if (g_callback != NULL)
+    {
+        g_callback(&g_tensao[offset], &g_corrente[offset],
+                   AQUISICAO_GB_AMOSTRAS_BLOCO, g_context);
+    }
+    g_estat.blocos++;
+
+    ciclos = AQUISICAO_GB_CONTADOR_CICLOS() - inicio;
+    g_estat.isr_ciclos = ciclos;
+    if (ciclos > g_estat.isr_ciclos_max)
+        g_estat.isr_ciclos_max = ciclos;
+}
+
+#if (AQUISICAO_GB_USA_DMA == 1)
+
+/* AQUISICAO_GB_PrioridadeSet()
+ * Ajusta prioridade/subprioridade de uma fonte de interrupo. Mesmo clculo
+ * de endereo usado em plib_evic.c, mas para os registradores IPCx.
+ */
+static void AQUISICAO_GB_PrioridadeSet(INT_SOURCE source, uint32_t prioridade)
+{
+    volatile uint32_t *IPCx = (volatile uint32_t *)(&IPC0 + ((0x10U * (source / 4U)) / 4U));
+    volatile uint32_t *IPCxCLR = (volatile uint32_t *)(IPCx + 1U);
+    volatile uint32_t *IPCxSET = (volatile uint32_t *)(IPCx + 2U);
+    uint32_t shift = 8U * (source & 0x3U);
+
+    *IPCxCLR = 0x1fU << shift;
+    *IPCxSET = (prioridade << 2) << shift;
+}
+
+/* DMA1_InterruptHandler()
+ * Canal 1 (corrente) chegou na metade ou no fim do buffer ping-pong.
+ */
+void __attribute__((used)) DMA1_InterruptHandler(void)
+{
+    uint32_t inicio = AQUISICAO_GB_CONTADOR_CICLOS();
+    uint32_t flags = DCH1INT;
+
+    DCH1INTCLR = _DCH1INT_CHDHIF_MASK | _DCH1INT_CHBCIF_MASK;
+    EVIC_SourceStatusClear(INT_SOURCE_DMA1);
+
+    if ((flags & _DCH1INT_CHDHIF_MASK) != 0U)
+    {
+        AQUISICAO_GB_EntregaBloco(0U, inicio);
+    }
+    if ((flags & _DCH1INT_CHBCIF_MASK) != 0U)
+    {
+        AQUISICAO_GB_EntregaBloco(1U, inicio);
+    }
+}
+
+#else
+
+/* AQUISICAO_GB_TMR2Callback()
+ * Uma amostra por interrupo. L os dois canais do scan e dispara a prxima
+ * converso por software.
+ */
+static void AQUISICAO_GB_TMR2Callback(uint32_t status, uintptr_t context)
+{
+    uint32_t inicio = AQUISICAO_GB_CONTADOR_CICLOS();
+
+    // L os dois canais configurados no scan. Cada canal  12bits
+    g_tensao[g_amostraIdx]   = (uint16_t)ADCDATA1;
+    g_corrente[g_amostraIdx] = (uint16_t)ADCDATA2;
+
+    // Dispara converso global para ler na prxima chamada do timer2
+    ADCHS_GlobalEdgeConversionStart();
+
+    g_amostraIdx++;
+    if (g_amostraIdx == AQUISICAO_GB_AMOSTRAS_BLOCO)
+    {
+        AQUISICAO_GB_EntregaBloco(0U, inicio);
+    }
+    else if (g_amostraIdx >= 2U * AQUISICAO_GB_AMOSTRAS_BLOCO)
+    {
+        g_amostraIdx = 0;
+        AQUISICAO_GB_EntregaBloco(1U, inicio);
+    }
+}
+
+#endif
+
+// *****************************************************************************
+// *****************************************************************************
+// Section: Interface Functions
+// *****************************************************************************
+// *****************************************************************************
+
+void AQUISICAO_GB_Initialize(void)
+{
+    g_callback = NULL;
+    g_context = 0;
+
+#if (AQUISICAO_GB_USA_DMA == 1)
+    // TMR5 parado, s serve de trigger (sem interrupo)
+    T5CON = 0;
+    TMR5 = 0;
+    PR5 = AQUISICAO_GB_TICKS_AMOSTRA - 1U;
+
+    // Canais 0 e 1 desligados at o Start
+    DMACONSET = _DMACON_ON_MASK;
+    DCH0CON = 0;
+    DCH1CON = 0;
+    DCH0INT = 0;
+    DCH1INT = 0;
+
+    AQUISICAO_GB_PrioridadeSet(INT_SOURCE_DMA1, AQUISICAO_GB_PRIORIDADE_ISR);
+    EVIC_SourceDisable(INT_SOURCE_DMA1);
+#endif
+}
+
+void AQUISICAO_GB_CallbackRegister(AQUISICAO_GB_CALLBACK callback, uintptr_t context)
+{
+    g_callback = callback;
+    g_context = context;
+}
+
+void AQUISICAO_GB_Start(void)
+{
+    g_estat.isr_ciclos = 0;
+    g_estat.isr_ciclos_max = 0;
+    g_estat.blocos = 0;
+
+#if (AQUISICAO_GB_USA_DMA == 1)
+    // Canal 0: ADCDATA1 (tenso) -> g_tensao, disparado pelo fim do scan
+    DCH0ECON = ((uint32_t)INT_SOURCE_ADC_EOS << _DCH0ECON_CHSIRQ_POSITION) | _DCH0ECON_SIRQEN_MASK;
+    DCH0SSA = KVA_TO_PA(&ADCDATA1);
+    DCH0DSA = KVA_TO_PA(g_tensao);
+    DCH0SSIZ = sizeof(uint16_t);
+    DCH0DSIZ = sizeof(g_tensao);
+    DCH0CSIZ = sizeof(uint16_t);
+    DCH0CON = _DCH0CON_CHAEN_MASK | (3U << _DCH0CON_CHPRI_POSITION);
+
+    // Canal 1: ADCDATA2 (corrente) -> g_corrente, prioridade menor que o 0
+    DCH1ECON = ((uint32_t)INT_SOURCE_ADC_EOS << _DCH1ECON_CHSIRQ_POSITION) | _DCH1ECON_SIRQEN_MASK;
+    DCH1SSA = KVA_TO_PA(&ADCDATA2);
+    DCH1DSA = KVA_TO_PA(g_corrente);
+    DCH1SSIZ = sizeof(uint16_t);
+    DCH1DSIZ = sizeof(g_corrente);
+    DCH1CSIZ = sizeof(uint16_t);
+    DCH1CON = _DCH1CON_CHAEN_MASK | (2U << _DCH1CON_CHPRI_POSITION);
+
+    // Interrompe na metade e no fim do buffer (um bloco por interrupo)
+    DCH1INT = _DCH1INT_CHDHIE_MASK | _DCH1INT_CHBCIE_MASK;
+    EVIC_SourceStatusClear(INT_SOURCE_DMA1);
+    EVIC_SourceEnable(INT_SOURCE_DMA1);
+
+    // O fim de scan s serve de trigger para o DMA, sem interromper a CPU
+    EVIC_SourceDisable(INT_SOURCE_ADC_EOS);
+
+    DCH0CONSET = _DCH0CON_CHEN_MASK;
+    DCH1CONSET = _DCH1CON_CHEN_MASK;
+
+    // AN1/AN2 convertem no trigger de scan, que passa a ser o TMR5
+    ADCTRG1bits.TRGSRC1 = AQUISICAO_GB_TRG_STRIG;
+    ADCTRG1bits.TRGSRC2 = AQUISICAO_GB_TRG_STRIG;
+    ADCCON1bits.STRGSRC = AQUISICAO_GB_TRG_TMR5;
+
+    TMR5 = 0;
+    T5CONSET = _T5CON_ON_MASK;
+#else
+    g_amostraIdx = 0;
+
+    // Dispara a primeira converso, lida na primeira chamada do timer2
+    ADCHS_GlobalEdgeConversionStart();
+
+    TMR2_Stop();
+    TMR2_CounterSet(0);
+    // PR2 j est 7811 (130,2 us)
+    TMR2_CallbackRegister(AQUISICAO_GB_TMR2Callback, 0);
+    TMR2_InterruptEnable();
+    TMR2_Start();
+#endif
+}
+
+void AQUISICAO_GB_Stop(void)
+{
+#if (AQUISICAO_GB_USA_DMA == 1)
+    T5CONCLR = _T5CON_ON_MASK;
+
+    EVIC_SourceDisable(INT_SOURCE_DMA1);
+    DCH0CONCLR = _DCH0CON_CHEN_MASK;
+    DCH1CONCLR = _DCH1CON_CHEN_MASK;
+    DCH1INT = 0;
+    EVIC_SourceStatusClear(INT_SOURCE_DMA1);
+
+    // Volta o ADCHS para o trigger global por software (configurao do MCC)
+    ADCCON1bits.STRGSRC = 0;
+    ADCTRG1bits.TRGSRC1 = AQUISICAO_GB_TRG_GSWTRG;
+    ADCTRG1bits.TRGSRC2 = AQUISICAO_GB_TRG_GSWTRG;
+    EVIC_SourceStatusClear(INT_SOURCE_ADC_EOS);
+    EVIC_SourceEnable(INT_SOURCE_ADC_EOS);
+#else
+    TMR2_Stop();
+    TMR2_InterruptDisable();
+    TMR2_CallbackRegister(NULL, 0);
+#endif
+}
+
+void AQUISICAO_GB_EstatisticasGet(AQUISICAO_GB_ESTATISTICAS *estat)
+{
+    estat->isr_ciclos     = g_estat.isr_ciclos;
+    estat->isr_ciclos_max = g_estat.isr_ciclos_max;
+    estat->blocos         = g_estat.blocos;
+}
+
+/*******************************************************************************
+ End of File
+ */
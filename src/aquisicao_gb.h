@@ -0,0 +1,120 @@
+/*******************************************************************************
+  Aquisio das amostras do ensaio GB
+
+  File Name:
+    aquisicao_gb.h
+
+  Summary:
+    Interface da aquisio de tenso/corrente do ensaio GB em blocos.
+
+  Description:
+    Esconde de onde vm as amostras do ensaio GB. O consumidor (medida_gb.c)
+    s registra um callback que recebe blocos completos de amostras
+    (tenso em ADCDATA1, corrente em ADCDATA2).
+
+    H dois modos, escolhidos por AQUISICAO_GB_USA_DMA:
+    - DMA (padro): o TMR5 dispara o scan do ADCHS por hardware, dois canais
+      de DMA levam ADCDATA1/ADCDATA2 para buffers ping-pong e a CPU s 
+      interrompida a cada meio buffer (um bloco).
+    - TMR2: uma interrupo por amostra, como era feito antes. Fica como
+      alternativa para depurao.
+
+    Como o consumidor s enxerga blocos, uma implementao desta interface
+    pode reproduzir buffers gravados sem o hardware.
+*******************************************************************************/
+
+#ifndef _AQUISICAO_GB_H
+#define _AQUISICAO_GB_H
+
+// *****************************************************************************
+// *****************************************************************************
+// Section: Included Files
+// *****************************************************************************
+// *****************************************************************************
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <stddef.h>
+
+// DOM-IGNORE-BEGIN
+#ifdef __cplusplus  // Provide C++ Compatibility
+
+extern "C" {
+
+#endif
+// DOM-IGNORE-END
+
+// *****************************************************************************
+// *****************************************************************************
+// Section: Type Definitions
+// *****************************************************************************
+// *****************************************************************************
+
+// 1 = scan disparado pelo TMR5 e resultados por DMA, 0 = ISR do TMR2 por amostra
+#ifndef AQUISICAO_GB_USA_DMA
+#define AQUISICAO_GB_USA_DMA        1
+#endif
+
+// Perodo de amostragem: PBCLK2 (60MHz) / 7812 = 7,68kHz (mesmo do PR2)
+#define AQUISICAO_GB_CLOCK_HZ       60000000U
+#define AQUISICAO_GB_TICKS_AMOSTRA  7812U
+
+// Amostras por bloco: meio ciclo de 60Hz a 7,68kHz (8,33ms)
+#define AQUISICAO_GB_AMOSTRAS_BLOCO 64U
+
+// Callback chamado (em contexto de interrupo) a cada bloco completo.
+// Os ponteiros s so vlidos durante a chamada: o buffer volta a ser
+// preenchido logo em seguida.
+typedef void (*AQUISICAO_GB_CALLBACK)(const uint16_t *tensao,
+                                      const uint16_t *corrente,
+                                      uint32_t n,
+                                      uintptr_t context);
+
+// Estatsticas da interrupo de aquisio
+typedef struct
+{
+    // Custo da ISR em ticks do core timer (SYSCLK/2), ltimo e mximo
+    uint32_t isr_ciclos;
+    uint32_t isr_ciclos_max;
+    // Blocos entregues ao consumidor desde o ltimo Start
+    uint32_t blocos;
+} AQUISICAO_GB_ESTATISTICAS;
+
+// *****************************************************************************
+// *****************************************************************************
+// Section: Interface Functions
+// *****************************************************************************
+// *****************************************************************************
+
+/* AQUISICAO_GB_Initialize()
+ * Deixa a aquisio parada. Chamar uma vez em SYS_Initialize.
+ */
+void AQUISICAO_GB_Initialize(void);
+
+/* AQUISICAO_GB_CallbackRegister()
+ * Registra o consumidor dos blocos de amostras.
+ */
+void AQUISICAO_GB_CallbackRegister(AQUISICAO_GB_CALLBACK callback, uintptr_t context);
+
+/* AQUISICAO_GB_Start() / AQUISICAO_GB_Stop()
+ * Inicia/para a amostragem contnua. Start zera as estatsticas.
+ */
+void AQUISICAO_GB_Start(void);
+void AQUISICAO_GB_Stop(void);
+
+/* AQUISICAO_GB_EstatisticasGet()
+ * Copia as estatsticas da interrupo de aquisio.
+ */
+void AQUISICAO_GB_EstatisticasGet(AQUISICAO_GB_ESTATISTICAS *estat);
+
+//DOM-IGNORE-BEGIN
+#ifdef __cplusplus
+}
+#endif
+//DOM-IGNORE-END
+
+#endif /* _AQUISICAO_GB_H */
+
+/*******************************************************************************
+ End of File
+ */
@@ -140,10 +140,13 @@ extern "C" {
 /* Maximum Number of pipes */
 #define DRV_USBFS_HOST_PIPES_NUMBER                       10  
 
-/* Attach Debounce duration in milli Seconds */ 
+/* Attach Debounce duration in milli Seconds. Default at boot, can be changed
+ * with DRV_USBFS_HOST_TimingSet() (USB 2.0 minimum TATTDB = 100 ms). The boot
+ * values of the four attach delays are the Harmony ones until shorter values
+ * are measured with the scanner ("usb" console command) */ 
 #define DRV_USBFS_HOST_ATTACH_DEBOUNCE_DURATION           500U
 
-/* Reset duration in milli Seconds */ 
+/* Reset duration in milli Seconds (USB 2.0 minimum TDRSTR = 50 ms) */ 
 #define DRV_USBFS_HOST_RESET_DURATION                     100U
 
 /* Alignment for buffers that are submitted to USB Driver*/ 
@@ -173,6 +176,12 @@ extern "C" {
 /* The maximum number of pipes that the USB Host layer can utilize. */
 #define USB_HOST_PIPES_NUMBER                               10
 
+/* Reset recovery delay in milli Seconds (USB 2.0 minimum TRSTRCY = 10 ms) */
+#define USB_HOST_RESET_SETTLING_DELAY                       100U
+
+/* Delay after Set Address in milli Seconds (USB 2.0 minimum TDSETADDR = 2 ms) */
+#define USB_HOST_POST_SET_ADDRESS_DELAY                     50U
+
 /* Number of HID Client driver instances in the application */
 #define USB_HOST_HID_INSTANCES_NUMBER        1U
 
@@ -186,6 +195,13 @@ extern "C" {
  * per HID interface */
 #define USB_HID_GLOBAL_PUSH_POP_STACK_SIZE        1U
 
+/* Number of devices whose report descriptor and parse results are cached, so
+ * that a device that is attached again skips the report descriptor request */
+#define USB_HOST_HID_DESCRIPTOR_CACHE_NUMBER      2U
+
+/* Largest report descriptor that can be cached, in bytes */
+#define USB_HOST_HID_DESCRIPTOR_CACHE_SIZE        256U
+
 
 
 
@@ -77,6 +77,10 @@
 #include "app_usb.h"
 #include "menu_display.h"
 #include "medida_gb.h"
+#include "aquisicao_gb.h"
+#include "diag_gb.h"
+#include "isr_latencia.h"
+#include "diag_sistema.h"
 
 
 
@@ -2888,6 +2888,110 @@ void DRV_USBFS_HOST_ROOT_HUB_Initialize
     USB_HOST_DEVICE_OBJ_HANDLE usbHostDeviceInfo
 );
 
+// ****************************************************************************
+/* Root hub attach timing limits
+
+  Summary:
+    Minimum attach debounce and reset durations in milliseconds.
+
+  Description:
+    These are the minimum values accepted by DRV_USBFS_HOST_TimingSet(). The
+    attach debounce must cover TATTDB (100 ms) and the root port reset must
+    last TDRSTR (50 ms) as per the USB 2.0 specification.
+
+  Remarks:
+    None.
+*/
+
+#define DRV_USBFS_HOST_ATTACH_DEBOUNCE_MIN      100U
+#define DRV_USBFS_HOST_RESET_DURATION_MIN       50U
+
+// ****************************************************************************
+/* Function:
+    void DRV_USBFS_HOST_TimingSet
+    (
+        uint32_t attachDebounce,
+        uint32_t resetDuration
+    )
+
+  Summary:
+    Sets the root hub attach debounce and reset durations.
+
+  Description:
+    This function sets the attach debounce duration and the port reset
+    duration in milliseconds. The values replace
+    DRV_USBFS_HOST_ATTACH_DEBOUNCE_DURATION and DRV_USBFS_HOST_RESET_DURATION
+    from the next attach onwards. Values below DRV_USBFS_HOST_ATTACH_DEBOUNCE_MIN
+    and DRV_USBFS_HOST_RESET_DURATION_MIN are raised to these limits.
+
+  Precondition:
+    None.
+
+  Parameters:
+    attachDebounce - attach debounce duration in milliseconds.
+
+    resetDuration - port reset duration in milliseconds.
+
+  Returns:
+    None.
+
+  Example:
+    <code>
+    // Use the shortest debounce and reset allowed by the specification
+    DRV_USBFS_HOST_TimingSet(DRV_USBFS_HOST_ATTACH_DEBOUNCE_MIN,
+                             DRV_USBFS_HOST_RESET_DURATION_MIN);
+    </code>
+
+  Remarks:
+    The values apply to all driver instances.
+*/
+
+void DRV_USBFS_HOST_TimingSet
+(
+    uint32_t attachDebounce,
+    uint32_t resetDuration
+);
+
+// ****************************************************************************
+/* Function:
+    void DRV_USBFS_HOST_TimingGet
+    (
+        uint32_t * attachDebounce,
+        uint32_t * resetDuration
+    )
+
+  Summary:
+    Returns the root hub attach debounce and reset durations.
+
+  Description:
+    This function returns the attach debounce duration and the port reset
+    duration in milliseconds. Either pointer can be NULL.
+
+  Precondition:
+    None.
+
+  Parameters:
+    attachDebounce - output parameter. Attach debounce duration.
+
+    resetDuration - output parameter. Port reset duration.
+
+  Returns:
+    None.
+
+  Example:
+    <code>
+    </code>
+
+  Remarks:
+    None.
+*/
+
+void DRV_USBFS_HOST_TimingGet
+(
+    uint32_t * attachDebounce,
+    uint32_t * resetDuration
+);
+
 
 // ****************************************************************************
 /* Function:
@@ -84,6 +84,14 @@ DRV_USB_HOST_INTERFACE gDrvUSBFSHostInterface =
  *****************************************************/
 static DRV_USBFS_HOST_PIPE_OBJ gDrvUSBHostPipeObj[DRV_USBFS_HOST_PIPES_NUMBER];
 
+/*****************************************************
+ * Attach debounce and reset durations in milliseconds.
+ * Counted in the 1 msec interrupt. Can be changed at
+ * run time with DRV_USBFS_HOST_TimingSet().
+ *****************************************************/
+static volatile uint32_t gDrvUSBFSHostAttachDebounce = DRV_USBFS_HOST_ATTACH_DEBOUNCE_DURATION;
+static volatile uint32_t gDrvUSBFSHostResetDuration = DRV_USBFS_HOST_RESET_DURATION;
+
 /******************************************************************************
  * This matrix provides a mapping of the amount of bandwidth left in a frame for
  * a given transfer size. The number in the matrix is the percentage of
@@ -2761,7 +2769,7 @@ void F_DRV_USBFS_HOST_Tasks_ISR(DRV_USBFS_OBJ * pusbdrvObj)
              * is a valid attach. */
 
             pusbdrvObj->attachDebounceCounter ++;
-            if(DRV_USBFS_HOST_ATTACH_DEBOUNCE_DURATION <= pusbdrvObj->attachDebounceCounter)
+            if(gDrvUSBFSHostAttachDebounce <= pusbdrvObj->attachDebounceCounter)
             {
                 /* The timer interrupt needs to be stopped and the
                  * attachDebouncing flag needs to be reset. This stops attach
@@ -2801,7 +2809,7 @@ void F_DRV_USBFS_HOST_Tasks_ISR(DRV_USBFS_OBJ * pusbdrvObj)
             /* The HCD is presently generating reset signalling */
             pusbdrvObj->resetDuration ++;
 
-            if(DRV_USBFS_HOST_RESET_DURATION ==  pusbdrvObj->resetDuration)
+            if(gDrvUSBFSHostResetDuration <= pusbdrvObj->resetDuration)
             {
                 /* This controller seems to need some time to detect speed after
                  * resetting is complete to detect speed. So what we will do is
@@ -2811,7 +2819,7 @@ void F_DRV_USBFS_HOST_Tasks_ISR(DRV_USBFS_OBJ * pusbdrvObj)
                 PLIB_USB_ResetSignalDisable(usbID);
             }
 
-            if((DRV_USBFS_HOST_RESET_DURATION + 1U) <= pusbdrvObj->resetDuration)
+            if((gDrvUSBFSHostResetDuration + 1U) <= pusbdrvObj->resetDuration)
             {
                 /* The resetting has completed and we are ready to detect the
                  * speed of the attached device. */
@@ -3655,4 +3663,82 @@ void DRV_USBFS_HOST_EndpointToggleClear
     
 } /* End of DRV_USBFS_HOST_EndpointToggleClear() */
 
+// ****************************************************************************
+/* Function:
+    void DRV_USBFS_HOST_TimingSet
+    (
+        uint32_t attachDebounce,
+        uint32_t resetDuration
+    )
+
+  Summary:
+    Sets the root hub attach debounce and reset durations.
+
+  Description:
+    This function sets the attach debounce and port reset durations counted in
+    the 1 msec interrupt. Values below the USB specification minimums are
+    raised to the minimums.
+
+  Remarks:
+    Refer to drv_usbfs.h for usage information.
+*/
+
+void DRV_USBFS_HOST_TimingSet
+(
+    uint32_t attachDebounce,
+    uint32_t resetDuration
+)
+{
+    if(attachDebounce < DRV_USBFS_HOST_ATTACH_DEBOUNCE_MIN)
+    {
+        attachDebounce = DRV_USBFS_HOST_ATTACH_DEBOUNCE_MIN;
+    }
+
+    if(resetDuration < DRV_USBFS_HOST_RESET_DURATION_MIN)
+    {
+        resetDuration = DRV_USBFS_HOST_RESET_DURATION_MIN;
+    }
+
+    gDrvUSBFSHostAttachDebounce = attachDebounce;
+    gDrvUSBFSHostResetDuration = resetDuration;
+
+} /* End of DRV_USBFS_HOST_TimingSet() */
+
+// ****************************************************************************
+/* Function:
+    void DRV_USBFS_HOST_TimingGet
+    (
+        uint32_t * attachDebounce,
+        uint32_t * resetDuration
+    )
+
+  Summary:
+    Returns the root hub attach debounce and reset durations.
+
+  Description:
+    This function returns the attach debounce and port reset durations in
+    milliseconds.
+
+  Remarks:
+    Refer to drv_usbfs.h for usage information.
+*/
+
+void DRV_USBFS_HOST_TimingGet
+(
+    uint32_t * attachDebounce,
+    uint32_t * resetDuration
+)
+{
+    if(attachDebounce != NULL)
+    {
+        *attachDebounce = gDrvUSBFSHostAttachDebounce;
+    }
+
+    if(resetDuration != NULL)
+    {
+        *resetDuration = gDrvUSBFSHostResetDuration;
+    }
+
+} /* End of DRV_USBFS_HOST_TimingGet() */
+
 /* MISRAC 2012 deviation block end */
\ No newline at end of file
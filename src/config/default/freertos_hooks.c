@@ -155,6 +155,20 @@ void vApplicationTickHook( void )
 
 /*-----------------------------------------------------------*/
 
+/* Memria da task Idle (configSUPPORT_STATIC_ALLOCATION = 1) */
+void vApplicationGetIdleTaskMemory( StaticTask_t ** ppxIdleTaskTCBBuffer,
+                                    StackType_t ** ppxIdleTaskStackBuffer,
+                                    configSTACK_DEPTH_TYPE * puxIdleTaskStackSize )
+{
+    static StaticTask_t xIdleTaskTCB;
+    static StackType_t uxIdleTaskStack[ configMINIMAL_STACK_SIZE ];
+
+    *ppxIdleTaskTCBBuffer = &xIdleTaskTCB;
+    *ppxIdleTaskStackBuffer = uxIdleTaskStack;
+    *puxIdleTaskStackSize = configMINIMAL_STACK_SIZE;
+}
+/*-----------------------------------------------------------*/
+
 /* Error Handler */
 void vAssertCalled( const char * pcFile, unsigned long ulLine )
 {
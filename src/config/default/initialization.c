@@ -355,10 +355,15 @@ void SYS_Initialize ( void* data )
     APP_USB_Initialize();
     MENU_DISPLAY_Initialize();
     MEDIDA_GB_Initialize();
+    AQUISICAO_GB_Initialize();
+    DIAG_SIS_Initialize();
 
 
     EVIC_Initialize();
 
+    /* Confere o esquema de prioridades (isr_latencia.h) e zera as medidas */
+    ISR_LAT_Initialize();
+
 	/* Enable global interrupts */
     (void)__builtin_enable_interrupts();
 
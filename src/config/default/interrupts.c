@@ -51,6 +51,7 @@
 #include "configuration.h"
 #include "interrupts.h"
 #include "definitions.h"
+#include "isr_latencia.h"
 
 
 
@@ -81,6 +82,7 @@ void UART2_TX_Handler (void);
 void TIMER_6_Handler (void);
 void TIMER_7_Handler (void);
 void ADC_EOS_Handler (void);
+void DMA1_Handler (void);
 
 
 // *****************************************************************************
@@ -90,74 +92,138 @@ void ADC_EOS_Handler (void);
 // *****************************************************************************
 void __attribute__((used)) CORE_TIMER_Handler (void)
 {
+    uint32_t entrada = ISR_LAT_AGORA();
+    // O contador passou de COMPARE desde a interrupo
+    uint32_t latencia = entrada - _CP0_GET_COMPARE();
+
     CORE_TIMER_InterruptHandler();
+    ISR_LAT_Registra(ISR_LAT_CORE_TIMER, entrada, latencia);
 }
 
 
 
 void __attribute__((used)) TIMER_2_Handler (void)
 {
+    uint32_t entrada = ISR_LAT_AGORA();
+    // O TMR2 (1:1, mesmo clock do core timer) conta desde o "match"
+    uint32_t latencia = TMR2;
+
     TIMER_2_InterruptHandler();
+    ISR_LAT_Registra(ISR_LAT_TMR2, entrada, latencia);
 }
 
 void __attribute__((used)) TIMER_3_Handler (void)
 {
+    uint32_t entrada = ISR_LAT_AGORA();
+    // O TMR3 (1:1, mesmo clock do core timer) conta desde o "match"
+    uint32_t latencia = TMR3;
+
     TIMER_3_InterruptHandler();
+    ISR_LAT_Registra(ISR_LAT_TMR3, entrada, latencia);
 }
 
 void __attribute__((used)) USB_1_Handler (void)
 {
+    uint32_t entrada = ISR_LAT_AGORA();
+    // Attach/detach acordam a task do host USB (o driver limpa as flags)
+    uint32_t conexao = U1IR & U1IE & APP_USB_INT_CONEXAO;
+
     DRV_USBFS_USB1_Handler();
+    if (conexao != 0U)
+        APP_USB_HostAcordaFromISR(conexao);
+    ISR_LAT_Registra(ISR_LAT_USB, entrada, ISR_LAT_SEM_LATENCIA);
 }
 
 void __attribute__((used)) CHANGE_NOTICE_A_Handler (void)
 {
+    uint32_t entrada = ISR_LAT_AGORA();
+
     CHANGE_NOTICE_A_InterruptHandler();
+    ISR_LAT_Registra(ISR_LAT_BOTOES, entrada, ISR_LAT_SEM_LATENCIA);
 }
 
 void __attribute__((used)) CHANGE_NOTICE_B_Handler (void)
 {
+    uint32_t entrada = ISR_LAT_AGORA();
+
     CHANGE_NOTICE_B_InterruptHandler();
+    ISR_LAT_Registra(ISR_LAT_BOTOES, entrada, ISR_LAT_SEM_LATENCIA);
 }
 
 void __attribute__((used)) CHANGE_NOTICE_C_Handler (void)
 {
+    uint32_t entrada = ISR_LAT_AGORA();
+
     CHANGE_NOTICE_C_InterruptHandler();
+    ISR_LAT_Registra(ISR_LAT_ZERO_CROSS, entrada, ISR_LAT_SEM_LATENCIA);
 }
 
 void __attribute__((used)) CHANGE_NOTICE_G_Handler (void)
 {
+    uint32_t entrada = ISR_LAT_AGORA();
+
     CHANGE_NOTICE_G_InterruptHandler();
+    ISR_LAT_Registra(ISR_LAT_BOTOES, entrada, ISR_LAT_SEM_LATENCIA);
 }
 
 void __attribute__((used)) UART2_FAULT_Handler (void)
 {
+    uint32_t entrada = ISR_LAT_AGORA();
+
     UART2_FAULT_InterruptHandler();
+    ISR_LAT_Registra(ISR_LAT_UART2, entrada, ISR_LAT_SEM_LATENCIA);
 }
 
 void __attribute__((used)) UART2_RX_Handler (void)
 {
+    uint32_t entrada = ISR_LAT_AGORA();
+
     UART2_RX_InterruptHandler();
+    ISR_LAT_Registra(ISR_LAT_UART2, entrada, ISR_LAT_SEM_LATENCIA);
 }
 
 void __attribute__((used)) UART2_TX_Handler (void)
 {
+    uint32_t entrada = ISR_LAT_AGORA();
+
     UART2_TX_InterruptHandler();
+    ISR_LAT_Registra(ISR_LAT_UART2, entrada, ISR_LAT_SEM_LATENCIA);
 }
 
 void __attribute__((used)) TIMER_6_Handler (void)
 {
+    uint32_t entrada = ISR_LAT_AGORA();
+    // O TMR6 (1:8) conta desde o "match": atraso da borda do gate
+    uint32_t latencia = TMR6 * ISR_LAT_CORE_POR_TMR_DIV8;
+
     TIMER_6_InterruptHandler();
+    ISR_LAT_Registra(ISR_LAT_TMR6, entrada, latencia);
 }
 
 void __attribute__((used)) TIMER_7_Handler (void)
 {
+    uint32_t entrada = ISR_LAT_AGORA();
+    // O TMR7 (1:8) conta desde o "match"
+    uint32_t latencia = TMR7 * ISR_LAT_CORE_POR_TMR_DIV8;
+
     TIMER_7_InterruptHandler();
+    ISR_LAT_Registra(ISR_LAT_TMR7, entrada, latencia);
 }
 
 void __attribute__((used)) ADC_EOS_Handler (void)
 {
+    uint32_t entrada = ISR_LAT_AGORA();
+
     ADC_EOS_InterruptHandler();
+    ISR_LAT_Registra(ISR_LAT_ADC_EOS, entrada, ISR_LAT_SEM_LATENCIA);
+}
+
+void __attribute__((used)) DMA1_Handler (void)
+{
+    uint32_t entrada = ISR_LAT_AGORA();
+
+    DMA1_InterruptHandler();
+    ISR_LAT_Registra(ISR_LAT_DMA1, entrada, ISR_LAT_SEM_LATENCIA);
 }
 
 
@@ -70,6 +70,7 @@ void UART2_TX_InterruptHandler( void );
 void TIMER_6_InterruptHandler( void );
 void TIMER_7_InterruptHandler( void );
 void ADC_EOS_InterruptHandler( void );
+void DMA1_InterruptHandler( void );
 
 
 
@@ -60,6 +60,15 @@
 // Section: RTOS "Tasks" Routine
 // *****************************************************************************
 // *****************************************************************************
+/* Pilha e TCB estticos de cada task: nenhuma task usa o heap */
+#define TASK_PILHA(pilha)   (sizeof(pilha) / sizeof((pilha)[0]))
+
+static StackType_t xUSB_HOST_TasksStack[1024];
+static StaticTask_t xUSB_HOST_TasksTCB;
+
+/* Handle for the USB_HOST_Tasks. */
+TaskHandle_t xUSB_HOST_Tasks;
+
 void F_USB_HOST_Tasks(  void *pvParameters  )
 {
     while(true)
@@ -68,13 +77,18 @@ void F_USB_HOST_Tasks(  void *pvParameters  )
         DRV_USBFS_Tasks(sysObj.drvUSBFSObject0);
         /* USB Host layer tasks routine */ 
         USB_HOST_Tasks(sysObj.usbHostObject0);
-        vTaskDelay(10U / portTICK_PERIOD_MS);
+        /* Dorme at a ISR USB ou o teclado avisar; durante attach/enumerao
+         * volta a cada 10ms (app_usb.c). Uma passada por aviso: o driver do
+         * teclado trata um relatrio da fila a cada passada */
+        (void)ulTaskNotifyTake(pdFALSE, APP_USB_HostEspera());
     }
 }
 
 
 /* Handle for the APP_Tasks. */
 TaskHandle_t xAPP_Tasks;
+static StackType_t xAPP_TasksStack[1024];
+static StaticTask_t xAPP_TasksTCB;
 
 
 
@@ -88,6 +102,8 @@ void lAPP_Tasks(  void *pvParameters  )
 
 /* Handle for the APP_DISPLAY_Tasks. */
 //TaskHandle_t xAPP_DISPLAY_Tasks;
+static StackType_t xAPP_DISPLAY_TasksStack[1024];
+static StaticTask_t xAPP_DISPLAY_TasksTCB;
 
 
 
@@ -101,6 +117,8 @@ static void lAPP_DISPLAY_Tasks(  void *pvParameters  )
 
 /* Handle for the APP_USB_Tasks. */
 TaskHandle_t xAPP_USB_Tasks;
+static StackType_t xAPP_USB_TasksStack[1024];
+static StaticTask_t xAPP_USB_TasksTCB;
 
 
 
@@ -109,12 +127,14 @@ static void lAPP_USB_Tasks(  void *pvParameters  )
     while(true)
     {
         APP_USB_Tasks();
-        vTaskDelay(pdMS_TO_TICKS(10)); // Atualiza a cada 10ms ***testes
+        (void)ulTaskNotifyTake(pdTRUE, APP_USB_Espera()); // Acordada pelo callback do teclado
     }
 }
 
 /* Handle for the MENU_DISPLAY_Tasks. */
 TaskHandle_t xMENU_DISPLAY_Tasks;
+static StackType_t xMENU_DISPLAY_TasksStack[1024];
+static StaticTask_t xMENU_DISPLAY_TasksTCB;
 
 
 
@@ -128,6 +148,40 @@ static void lMENU_DISPLAY_Tasks(  void *pvParameters  )
 
 /* Handle for the MEDIDA_GB_Tasks. */
 TaskHandle_t xMEDIDA_GB_Tasks;
+static StackType_t xMEDIDA_GB_TasksStack[256];
+static StaticTask_t xMEDIDA_GB_TasksTCB;
+
+
+
+static void lMEDIDA_GB_Tasks(  void *pvParameters  )
+{   
+    while(true)
+    {
+        MEDIDA_GB_Tasks();
+    }
+}
+
+/* Handle for the MEDIDA_GB_RunTestTask. */
+/* Task do ensaio GB: criada uma vez e acordada por MEDIDA_GB_IniciaEnsaio */
+TaskHandle_t xMEDIDA_GB_TesteTask;
+static StackType_t xMEDIDA_GB_TesteTaskStack[1024];
+static StaticTask_t xMEDIDA_GB_TesteTaskTCB;
+
+/* Handle for the DIAG_SIS_Tasks. */
+TaskHandle_t xDIAG_SIS_Tasks;
+static StackType_t xDIAG_SIS_TasksStack[512];
+static StaticTask_t xDIAG_SIS_TasksTCB;
+
+
+
+static void lDIAG_SIS_Tasks(  void *pvParameters  )
+{   
+    while(true)
+    {
+        DIAG_SIS_Tasks();
+        vTaskDelay(pdMS_TO_TICKS(DIAG_SIS_PERIODO_MS)); // L o console a cada 50ms
+    }
+}
 
 // *****************************************************************************
 // *****************************************************************************
@@ -154,12 +208,16 @@ void SYS_Tasks ( void )
     /* Maintain Middleware & Other Libraries */
     
     /* Create OS Thread for USB_HOST_Tasks. */
-    (void) xTaskCreate( F_USB_HOST_Tasks,
+    /* Abaixo das tasks do GB: a prioridade 5 gerada era limitada pelo kernel
+     * a configMAX_PRIORITIES - 1 e dividia a fatia de tempo com a
+     * MEDIDA_GB_Tasks, escritora do seqlock de MEDIDA_GB_LeituraGet. */
+    xUSB_HOST_Tasks = xTaskCreateStatic( F_USB_HOST_Tasks,
         "USB_HOST_TASKS",
-        1024,
+        TASK_PILHA(xUSB_HOST_TasksStack),
         (void*)NULL,
-        5,
-        (TaskHandle_t*)NULL
+        (configMAX_PRIORITIES - 3U),
+        xUSB_HOST_TasksStack,
+        &xUSB_HOST_TasksTCB
     );
 
 
@@ -167,40 +225,83 @@ void SYS_Tasks ( void )
     /* Maintain the application's state machine. */
     
     /* Create OS Thread for APP_Tasks. */
-    (void) xTaskCreate(
+    xAPP_Tasks = xTaskCreateStatic(
            (TaskFunction_t) lAPP_Tasks,
            "APP_Tasks",
-           1024,
+           TASK_PILHA(xAPP_TasksStack),
            NULL,
            1U ,
-           &xAPP_Tasks);
+           xAPP_TasksStack,
+           &xAPP_TasksTCB);
 
     /* Create OS Thread for APP_DISPLAY_Tasks. */
-    (void) xTaskCreate(
+    xAPP_DISPLAY_Tasks = xTaskCreateStatic(
            (TaskFunction_t) lAPP_DISPLAY_Tasks,
            "APP_DISPLAY_Tasks",
-           1024,
+           TASK_PILHA(xAPP_DISPLAY_TasksStack),
            NULL,
            1U ,
-           &xAPP_DISPLAY_Tasks);
+           xAPP_DISPLAY_TasksStack,
+           &xAPP_DISPLAY_TasksTCB);
 
     /* Create OS Thread for APP_USB_Tasks. */
-    (void) xTaskCreate(
+    /* Mantm a ordem gerada (6, acima da USB_HOST_Tasks), mas abaixo das
+     * tasks do GB, pelo mesmo motivo da USB_HOST_Tasks. */
+    xAPP_USB_Tasks = xTaskCreateStatic(
            (TaskFunction_t) lAPP_USB_Tasks,
            "APP_USB_Tasks",
-           1024,
+           TASK_PILHA(xAPP_USB_TasksStack),
            NULL,
-           6U ,
-           &xAPP_USB_Tasks);
+           (configMAX_PRIORITIES - 2U) ,
+           xAPP_USB_TasksStack,
+           &xAPP_USB_TasksTCB);
 
     /* Create OS Thread for MENU_DISPLAY_Tasks. */
-    (void) xTaskCreate(
+    xMENU_DISPLAY_Tasks = xTaskCreateStatic(
            (TaskFunction_t) lMENU_DISPLAY_Tasks,
            "MENU_DISPLAY_Tasks",
-           1024,
+           TASK_PILHA(xMENU_DISPLAY_TasksStack),
+           NULL,
+           1U ,
+           xMENU_DISPLAY_TasksStack,
+           &xMENU_DISPLAY_TasksTCB);
+
+    /* Create OS Thread for MEDIDA_GB_Tasks. */
+    /* Processa os blocos de amostras do ensaio GB, acordada pela ISR do TMR2.
+     * Pouca pilha (s contas inteiras) e prioridade mxima, para esvaziar o
+     * anel de blocos antes que a ISR precise descartar amostras. */
+    xMEDIDA_GB_Tasks = xTaskCreateStatic(
+           (TaskFunction_t) lMEDIDA_GB_Tasks,
+           "MEDIDA_GB_Tasks",
+           TASK_PILHA(xMEDIDA_GB_TasksStack),
+           NULL,
+           (configMAX_PRIORITIES - 1U) ,
+           xMEDIDA_GB_TasksStack,
+           &xMEDIDA_GB_TasksTCB);
+
+    /* Create OS Thread for MEDIDA_GB_RunTestTask. */
+    /* Dorme at o menu pedir um ensaio. Mesma prioridade da MEDIDA_GB_Tasks:
+     * o kernel j limitava a prioridade 7 pedida antes a configMAX_PRIORITIES - 1. */
+    xMEDIDA_GB_TesteTask = xTaskCreateStatic(
+           (TaskFunction_t) MEDIDA_GB_RunTestTask,
+           "MEDIDA_GB",
+           TASK_PILHA(xMEDIDA_GB_TesteTaskStack),
+           NULL,
+           (configMAX_PRIORITIES - 1U) ,
+           xMEDIDA_GB_TesteTaskStack,
+           &xMEDIDA_GB_TesteTaskTCB);
+
+    /* Create OS Thread for DIAG_SIS_Tasks. */
+    /* Comandos de diagnstico no console (stats, isr, gb). Prioridade mnima
+     * das apps: s imprime quando sobra CPU. */
+    xDIAG_SIS_Tasks = xTaskCreateStatic(
+           (TaskFunction_t) lDIAG_SIS_Tasks,
+           "DIAG_SIS_Tasks",
+           TASK_PILHA(xDIAG_SIS_TasksStack),
            NULL,
            1U ,
-           &xMENU_DISPLAY_Tasks);
+           xDIAG_SIS_TasksStack,
+           &xDIAG_SIS_TasksTCB);
 
     /* Start RTOS Scheduler. */
     
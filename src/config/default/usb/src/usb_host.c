@@ -104,6 +104,21 @@ static USB_HOST_PIPE_OBJ  gUSBHostPipeObj[ USB_HOST_PIPES_NUMBER ];
  ************************************************************/
 static USB_HOST_TRANSFER_OBJ gUSBHostTransferObj[ USB_HOST_TRANSFERS_NUMBER ];
 
+/************************************************************
+ * SYS_TIME counter value at each stage of the last device
+ * enumeration. Written by the host layer, including the
+ * root hub attach callback (USB_HOST_DeviceEnumerate, in
+ * interrupt context), and by the class drivers.
+ ************************************************************/
+static volatile uint32_t gUSBHostEnumerationTimes[ USB_HOST_ENUMERATION_STAGES ];
+
+/************************************************************
+ * Enumeration delays in milliseconds. These can be changed
+ * at run time with USB_HOST_EnumerationDelaysSet().
+ ************************************************************/
+static uint32_t gUSBHostResetSettlingDelay = USB_HOST_RESET_SETTLING_DELAY;
+static uint32_t gUSBHostPostSetAddressDelay = USB_HOST_POST_SET_ADDRESS_DELAY;
+
 // *****************************************************************************
 // *****************************************************************************
 // Section: USB HOST Layer Local Functions
@@ -1997,6 +2012,7 @@ void F_USB_HOST_MakeDeviceReady
                      * device. We give a reset recovery delay to the device */
                     deviceObj->speed = deviceObj->hubInterface->hubPortSpeedGet(deviceObj->hubHandle, deviceObj->devicePort);
                     deviceObj->deviceState = USB_HOST_DEVICE_STATE_START_RESET_SETTLING_DELAY;
+                    USB_HOST_EnumerationStageStamp(USB_HOST_ENUMERATION_STAGE_RESET);
                 }
 
                 break;
@@ -2005,7 +2021,7 @@ void F_USB_HOST_MakeDeviceReady
 
                 /* In this state we start the Post Reset Settling delay */
                 busObj->timerExpired = false;
-                busObj->busOperationsTimerHandle = SYS_TMR_CallbackSingle(100, (uintptr_t ) busObj, F_USB_HOST_TimerCallback);
+                busObj->busOperationsTimerHandle = SYS_TMR_CallbackSingle(gUSBHostResetSettlingDelay, (uintptr_t ) busObj, F_USB_HOST_TimerCallback);
                 if(SYS_TMR_HANDLE_INVALID != busObj->busOperationsTimerHandle)
                 {
                     /* Wait for the post bus reset to complete */
@@ -2104,6 +2120,7 @@ void F_USB_HOST_MakeDeviceReady
                      * descriptor. We can move to addressing state. */
 
                     deviceObj->deviceState = USB_HOST_DEVICE_STATE_SET_ADDRESS;
+                    USB_HOST_EnumerationStageStamp(USB_HOST_ENUMERATION_STAGE_DEVICE_DESCRIPTOR);
 
                     /* Reset the enumeration failure count */
                     deviceObj->enumerationFailCount = 0;
@@ -2302,10 +2319,10 @@ void F_USB_HOST_MakeDeviceReady
 
             case USB_HOST_DEVICE_STATE_POST_SET_ADDRESS_DELAY:
 
-                /* After the address has been set, we provide a delay of 50
-                 * milliseconds */
+                /* After the address has been set, we provide a delay of
+                 * gUSBHostPostSetAddressDelay milliseconds */
                 busObj->timerExpired = false;
-                busObj->busOperationsTimerHandle = SYS_TMR_CallbackSingle( 50, (uintptr_t ) busObj, F_USB_HOST_TimerCallback);;
+                busObj->busOperationsTimerHandle = SYS_TMR_CallbackSingle( gUSBHostPostSetAddressDelay, (uintptr_t ) busObj, F_USB_HOST_TimerCallback);
 
                 if(SYS_TMR_HANDLE_INVALID != busObj->busOperationsTimerHandle)
                 {
@@ -2321,6 +2338,7 @@ void F_USB_HOST_MakeDeviceReady
                 {
                     busObj->busOperationsTimerHandle = SYS_TMR_HANDLE_INVALID ;
                     SYS_DEBUG_PRINT(SYS_ERROR_INFO, "\r\nUSB Host Layer: Bus %d Post Set Address Delay completed.", busIndex);
+                    USB_HOST_EnumerationStageStamp(USB_HOST_ENUMERATION_STAGE_ADDRESS);
                     SYS_DEBUG_PRINT(SYS_ERROR_INFO, "\r\nUSB Host Layer: Bus %d Device %d Requesting Full Device Descriptor.", busIndex, deviceObj->deviceAddress);
                     deviceObj->deviceState = USB_HOST_DEVICE_STATE_GET_DEVICE_DESCRIPTOR_FULL;
                 }
@@ -2638,6 +2656,7 @@ void F_USB_HOST_MakeDeviceReady
                              * device to the ready state */
 
                             deviceObj->deviceState = USB_HOST_DEVICE_STATE_READY;
+                            USB_HOST_EnumerationStageStamp(USB_HOST_ENUMERATION_STAGE_CONFIGURATION);
 
                             /* Release the control transfer object */
                             deviceObj->controlTransferObj.inUse = false;
@@ -3655,6 +3674,227 @@ USB_HOST_RESULT USB_HOST_DeviceSpeedGet
     return(result);
 }
 
+// *****************************************************************************
+/* Function:
+    USB_HOST_RESULT USB_HOST_DeviceDescriptorGet
+    (
+        USB_HOST_DEVICE_OBJ_HANDLE deviceObjHandle,
+        USB_DEVICE_DESCRIPTOR * deviceDescriptor
+    );
+
+  Summary:
+    Returns a copy of the device descriptor.
+
+  Description:
+    This function copies the device descriptor that the host layer obtained
+    during enumeration.
+
+  Remarks:
+    Refer to usb_host_client_driver.h for usage information.
+*/
+
+USB_HOST_RESULT USB_HOST_DeviceDescriptorGet
+(
+    USB_HOST_DEVICE_OBJ_HANDLE deviceObjHandle,
+    USB_DEVICE_DESCRIPTOR * deviceDescriptor
+)
+{
+    USB_HOST_RESULT  result = USB_HOST_RESULT_SUCCESS;
+    uint32_t index = 0;
+    USB_HOST_DEVICE_OBJ * deviceObj = NULL;
+
+    /* Check if the parameter is NULL */
+    if(NULL == deviceDescriptor)
+    {
+       result = USB_HOST_RESULT_PARAMETER_INVALID;
+    }
+    else
+    {
+       /* Check if the device index is valid */
+        index = USB_HOST_DEVICE_INDEX(deviceObjHandle);
+        if( (USB_HOST_DEVICES_NUMBER + USB_HOST_CONTROLLERS_NUMBER ) <=  index) 
+        {
+            result = USB_HOST_RESULT_DEVICE_UNKNOWN;
+        }
+        else
+        {
+            /* Get the pointer to the device object */
+            deviceObj = &gUSBHostDeviceList[index];
+
+            /* Validate the plug and play identifier */
+            if((!deviceObj->inUse) ||
+                    (USB_HOST_PNP_IDENTIFIER(deviceObj->deviceIdentifier ) != USB_HOST_PNP_IDENTIFIER(deviceObjHandle)))
+            {
+                /* The device handle is pointing to a device that does not exist
+                 * in the system */
+                result = USB_HOST_RESULT_DEVICE_UNKNOWN;
+            }
+            else
+            {
+                /* Everything checks out. Copy the device descriptor */
+                (void) memcpy(deviceDescriptor, &deviceObj->deviceDescriptor, sizeof(USB_DEVICE_DESCRIPTOR));
+            }
+        }
+    }
+
+    return(result);
+}
+
+// *****************************************************************************
+/* Function:
+    void USB_HOST_EnumerationStageStamp
+    (
+        USB_HOST_ENUMERATION_STAGE stage
+    )
+
+  Summary:
+    Records the time at which an enumeration stage was reached.
+
+  Description:
+    This function stores the current SYS_TIME counter value for the specified
+    stage. The attach stage starts a new enumeration and clears the other
+    stages.
+
+  Remarks:
+    See usb_host.h for usage information.
+*/
+
+void USB_HOST_EnumerationStageStamp
+(
+    USB_HOST_ENUMERATION_STAGE stage
+)
+{
+    uint32_t index;
+    uint32_t now;
+
+    if((uint32_t)stage < (uint32_t)USB_HOST_ENUMERATION_STAGES)
+    {
+        /* A counter value of 0 means "not reached" */
+        now = SYS_TIME_CounterGet();
+        if(now == 0U)
+        {
+            now = 1U;
+        }
+
+        if(stage == USB_HOST_ENUMERATION_STAGE_ATTACH)
+        {
+            for(index = 1U; index < (uint32_t)USB_HOST_ENUMERATION_STAGES; index ++)
+            {
+                gUSBHostEnumerationTimes[index] = 0U;
+            }
+        }
+
+        gUSBHostEnumerationTimes[stage] = now;
+    }
+}
+
+// *****************************************************************************
+/* Function:
+    void USB_HOST_EnumerationTimesGet
+    (
+        uint32_t times[USB_HOST_ENUMERATION_STAGES]
+    )
+
+  Summary:
+    Returns the time stamps of the last device enumeration.
+
+  Description:
+    This function copies the time stamps of the last device enumeration.
+
+  Remarks:
+    See usb_host.h for usage information.
+*/
+
+void USB_HOST_EnumerationTimesGet
+(
+    uint32_t times[USB_HOST_ENUMERATION_STAGES]
+)
+{
+    uint32_t index;
+
+    if(times != NULL)
+    {
+        for(index = 0U; index < (uint32_t)USB_HOST_ENUMERATION_STAGES; index ++)
+        {
+            times[index] = gUSBHostEnumerationTimes[index];
+        }
+    }
+}
+
+// *****************************************************************************
+/* Function:
+    void USB_HOST_EnumerationDelaysSet
+    (
+        uint32_t resetSettling,
+        uint32_t postSetAddress
+    )
+
+  Summary:
+    Sets the enumeration delays applied by the host layer.
+
+  Description:
+    This function sets the reset recovery and post Set Address delays. Values
+    below the USB specification minimums are raised to the minimums.
+
+  Remarks:
+    See usb_host.h for usage information.
+*/
+
+void USB_HOST_EnumerationDelaysSet
+(
+    uint32_t resetSettling,
+    uint32_t postSetAddress
+)
+{
+    if(resetSettling < USB_HOST_RESET_SETTLING_DELAY_MIN)
+    {
+        resetSettling = USB_HOST_RESET_SETTLING_DELAY_MIN;
+    }
+
+    if(postSetAddress < USB_HOST_POST_SET_ADDRESS_DELAY_MIN)
+    {
+        postSetAddress = USB_HOST_POST_SET_ADDRESS_DELAY_MIN;
+    }
+
+    gUSBHostResetSettlingDelay = resetSettling;
+    gUSBHostPostSetAddressDelay = postSetAddress;
+}
+
+// *****************************************************************************
+/* Function:
+    void USB_HOST_EnumerationDelaysGet
+    (
+        uint32_t * resetSettling,
+        uint32_t * postSetAddress
+    )
+
+  Summary:
+    Returns the enumeration delays applied by the host layer.
+
+  Description:
+    This function returns the reset recovery and post Set Address delays.
+
+  Remarks:
+    See usb_host.h for usage information.
+*/
+
+void USB_HOST_EnumerationDelaysGet
+(
+    uint32_t * resetSettling,
+    uint32_t * postSetAddress
+)
+{
+    if(resetSettling != NULL)
+    {
+        *resetSettling = gUSBHostResetSettlingDelay;
+    }
+
+    if(postSetAddress != NULL)
+    {
+        *postSetAddress = gUSBHostPostSetAddressDelay;
+    }
+}
+
 // *****************************************************************************
 /* Function:
     USB_HOST_RESULT USB_HOST_BusEnable(USB_HOST_BUS bus)
@@ -4125,6 +4365,10 @@ USB_HOST_DEVICE_OBJ_HANDLE USB_HOST_DeviceEnumerate
     USB_HOST_DEVICE_OBJ_HANDLE result = USB_HOST_DEVICE_OBJ_HANDLE_INVALID;
     USB_CONFIGURATION_DESCRIPTOR * configurationDescriptor = NULL;
 
+    /* The root hub calls this after the attach debounce. A new
+     * enumeration starts here */
+    USB_HOST_EnumerationStageStamp(USB_HOST_ENUMERATION_STAGE_ATTACH);
+
     /* Get the bus number and the device object index of the parent device. This
      * is needed to get the bus object and the parent device object */
 
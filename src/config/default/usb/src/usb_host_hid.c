@@ -119,6 +119,30 @@ static USB_HOST_HID_INSTANCE  gUSBHostHIDInstance[USB_HOST_HID_INSTANCES_NUMBER]
 volatile uint8_t gUSBHostHIDReadBuffer[USB_HOST_HID_INSTANCES_NUMBER][64] USB_ALIGN;
 volatile uint8_t gUSBHostHIDWriteBuffer[USB_HOST_HID_INSTANCES_NUMBER][64] USB_ALIGN;
 
+/**************************************************
+ * Report descriptor cache. Holds the descriptor and
+ * the parse results of the last devices attached, so
+ * that a known device skips GET REPORT DESCRIPTOR.
+ **************************************************/
+static USB_HOST_HID_DESCRIPTOR_CACHE_ENTRY gUSBHostHIDDescCache
+        [USB_HOST_HID_DESCRIPTOR_CACHE_NUMBER];
+static uint32_t gUSBHostHIDDescCacheSequence = 0;
+static uint32_t gUSBHostHIDDescCacheHits = 0;
+static uint32_t gUSBHostHIDDescCacheMisses = 0;
+
+/**************************************************
+ * Set by USB_HOST_HID_DescriptorCacheClear() from
+ * any thread. The cache is emptied by the HID task
+ * routine, which is the only user of the entries.
+ **************************************************/
+static volatile bool gUSBHostHIDDescCacheClearPending = false;
+
+/**************************************************
+ * Called after every transfer complete and pipe
+ * halt clear complete interface event.
+ **************************************************/
+static USB_HOST_HID_INTERFACE_EVENT_NOTIFY gUSBHostHIDInterfaceEventNotify = NULL;
+
 // *****************************************************************************
 // *****************************************************************************
 // USB Host HID Local Functions
@@ -2014,6 +2038,220 @@ USB_HOST_HID_RESULT F_USB_HOST_HID_ReportDescriptorGet
     return status;
 }/* end of F_USB_HOST_HID_ReportDescriptorGet () */
 
+
+/*************************************************************************/
+/* Function:
+    bool F_USB_HOST_HID_DescriptorCacheLoad
+    (
+        uint8_t hidInstanceIndex
+    )
+
+  Summary:
+    Loads the report descriptor and top level usages from the cache.
+
+  Description:
+    Function looks up the attached device in the report descriptor cache.
+    On a hit the report descriptor is copied to reportDescBuffer and the top
+    level usages are restored, so that GET REPORT DESCRIPTOR and the parsing
+    of the descriptor can be skipped. On a miss the instance remembers the
+    key so that F_USB_HOST_HID_DescriptorCacheStore() can fill an entry.
+
+  Remarks:
+    This is local function and should not be called directly by the application.
+*/
+bool F_USB_HOST_HID_DescriptorCacheLoad
+(
+    uint8_t hidInstanceIndex
+)
+{
+    /* Start of local variable */
+    USB_HOST_HID_INSTANCE *hidInstanceInfo =
+            &(gUSBHostHIDInstance[hidInstanceIndex]);
+    USB_HOST_HID_DESCRIPTOR_CACHE_ENTRY *entry = NULL;
+    USB_DEVICE_DESCRIPTOR deviceDescriptor;
+    uint8_t iterator = 0;
+    uint8_t loop = 0;
+    bool hit = false;
+    /* End of local variable */
+
+    hidInstanceInfo->descCacheIndex = USB_HOST_HID_DESCRIPTOR_CACHE_INVALID;
+
+    if((hidInstanceInfo->reportDescLength == 0U) ||
+            (hidInstanceInfo->reportDescLength > USB_HOST_HID_DESCRIPTOR_CACHE_SIZE) ||
+            (USB_HOST_RESULT_SUCCESS != USB_HOST_DeviceDescriptorGet
+                (hidInstanceInfo->deviceObjHandle, &deviceDescriptor)))
+    {
+        /* Descriptor does not fit in the cache */
+        gUSBHostHIDDescCacheMisses++;
+        return false;
+    }
+
+    for(iterator = 0; iterator < USB_HOST_HID_DESCRIPTOR_CACHE_NUMBER; iterator++)
+    {
+        entry = &gUSBHostHIDDescCache[iterator];
+        if((entry->inUse) &&
+                (entry->idVendor == deviceDescriptor.idVendor) &&
+                (entry->idProduct == deviceDescriptor.idProduct) &&
+                (entry->bcdDevice == deviceDescriptor.bcdDevice) &&
+                (entry->bInterfaceNumber == hidInstanceInfo->bInterfaceNumber) &&
+                (entry->reportDescLength == hidInstanceInfo->reportDescLength))
+        {
+            break;
+        }
+    }
+
+    if(iterator < USB_HOST_HID_DESCRIPTOR_CACHE_NUMBER)
+    {
+        /* Known device. Same buffer handling as GET REPORT DESCRIPTOR */
+        if(NULL != hidInstanceInfo->reportDescBuffer)
+        {
+            USB_HOST_FREE(hidInstanceInfo->reportDescBuffer);
+            hidInstanceInfo->reportDescBuffer = NULL;
+        }
+        hidInstanceInfo->reportDescBuffer = 
+                USB_HOST_MALLOC((size_t)(hidInstanceInfo->reportDescLength));
+        if(NULL != hidInstanceInfo->reportDescBuffer)
+        {
+            (void) memcpy(hidInstanceInfo->reportDescBuffer, entry->reportDesc,
+                    hidInstanceInfo->reportDescLength);
+            (void) memcpy(hidInstanceInfo->topLevelUsages, entry->topLevelUsages,
+                    sizeof(hidInstanceInfo->topLevelUsages));
+            hidInstanceInfo->nTopLevelUsages = entry->nTopLevelUsages;
+            hidInstanceInfo->collectionNestingLevel = 0;
+            entry->lastUse = ++gUSBHostHIDDescCacheSequence;
+            hit = true;
+        }
+    }
+    else
+    {
+        /* Pick a free entry or the least recently used one. It is filled
+         * once the descriptor has been fetched and parsed. */
+        iterator = 0;
+        for(loop = 1; loop < USB_HOST_HID_DESCRIPTOR_CACHE_NUMBER; loop++)
+        {
+            if(!gUSBHostHIDDescCache[iterator].inUse)
+            {
+                break;
+            }
+            if((!gUSBHostHIDDescCache[loop].inUse) ||
+                    (gUSBHostHIDDescCache[loop].lastUse <
+                     gUSBHostHIDDescCache[iterator].lastUse))
+            {
+                iterator = loop;
+            }
+        }
+        entry = &gUSBHostHIDDescCache[iterator];
+        entry->inUse = false;
+        entry->fieldMapValid = false;
+        entry->idVendor = deviceDescriptor.idVendor;
+        entry->idProduct = deviceDescriptor.idProduct;
+        entry->bcdDevice = deviceDescriptor.bcdDevice;
+        entry->bInterfaceNumber = hidInstanceInfo->bInterfaceNumber;
+        entry->reportDescLength = hidInstanceInfo->reportDescLength;
+    }
+
+    hidInstanceInfo->descCacheIndex = iterator;
+    if(hit)
+    {
+        gUSBHostHIDDescCacheHits++;
+    }
+    else
+    {
+        gUSBHostHIDDescCacheMisses++;
+    }
+
+    return hit;
+
+}/* end of F_USB_HOST_HID_DescriptorCacheLoad () */
+
+
+/*************************************************************************/
+/* Function:
+    void F_USB_HOST_HID_DescriptorCacheStore
+    (
+        uint8_t hidInstanceIndex
+    )
+
+  Summary:
+    Stores the report descriptor and top level usages in the cache.
+
+  Description:
+    Function fills the cache entry reserved by
+    F_USB_HOST_HID_DescriptorCacheLoad() after the report descriptor has been
+    fetched and parsed without errors.
+
+  Remarks:
+    This is local function and should not be called directly by the application.
+*/
+void F_USB_HOST_HID_DescriptorCacheStore
+(
+    uint8_t hidInstanceIndex
+)
+{
+    /* Start of local variable */
+    USB_HOST_HID_INSTANCE *hidInstanceInfo =
+            &(gUSBHostHIDInstance[hidInstanceIndex]);
+    USB_HOST_HID_DESCRIPTOR_CACHE_ENTRY *entry = NULL;
+    /* End of local variable */
+
+    if((hidInstanceInfo->descCacheIndex >= USB_HOST_HID_DESCRIPTOR_CACHE_NUMBER) ||
+            (NULL == hidInstanceInfo->reportDescBuffer))
+    {
+        return;
+    }
+
+    entry = &gUSBHostHIDDescCache[hidInstanceInfo->descCacheIndex];
+    if((entry->inUse) ||
+            (entry->reportDescLength != hidInstanceInfo->reportDescLength))
+    {
+        /* Already stored or reserved for another key */
+        return;
+    }
+
+    (void) memcpy(entry->reportDesc, hidInstanceInfo->reportDescBuffer,
+            hidInstanceInfo->reportDescLength);
+    (void) memcpy(entry->topLevelUsages, hidInstanceInfo->topLevelUsages,
+            sizeof(entry->topLevelUsages));
+    entry->nTopLevelUsages = hidInstanceInfo->nTopLevelUsages;
+    entry->fieldMapValid = false;
+    entry->lastUse = ++gUSBHostHIDDescCacheSequence;
+    entry->inUse = true;
+
+}/* end of F_USB_HOST_HID_DescriptorCacheStore () */
+
+
+/*************************************************************************/
+/* Function:
+    void F_USB_HOST_HID_DescriptorCacheEmpty(void)
+
+  Summary:
+    Discards all report descriptor cache entries.
+
+  Description:
+    Function discards all cache entries and clears the counters. HID
+    instances that were using an entry stop using it.
+
+  Remarks:
+    This is local function and should not be called directly by the application.
+    Runs in the HID task routine on a USB_HOST_HID_DescriptorCacheClear()
+    request.
+*/
+void F_USB_HOST_HID_DescriptorCacheEmpty(void)
+{
+    uint8_t iterator = 0;
+    
+    for(iterator = 0; iterator < USB_HOST_HID_INSTANCES_NUMBER; iterator++)
+    {
+        gUSBHostHIDInstance[iterator].descCacheIndex =
+                USB_HOST_HID_DESCRIPTOR_CACHE_INVALID;
+    }
+    (void) memset(gUSBHostHIDDescCache, 0, sizeof(gUSBHostHIDDescCache));
+    gUSBHostHIDDescCacheSequence = 0;
+    gUSBHostHIDDescCacheHits = 0;
+    gUSBHostHIDDescCacheMisses = 0;
+
+}/* end of F_USB_HOST_HID_DescriptorCacheEmpty () */
+
 /* MISRAC 2012 deviation block end */
 // ******************************************************************************
 /* MISRA C-2012 Rule 11.3, and 11.8 deviated below. Deviation record ID -  
@@ -2623,6 +2861,8 @@ void F_USB_HOST_HID_InterfaceAssign
         /* Save these handles */
         hidInstanceInfo->deviceObjHandle = deviceObjHandle;
         hidInstanceInfo->interfaceHandle = interfaceHandle;
+        hidInstanceInfo->descCacheIndex = USB_HOST_HID_DESCRIPTOR_CACHE_INVALID;
+        hidInstanceInfo->descCacheChecked = false;
 
         /* Get the interface descriptor pointer */
         interfaceDescriptor = (USB_INTERFACE_DESCRIPTOR *)(descriptor);
@@ -3227,6 +3467,14 @@ USB_HOST_DEVICE_INTERFACE_EVENT_RESPONSE F_USB_HOST_HID_InterfaceEventHandler
                  /* Do Nothing */
                 break;
         }
+
+        if((NULL != gUSBHostHIDInterfaceEventNotify) &&
+                ((USB_HOST_DEVICE_INTERFACE_EVENT_TRANSFER_COMPLETE == event) ||
+                (USB_HOST_DEVICE_INTERFACE_EVENT_PIPE_HALT_CLEAR_COMPLETE == event)))
+        {
+            /* The interface state changed: USB_HOST_HID_Tasks has to run */
+            gUSBHostHIDInterfaceEventNotify();
+        }
     }
     
     return returnValue;
@@ -4423,6 +4671,397 @@ USB_HOST_HID_RESULT USB_HOST_HID_MainItemGet
 }/* End of USB_HOST_HID_MainItemGet() */
 
 
+/*************************************************************************/
+/* Function:
+    USB_HOST_HID_RESULT USB_HOST_HID_FieldMapGet
+    (
+        USB_HOST_HID_OBJ_HANDLE handle,
+        USB_HOST_HID_FIELD *fields,
+        uint8_t maxFields,
+        uint8_t *nFields
+    )
+
+  Summary:
+    Function builds the field table of the top level usage.
+
+  Description:
+    Function builds the field table of the top level usage. Only the Main
+    items inside the top level collection of the handle are taken, so the
+    table of a keyboard does not get the fields of other top level usages of
+    the same interface. The report offsets are kept per report type and
+    Report ID. The table is kept in the report descriptor cache, so a device
+    that is attached again gets it without parsing the report descriptor.
+
+  Remarks:
+    None.
+*/
+
+#define USB_HOST_HID_FIELD_MAP_REPORTS 8U
+
+USB_HOST_HID_RESULT USB_HOST_HID_FieldMapGet
+(
+    USB_HOST_HID_OBJ_HANDLE handle,
+    USB_HOST_HID_FIELD *fields,
+    uint8_t maxFields,
+    uint8_t *nFields
+)
+{
+    /* Start of local variables */
+    USB_HOST_HID_LOCAL_ITEM localItem = {.delimiterBranch = 0};
+    USB_HOST_HID_GLOBAL_ITEM globalItem = {.reportSize = 0};
+    USB_HOST_HID_MAIN_ITEM mainItem = {.localItem = NULL};
+    USB_HOST_HID_RESULT result = USB_HOST_HID_RESULT_SUCCESS;
+    USB_HOST_HID_FIELD * field = NULL;
+    
+    /* Next free bit of each (report type, Report ID) seen so far */
+    uint8_t offsetTag[USB_HOST_HID_FIELD_MAP_REPORTS];
+    uint8_t offsetID[USB_HOST_HID_FIELD_MAP_REPORTS];
+    uint32_t offsetBits[USB_HOST_HID_FIELD_MAP_REPORTS];
+    uint8_t nOffsets = 0;
+    
+    uint32_t bits = 0;
+    uint8_t index = 1;
+    uint8_t loop = 0;
+    bool truncated = false;
+    
+    /* Top level collection of the handle and the one being parsed */
+    uint8_t collection = 0;
+    uint8_t topLevelCollection = 0;
+    uint8_t nestingLevel = 0;
+    
+    USB_HOST_HID_DESCRIPTOR_CACHE_ENTRY *entry = NULL;
+    uint32_t usage = 0;
+    int8_t hidInstanceIndex = 0;
+    /* End of local variables */
+
+    if((USB_HOST_HID_OBJ_HANDLE_INVALID == handle) || (NULL == fields) ||
+            (NULL == nFields))
+    {
+        return USB_HOST_HID_RESULT_PARAMETER_INVALID;
+    }
+    
+    *nFields = 0;
+    
+    hidInstanceIndex = F_USB_HOST_HID_ObjectHandleToHIDIndex(handle);
+    if(hidInstanceIndex < 0)
+    {
+        return USB_HOST_HID_RESULT_PARAMETER_INVALID;
+    }
+    usage = ((USB_HOST_HID_OBJECT_HANDLE_POOL *)handle)->usage;
+    
+    /* The top level usages are kept in the order of their collections */
+    for(loop = 0; loop < gUSBHostHIDInstance[hidInstanceIndex].nTopLevelUsages; loop++)
+    {
+        if(gUSBHostHIDInstance[hidInstanceIndex].topLevelUsages[loop] == usage)
+        {
+            collection = loop + 1U;
+            break;
+        }
+    }
+    if(0U == collection)
+    {
+        return USB_HOST_HID_RESULT_PARAMETER_INVALID;
+    }
+    
+    if(gUSBHostHIDInstance[hidInstanceIndex].descCacheIndex <
+             USB_HOST_HID_DESCRIPTOR_CACHE_NUMBER)
+    {
+        entry = &gUSBHostHIDDescCache[gUSBHostHIDInstance[hidInstanceIndex].descCacheIndex];
+        if((entry->inUse) && (entry->fieldMapValid) &&
+                (entry->usage == usage) && (entry->nFields <= maxFields))
+        {
+            /* Known device: the table was built on a previous attach */
+            (void) memcpy(fields, entry->fields,
+                    (size_t)entry->nFields * sizeof(USB_HOST_HID_FIELD));
+            *nFields = entry->nFields;
+            return USB_HOST_HID_RESULT_SUCCESS;
+        }
+    }
+    mainItem.globalItem = &globalItem;
+    mainItem.localItem = &localItem;
+    
+    /* Global items are valid across Main items: reset them only once */
+    (void) memset(&globalItem, 0, sizeof(USB_HOST_HID_GLOBAL_ITEM));
+    
+    for(;;)
+    {
+        (void) memset(&localItem, 0, sizeof(USB_HOST_HID_LOCAL_ITEM));
+        (void) memset(&(mainItem.data), 0, sizeof(USB_HID_MAIN_ITEM_OPTIONAL_DATA));
+        mainItem.tag = USB_HID_REPORT_TYPE_ERROR;
+        
+        result = USB_HOST_HID_MainItemGet(handle, index, &mainItem);
+        if(USB_HOST_HID_RESULT_FAILURE == result)
+        {
+            /* No more Main items for this top level usage */
+            result = USB_HOST_HID_RESULT_SUCCESS;
+            break;
+        }
+        if(USB_HOST_HID_RESULT_SUCCESS != result)
+        {
+            break;
+        }
+        index++;
+        
+        if((uint32_t)mainItem.tag == (uint32_t)USB_HID_MAIN_ITEM_TAG_BEGIN_COLLECTION)
+        {
+            if(0U == nestingLevel)
+            {
+                topLevelCollection++;
+            }
+            nestingLevel++;
+            continue;
+        }
+        if((uint32_t)mainItem.tag == (uint32_t)USB_HID_MAIN_ITEM_TAG_END_COLLECTION)
+        {
+            if(nestingLevel > 0U)
+            {
+                nestingLevel--;
+            }
+            continue;
+        }
+        if((0U == nestingLevel) || (topLevelCollection != collection))
+        {
+            /* Field of another top level usage */
+            continue;
+        }
+        
+        if(((uint32_t)mainItem.tag != (uint32_t)USB_HID_MAIN_ITEM_TAG_INPUT) &&
+                ((uint32_t)mainItem.tag != (uint32_t)USB_HID_MAIN_ITEM_TAG_OUTPUT) &&
+                ((uint32_t)mainItem.tag != (uint32_t)USB_HID_MAIN_ITEM_TAG_FEATURE))
+        {
+            /* Collections do not create data fields */
+            continue;
+        }
+        
+        bits = globalItem.reportCount * globalItem.reportSize;
+        if(0U == bits)
+        {
+            continue;
+        }
+        
+        /* Find the offset of this report type and Report ID */
+        for(loop = 0; loop < nOffsets; loop++)
+        {
+            if((offsetTag[loop] == (uint8_t)mainItem.tag) &&
+                    (offsetID[loop] == (uint8_t)globalItem.reportID))
+            {
+                break;
+            }
+        }
+        if(loop == nOffsets)
+        {
+            if(nOffsets == USB_HOST_HID_FIELD_MAP_REPORTS)
+            {
+                /* Too many different reports: the offsets of the next
+                 * fields would be wrong, so stop here */
+                break;
+            }
+            offsetTag[loop] = (uint8_t)mainItem.tag;
+            offsetID[loop] = (uint8_t)globalItem.reportID;
+            offsetBits[loop] = 0;
+            nOffsets++;
+        }
+        
+        if((*nFields < maxFields) && (globalItem.reportSize <= 32U) &&
+                (globalItem.reportCount <= 0xFFU) && (offsetBits[loop] <= 0xFFFFU))
+        {
+            field = &fields[*nFields];
+            field->tag = (uint8_t)mainItem.tag;
+            field->reportID = (uint8_t)globalItem.reportID;
+            field->reportSize = (uint8_t)globalItem.reportSize;
+            field->reportCount = (uint8_t)globalItem.reportCount;
+            field->bitOffset = (uint16_t)offsetBits[loop];
+            field->usageMinMaxValid = localItem.usageMinMax.valid;
+            field->data = mainItem.data;
+            field->usagePage = globalItem.usagePage;
+            field->usageMin = localItem.usageMinMax.min;
+            field->usageMax = localItem.usageMinMax.max;
+            field->logicalMinimum = globalItem.logicalMinimum;
+            field->logicalMaximum = globalItem.logicalMaximum;
+            (*nFields)++;
+        }
+        else if(*nFields >= maxFields)
+        {
+            truncated = true;
+        }
+        else
+        {
+            /* Field cannot be described by USB_HOST_HID_FIELD */
+        }
+        
+        offsetBits[loop] += bits;
+    }
+    
+    if((USB_HOST_HID_RESULT_SUCCESS == result) && (NULL != entry) &&
+            (entry->inUse) && (!truncated) &&
+            (*nFields <= USB_HOST_HID_DESCRIPTOR_CACHE_FIELDS))
+    {
+        /* Keep the table for the next attach of this device */
+        (void) memcpy(entry->fields, fields,
+                (size_t)(*nFields) * sizeof(USB_HOST_HID_FIELD));
+        entry->nFields = *nFields;
+        entry->usage = usage;
+        entry->fieldMapValid = true;
+    }
+    
+    return result;
+    
+}/* End of USB_HOST_HID_FieldMapGet() */
+
+
+/*************************************************************************/
+/* Function:
+    void USB_HOST_HID_DescriptorCacheStatsGet
+    (
+        uint32_t *hits,
+        uint32_t *misses
+    )
+
+  Summary:
+    Function returns the report descriptor cache counters.
+
+  Description:
+    Function returns the number of attaches served from the report descriptor
+    cache and the number of attaches that fetched the report descriptor.
+    While a clear is pending both counters read as zero.
+
+  Remarks:
+    None.
+*/
+void USB_HOST_HID_DescriptorCacheStatsGet
+(
+    uint32_t *hits,
+    uint32_t *misses
+)
+{
+    bool clearPending = gUSBHostHIDDescCacheClearPending;
+
+    if(NULL != hits)
+    {
+        *hits = clearPending ? 0U : gUSBHostHIDDescCacheHits;
+    }
+    if(NULL != misses)
+    {
+        *misses = clearPending ? 0U : gUSBHostHIDDescCacheMisses;
+    }
+    
+}/* End of USB_HOST_HID_DescriptorCacheStatsGet() */
+
+
+/*************************************************************************/
+/* Function:
+    void USB_HOST_HID_DescriptorCacheClear(void)
+
+  Summary:
+    Function empties the report descriptor cache.
+
+  Description:
+    Function requests the cache to be emptied. The entries and counters are
+    discarded by the HID task routine the next time it runs, so that an
+    attach in progress never sees a half cleared entry.
+
+  Remarks:
+    None.
+*/
+void USB_HOST_HID_DescriptorCacheClear(void)
+{
+    gUSBHostHIDDescCacheClearPending = true;
+    
+}/* End of USB_HOST_HID_DescriptorCacheClear() */
+
+
+/*************************************************************************/
+/* Function:
+    void USB_HOST_HID_InterfaceEventNotifySet
+    (
+        USB_HOST_HID_INTERFACE_EVENT_NOTIFY notify
+    )
+
+  Summary:
+    Function registers the interface event notification.
+
+  Description:
+    Function registers the function called at the end of every transfer
+    complete and pipe halt clear complete interface event.
+
+  Remarks:
+    None.
+*/
+void USB_HOST_HID_InterfaceEventNotifySet
+(
+    USB_HOST_HID_INTERFACE_EVENT_NOTIFY notify
+)
+{
+    gUSBHostHIDInterfaceEventNotify = notify;
+    
+}/* End of USB_HOST_HID_InterfaceEventNotifySet() */
+
+
+/*************************************************************************/
+/* Function:
+    uint32_t USB_HOST_HID_FieldValueGet
+    (
+        const USB_HOST_HID_FIELD *field,
+        const uint8_t *report,
+        size_t length,
+        uint32_t element
+    )
+
+  Summary:
+    Function extracts one element of a field from a report.
+
+  Description:
+    Function extracts one element of a field from a report. Reads the (at
+    most 5) bytes holding the element in one 64 bit window.
+
+  Remarks:
+    None.
+*/
+
+uint32_t USB_HOST_HID_FieldValueGet
+(
+    const USB_HOST_HID_FIELD *field,
+    const uint8_t *report,
+    size_t length,
+    uint32_t element
+)
+{
+    /* Start of local variables */
+    uint64_t window = 0;
+    uint32_t bit = 0;
+    uint32_t byte = 0;
+    uint32_t loop = 0;
+    /* End of local variables */
+    
+    if((NULL == field) || (NULL == report) || (0U == field->reportSize) ||
+            (field->reportSize > 32U))
+    {
+        return 0;
+    }
+    
+    bit = (uint32_t)field->bitOffset + (element * (uint32_t)field->reportSize);
+    if(0U != field->reportID)
+    {
+        /* Skip the Report ID byte */
+        bit += 8U;
+    }
+    if((bit + (uint32_t)field->reportSize) > ((uint32_t)length * 8U))
+    {
+        return 0;
+    }
+    
+    byte = bit / 8U;
+    for(loop = 0; (loop < 5U) && ((byte + loop) < (uint32_t)length); loop++)
+    {
+        window |= ((uint64_t)report[byte + loop]) << (loop * 8U);
+    }
+    window >>= (bit % 8U);
+    
+    return (uint32_t)(window & ((((uint64_t)1U) << field->reportSize) - 1U));
+    
+}/* End of USB_HOST_HID_FieldValueGet() */
+
+
 /*************************************************************************/
 /* Function:
     USB_HOST_HID_RESULT USB_HOST_HID_UsageGet
@@ -4768,6 +5407,12 @@ void F_USB_HOST_HID_InterfaceTasks(USB_HOST_DEVICE_INTERFACE_HANDLE interfaceHan
     USB_HOST_HID_USAGE_DRIVER_TABLE_ENTRY * usageDriverTable_Entry = NULL;
     /* End of local variables */
 
+    if(gUSBHostHIDDescCacheClearPending)
+    {
+        gUSBHostHIDDescCacheClearPending = false;
+        F_USB_HOST_HID_DescriptorCacheEmpty();
+    }
+
     /* Get the HID instance for this interface */
     hidInstanceIndex = F_USB_HOST_HID_InterfaceHandleToHIDIndex(interfaceHandle);
 
@@ -4976,6 +5621,20 @@ void F_USB_HOST_HID_InterfaceTasks(USB_HOST_DEVICE_INTERFACE_HANDLE interfaceHan
                 break;
             
             case USB_HOST_HID_STATE_REPORT_DESCRIPTOR_GET:
+                if(!hidInstanceInfo->descCacheChecked)
+                {
+                    /* Look the device up only once, not on every retry */
+                    hidInstanceInfo->descCacheChecked = true;
+                    if(F_USB_HOST_HID_DescriptorCacheLoad((uint8_t)hidInstanceIndex))
+                    {
+                        /* Known device. The report descriptor and its top
+                         * level usages came from the cache. */
+                        USB_HOST_EnumerationStageStamp(USB_HOST_ENUMERATION_STAGE_REPORT_DESCRIPTOR);
+                        hidInstanceInfo->state = USB_HOST_HID_STATE_ATTACHED;
+                        break;
+                    }
+                }
+
                 hidInstanceInfo->state = USB_HOST_HID_STATE_WAITING_REPORT_DESCRIPTOR_GET;
 
                 status = F_USB_HOST_HID_ReportDescriptorGet((uint8_t)hidInstanceIndex);
@@ -5025,6 +5684,8 @@ void F_USB_HOST_HID_InterfaceTasks(USB_HOST_DEVICE_INTERFACE_HANDLE interfaceHan
                 }
                 else
                 {
+                    F_USB_HOST_HID_DescriptorCacheStore((uint8_t)hidInstanceIndex);
+                    USB_HOST_EnumerationStageStamp(USB_HOST_ENUMERATION_STAGE_REPORT_DESCRIPTOR);
                     hidInstanceInfo->state = USB_HOST_HID_STATE_ATTACHED;
                 }
 
@@ -5099,6 +5760,7 @@ void F_USB_HOST_HID_InterfaceTasks(USB_HOST_DEVICE_INTERFACE_HANDLE interfaceHan
                  */
                 if (true == hidInstanceInfo->isHIDDriverAttached)
                 {
+                    USB_HOST_EnumerationStageStamp(USB_HOST_ENUMERATION_STAGE_CLIENT_READY);
                     hidInstanceInfo->state = USB_HOST_HID_STATE_READY;
                 }
                 else
@@ -191,6 +191,46 @@ USB_HOST_HID_KEYBOARD_RESULT USB_HOST_HID_KEYBOARD_ReportSend
 }/* End of USB_HOST_HID_KEYBOARD_ReportSend() */
 
 
+// *****************************************************************************
+/* Function:
+    uint32_t USB_HOST_HID_KEYBOARD_DroppedReportsGet
+    (
+        USB_HOST_HID_KEYBOARD_HANDLE handle
+    )
+ 
+  Summary:
+   Function returns the number of IN reports dropped since attach
+  
+  Description:
+   Function returns the number of IN reports dropped since attach because
+   the report queue was full.
+  
+  Remarks:
+   None.
+*/
+
+uint32_t USB_HOST_HID_KEYBOARD_DroppedReportsGet
+(
+    USB_HOST_HID_KEYBOARD_HANDLE handle
+)
+{
+    /* Start of local variables */
+    uint8_t loop = 0;
+    /* End of local variables */
+    for(loop = 0; loop < USB_HOST_HID_USAGE_DRIVER_SUPPORT_NUMBER; loop++)
+    {
+        if(keyboardData[loop].inUse && 
+                (keyboardData[loop].handle == handle))
+        {
+            /* Found the Keyboard data object */
+            return keyboardData[loop].droppedReports;
+        }
+    }
+    return 0;
+    
+}/* End of USB_HOST_HID_KEYBOARD_DroppedReportsGet() */
+
+
 // *****************************************************************************
 /* Function:
     void USB_HOST_HID_KEYBOARD_EventHandler
@@ -239,6 +279,7 @@ void USB_HOST_HID_KEYBOARD_EventHandler
                         keyboardData[loop].handle = handle;
                         keyboardData[loop].index = 0;
                         keyboardData[loop].counter = 0;
+                        keyboardData[loop].droppedReports = 0;
                         keyboardData[loop].outputReportID = 0;
                         keyboardData[loop].state = USB_HOST_HID_KEYBOARD_ATTACHED;
                         
@@ -248,6 +289,29 @@ void USB_HOST_HID_KEYBOARD_EventHandler
                                 sizeof(keyboardData[loop].lastKeyCode));
                        (void) memset((void *)keyboardData[loop].buffer, 0,
                                 sizeof(keyboardData[loop].buffer));
+                        
+                        /* Parse the Report Descriptor once: reports are
+                         * decoded from this table */
+                        if(USB_HOST_HID_RESULT_SUCCESS != USB_HOST_HID_FieldMapGet(handle,
+                                    keyboardData[loop].fields, USB_HOST_HID_KEYBOARD_FIELDS_MAX,
+                                    &keyboardData[loop].nFields))
+                        {
+                            keyboardData[loop].nFields = 0;
+                            SYS_DEBUG_MESSAGE (SYS_ERROR_INFO,
+                                    "\r\nUSBHID Keyboard Driver: Report field table not built");
+                        }
+                        for(index = 0; index < keyboardData[loop].nFields; index++)
+                        {
+                            if((keyboardData[loop].fields[index].tag == (uint8_t)USB_HID_MAIN_ITEM_TAG_OUTPUT) &&
+                                    (keyboardData[loop].fields[index].data.outputOptionalData.isConstant == 0U) &&
+                                    (keyboardData[loop].fields[index].data.outputOptionalData.isVariable != 0U) &&
+                                    (keyboardData[loop].fields[index].data.outputOptionalData.isRelative == 0U))
+                            {
+                                /* LED Output report */
+                                keyboardData[loop].outputReportID =
+                                        keyboardData[loop].fields[index].reportID;
+                            }
+                        }
                         break;
                     }
                 }
@@ -317,6 +381,15 @@ void USB_HOST_HID_KEYBOARD_EventHandler
                 }
                 if(loop != USB_HOST_HID_USAGE_DRIVER_SUPPORT_NUMBER)
                 {
+                    if(keyboardData[loop].buffer[keyboardData[loop].index].tobeDone)
+                    {
+                        /* Queue full: the task has not processed this
+                         * entry yet. Drop the new report instead of
+                         * overwriting an older one, so that the key events
+                         * stay in order */
+                        keyboardData[loop].droppedReports++;
+                        break;
+                    }
                     (void) memcpy((void *)keyboardData[loop].buffer[keyboardData[loop].index].data,
                                     (const void *)eventData, 64);
                     
@@ -325,8 +398,9 @@ void USB_HOST_HID_KEYBOARD_EventHandler
                     /*
                      * The keyboard driver maintains a buffer where the IN
                      * Report data are stored. The Report data is processed
-                     * in task context later. By this approach we eliminate
-                     * any potential overwriting of IN data
+                     * in task context later, in the same order. By this
+                     * approach we eliminate any potential overwriting of
+                     * IN data
                      */
                     keyboardData[loop].buffer[keyboardData[loop].index].tobeDone
                             = true;
@@ -342,13 +416,6 @@ void USB_HOST_HID_KEYBOARD_EventHandler
                     {
                         /* Reset it to 0 for next iteration */
                         keyboardData[loop].index = 0;
-
-                        /* Reset the flag to false, so that in task routine
-                         * we do not process this queue data now. The
-                         * queue data will be processed only when there
-                         * is valid data for index 0 */
-                        keyboardData[loop].buffer[keyboardData[loop].index].tobeDone
-                            = false;
                     }
                 }
                 else
@@ -391,21 +458,15 @@ void USB_HOST_HID_KEYBOARD_EventHandler
 void USB_HOST_HID_KEYBOARD_Task(USB_HOST_HID_OBJ_HANDLE handle)
 {
     /* Start of local variables */
-    USB_HOST_HID_LOCAL_ITEM localItem = {.delimiterBranch = 0};
-    USB_HOST_HID_GLOBAL_ITEM globalItem = {.reportSize = 0};
-    USB_HOST_HID_MAIN_ITEM mainItem = {.localItem = NULL};
-    
-    uint64_t keyboardDataBufferTemp = 0;
-    uint8_t * keyboardDataBuffer = NULL;
-    uint8_t *ptr = NULL;
+    USB_HOST_HID_KEYBOARD_DATA_OBJ * keyboard = NULL;
+    USB_HOST_HID_KEYBOARD_DATA * usageDriverData = NULL;
+    const USB_HOST_HID_FIELD * field = NULL;
     uint8_t dataTemp[64] = {0};
     
-    uint32_t reportOffset = 0;
-    uint32_t currentReportOffsetTemp = 0;
+    uint32_t value = 0;
     uint32_t usage = 0;
     uint32_t count = 0;
     
-    uint8_t index = 1;
     uint8_t loop = 0;
     uint8_t i = 0;
     uint8_t keyboardIndex = 0;
@@ -413,8 +474,6 @@ void USB_HOST_HID_KEYBOARD_Task(USB_HOST_HID_OBJ_HANDLE handle)
     uint8_t counter = 0;
     bool lastKeyFound = false;
     bool tobeDone = false;
-    uint32_t temp_32;
-    USB_HOST_HID_RESULT result = USB_HOST_HID_RESULT_FAILURE;
     /* End of local variables */
     
     if(handle == USB_HOST_HID_OBJ_HANDLE_INVALID)
@@ -437,11 +496,10 @@ void USB_HOST_HID_KEYBOARD_Task(USB_HOST_HID_OBJ_HANDLE handle)
                 "\r\nUSBHID Keyboard Driver: Keyboard instance corresponding to handle not found");
         return;
     }
-    /* Allocate global and local items buffer memory */
-    mainItem.globalItem = &globalItem;
-    mainItem.localItem = &localItem;
+    keyboard = &keyboardData[keyboardIndex];
+    usageDriverData = &keyboard->usageDriverData;
     
-    switch(keyboardData[keyboardIndex].state)
+    switch(keyboard->state)
     {
         case USB_HOST_HID_KEYBOARD_DETACHED:
             break;
@@ -455,19 +513,19 @@ void USB_HOST_HID_KEYBOARD_Task(USB_HOST_HID_OBJ_HANDLE handle)
              * (USB_HOST_HID_KEYBOARD_BUFFER_QUEUE_SIZE - 1). The processing
              * starts from index 0 once maximum queue size is reached.
              */
-            counter = keyboardData[keyboardIndex].counter;
+            counter = keyboard->counter;
             if(counter == USB_HOST_HID_KEYBOARD_BUFFER_QUEUE_SIZE)
             {
-                keyboardData[keyboardIndex].counter = 0;
+                keyboard->counter = 0;
                 counter = 0;
             }
             /* Check if this buffer needs to be processed. tobeDone will
              * be set to true from ISR context.
              */
-            if(keyboardData[keyboardIndex].buffer[counter].tobeDone)
+            if(keyboard->buffer[counter].tobeDone)
             {
                 /* Keep a temp backup of the data */
-                (void) memcpy(&dataTemp,(const uint8_t *)keyboardData[keyboardIndex].buffer
+                (void) memcpy(&dataTemp,(const uint8_t *)keyboard->buffer
                         [counter].data, 64);
                 tobeDone = true;
             }
@@ -477,352 +535,175 @@ void USB_HOST_HID_KEYBOARD_Task(USB_HOST_HID_OBJ_HANDLE handle)
                 /* Increment the queue counter. Next task iteration the
                  * processing will start from here.
                  */
-                keyboardData[keyboardIndex].counter++;
-                /* Reset global items only once as they are applicable
-                 * through out */
-                (void) memset(&globalItem, 0,
-                            (size_t)sizeof(USB_HOST_HID_GLOBAL_ITEM));
+                keyboard->counter++;
                 /* Reset the app Data otherwise key count will be an issue. Also
                  data from last report if exists will lead to false key press
                  or release event */
-                (void) memset(&(keyboardData[keyboardIndex].usageDriverData), 0,
+                (void) memset(usageDriverData, 0,
                         (size_t)sizeof(USB_HOST_HID_KEYBOARD_DATA));
-                do
+                
+                /* One pass over the field table built at attach. The Report
+                 * Descriptor is not parsed again for each report. */
+                for(loop = 0; loop < keyboard->nFields; loop++)
                 {
-                    /* Reset the field data except global items */
-                    (void) memset(&localItem, 0, 
-                            (size_t)sizeof(USB_HOST_HID_LOCAL_ITEM));
-                    (void) memset(&(mainItem.data), 0,
-                            (size_t)sizeof(USB_HID_MAIN_ITEM_OPTIONAL_DATA));
-                    mainItem.tag = USB_HID_REPORT_TYPE_ERROR;
-
-                    /* Start enquiring for the main items starting from
-                     * index = 1. index = 0 is invalid to HID client driver. */
-                    result = USB_HOST_HID_MainItemGet(handle,index,&mainItem);
-
-                    if(result == USB_HOST_HID_RESULT_SUCCESS)
+                    field = &keyboard->fields[loop];
+                    
+                    if((field->tag != (uint8_t)USB_HID_MAIN_ITEM_TAG_INPUT) ||
+                            (field->data.inputOptionalData.isConstant != 0U))
                     {
-                        /* Copy the data as while processing the last field
-                         we have changed the data for numbered report.*/
-                        (void) memcpy((void *)keyboardData[keyboardIndex].buffer
-                                [counter].data,
-                                (const void *)&dataTemp, 64);
-                        
-                        if((uint32_t)mainItem.tag ==
-                                (uint32_t)USB_HID_MAIN_ITEM_TAG_BEGIN_COLLECTION)
-                        {                
-                            /* Do not change report offset as they do not
-                             * create data fields. Just reset the global item
-                             * data.
-                             *
-                             * Also we will not reset the Global item as
-                             * they are applicable across collections.
-                             */
-                        }/* Main item = BEGIN COLLECTION */
-                        
-                        else if((uint32_t)mainItem.tag == 
-                                (uint32_t)USB_HID_MAIN_ITEM_TAG_END_COLLECTION)
+                        continue;
+                    }
+                    if((field->reportID != 0U) && (dataTemp[0] != field->reportID))
+                    {
+                        /* Report ID does not match. No point in parsing
+                         * this field */
+                        continue;
+                    }
+                    /* Keyboard keys handling logic*/
+                    if(!((((0xFF00U & (uint32_t)field->usagePage)>>8) 
+                            == (uint32_t)USB_HID_USAGE_PAGE_KEYBOARD_KEYPAD) || 
+                            ((0x00FFU & (uint32_t)field->usagePage)
+                                == (uint32_t)USB_HID_USAGE_PAGE_KEYBOARD_KEYPAD)))
+                    {
+                        continue;
+                    }
+                    
+                    if(field->data.inputOptionalData.isVariable != 0U)
+                    {
+                        /* Modifier byte: one bit per usage */
+                        if(!field->usageMinMaxValid)
                         {
-                            /* Do not change report offset as they do not
-                             * create data fields*/
-                        }/* Main item = END COLLECTION */
-                        
-                        else if((uint32_t)mainItem.tag == (uint32_t)USB_HID_MAIN_ITEM_TAG_INPUT)
+                            continue;
+                        }
+                        usage = field->usageMin;
+                        for(count = 0; (count < field->reportCount) && (usage <= field->usageMax);
+                                count++, usage++)
                         {
-                            if(((mainItem.globalItem)->reportCount == 0U))
+                            value = USB_HOST_HID_FieldValueGet(field, dataTemp,
+                                    sizeof(dataTemp), count) & 0x01U;
+                            
+                            switch(0x00FFU & usage)
                             {
-                                /* Try looking for the next main item as this
-                                 * item will not create any data field.
-                                 */
-                                index++;
-                                continue;
+                                case (uint32_t)USB_HID_KEYBOARD_KEYPAD_KEYBOARD_LEFT_CONTROL:
+                                    usageDriverData->modifierKeysData.leftControl = (uint8_t)value;
+                                    break;
+                                case (uint32_t)USB_HID_KEYBOARD_KEYPAD_KEYBOARD_LEFT_SHIFT:
+                                    usageDriverData->modifierKeysData.leftShift = (uint8_t)value;
+                                    break;
+                                case (uint32_t)USB_HID_KEYBOARD_KEYPAD_KEYBOARD_LEFT_ALT:
+                                    usageDriverData->modifierKeysData.leftAlt = (uint8_t)value;
+                                    break;
+                                case (uint32_t)USB_HID_KEYBOARD_KEYPAD_KEYBOARD_LEFT_GUI:
+                                    usageDriverData->modifierKeysData.leftGui = (uint8_t)value;
+                                    break;
+                                case (uint32_t)USB_HID_KEYBOARD_KEYPAD_KEYBOARD_RIGHT_CONTROL:
+                                    usageDriverData->modifierKeysData.rightControl = (uint8_t)value;
+                                    break;
+                                case (uint32_t)USB_HID_KEYBOARD_KEYPAD_KEYBOARD_RIGHT_SHIFT:
+                                    usageDriverData->modifierKeysData.rightShift = (uint8_t)value;
+                                    break;
+                                case (uint32_t)USB_HID_KEYBOARD_KEYPAD_KEYBOARD_RIGHT_ALT:
+                                    usageDriverData->modifierKeysData.rightAlt = (uint8_t)value;
+                                    break;
+                                case (uint32_t)USB_HID_KEYBOARD_KEYPAD_KEYBOARD_RIGHT_GUI:
+                                    usageDriverData->modifierKeysData.rightGui = (uint8_t)value;
+                                    break;
+                                default:
+                                    /* Do Nothing */
+                                    break;
                             }
-
-                            if(!((mainItem.globalItem)->reportID == 0U))
+                        }
+                    } /* end of if Modifier bytes */
+                    else
+                    {
+                        /* Non Modifier keys (array): each element holds the
+                         * usage of a pressed key. If present in current it
+                         * is KEY PRESS event. If it is present in past but
+                         * not present in current, it is KEY RELEASE */
+                        for(count = 0; count < field->reportCount; count++)
+                        {
+                            value = USB_HOST_HID_FieldValueGet(field, dataTemp,
+                                    sizeof(dataTemp), count);
+                            if(field->usageMinMaxValid)
                             {
-                                /* Numbered report */
-                                if(keyboardData[keyboardIndex].buffer
-                                        [counter].data[0] !=
-                                        (mainItem.globalItem)->reportID)
-                                {
-                                        /* Report ID does not match. No point in
-                                           parsing this data */
-                                        index++;
-                                        continue;
-                                }
-                                /* Numbered Report. Shift right by 1 byte */
-                                for(loop = 0; loop < 64U; loop ++)
-                                {
-                                    if(loop == 63U)
-                                    {
-                                        keyboardData[keyboardIndex].buffer
-                                                [counter].data[loop] = 0;
-                                        break;
-                                    }
-                                    keyboardData[keyboardIndex].buffer
-                                            [counter].data[loop] = 
-                                            keyboardData[keyboardIndex].buffer
-                                            [counter].data[loop + 1U];
-                                    
-                                }
-                            } /* end of if numbered report */
-                            
-                            keyboardDataBuffer = keyboardData[keyboardIndex].buffer
-                                                    [counter].data;
-                            
-                            currentReportOffsetTemp = reportOffset;
-                            reportOffset = ((reportOffset) + 
-                                    ((mainItem.globalItem)->reportCount) *
-                                    ((mainItem.globalItem)->reportSize));
-                            
-                            /* Keyboard keys handling logic*/
-                            if((((0xFF00U & (uint32_t)(mainItem.globalItem)->usagePage)>>8) 
-                                    == (uint32_t)USB_HID_USAGE_PAGE_KEYBOARD_KEYPAD) || 
-                                    ((0x00FFU & (uint32_t)(mainItem.globalItem)->usagePage)
-                                        == (uint32_t)USB_HID_USAGE_PAGE_KEYBOARD_KEYPAD))
+                                value = (uint32_t)((int32_t)value - field->logicalMinimum)
+                                        + field->usageMin;
+                            }
+                            if((value != (uint32_t)USB_HID_KEYBOARD_KEYPAD_RESERVED_NO_EVENT_INDICATED)
+                                    &&(value != (uint32_t)USB_HID_KEYBOARD_KEYPAD_KEYBOARD_ERROR_ROLL_OVER)
+                                    &&(value != (uint32_t)USB_HID_KEYBOARD_KEYPAD_KEYBOARD_POST_FAIL)
+                                    &&(value != (uint32_t)USB_HID_KEYBOARD_KEYPAD_KEYBOARD_ERROR_UNDEFINED)
+                                    &&(usageDriverData->nNonModifierKeysData < USB_HOST_HID_KEYBOARD_KEYS_MAX))
                             {
-                                if((mainItem.data.inputOptionalData.isConstant == 0U) &&
-                                        (mainItem.data.inputOptionalData.isVariable != 0U))
-                                {
-                                    /* Modifier byte */
-                                    if(mainItem.localItem->usageMinMax.valid)
-                                    {
-                                        usage = mainItem.localItem->usageMinMax.min;
-                                        while(usage <= 
-                                                (mainItem.localItem->usageMinMax.max))
-                                        {
-                                            keyboardDataBuffer = keyboardData[keyboardIndex].buffer
-                                                    [counter].data;
-
-                                            if((0x00FFU & usage) == (uint32_t)USB_HID_KEYBOARD_KEYPAD_KEYBOARD_LEFT_CONTROL)
-                                            {
-                                                keyboardDataBuffer = keyboardDataBuffer + (currentReportOffsetTemp/8U);
-                                                keyboardData[keyboardIndex].usageDriverData.modifierKeysData.leftControl = 
-                                                    (uint8_t)((((uint32_t)*keyboardDataBuffer) >> (currentReportOffsetTemp % 8U))
-                                                            & 0x01U);
-                                            }
-                                            if((0x00FFU & usage) == (uint32_t)USB_HID_KEYBOARD_KEYPAD_KEYBOARD_LEFT_SHIFT)
-                                            {
-                                                keyboardDataBuffer = keyboardDataBuffer + (currentReportOffsetTemp/8U);
-                                                keyboardData[keyboardIndex].usageDriverData.modifierKeysData.leftShift = 
-                                                    (uint8_t)((((uint32_t)*keyboardDataBuffer) >> (currentReportOffsetTemp % 8U))
-                                                            & 0x01U);
-                                            }
-                                            if((0x00FFU & usage) == (uint32_t)USB_HID_KEYBOARD_KEYPAD_KEYBOARD_LEFT_ALT)
-                                            {
-                                                keyboardDataBuffer = keyboardDataBuffer + (currentReportOffsetTemp/8U);
-                                                keyboardData[keyboardIndex].usageDriverData.modifierKeysData.leftAlt = 
-                                                    (uint8_t)((((uint32_t)*keyboardDataBuffer) >> (currentReportOffsetTemp % 8U))
-                                                            & 0x01U);
-                                            }
-                                            if((0x00FFU & usage) == (uint32_t)USB_HID_KEYBOARD_KEYPAD_KEYBOARD_LEFT_GUI)
-                                            {
-                                                keyboardDataBuffer = keyboardDataBuffer + (currentReportOffsetTemp/8U);
-                                                keyboardData[keyboardIndex].usageDriverData.modifierKeysData.leftGui = 
-                                                    (uint8_t)((((uint32_t)*keyboardDataBuffer) >> (currentReportOffsetTemp % 8U))
-                                                            & 0x01U);
-                                            }
-                                            if((0x00FFU & usage) == (uint32_t)USB_HID_KEYBOARD_KEYPAD_KEYBOARD_RIGHT_CONTROL)
-                                            {
-                                                keyboardDataBuffer = keyboardDataBuffer + (currentReportOffsetTemp/8U);
-                                                keyboardData[keyboardIndex].usageDriverData.modifierKeysData.rightControl = 
-                                                    (uint8_t)((((uint32_t)*keyboardDataBuffer) >> (currentReportOffsetTemp % 8U))
-                                                            & 0x01U);
-                                            }
-                                            if((0x00FFU & usage) == (uint32_t)USB_HID_KEYBOARD_KEYPAD_KEYBOARD_RIGHT_SHIFT)
-                                            {
-                                                keyboardDataBuffer = keyboardDataBuffer + (currentReportOffsetTemp/8U);
-                                                keyboardData[keyboardIndex].usageDriverData.modifierKeysData.rightShift = 
-                                                    (uint8_t)((((uint32_t)*keyboardDataBuffer) >> (currentReportOffsetTemp % 8U))
-                                                            & 0x01U);
-                                            }
-                                            if((0x00FFU & usage) == (uint32_t)USB_HID_KEYBOARD_KEYPAD_KEYBOARD_RIGHT_ALT)
-                                            {
-                                                keyboardDataBuffer = keyboardDataBuffer + (currentReportOffsetTemp/8U);
-                                                keyboardData[keyboardIndex].usageDriverData.modifierKeysData.rightAlt = 
-                                                    (uint8_t)((((uint32_t)*keyboardDataBuffer) >> (currentReportOffsetTemp % 8U))
-                                                            & 0x01U);
-                                            }
-                                            if((0x00FFU & usage) == (uint32_t)USB_HID_KEYBOARD_KEYPAD_KEYBOARD_RIGHT_GUI)
-                                            {
-                                                keyboardDataBuffer = keyboardDataBuffer + (currentReportOffsetTemp/8U);
-                                                keyboardData[keyboardIndex].usageDriverData.modifierKeysData.rightGui = 
-                                                    (uint8_t)((((uint32_t)*keyboardDataBuffer) >> (currentReportOffsetTemp % 8U))
-                                                            & 0x01U);
-                                            }
-                                            /* Move to the next usage */
-                                            usage++;
-                                            /* Update the report offset */
-                                            currentReportOffsetTemp = 
-                                                currentReportOffsetTemp + 
-                                                (mainItem.globalItem)->reportSize;
-                                        } /* end of while(all usages) */
-                                    } /* Usage Min Max present */
-                                } /* end of if Modifier bytes */
-
-                                else if((mainItem.data.inputOptionalData.isConstant == 0U)
-                                        && (mainItem.data.inputOptionalData.isVariable == 0U))
+                                /* Valid key press detected */
+                                usageDriverData->nonModifierKeysData
+                                        [usageDriverData->nNonModifierKeysData].keyCode
+                                        = (USB_HID_KEYBOARD_KEYPAD) value;
+                                usageDriverData->nonModifierKeysData
+                                        [usageDriverData->nNonModifierKeysData].event
+                                        = USB_HID_KEY_PRESSED;
+                                usageDriverData->nonModifierKeysData
+                                        [usageDriverData->nNonModifierKeysData].sysCount
+                                        = SYS_TIME_CounterGet();
+                                usageDriverData->nNonModifierKeysData++;
+                            }
+                        }
+                        
+                        for(count = 0; count < 6U; count++)
+                        {
+                            /* If it is present in the past
+                             but not in current, it is key release */
+                            if(keyboard->lastKeyCode[count]  >
+                                    USB_HID_KEYBOARD_KEYPAD_KEYBOARD_ERROR_UNDEFINED)
+                            {
+                                for(i=0; i < 6U; i++)
                                 {
-                                    /* Non Modifier keys */
-                                    
-                                    /* Starting from currentReportOffsetTemp compare
-                                     report size of data for report count times.
-                                     If present in current it is KEY PRESS event.
-                                     If it is present in past but not present in
-                                     current, it is KEY RELEASE */
-                                    
-                                    do
-                                    {
-                                        count++;
-                                        ptr = keyboardDataBuffer + (currentReportOffsetTemp/8U);
-                                        
-                                        keyboardDataBufferTemp = 0;
-                                        if((mainItem.globalItem)->reportSize >= 8U)
-                                        {
-                                            for (i = 0; i < ((mainItem.globalItem)->reportSize/8U); i++)
-                                            {
-                                                keyboardDataBufferTemp = (keyboardDataBufferTemp | ((uint64_t)ptr[i] << (i * 8U)));
-                                            }
-                                            /* The reason why we do this is we
-                                             are copying some bits extra. Hence
-                                             now we need to remove those bits*/
-                                            keyboardDataBufferTemp = keyboardDataBufferTemp >> (currentReportOffsetTemp % 8U);
-                                            keyboardDataBufferTemp = keyboardDataBufferTemp & (uint64_t)0xFFFFFFFFU;
-                                        }
-                                        else
-                                        {
-                                            keyboardDataBufferTemp = (uint64_t)keyboardDataBufferTemp | (uint64_t)ptr[0];
-                                            
-                                            keyboardDataBufferTemp = (uint64_t)keyboardDataBufferTemp << (8U - (mainItem.globalItem)->reportSize);
-                                                    
-                                            keyboardDataBufferTemp = (uint64_t)keyboardDataBufferTemp >> (8U - (mainItem.globalItem)->reportSize);
-                                                    
-                                        }
-                                        if((keyboardDataBufferTemp != (uint64_t)USB_HID_KEYBOARD_KEYPAD_RESERVED_NO_EVENT_INDICATED)
-                                                &&(keyboardDataBufferTemp != (uint64_t)USB_HID_KEYBOARD_KEYPAD_KEYBOARD_ERROR_ROLL_OVER)
-                                                &&(keyboardDataBufferTemp != (uint64_t)USB_HID_KEYBOARD_KEYPAD_KEYBOARD_POST_FAIL)
-                                                &&(keyboardDataBufferTemp != (uint64_t)USB_HID_KEYBOARD_KEYPAD_KEYBOARD_ERROR_UNDEFINED))
-                                        {
-                                            /* Valid key press detected */
-                                            keyboardData[keyboardIndex].usageDriverData.nonModifierKeysData
-                                                    [keyboardData[keyboardIndex].usageDriverData.nNonModifierKeysData].keyCode
-                                                    = (USB_HID_KEYBOARD_KEYPAD) keyboardDataBufferTemp;
-                                            keyboardData[keyboardIndex].usageDriverData.nonModifierKeysData
-                                                    [keyboardData[keyboardIndex].usageDriverData.nNonModifierKeysData].event
-                                                    = USB_HID_KEY_PRESSED;
-                                            
-                                            keyboardData[keyboardIndex].usageDriverData.nonModifierKeysData
-                                                    [keyboardData[keyboardIndex].usageDriverData.nNonModifierKeysData].sysCount
-                                                    = SYS_TIME_CounterGet();
-                                            keyboardData[keyboardIndex].usageDriverData.nNonModifierKeysData++;
-                                        }
-                                    
-                                        /* Update the report offset */
-                                        currentReportOffsetTemp = 
-                                            currentReportOffsetTemp + 
-                                            (mainItem.globalItem)->reportSize;
-                                        
-                                    } while(count < (mainItem.globalItem)->reportCount);
-                                    
-                                    for(count = 0; count < 6U; count++)
-                                    {
-                                        /* If it is present in the past
-                                         but not in current, it is key release */
-                                        if(keyboardData[keyboardIndex].lastKeyCode[count]  >
-                                                USB_HID_KEYBOARD_KEYPAD_KEYBOARD_ERROR_UNDEFINED)
-                                        {
-                                            for(i=0; i < 6U; i++)
-                                            {
-                                                if(keyboardData[keyboardIndex].usageDriverData.nonModifierKeysData[i].keyCode
-                                                        == keyboardData[keyboardIndex].lastKeyCode[count])
-                                                {
-                                                    lastKeyFound = true;
-                                                    break;
-                                                }
-                                            }
-                                            if(lastKeyFound == false)
-                                            {
-                                                keyboardData[keyboardIndex].usageDriverData.nonModifierKeysData
-                                                    [keyboardData[keyboardIndex].usageDriverData.nNonModifierKeysData].keyCode
-                                                    = (USB_HID_KEYBOARD_KEYPAD)keyboardData[keyboardIndex].lastKeyCode[count];
-                                                keyboardData[keyboardIndex].usageDriverData.nonModifierKeysData
-                                                    [keyboardData[keyboardIndex].usageDriverData.nNonModifierKeysData].event
-                                                    = USB_HID_KEY_RELEASED;
-                                                temp_32 = SYS_TIME_CounterGet();
-                                                keyboardData[keyboardIndex].usageDriverData.nonModifierKeysData
-                                                    [keyboardData[keyboardIndex].usageDriverData.nNonModifierKeysData].event
-                                                    = (USB_HID_KEY_EVENT)temp_32;
-                                                keyboardData[keyboardIndex].usageDriverData.nNonModifierKeysData++;
-                                            }
-                                            else
-                                            {
-                                                /* Reset the flag to false for
-                                                 next iteration */
-                                                lastKeyFound = false;
-                                            }
-                                        }
-                                    }
-                                    for(count = 0; count < 6U; count++)
+                                    if(usageDriverData->nonModifierKeysData[i].keyCode
+                                            == keyboard->lastKeyCode[count])
                                     {
-                                        /* Save the present key state for next
-                                         * processing */
-                                        keyboardData[keyboardIndex].lastKeyCode[count] = USB_HID_KEYBOARD_KEYPAD_RESERVED_NO_EVENT_INDICATED;
-                                        if(keyboardData[keyboardIndex].usageDriverData
-                                                .nonModifierKeysData[count].event == USB_HID_KEY_PRESSED)
-                                        {
-                                            keyboardData[keyboardIndex].lastKeyCode[count] =
-                                                keyboardData[keyboardIndex].usageDriverData.nonModifierKeysData[count].keyCode;
-                                        }
+                                        lastKeyFound = true;
+                                        break;
                                     }
                                 }
-                                else
+                                if((lastKeyFound == false) &&
+                                        (usageDriverData->nNonModifierKeysData < USB_HOST_HID_KEYBOARD_KEYS_MAX))
                                 {
-                                    /* Do Nothing */
+                                    usageDriverData->nonModifierKeysData
+                                        [usageDriverData->nNonModifierKeysData].keyCode
+                                        = (USB_HID_KEYBOARD_KEYPAD)keyboard->lastKeyCode[count];
+                                    usageDriverData->nonModifierKeysData
+                                        [usageDriverData->nNonModifierKeysData].event
+                                        = USB_HID_KEY_RELEASED;
+                                    usageDriverData->nonModifierKeysData
+                                        [usageDriverData->nNonModifierKeysData].sysCount
+                                        = SYS_TIME_CounterGet();
+                                    usageDriverData->nNonModifierKeysData++;
                                 }
-
-                            } /* Keyboard/Keypad page */
-                            else
-                            {
-                                /* Do Nothing */
+                                /* Reset the flag to false for next iteration */
+                                lastKeyFound = false;
                             }
-                        }/* Main item = INPUT */
-
-                        else if((uint32_t)mainItem.tag ==
-                                    (uint32_t)USB_HID_MAIN_ITEM_TAG_OUTPUT)
+                        }
+                        for(count = 0; count < 6U; count++)
                         {
-                            /* Change output report offset as they
-                             * create data fields*/
-                            if((mainItem.data.inputOptionalData.isConstant == 0U) &&
-                                    (mainItem.data.inputOptionalData.isVariable != 0U) &&
-                                    (mainItem.data.inputOptionalData.isRelative == 0U))
+                            /* Save the present key state for next
+                             * processing */
+                            keyboard->lastKeyCode[count] = USB_HID_KEYBOARD_KEYPAD_RESERVED_NO_EVENT_INDICATED;
+                            if(usageDriverData->nonModifierKeysData[count].event == USB_HID_KEY_PRESSED)
                             {
-                                keyboardData[keyboardIndex].outputReportID = 
-                                        (uint8_t)(mainItem.globalItem)->reportID;
+                                keyboard->lastKeyCode[count] =
+                                    usageDriverData->nonModifierKeysData[count].keyCode;
                             }
                         }
-                        else if((uint32_t)mainItem.tag ==
-                                    (uint32_t)USB_HID_MAIN_ITEM_TAG_FEATURE)
-                        {
-                            /* Change feature report offset as they
-                             * create data fields*/
-                        }
-                        else
-                        {
-                            /* Do Nothing */
-                        }
-                    }/* Field found */
-
-                    index++;
-                    
-                } while(result == USB_HOST_HID_RESULT_SUCCESS);
+                    } /* end of Non Modifier keys */
+                } /* end of field table */
                 
-                keyboardData[keyboardIndex].buffer[counter].tobeDone = false;
+                keyboard->buffer[counter].tobeDone = false;
                 
                 if(appKeyboardHandler != NULL)
                 {
                     appKeyboardHandler((USB_HOST_HID_KEYBOARD_HANDLE)handle,
                                 USB_HOST_HID_KEYBOARD_EVENT_REPORT_RECEIVED,
-                                &keyboardData[keyboardIndex].usageDriverData);
+                                usageDriverData);
                 }
 
             }/* end of report processing */
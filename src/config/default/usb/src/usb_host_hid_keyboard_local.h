@@ -52,6 +52,12 @@
 
 #define USB_HOST_HID_KEYBOARD_BUFFER_QUEUE_SIZE 15U
 
+/* Report fields kept per keyboard (boot keyboards use 5 or 6) */
+#define USB_HOST_HID_KEYBOARD_FIELDS_MAX 16U
+
+/* Entries of USB_HOST_HID_KEYBOARD_DATA.nonModifierKeysData[] */
+#define USB_HOST_HID_KEYBOARD_KEYS_MAX 6U
+
 // *****************************************************************************
 /* USB HOST HID Keyboard Driver State
 
@@ -122,6 +128,11 @@ typedef struct
     USB_HOST_HID_OBJ_HANDLE handle;
     USB_HOST_HID_KEYBOARD_DATA usageDriverData;
     uint8_t outputReport;
+    /* Report fields, built at attach by USB_HOST_HID_FieldMapGet() */
+    USB_HOST_HID_FIELD fields[USB_HOST_HID_KEYBOARD_FIELDS_MAX];
+    uint8_t nFields;
+    /* IN Reports dropped because the queue was full */
+    uint32_t droppedReports;
     
 } USB_HOST_HID_KEYBOARD_DATA_OBJ;
 
@@ -348,6 +348,63 @@ typedef struct S_USB_HOST_HID_DEVICE_INFO_
     
 } USB_HOST_HID_DEVICE_INFO;
 
+// *****************************************************************************
+/* USB HOST HID report descriptor cache entry
+
+  Summary:
+    Report descriptor and parse results of a device attached before.
+
+  Description:
+    An entry is keyed by the device descriptor (idVendor, idProduct,
+    bcdDevice), the interface number and the report descriptor length. It
+    holds the report descriptor, the top level usages found by
+    F_USB_HOST_HID_FindTopLevelUsage() and the field table returned by
+    USB_HOST_HID_FieldMapGet() for one top level usage.
+
+  Remarks:
+    None.
+ */
+
+#ifndef USB_HOST_HID_DESCRIPTOR_CACHE_NUMBER
+#define USB_HOST_HID_DESCRIPTOR_CACHE_NUMBER    2U
+#endif
+
+#ifndef USB_HOST_HID_DESCRIPTOR_CACHE_SIZE
+#define USB_HOST_HID_DESCRIPTOR_CACHE_SIZE      256U
+#endif
+
+/* Field table entries kept per cache entry */
+#define USB_HOST_HID_DESCRIPTOR_CACHE_FIELDS    16U
+
+/* The HID instance is not using a cache entry */
+#define USB_HOST_HID_DESCRIPTOR_CACHE_INVALID   0xFFU
+
+typedef struct
+{
+    /* Entry holds a valid descriptor */
+    bool inUse;
+    /* fields[] holds the field table of 'usage' */
+    bool fieldMapValid;
+    /* Key */
+    uint16_t idVendor;
+    uint16_t idProduct;
+    uint16_t bcdDevice;
+    uint8_t bInterfaceNumber;
+    uint16_t reportDescLength;
+    /* Last time the entry was used (cache sequence number) */
+    uint32_t lastUse;
+    /* Report descriptor */
+    uint8_t reportDesc[USB_HOST_HID_DESCRIPTOR_CACHE_SIZE];
+    /* Top level usages */
+    uint8_t nTopLevelUsages;
+    uint32_t topLevelUsages[USB_HOST_HID_USAGE_DRIVER_SUPPORT_NUMBER];
+    /* Field table of one top level usage */
+    uint32_t usage;
+    uint8_t nFields;
+    USB_HOST_HID_FIELD fields[USB_HOST_HID_DESCRIPTOR_CACHE_FIELDS];
+
+} USB_HOST_HID_DESCRIPTOR_CACHE_ENTRY;
+
 // *****************************************************************************
 /* USB HOST HID Client Driver data structure
 
@@ -414,6 +471,11 @@ typedef struct
     uint8_t nTopLevelUsages;
     /* Array of top level usages. */
     uint32_t topLevelUsages[USB_HOST_HID_USAGE_DRIVER_SUPPORT_NUMBER];
+    /* Report descriptor cache entry of this device or
+     * USB_HOST_HID_DESCRIPTOR_CACHE_INVALID */
+    uint8_t descCacheIndex;
+    /* The report descriptor cache was looked up for this attach */
+    bool descCacheChecked;
     /* Place holder for Main Item Data */
     USB_HOST_HID_MAIN_ITEM *mainItemData;
     /* Number of usage tags count */
@@ -465,6 +527,18 @@ USB_HOST_HID_RESULT F_USB_HOST_HID_FindTopLevelUsage
     uint8_t hidInstanceIndex
 );
 
+bool F_USB_HOST_HID_DescriptorCacheLoad
+(
+    uint8_t hidInstanceIndex
+);
+
+void F_USB_HOST_HID_DescriptorCacheStore
+(
+    uint8_t hidInstanceIndex
+);
+
+void F_USB_HOST_HID_DescriptorCacheEmpty(void);
+
 void F_USB_HOST_HID_ControlTransferCallback
 (
     USB_HOST_DEVICE_OBJ_HANDLE deviceObjHandle,
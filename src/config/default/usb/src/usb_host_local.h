@@ -76,6 +76,21 @@
 /* Invalid configuration value */
 #define USB_HOST_CONFIGURATION_NUMBER_INVALID 0xFFU
 
+#ifndef USB_HOST_RESET_SETTLING_DELAY
+/* Reset recovery delay in milliseconds, applied after port reset */
+#define USB_HOST_RESET_SETTLING_DELAY       100U
+#endif
+
+#ifndef USB_HOST_POST_SET_ADDRESS_DELAY
+/* Delay in milliseconds applied after the Set Address request */
+#define USB_HOST_POST_SET_ADDRESS_DELAY     50U
+#endif
+
+/* Minimum reset recovery (TRSTRCY) and Set Address recovery (TDSETADDR)
+   times in milliseconds as per the USB 2.0 specification */
+#define USB_HOST_RESET_SETTLING_DELAY_MIN   10U
+#define USB_HOST_POST_SET_ADDRESS_DELAY_MIN 2U
+
 /* Definition of USB_HOST_DEVICE_OBJ_HANDLE 
  * Bits 31-16: Unique PNP identifier
  * Bits 15-8: Bus number
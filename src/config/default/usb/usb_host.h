@@ -918,6 +918,51 @@ typedef enum
 
 } USB_HOST_RESULT;
 
+// *****************************************************************************
+/* USB Host Enumeration Stages
+
+  Summary:
+    Identifies the stages of device enumeration that are time stamped.
+
+  Description:
+    The host layer records the SYS_TIME counter value at each of these stages
+    of the most recent device enumeration. The time stamps can be read with the
+    USB_HOST_EnumerationTimesGet() function and are meant for tuning the attach
+    and enumeration timing.
+
+  Remarks:
+    The time stamps are kept for the last device that was attached. A new
+    attach clears all the stages.
+*/
+
+typedef enum
+{
+    /* The root hub reported a debounced attach (USB_HOST_DeviceEnumerate) */
+    USB_HOST_ENUMERATION_STAGE_ATTACH = 0,
+
+    /* Port reset signalling has completed */
+    USB_HOST_ENUMERATION_STAGE_RESET,
+
+    /* The first 8 bytes of the device descriptor were obtained */
+    USB_HOST_ENUMERATION_STAGE_DEVICE_DESCRIPTOR,
+
+    /* The device address was set and the post set address delay expired */
+    USB_HOST_ENUMERATION_STAGE_ADDRESS,
+
+    /* All configuration descriptors were obtained and checked */
+    USB_HOST_ENUMERATION_STAGE_CONFIGURATION,
+
+    /* The class driver has the report descriptor (fetched or cached) */
+    USB_HOST_ENUMERATION_STAGE_REPORT_DESCRIPTOR,
+
+    /* The class driver attached the device to its usage driver */
+    USB_HOST_ENUMERATION_STAGE_CLIENT_READY,
+
+    /* Number of time stamped stages */
+    USB_HOST_ENUMERATION_STAGES
+
+} USB_HOST_ENUMERATION_STAGE;
+
 // *****************************************************************************
 // *****************************************************************************
 // Section: USB Host Layer MPLAB Harmony System Functions
@@ -1748,6 +1793,172 @@ USB_HOST_RESULT USB_HOST_EventHandlerSet
 );
 
 
+// *****************************************************************************
+/* Function:
+    void USB_HOST_EnumerationStageStamp
+    (
+        USB_HOST_ENUMERATION_STAGE stage
+    )
+
+  Summary:
+    Records the time at which an enumeration stage was reached.
+
+  Description:
+    This function stores the current SYS_TIME counter value for the specified
+    enumeration stage. Stamping USB_HOST_ENUMERATION_STAGE_ATTACH clears all
+    the other stages. The function is called by the host layer and the class
+    drivers. The attach stage is stamped when the root hub hands a debounced
+    attach to the host layer, so the attach debounce itself is not part of
+    the measured times.
+
+  Precondition:
+    The SYS_TIME service should have been initialized.
+
+  Parameters:
+    stage - enumeration stage that was reached.
+
+  Returns:
+    None.
+
+  Example:
+    <code>
+    </code>
+
+  Remarks:
+    This function can be called from an interrupt context.
+*/
+
+void USB_HOST_EnumerationStageStamp
+(
+    USB_HOST_ENUMERATION_STAGE stage
+);
+
+// *****************************************************************************
+/* Function:
+    void USB_HOST_EnumerationTimesGet
+    (
+        uint32_t times[USB_HOST_ENUMERATION_STAGES]
+    )
+
+  Summary:
+    Returns the time stamps of the last device enumeration.
+
+  Description:
+    This function copies the SYS_TIME counter value recorded at each stage of
+    the last device enumeration into the times array. A stage that was not
+    reached since the last attach is returned as 0. The difference between two
+    stages can be converted with SYS_TIME_CountToMS().
+
+  Precondition:
+    The USB_HOST_Initialize() function should have been called.
+
+  Parameters:
+    times - output array. Indexed by USB_HOST_ENUMERATION_STAGE.
+
+  Returns:
+    None.
+
+  Example:
+    <code>
+    uint32_t times[USB_HOST_ENUMERATION_STAGES];
+
+    USB_HOST_EnumerationTimesGet(times);
+    </code>
+
+  Remarks:
+    None.
+*/
+
+void USB_HOST_EnumerationTimesGet
+(
+    uint32_t times[USB_HOST_ENUMERATION_STAGES]
+);
+
+// *****************************************************************************
+/* Function:
+    void USB_HOST_EnumerationDelaysSet
+    (
+        uint32_t resetSettling,
+        uint32_t postSetAddress
+    )
+
+  Summary:
+    Sets the enumeration delays applied by the host layer.
+
+  Description:
+    This function sets the reset recovery delay (applied after port reset and
+    before the first device request) and the delay applied after the Set
+    Address request. Both values are in milliseconds and take effect at the
+    next enumeration. Values below USB_HOST_RESET_SETTLING_DELAY_MIN and
+    USB_HOST_POST_SET_ADDRESS_DELAY_MIN are raised to these limits.
+
+  Precondition:
+    None.
+
+  Parameters:
+    resetSettling - reset recovery delay in milliseconds.
+
+    postSetAddress - post Set Address delay in milliseconds.
+
+  Returns:
+    None.
+
+  Example:
+    <code>
+    </code>
+
+  Remarks:
+    The default values are USB_HOST_RESET_SETTLING_DELAY and
+    USB_HOST_POST_SET_ADDRESS_DELAY.
+*/
+
+void USB_HOST_EnumerationDelaysSet
+(
+    uint32_t resetSettling,
+    uint32_t postSetAddress
+);
+
+// *****************************************************************************
+/* Function:
+    void USB_HOST_EnumerationDelaysGet
+    (
+        uint32_t * resetSettling,
+        uint32_t * postSetAddress
+    )
+
+  Summary:
+    Returns the enumeration delays applied by the host layer.
+
+  Description:
+    This function returns the reset recovery delay and the post Set Address
+    delay in milliseconds. Either pointer can be NULL.
+
+  Precondition:
+    None.
+
+  Parameters:
+    resetSettling - output parameter. Reset recovery delay.
+
+    postSetAddress - output parameter. Post Set Address delay.
+
+  Returns:
+    None.
+
+  Example:
+    <code>
+    </code>
+
+  Remarks:
+    None.
+*/
+
+void USB_HOST_EnumerationDelaysGet
+(
+    uint32_t * resetSettling,
+    uint32_t * postSetAddress
+);
+
+
 //DOM-IGNORE-BEGIN
 #ifdef __cplusplus
 }
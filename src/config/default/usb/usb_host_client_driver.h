@@ -944,6 +944,51 @@ USB_HOST_RESULT USB_HOST_DeviceConfigurationDescriptorGet
     uintptr_t context
 );
 
+// *****************************************************************************
+/* Function:
+    USB_HOST_RESULT USB_HOST_DeviceDescriptorGet
+    (
+        USB_HOST_DEVICE_OBJ_HANDLE deviceObjHandle,
+        USB_DEVICE_DESCRIPTOR * deviceDescriptor
+    );
+
+  Summary:
+    Returns a copy of the device descriptor.
+
+  Description:
+    This function copies the device descriptor that the host layer obtained
+    during enumeration. No request is sent to the device. Client drivers can
+    use the idVendor, idProduct and bcdDevice fields to identify a device that
+    was attached before.
+
+  Precondition:
+    The client driver should have been assigned to the device.
+
+  Parameters:
+    deviceObjHandle - handle to the device.
+
+    deviceDescriptor - output parameter. Will contain the device descriptor if
+    the function was successful.
+  
+  Returns:
+    USB_HOST_RESULT_SUCCESS - The function was successful.
+    USB_HOST_RESULT_PARAMETER_INVALID - deviceDescriptor is NULL.
+    USB_HOST_RESULT_DEVICE_UNKNOWN - The device does not exist in the system.
+    
+  Example:
+    <code>
+    </code>
+
+  Remarks:
+    None.
+*/
+
+USB_HOST_RESULT USB_HOST_DeviceDescriptorGet
+(
+    USB_HOST_DEVICE_OBJ_HANDLE deviceObjHandle,
+    USB_DEVICE_DESCRIPTOR * deviceDescriptor
+);
+
 // *****************************************************************************
 /* MISRA C-2012 Rule 8.6 deviated:2 Deviation record ID -  H3_USB_MISRAC_2012_R_8_6_DR_1 */
 /* Function:
@@ -297,6 +297,52 @@ typedef struct S_USB_HOST_HID_MAIN_ITEM
 } USB_HOST_HID_MAIN_ITEM ;
 
 
+// *****************************************************************************
+/*  USB Host HID Report field information
+
+  Summary:
+    One data field of a report, precomputed from the Report Descriptor.
+
+  Description:
+    USB_HOST_HID_FieldMapGet() walks the Report Descriptor once (typically at
+    USB_HOST_HID_EVENT_ATTACH) and returns one entry per data creating Main
+    item (Input, Output or Feature). A usage driver can then decode every
+    report in one pass over the table with USB_HOST_HID_FieldValueGet(),
+    instead of calling USB_HOST_HID_MainItemGet() for each item of each report
+    (every call parses the descriptor again from the beginning).
+
+    bitOffset is counted separately for each report type and Report ID, from
+    the first byte after the Report ID (numbered reports) or from the start of
+    the report (reportID = 0).
+  
+  Remarks:
+    None.
+*/
+typedef struct
+{
+    /* Main item tag: USB_HID_MAIN_ITEM_TAG_INPUT, _OUTPUT or _FEATURE */
+    uint8_t tag;
+    /* Report ID (0 if the reports are not numbered) */
+    uint8_t reportID;
+    /* Size of each element in bits (1 to 32) */
+    uint8_t reportSize;
+    /* Number of elements */
+    uint8_t reportCount;
+    /* Offset of the first element in bits */
+    uint16_t bitOffset;
+    /* Usage Minimum/Maximum are valid */
+    bool usageMinMaxValid;
+    /* Constant/variable/relative etc. flags of the Main item */
+    USB_HID_MAIN_ITEM_OPTIONAL_DATA data;
+    USB_HID_USAGE_PAGE usagePage;
+    uint32_t usageMin;
+    uint32_t usageMax;
+    int32_t  logicalMinimum;
+    int32_t  logicalMaximum;
+
+} USB_HOST_HID_FIELD;
+
+
 // *****************************************************************************
 /* USB HOST HID Client Driver Events
 
@@ -564,6 +610,174 @@ USB_HOST_HID_RESULT USB_HOST_HID_MainItemGet
     USB_HOST_HID_MAIN_ITEM *pMainItemData
 );
 
+// *****************************************************************************
+/* Function:
+    USB_HOST_HID_RESULT USB_HOST_HID_FieldMapGet
+    (
+        USB_HOST_HID_OBJ_HANDLE handle,
+        USB_HOST_HID_FIELD *fields,
+        uint8_t maxFields,
+        uint8_t *nFields
+    );
+
+  Summary:
+    This function builds the field table of the top level usage.
+
+  Description:
+    This function walks all Main items of the top level usage owned by the
+    usage driver and fills 'fields' with one entry per Input, Output or
+    Feature item that creates data (Report Count and Report Size not zero).
+    Items that do not fit in 'maxFields' are dropped, but the offsets of the
+    fields already stored stay correct.
+    
+  Precondition:
+    This function should be called after obtaining USB_HOST_HID_EVENT_ATTACH
+    event from HID client driver.
+
+  Parameters:
+    handle - HID client driver handle
+    fields - Pointer to usage driver provided table
+    maxFields - Number of entries in 'fields'
+    nFields - Returns the number of entries filled
+
+  Returns:
+      USB_HOST_HID_RESULT_PARAMETER_INVALID - Invalid parameter
+      USB_HOST_HID_RESULT_REQUEST_BUSY - HID client driver busy, retry later
+      USB_HOST_HID_RESULT_SUCCESS - Table built
+
+  Remarks:
+    The table does not depend on the report data and needs to be built only
+    once per attach.
+*/
+USB_HOST_HID_RESULT USB_HOST_HID_FieldMapGet
+(
+    USB_HOST_HID_OBJ_HANDLE handle,
+    USB_HOST_HID_FIELD *fields,
+    uint8_t maxFields,
+    uint8_t *nFields
+);
+
+// *****************************************************************************
+/* Function:
+    uint32_t USB_HOST_HID_FieldValueGet
+    (
+        const USB_HOST_HID_FIELD *field,
+        const uint8_t *report,
+        size_t length,
+        uint32_t element
+    );
+
+  Summary:
+    This function extracts one element of a field from a report.
+
+  Description:
+    This function returns the raw (unsigned, not sign extended) value of
+    element 'element' of 'field' in 'report'. 'report' is the report as
+    received, including the Report ID byte for numbered reports. The caller
+    must check that the Report ID matches.
+
+  Returns:
+    Element value, or 0 if it lies outside the 'length' bytes of the report.
+
+  Remarks:
+    None.
+*/
+uint32_t USB_HOST_HID_FieldValueGet
+(
+    const USB_HOST_HID_FIELD *field,
+    const uint8_t *report,
+    size_t length,
+    uint32_t element
+);
+
+// *****************************************************************************
+/* Function:
+    void USB_HOST_HID_DescriptorCacheStatsGet
+    (
+        uint32_t *hits,
+        uint32_t *misses
+    );
+
+  Summary:
+    This function returns the report descriptor cache counters.
+
+  Description:
+    The HID client driver keeps the report descriptor, the top level usages
+    and the field table of the last USB_HOST_HID_DESCRIPTOR_CACHE_NUMBER
+    devices, keyed by idVendor, idProduct, bcdDevice, interface number and
+    report descriptor length. A device found in the cache skips the GET
+    REPORT DESCRIPTOR request and the parsing of the descriptor. This function
+    returns the number of attaches that were served from the cache (hits) and
+    that fetched the descriptor from the device (misses). Either pointer can
+    be NULL. Both counters read as zero while a clear is pending.
+
+  Returns:
+    None.
+
+  Remarks:
+    The counters are cleared by USB_HOST_HID_DescriptorCacheClear().
+*/
+void USB_HOST_HID_DescriptorCacheStatsGet
+(
+    uint32_t *hits,
+    uint32_t *misses
+);
+
+// *****************************************************************************
+/* Function:
+    void USB_HOST_HID_DescriptorCacheClear(void);
+
+  Summary:
+    This function empties the report descriptor cache.
+
+  Description:
+    All entries are discarded and the counters are cleared. The next attach
+    of every device fetches and parses its report descriptor again. Useful
+    when a device firmware is updated without changing bcdDevice.
+
+  Returns:
+    None.
+
+  Remarks:
+    Can be called from any thread. The function only posts the request; the
+    entries are discarded by the HID client task routine (USB_HOST_Tasks)
+    the next time it runs for an interface, at the latest on the next
+    attach.
+*/
+void USB_HOST_HID_DescriptorCacheClear(void);
+
+// *****************************************************************************
+/* Function:
+    void USB_HOST_HID_InterfaceEventNotifySet
+    (
+        USB_HOST_HID_INTERFACE_EVENT_NOTIFY notify
+    );
+
+  Summary:
+    This function registers a function called after every interface event.
+
+  Description:
+    The HID client driver calls the registered function at the end of every
+    transfer complete and pipe halt clear complete event of a HID interface,
+    after updating the interface state. An application that runs the host
+    tasks only when notified uses it to run USB_HOST_HID_Tasks again: the
+    path STALL, endpoint clear, halt clear complete, ready does not produce
+    any usage driver event.
+
+  Returns:
+    None.
+
+  Remarks:
+    The function can be called from the USB interrupt context. Passing NULL
+    removes the function.
+*/
+typedef void (*USB_HOST_HID_INTERFACE_EVENT_NOTIFY)(void);
+
+void USB_HOST_HID_InterfaceEventNotifySet
+(
+    USB_HOST_HID_INTERFACE_EVENT_NOTIFY notify
+);
+
 
 // *****************************************************************************
 /* Function:
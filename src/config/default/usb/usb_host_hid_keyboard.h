@@ -367,6 +367,46 @@ USB_HOST_HID_KEYBOARD_RESULT USB_HOST_HID_KEYBOARD_ReportSend
 );
 
 
+// *****************************************************************************
+/* Function:
+    uint32_t USB_HOST_HID_KEYBOARD_DroppedReportsGet
+    (
+        USB_HOST_HID_KEYBOARD_HANDLE handle
+    );
+
+  Summary:
+    This function returns the number of IN Reports dropped by the driver
+
+  Description:
+    This function returns the number of IN Reports dropped since the keyboard
+    was attached. A report is dropped when all the entries of the report
+    queue (USB_HOST_HID_KEYBOARD_BUFFER_QUEUE_SIZE) still wait to be
+    processed. Queued reports are never overwritten.
+    
+  Precondition:
+    None.
+
+  Parameters:
+    handle  - Keyboard driver handle to application.
+
+  Returns:
+    Number of dropped IN Reports. 0 if the handle is not valid.
+    
+  Example:
+    <code>
+      
+    </code>
+
+  Remarks:
+    None
+*/
+
+uint32_t USB_HOST_HID_KEYBOARD_DroppedReportsGet
+(
+    USB_HOST_HID_KEYBOARD_HANDLE handle
+);
+
+
 /* MISRAC 2012 deviation block end */
 //DOM-IGNORE-BEGIN
 #ifdef __cplusplus
@@ -41,7 +41,7 @@ static USB_HOST_HID_USAGE_DRIVER_INTERFACE usageDriverInterfaceKeyboard =
 {
   .initialize = NULL,
   .deinitialize = NULL,
-  .usageDriverEventHandler = USB_HOST_HID_KEYBOARD_EventHandler,
+  .usageDriverEventHandler = APP_USB_HIDKeyboardEventHandler,
   .usageDriverTask = USB_HOST_HID_KEYBOARD_Task
 };
 static USB_HOST_HID_USAGE_DRIVER_TABLE_ENTRY usageDriverTableEntry[1] =
@@ -0,0 +1,211 @@
+/*******************************************************************************
+  Diagnstico de tempo do ensaio GB
+
+  File Name:
+    diag_gb.c
+
+  Summary:
+    Trace e estatsticas de tempo do zero-cross e do disparo do TRIAC.
+
+  Description:
+    O TMR6 (prioridade 7) e o zero-cross (CN, prioridade 6) registram aqui.
+    Como a ISR do TMR6 pode interromper a do zero-cross, todo acesso ao trace
+    e s estatsticas  feito com as interrupes desabilitadas (poucas
+    instrues). taskENTER_CRITICAL no serve: s mascara at a prioridade
+    configMAX_SYSCALL_INTERRUPT_PRIORITY (3).
+ *******************************************************************************/
+
+// *****************************************************************************
+// *****************************************************************************
+// Section: Included Files
+// *****************************************************************************
+// *****************************************************************************
+
+#include <string.h>
+#include "diag_gb.h"
+#include "definitions.h"
+
+// *****************************************************************************
+// *****************************************************************************
+// Section: Global Data Definitions
+// *****************************************************************************
+// *****************************************************************************
+
+// Ticks do core timer por microssegundo
+#define DIAG_GB_TICKS_US    (CORE_TIMER_FREQUENCY / 1000000U)
+
+// Eventos do trace impressos no console
+#define DIAG_GB_TRACE_CONSOLE   16U
+
+// Seo crtica contra todas as prioridades (inclusive TMR6 e zero-cross)
+#define DIAG_GB_TRAVA()     uint32_t estado_ = __builtin_disable_interrupts()
+#define DIAG_GB_DESTRAVA()  do { if ((estado_ & 0x1U) != 0U) __builtin_enable_interrupts(); } while (0)
+
+static DIAG_GB_EVENTO g_trace[DIAG_GB_TRACE_TAM];
+static uint32_t g_traceEscrita = 0;     // total de eventos registrados
+
+static DIAG_GB_ESTATISTICAS g_estat;
+
+static uint32_t g_ultimoZc = 0;
+static bool     g_temZc = false;        // j houve um zero-cross desde o Reset
+static uint32_t g_ultimoGateOff = 0;
+static bool     g_gateOffPendente = false;
+
+// *****************************************************************************
+// *****************************************************************************
+// Section: Local Functions
+// *****************************************************************************
+// *****************************************************************************
+
+static void DIAG_GB_Registra(DIAG_GB_EVENTO_TIPO tipo, uint32_t t)
+{
+    DIAG_GB_EVENTO *ev = &g_trace[g_traceEscrita & (DIAG_GB_TRACE_TAM - 1U)];
+
+    ev->t = t;
+    ev->tipo = tipo;
+    g_traceEscrita++;
+}
+
+static void DIAG_GB_Acumula(DIAG_GB_ESTAT *estat, int32_t valor)
+{
+    if (estat->n == 0U)
+    {
+        estat->min = valor;
+        estat->max = valor;
+    }
+    else
+    {
+        if (valor < estat->min)
+            estat->min = valor;
+        if (valor > estat->max)
+            estat->max = valor;
+    }
+    estat->soma += valor;
+    estat->n++;
+}
+
+// *****************************************************************************
+// *****************************************************************************
+// Section: Interface Functions
+// *****************************************************************************
+// *****************************************************************************
+
+void DIAG_GB_Reset(void)
+{
+    DIAG_GB_TRAVA();
+    memset(&g_estat, 0, sizeof(g_estat));
+    g_traceEscrita = 0;
+    g_temZc = false;
+    g_gateOffPendente = false;
+    DIAG_GB_DESTRAVA();
+}
+
+void DIAG_GB_ZeroCross(uint32_t t)
+{
+    DIAG_GB_TRAVA();
+    DIAG_GB_Registra(DIAG_GB_EVT_ZERO_CROSS, t);
+
+    if (g_temZc)
+        DIAG_GB_Acumula(&g_estat.semiciclo, (int32_t)(t - g_ultimoZc));
+
+    if (g_gateOffPendente)
+    {
+        DIAG_GB_Acumula(&g_estat.folga_zero, (int32_t)(t - g_ultimoGateOff));
+        g_gateOffPendente = false;
+    }
+
+    g_ultimoZc = t;
+    g_temZc = true;
+    DIAG_GB_DESTRAVA();
+}
+
+void DIAG_GB_GateOn(uint32_t t, uint32_t previsto)
+{
+    DIAG_GB_TRAVA();
+    DIAG_GB_Registra(DIAG_GB_EVT_GATE_ON, t);
+    DIAG_GB_Acumula(&g_estat.atraso_gate, (int32_t)(t - previsto));
+    DIAG_GB_DESTRAVA();
+}
+
+void DIAG_GB_GateOff(uint32_t t)
+{
+    DIAG_GB_TRAVA();
+    DIAG_GB_Registra(DIAG_GB_EVT_GATE_OFF, t);
+    g_ultimoGateOff = t;
+    g_gateOffPendente = true;
+    DIAG_GB_DESTRAVA();
+}
+
+void DIAG_GB_EstatisticasGet(DIAG_GB_ESTATISTICAS *estat)
+{
+    DIAG_GB_TRAVA();
+    *estat = g_estat;
+    DIAG_GB_DESTRAVA();
+}
+
+uint32_t DIAG_GB_TraceGet(DIAG_GB_EVENTO *dest, uint32_t max)
+{
+    uint32_t n, i, inicio;
+
+    DIAG_GB_TRAVA();
+    n = (g_traceEscrita < DIAG_GB_TRACE_TAM) ? g_traceEscrita : DIAG_GB_TRACE_TAM;
+    if (n > max)
+        n = max;
+    inicio = g_traceEscrita - n;
+    for (i = 0; i < n; i++)
+        dest[i] = g_trace[(inicio + i) & (DIAG_GB_TRACE_TAM - 1U)];
+    DIAG_GB_DESTRAVA();
+
+    return n;
+}
+
+int32_t DIAG_GB_MediaUs(const DIAG_GB_ESTAT *estat)
+{
+    if (estat->n == 0U)
+        return 0;
+    return (int32_t)((estat->soma / (int64_t)estat->n) / (int64_t)DIAG_GB_TICKS_US);
+}
+
+int32_t DIAG_GB_TicksUs(int32_t ticks)
+{
+    return ticks / (int32_t)DIAG_GB_TICKS_US;
+}
+
+void DIAG_GB_ImprimeConsole(void)
+{
+    static const char * const nomes[] = { "ZC", "ON", "OFF" };
+    DIAG_GB_ESTATISTICAS estat;
+    DIAG_GB_EVENTO trace[DIAG_GB_TRACE_CONSOLE];
+    uint32_t n, i;
+
+    DIAG_GB_EstatisticasGet(&estat);
+    n = DIAG_GB_TraceGet(trace, DIAG_GB_TRACE_CONSOLE);
+
+    SYS_CONSOLE_PRINT("\r\nGB tempo (us)      min    med    max      n\r\n");
+    SYS_CONSOLE_PRINT("semiciclo     %6ld %6ld %6ld %6lu\r\n",
+                      (long)DIAG_GB_TicksUs(estat.semiciclo.min),
+                      (long)DIAG_GB_MediaUs(&estat.semiciclo),
+                      (long)DIAG_GB_TicksUs(estat.semiciclo.max),
+                      (unsigned long)estat.semiciclo.n);
+    SYS_CONSOLE_PRINT("atraso gate   %6ld %6ld %6ld %6lu\r\n",
+                      (long)DIAG_GB_TicksUs(estat.atraso_gate.min),
+                      (long)DIAG_GB_MediaUs(&estat.atraso_gate),
+                      (long)DIAG_GB_TicksUs(estat.atraso_gate.max),
+                      (unsigned long)estat.atraso_gate.n);
+    SYS_CONSOLE_PRINT("folga ao zero %6ld %6ld %6ld %6lu\r\n",
+                      (long)DIAG_GB_TicksUs(estat.folga_zero.min),
+                      (long)DIAG_GB_MediaUs(&estat.folga_zero),
+                      (long)DIAG_GB_TicksUs(estat.folga_zero.max),
+                      (unsigned long)estat.folga_zero.n);
+
+    // Trace: tempo de cada evento relativo ao primeiro impresso
+    for (i = 0; i < n; i++)
+    {
+        SYS_CONSOLE_PRINT("%-3s %8ld\r\n", nomes[trace[i].tipo],
+                          (long)DIAG_GB_TicksUs((int32_t)(trace[i].t - trace[0].t)));
+    }
+}
+
+/*******************************************************************************
+ End of File
+ */
@@ -0,0 +1,130 @@
+/*******************************************************************************
+  Diagnstico de tempo do ensaio GB
+
+  File Name:
+    diag_gb.h
+
+  Summary:
+    Trace e estatsticas de tempo do zero-cross e do disparo do TRIAC.
+
+  Description:
+    Registra, com o core timer (SYSCLK/2), cada zero-cross e cada borda do
+    gate do TRIAC num buffer circular, e mantm mnimo/mximo/mdia de:
+    - semiciclo: intervalo entre zero-cross seguidos (mostra o jitter);
+    - atraso do gate: instante real do disparo menos o previsto no zero-cross
+      (latncia do TMR6 + ISR);
+    - folga ao zero: do fim do gate at o prximo zero-cross (o que sobra de
+      SAFETY_TICKS_TO_ZERO na prtica).
+    As funes de registro so chamadas pelas ISRs de medida_gb.c.
+*******************************************************************************/
+
+#ifndef _DIAG_GB_H
+#define _DIAG_GB_H
+
+// *****************************************************************************
+// *****************************************************************************
+// Section: Included Files
+// *****************************************************************************
+// *****************************************************************************
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <stddef.h>
+
+// DOM-IGNORE-BEGIN
+#ifdef __cplusplus  // Provide C++ Compatibility
+
+extern "C" {
+
+#endif
+// DOM-IGNORE-END
+
+// *****************************************************************************
+// *****************************************************************************
+// Section: Type Definitions
+// *****************************************************************************
+// *****************************************************************************
+
+// Eventos guardados no trace (potncia de 2)
+#define DIAG_GB_TRACE_TAM   64U
+
+typedef enum
+{
+    DIAG_GB_EVT_ZERO_CROSS = 0,
+    DIAG_GB_EVT_GATE_ON,
+    DIAG_GB_EVT_GATE_OFF
+} DIAG_GB_EVENTO_TIPO;
+
+typedef struct
+{
+    uint32_t t;                 // core timer no evento
+    DIAG_GB_EVENTO_TIPO tipo;
+} DIAG_GB_EVENTO;
+
+// Mnimo/mximo/soma de uma medida, em ticks do core timer
+typedef struct
+{
+    int32_t  min;
+    int32_t  max;
+    int64_t  soma;
+    uint32_t n;
+} DIAG_GB_ESTAT;
+
+typedef struct
+{
+    DIAG_GB_ESTAT semiciclo;    // zero-cross -> zero-cross
+    DIAG_GB_ESTAT atraso_gate;  // gate-on real - previsto
+    DIAG_GB_ESTAT folga_zero;   // gate-off -> prximo zero-cross
+} DIAG_GB_ESTATISTICAS;
+
+// *****************************************************************************
+// *****************************************************************************
+// Section: Interface Functions
+// *****************************************************************************
+// *****************************************************************************
+
+/* DIAG_GB_Reset()
+ * Zera trace e estatsticas. Chamar antes de habilitar o zero-cross.
+ */
+void DIAG_GB_Reset(void);
+
+/* Registro dos eventos (contexto de interrupo). 't'  o core timer lido
+ * no evento e 'previsto' o instante em que o disparo deveria acontecer.
+ */
+void DIAG_GB_ZeroCross(uint32_t t);
+void DIAG_GB_GateOn(uint32_t t, uint32_t previsto);
+void DIAG_GB_GateOff(uint32_t t);
+
+/* DIAG_GB_EstatisticasGet()
+ * Cpia consistente das estatsticas.
+ */
+void DIAG_GB_EstatisticasGet(DIAG_GB_ESTATISTICAS *estat);
+
+/* DIAG_GB_TraceGet()
+ * Copia at 'max' eventos, do mais antigo para o mais recente. Retorna a
+ * quantidade copiada.
+ */
+uint32_t DIAG_GB_TraceGet(DIAG_GB_EVENTO *dest, uint32_t max);
+
+/* DIAG_GB_MediaUs() / DIAG_GB_TicksUs()
+ * Converso para microssegundos (mdia de uma medida, ou um valor).
+ */
+int32_t DIAG_GB_MediaUs(const DIAG_GB_ESTAT *estat);
+int32_t DIAG_GB_TicksUs(int32_t ticks);
+
+/* DIAG_GB_ImprimeConsole()
+ * Imprime as estatsticas e o trace no console (UART2).
+ */
+void DIAG_GB_ImprimeConsole(void);
+
+//DOM-IGNORE-BEGIN
+#ifdef __cplusplus
+}
+#endif
+//DOM-IGNORE-END
+
+#endif /* _DIAG_GB_H */
+
+/*******************************************************************************
+ End of File
+ */
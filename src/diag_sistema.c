@@ -0,0 +1,424 @@
+/*******************************************************************************
+  Diagnstico do sistema pelo console
+
+  File Name:
+    diag_sistema.c
+
+  Summary:
+    Comandos de diagnstico no console (UART2): uso de CPU por task, pilhas,
+    heap e filas.
+
+  Description:
+    Ver diag_sistema.h.
+ *******************************************************************************/
+
+// *****************************************************************************
+// *****************************************************************************
+// Section: Included Files
+// *****************************************************************************
+// *****************************************************************************
+
+#include <string.h>
+#include <stdlib.h>
+#include "diag_sistema.h"
+#include "teclado.h"
+#include "definitions.h"
+
+// *****************************************************************************
+// *****************************************************************************
+// Section: Global Data Definitions
+// *****************************************************************************
+// *****************************************************************************
+
+// Espao livre no buffer de escrita do console antes de cada linha, para o
+// relatrio no perder linhas quando a UART est atrasada
+#define DIAG_SIS_ESPACO_LINHA   100
+
+// Fila do menu (menu_display.c)
+extern QueueHandle_t xActionEventQueue;
+
+// Contador de run time de cada task no ltimo relatrio
+typedef struct
+{
+    TaskHandle_t tarefa;
+    configRUN_TIME_COUNTER_TYPE contador;
+} DIAG_SIS_REFERENCIA;
+
+static DIAG_SIS_STATES g_estado;
+static SYS_CONSOLE_HANDLE g_console = SYS_CONSOLE_HANDLE_INVALID;
+
+static TaskStatus_t g_tarefas[DIAG_SIS_MAX_TAREFAS];
+static DIAG_SIS_REFERENCIA g_referencia[DIAG_SIS_MAX_TAREFAS];
+static uint32_t g_nReferencia;
+static configRUN_TIME_COUNTER_TYPE g_totalReferencia;
+static TickType_t g_tickReferencia;
+
+static char g_linha[DIAG_SIS_LINHA_TAM];
+static uint32_t g_linhaTam;
+
+// Modo contnuo: 0 = desligado
+static TickType_t g_periodo;
+static TickType_t g_ultimoRelatorio;
+
+// Nome de cada etapa da enumerao USB (USB_HOST_ENUMERATION_STAGE)
+static const char * const g_etapasUSB[USB_HOST_ENUMERATION_STAGES] =
+{
+    "attach", "reset", "descritor", "endereco", "config", "report", "pronto"
+};
+
+// *****************************************************************************
+// *****************************************************************************
+// Section: Local Functions
+// *****************************************************************************
+// *****************************************************************************
+
+/* DIAG_SIS_EsperaConsole()
+ * Espera haver espao para uma linha no buffer de escrita do console.
+ */
+static void DIAG_SIS_EsperaConsole(void)
+{
+    while (SYS_CONSOLE_WriteFreeBufferCountGet(g_console) < DIAG_SIS_ESPACO_LINHA)
+        vTaskDelay(1);
+}
+
+/* DIAG_SIS_Referencia()
+ * Guarda os contadores atuais como referncia do prximo relatrio.
+ */
+static void DIAG_SIS_Referencia(const TaskStatus_t *tarefas, uint32_t n,
+                                configRUN_TIME_COUNTER_TYPE total)
+{
+    uint32_t i;
+
+    for (i = 0; i < n; i++)
+    {
+        g_referencia[i].tarefa   = tarefas[i].xHandle;
+        g_referencia[i].contador = tarefas[i].ulRunTimeCounter;
+    }
+    g_nReferencia = n;
+    g_totalReferencia = total;
+    g_tickReferencia = xTaskGetTickCount();
+}
+
+/* DIAG_SIS_ContadorAnterior()
+ * Contador da task no ltimo relatrio (0 se ela ainda no existia).
+ */
+static configRUN_TIME_COUNTER_TYPE DIAG_SIS_ContadorAnterior(TaskHandle_t tarefa)
+{
+    uint32_t i;
+
+    for (i = 0; i < g_nReferencia; i++)
+    {
+        if (g_referencia[i].tarefa == tarefa)
+            return g_referencia[i].contador;
+    }
+    return 0;
+}
+
+static char DIAG_SIS_EstadoLetra(eTaskState estado)
+{
+    switch (estado)
+    {
+        case eRunning:   return 'X';
+        case eReady:     return 'R';
+        case eBlocked:   return 'B';
+        case eSuspended: return 'S';
+        case eDeleted:   return 'D';
+        default:         return '?';
+    }
+}
+
+static void DIAG_SIS_Ajuda(void)
+{
+    SYS_CONSOLE_PRINT("\r\nstats | stats <s> (0 para) | isr | gb | zera | leitor [on [prefixo] | off] | layout [us | abnt2] | usb [deb rst rec end | cache] | ?\r\n");
+}
+
+/* DIAG_SIS_ImprimeUSB()
+ * Tempos de attach em uso, cache de descritores HID e, para o ltimo
+ * attach, cada etapa da enumerao em ms desde o attach e desde a etapa
+ * anterior. O attach  marcado depois do debounce, que no entra na conta.
+ */
+static void DIAG_SIS_ImprimeUSB(void)
+{
+    uint32_t tempos[USB_HOST_ENUMERATION_STAGES];
+    uint32_t debounce, reset, recuperacao, endereco, acertos, falhas, anterior, i;
+
+    DRV_USBFS_HOST_TimingGet(&debounce, &reset);
+    USB_HOST_EnumerationDelaysGet(&recuperacao, &endereco);
+    USB_HOST_HID_DescriptorCacheStatsGet(&acertos, &falhas);
+    USB_HOST_EnumerationTimesGet(tempos);
+
+    DIAG_SIS_EsperaConsole();
+    SYS_CONSOLE_PRINT("\r\nTempos (ms): debounce %lu reset %lu recuperacao %lu endereco %lu\r\n",
+                      (unsigned long)debounce, (unsigned long)reset,
+                      (unsigned long)recuperacao, (unsigned long)endereco);
+    SYS_CONSOLE_PRINT("Cache de descritores: %lu acertos, %lu falhas\r\n",
+                      (unsigned long)acertos, (unsigned long)falhas);
+
+    if (tempos[USB_HOST_ENUMERATION_STAGE_ATTACH] == 0U)
+    {
+        SYS_CONSOLE_PRINT("Nenhum attach medido\r\n");
+        return;
+    }
+
+    SYS_CONSOLE_PRINT("etapa      attach  etapa (ms)\r\n");
+    anterior = tempos[USB_HOST_ENUMERATION_STAGE_ATTACH];
+    for (i = 1; i < (uint32_t)USB_HOST_ENUMERATION_STAGES; i++)
+    {
+        DIAG_SIS_EsperaConsole();
+        if (tempos[i] == 0U)
+        {
+            SYS_CONSOLE_PRINT("%-10s      -       -\r\n", g_etapasUSB[i]);
+            continue;
+        }
+        SYS_CONSOLE_PRINT("%-10s %6lu  %6lu\r\n", g_etapasUSB[i],
+                          (unsigned long)SYS_TIME_CountToMS(tempos[i] - tempos[USB_HOST_ENUMERATION_STAGE_ATTACH]),
+                          (unsigned long)SYS_TIME_CountToMS(tempos[i] - anterior));
+        anterior = tempos[i];
+    }
+}
+
+/* DIAG_SIS_TemposUSB()
+ * "deb rst rec end": debounce e reset do attach (driver) e recuperao
+ * aps o reset e espera aps o endereo (host), em ms. S muda se vierem
+ * os quatro; valores abaixo do mnimo da norma USB sobem para o mnimo.
+ */
+static void DIAG_SIS_TemposUSB(const char *arg)
+{
+    unsigned long valor[4];
+    char *fim;
+    uint32_t i;
+
+    for (i = 0; i < 4U; i++)
+    {
+        valor[i] = strtoul(arg, &fim, 10);
+        if (fim == arg)
+            return;
+        arg = fim;
+    }
+
+    DRV_USBFS_HOST_TimingSet((uint32_t)valor[0], (uint32_t)valor[1]);
+    USB_HOST_EnumerationDelaysSet((uint32_t)valor[2], (uint32_t)valor[3]);
+}
+
+/* DIAG_SIS_Executa()
+ * Executa a linha recebida em 'g_linha'.
+ */
+static void DIAG_SIS_Executa(void)
+{
+    char *arg;
+    unsigned long segundos;
+    uint32_t layout;
+
+    if (g_linhaTam == 0U)
+        return;
+    g_linha[g_linhaTam] = '\0';
+
+    arg = strchr(g_linha, ' ');
+    if (arg != NULL)
+        *arg++ = '\0';
+
+    if (strcmp(g_linha, "stats") == 0)
+    {
+        if (arg == NULL)
+        {
+            DIAG_SIS_ImprimeTarefas();
+        }
+        else
+        {
+            segundos = strtoul(arg, NULL, 10);
+            if (segundos > DIAG_SIS_JANELA_MAX_S)
+                segundos = DIAG_SIS_JANELA_MAX_S;
+            g_periodo = pdMS_TO_TICKS(segundos * 1000U);
+            g_ultimoRelatorio = xTaskGetTickCount();
+            if (g_periodo != 0U)
+                DIAG_SIS_ImprimeTarefas();
+        }
+    }
+    else if (strcmp(g_linha, "isr") == 0)
+    {
+        ISR_LAT_ImprimeConsole();
+    }
+    else if (strcmp(g_linha, "gb") == 0)
+    {
+        DIAG_GB_ImprimeConsole();
+    }
+    else if (strcmp(g_linha, "leitor") == 0)
+    {
+        // "leitor on #" liga o modo leitor com prefixo '#'
+        if ((arg != NULL) && (strncmp(arg, "on", 2) == 0))
+            APP_USB_LeitorModoSet(true, (arg[2] == ' ') ? arg[3] : '\0');
+        else if ((arg != NULL) && (strcmp(arg, "off") == 0))
+            APP_USB_LeitorModoSet(false, '\0');
+        APP_USB_ImprimeConsole();
+    }
+    else if (strcmp(g_linha, "layout") == 0)
+    {
+        for (layout = 0; (arg != NULL) && (layout < (uint32_t)TECLADO_LAYOUT_QUANT); layout++)
+        {
+            if (strcmp(arg, TECLADO_LayoutNome((TECLADO_LAYOUT)layout)) == 0)
+                TECLADO_LayoutSet((TECLADO_LAYOUT)layout);
+        }
+        SYS_CONSOLE_PRINT("layout %s\r\n", TECLADO_LayoutNome(TECLADO_LayoutGet()));
+    }
+    else if (strcmp(g_linha, "usb") == 0)
+    {
+        // "usb 200 60 20 10" muda os tempos; vale a partir do prximo attach
+        if ((arg != NULL) && (strcmp(arg, "cache") == 0))
+        {
+            // Esvaziado pela task do USB, no mximo no prximo attach
+            USB_HOST_HID_DescriptorCacheClear();
+            SYS_CONSOLE_PRINT("\r\nCache de descritores: limpeza pedida\r\n");
+        }
+        else if (arg != NULL)
+        {
+            DIAG_SIS_TemposUSB(arg);
+        }
+        DIAG_SIS_ImprimeUSB();
+    }
+    else if (strcmp(g_linha, "zera") == 0)
+    {
+        ISR_LAT_Reset();
+        DIAG_GB_Reset();
+    }
+    else
+    {
+        DIAG_SIS_Ajuda();
+    }
+}
+
+/* DIAG_SIS_LeConsole()
+ * Junta os caracteres recebidos numa linha (com eco) e executa no Enter.
+ */
+static void DIAG_SIS_LeConsole(void)
+{
+    char c;
+
+    while (SYS_CONSOLE_Read(g_console, &c, 1) == 1)
+    {
+        if ((c == '\r') || (c == '\n'))
+        {
+            SYS_CONSOLE_Write(g_console, "\r\n", 2);
+            DIAG_SIS_Executa();
+            g_linhaTam = 0;
+        }
+        else if (((c == '\b') || (c == 0x7F)) && (g_linhaTam > 0U))
+        {
+            g_linhaTam--;
+            SYS_CONSOLE_Write(g_console, "\b \b", 3);
+        }
+        else if ((c >= ' ') && (g_linhaTam < (DIAG_SIS_LINHA_TAM - 1U)))
+        {
+            g_linha[g_linhaTam++] = c;
+            SYS_CONSOLE_Write(g_console, &c, 1);
+        }
+    }
+}
+
+// *****************************************************************************
+// *****************************************************************************
+// Section: Interface Functions
+// *****************************************************************************
+// *****************************************************************************
+
+void DIAG_SIS_Initialize(void)
+{
+    g_estado = DIAG_SIS_STATE_INIT;
+    g_console = SYS_CONSOLE_HANDLE_INVALID;
+    g_nReferencia = 0;
+    g_linhaTam = 0;
+    g_periodo = 0;
+}
+
+void DIAG_SIS_ImprimeTarefas(void)
+{
+    configRUN_TIME_COUNTER_TYPE total, delta_total, delta;
+    uint32_t n, i, milesimos;
+
+    // Se as tasks no couberem, 'total' no  escrito: fica a referncia
+    total = g_totalReferencia;
+    n = (uint32_t)uxTaskGetSystemState(g_tarefas, DIAG_SIS_MAX_TAREFAS, &total);
+    delta_total = total - g_totalReferencia;
+
+    DIAG_SIS_EsperaConsole();
+    SYS_CONSOLE_PRINT("\r\nTask                 CPU%%  E Pr Pilha livre (palavras)\r\n");
+
+    // uxTaskGetSystemState no preenche nada se as tasks no couberem
+    if (n == 0U)
+        SYS_CONSOLE_PRINT("%lu tasks, a tabela so tem %lu (DIAG_SIS_MAX_TAREFAS)\r\n",
+                          (unsigned long)uxTaskGetNumberOfTasks(),
+                          (unsigned long)DIAG_SIS_MAX_TAREFAS);
+    for (i = 0; i < n; i++)
+    {
+        delta = g_tarefas[i].ulRunTimeCounter - DIAG_SIS_ContadorAnterior(g_tarefas[i].xHandle);
+        milesimos = (delta_total != 0U) ? (uint32_t)(((uint64_t)delta * 1000U) / delta_total) : 0U;
+
+        DIAG_SIS_EsperaConsole();
+        SYS_CONSOLE_PRINT("%-18s %3lu,%lu  %c %2lu %6u\r\n",
+                          g_tarefas[i].pcTaskName,
+                          (unsigned long)(milesimos / 10U), (unsigned long)(milesimos % 10U),
+                          DIAG_SIS_EstadoLetra(g_tarefas[i].eCurrentState),
+                          (unsigned long)g_tarefas[i].uxCurrentPriority,
+                          (unsigned)g_tarefas[i].usStackHighWaterMark);
+    }
+
+    DIAG_SIS_EsperaConsole();
+    SYS_CONSOLE_PRINT("Heap livre %u, minimo %u de %u bytes\r\n",
+                      (unsigned)xPortGetFreeHeapSize(),
+                      (unsigned)xPortGetMinimumEverFreeHeapSize(),
+                      (unsigned)configTOTAL_HEAP_SIZE);
+    if (xActionEventQueue != NULL)
+        SYS_CONSOLE_PRINT("Fila do menu %lu/%lu\r\n",
+                          (unsigned long)uxQueueMessagesWaiting(xActionEventQueue),
+                          (unsigned long)(uxQueueMessagesWaiting(xActionEventQueue)
+                                          + uxQueueSpacesAvailable(xActionEventQueue)));
+
+    DIAG_SIS_Referencia(g_tarefas, n, total);
+}
+
+void DIAG_SIS_Tasks(void)
+{
+    configRUN_TIME_COUNTER_TYPE total;
+    uint32_t n;
+
+    switch (g_estado)
+    {
+        case DIAG_SIS_STATE_INIT:
+        {
+            g_console = SYS_CONSOLE_HandleGet(SYS_CONSOLE_INDEX_0);
+            if (g_console != SYS_CONSOLE_HANDLE_INVALID)
+            {
+                total = g_totalReferencia;
+                n = (uint32_t)uxTaskGetSystemState(g_tarefas, DIAG_SIS_MAX_TAREFAS, &total);
+                DIAG_SIS_Referencia(g_tarefas, n, total);
+                g_estado = DIAG_SIS_STATE_SERVICE_TASKS;
+            }
+            break;
+        }
+
+        case DIAG_SIS_STATE_SERVICE_TASKS:
+        {
+            DIAG_SIS_LeConsole();
+
+            if ((g_periodo != 0U) && ((xTaskGetTickCount() - g_ultimoRelatorio) >= g_periodo))
+            {
+                g_ultimoRelatorio = xTaskGetTickCount();
+                DIAG_SIS_ImprimeTarefas();
+            }
+            // Sem relatrio h muito tempo: o core timer pode ter dado a volta
+            else if ((xTaskGetTickCount() - g_tickReferencia) >= pdMS_TO_TICKS(DIAG_SIS_JANELA_MAX_S * 1000U))
+            {
+                total = g_totalReferencia;
+                n = (uint32_t)uxTaskGetSystemState(g_tarefas, DIAG_SIS_MAX_TAREFAS, &total);
+                DIAG_SIS_Referencia(g_tarefas, n, total);
+            }
+            break;
+        }
+
+        default:
+            break;
+    }
+}
+
+/*******************************************************************************
+ End of File
+ */
@@ -0,0 +1,103 @@
+/*******************************************************************************
+  Diagnstico do sistema pelo console
+
+  File Name:
+    diag_sistema.h
+
+  Summary:
+    Comandos de diagnstico no console (UART2): uso de CPU por task, pilhas,
+    heap e filas.
+
+  Description:
+    A task DIAG_SIS_Tasks l linhas do SYS_CONSOLE e atende os comandos:
+
+      stats       uma tabela das tasks desde o ltimo relatrio
+      stats <s>   repete a tabela a cada <s> segundos (0 para parar)
+      isr         latncia das interrupes (isr_latencia.c)
+      gb          tempos do zero-cross e do gate (diag_gb.c)
+      zera        zera as medidas de isr e gb
+      usb         tempos de attach, cache de descritores HID e etapas da
+                  ltima enumerao (ms desde o attach e desde a etapa
+                  anterior)
+      usb <deb> <rst> <rec> <end>
+                  muda debounce, reset, recuperao e espera aps o
+                  endereo (ms) a partir do prximo attach
+      usb cache   esvazia o cache de descritores HID (o prximo attach
+                  pede e interpreta o report descriptor de novo)
+      ?           lista os comandos
+
+    O uso de CPU vem do run time stats do FreeRTOS, contado com o core timer
+    (SYSCLK/2, livre). Como o contador  de 32 bits e volta a zero a cada
+    ~71 s, o percentual  sempre calculado entre dois relatrios; sem
+    relatrio h mais de DIAG_SIS_JANELA_MAX_S, a referncia  renovada.
+*******************************************************************************/
+
+#ifndef _DIAG_SISTEMA_H
+#define _DIAG_SISTEMA_H
+
+// *****************************************************************************
+// *****************************************************************************
+// Section: Included Files
+// *****************************************************************************
+// *****************************************************************************
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <stddef.h>
+
+// DOM-IGNORE-BEGIN
+#ifdef __cplusplus  // Provide C++ Compatibility
+
+extern "C" {
+
+#endif
+// DOM-IGNORE-END
+
+// *****************************************************************************
+// *****************************************************************************
+// Section: Type Definitions
+// *****************************************************************************
+// *****************************************************************************
+
+#define DIAG_SIS_MAX_TAREFAS    12U     // tasks acompanhadas no relatrio
+#define DIAG_SIS_JANELA_MAX_S   60U     // intervalo mximo entre relatrios
+#define DIAG_SIS_LINHA_TAM      24U     // comando mais longo aceito
+#define DIAG_SIS_PERIODO_MS     50U     // leitura do console
+
+typedef enum
+{
+    DIAG_SIS_STATE_INIT = 0,
+    DIAG_SIS_STATE_SERVICE_TASKS,
+} DIAG_SIS_STATES;
+
+// *****************************************************************************
+// *****************************************************************************
+// Section: Interface Functions
+// *****************************************************************************
+// *****************************************************************************
+
+void DIAG_SIS_Initialize(void);
+
+/* DIAG_SIS_Tasks()
+ * L o console e, no modo contnuo, imprime o relatrio no perodo pedido.
+ * No bloqueia: a task em tasks.c chama a cada DIAG_SIS_PERIODO_MS.
+ */
+void DIAG_SIS_Tasks(void);
+
+/* DIAG_SIS_ImprimeTarefas()
+ * Uso de CPU (desde o ltimo relatrio), estado, prioridade e pilha mnima
+ * livre de cada task, heap livre e mnimo j atingido, e ocupao das filas.
+ */
+void DIAG_SIS_ImprimeTarefas(void);
+
+//DOM-IGNORE-BEGIN
+#ifdef __cplusplus
+}
+#endif
+//DOM-IGNORE-END
+
+#endif /* _DIAG_SISTEMA_H */
+
+/*******************************************************************************
+ End of File
+ */
@@ -0,0 +1,155 @@
+/*******************************************************************************
+  Grficos no LCD 20x4
+
+  File Name:
+    display_graficos.c
+
+  Summary:
+    Barras horizontais e grficos de tendncia com caracteres da CGRAM.
+
+  Description:
+    Ver display_graficos.h.
+ *******************************************************************************/
+
+// *****************************************************************************
+// *****************************************************************************
+// Section: Included Files
+// *****************************************************************************
+// *****************************************************************************
+
+#include "display_graficos.h"
+
+// *****************************************************************************
+// *****************************************************************************
+// Section: Global Data Definitions
+// *****************************************************************************
+// *****************************************************************************
+
+// Nveis do grfico de tendncia (slots 4..7)
+#define DISPLAY_GRAF_NIVEIS         4U
+#define DISPLAY_GRAF_SLOT_TENDENCIA 4U
+
+const uint8_t DISPLAY_GRAF_Glifos[8][8] =
+{
+    // Barra: 1..4 colunas da esquerda preenchidas
+    { 0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10 },
+    { 0x18, 0x18, 0x18, 0x18, 0x18, 0x18, 0x18, 0x18 },
+    { 0x1C, 0x1C, 0x1C, 0x1C, 0x1C, 0x1C, 0x1C, 0x1C },
+    { 0x1E, 0x1E, 0x1E, 0x1E, 0x1E, 0x1E, 0x1E, 0x1E },
+    // Tendncia: 2, 4, 6 e 8 linhas de baixo preenchidas
+    { 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x1F, 0x1F },
+    { 0x00, 0x00, 0x00, 0x00, 0x1F, 0x1F, 0x1F, 0x1F },
+    { 0x00, 0x00, 0x1F, 0x1F, 0x1F, 0x1F, 0x1F, 0x1F },
+    { 0x1F, 0x1F, 0x1F, 0x1F, 0x1F, 0x1F, 0x1F, 0x1F }
+};
+
+// Latin-1 0xA0..0xFF -> ROM A00 do HD44780 (ver DISPLAY_GRAF_Latin1)
+#define DISPLAY_GRAF_LATIN1_INICIO  0xA0U
+
+static const uint8_t DISPLAY_GRAF_RomA00[96] =
+{
+    ' ',  '!',  'c',  'L',  '*',  0x5C, '|',  'S',  // .       
+    '"',  'C',  'a',  '<',  '-',  '-',  'R',  '-',  //      .  
+    0xDF, '+',  '2',  '3',  '\'', 0xE4, 'P',  0xA5,  //        
+    ',',  '1',  0xDF, '>',  '/',  '/',  '/',  '?',  //        
+    'A',  'A',  'A',  'A',  'A',  'A',  'A',  'C',  //        
+    'E',  'E',  'E',  'E',  'I',  'I',  'I',  'I',  //        
+    'D',  'N',  'O',  'O',  'O',  'O',  'O',  'x',  //        
+    'O',  'U',  'U',  'U',  'U',  'Y',  'P',  0xE2,  //        
+    'a',  'a',  'a',  'a',  0xE1, 'a',  'a',  'c',  //        
+    'e',  'e',  'e',  'e',  'i',  'i',  'i',  'i',  //        
+    'd',  0xEE, 'o',  'o',  'o',  'o',  0xEF, 0xFD,  //        
+    'o',  'u',  'u',  'u',  0xF5, 'y',  'p',  'y',  //        
+};
+
+// *****************************************************************************
+// *****************************************************************************
+// Section: Interface Functions
+// *****************************************************************************
+// *****************************************************************************
+
+void DISPLAY_GRAF_Barra(char *linha, uint8_t col, uint8_t largura,
+                        uint32_t valor, uint32_t maximo)
+{
+    uint32_t pixels, total, i;
+
+    if (col >= DISPLAY_GRAF_COLUNAS_LCD)
+        return;
+    if (largura > (DISPLAY_GRAF_COLUNAS_LCD - col))
+        largura = (uint8_t)(DISPLAY_GRAF_COLUNAS_LCD - col);
+
+    // Colunas de pixel acesas (arredondado)
+    total = (uint32_t)largura * DISPLAY_GRAF_PIXELS_CELULA;
+    if ((maximo == 0U) || (valor >= maximo))
+        pixels = (maximo == 0U) ? 0U : total;
+    else
+        pixels = (uint32_t)(((uint64_t)valor * total + (maximo / 2U)) / maximo);
+
+    for (i = 0; i < largura; i++)
+    {
+        if (pixels >= DISPLAY_GRAF_PIXELS_CELULA)
+        {
+            linha[col + i] = DISPLAY_GRAF_CHEIO;
+            pixels -= DISPLAY_GRAF_PIXELS_CELULA;
+        }
+        else if (pixels > 0U)
+        {
+            linha[col + i] = DISPLAY_GRAF_CODIGO(pixels - 1U);
+            pixels = 0;
+        }
+        else
+        {
+            linha[col + i] = ' ';
+        }
+    }
+}
+
+void DISPLAY_GRAF_Tendencia(char *linha, uint8_t col, const uint16_t *amostras,
+                            uint8_t n, uint16_t maximo)
+{
+    uint32_t nivel, i;
+
+    if (col >= DISPLAY_GRAF_COLUNAS_LCD)
+        return;
+    if (n > (DISPLAY_GRAF_COLUNAS_LCD - col))
+        n = (uint8_t)(DISPLAY_GRAF_COLUNAS_LCD - col);
+
+    for (i = 0; i < n; i++)
+    {
+        if (maximo == 0U)
+            nivel = 0;
+        else if (amostras[i] >= maximo)
+            nivel = DISPLAY_GRAF_NIVEIS;
+        else
+            nivel = ((uint32_t)amostras[i] * DISPLAY_GRAF_NIVEIS + (maximo / 2U)) / maximo;
+
+        if (nivel == 0U)
+            linha[col + i] = ' ';
+        else
+            linha[col + i] = DISPLAY_GRAF_CODIGO(DISPLAY_GRAF_SLOT_TENDENCIA + nivel - 1U);
+    }
+}
+
+void DISPLAY_GRAF_Latin1(char *linha, uint8_t n)
+{
+    uint8_t c;
+    uint32_t i;
+
+    for (i = 0; i < n; i++)
+    {
+        c = (uint8_t)linha[i];
+        if (c >= DISPLAY_GRAF_LATIN1_INICIO)
+            c = DISPLAY_GRAF_RomA00[c - DISPLAY_GRAF_LATIN1_INICIO];
+        else if (c == '\\')
+            c = '/';
+        else if (c == '~')
+            c = '-';
+        else if ((c < 0x20U) || (c >= 0x7FU))
+            c = ' ';
+        linha[i] = (char)c;
+    }
+}
+
+/*******************************************************************************
+ End of File
+ */
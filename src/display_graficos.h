@@ -0,0 +1,102 @@
+/*******************************************************************************
+  Grficos no LCD 20x4
+
+  File Name:
+    display_graficos.h
+
+  Summary:
+    Barras horizontais e grficos de tendncia com caracteres da CGRAM.
+
+  Description:
+    Os 8 caracteres programveis do HD44780 (CGRAM) so carregados por
+    lcd_init (app_display.c) com os glifos de DISPLAY_GRAF_Glifos:
+    - slots 0..3: barra com 1..4 colunas preenchidas (5 colunas = 0xFF);
+    - slots 4..7: coluna de tendncia com 2, 4, 6 e 8 linhas de altura.
+    Os glifos so escritos no quadro com os cdigos 8..15, que o HD44780
+    tambm mapeia para a CGRAM 0..7. O cdigo 0 no pode ser usado porque
+    lcd_send_byte troca '\0' por espao.
+
+    As funes s escrevem numa linha do quadro (char[20]); quem envia ao LCD
+     atualiza_lcd, que j manda s as clulas que mudaram.
+
+    Texto vindo de fora (leitor USB, Latin-1) passa por DISPLAY_GRAF_Latin1
+    antes de ir ao quadro: a ROM A00 do HD44780 no segue o Latin-1 acima de
+    0x7F e no h slot livre na CGRAM para acentos.
+*******************************************************************************/
+
+#ifndef _DISPLAY_GRAFICOS_H
+#define _DISPLAY_GRAFICOS_H
+
+// *****************************************************************************
+// *****************************************************************************
+// Section: Included Files
+// *****************************************************************************
+// *****************************************************************************
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <stddef.h>
+
+// DOM-IGNORE-BEGIN
+#ifdef __cplusplus  // Provide C++ Compatibility
+
+extern "C" {
+
+#endif
+// DOM-IGNORE-END
+
+// *****************************************************************************
+// *****************************************************************************
+// Section: Type Definitions
+// *****************************************************************************
+// *****************************************************************************
+
+#define DISPLAY_GRAF_COLUNAS_LCD    20U     // caracteres por linha
+#define DISPLAY_GRAF_PIXELS_CELULA  5U      // colunas de pixel por caractere
+
+// Cdigo de caractere do glifo no slot 'n' da CGRAM (ver Description)
+#define DISPLAY_GRAF_CODIGO(n)      ((char)(8U + (n)))
+#define DISPLAY_GRAF_CHEIO          ((char)0xFF)    // bloco cheio da ROM
+
+// Glifos da CGRAM: 8 caracteres de 8 linhas (5 bits cada)
+extern const uint8_t DISPLAY_GRAF_Glifos[8][8];
+
+// *****************************************************************************
+// *****************************************************************************
+// Section: Interface Functions
+// *****************************************************************************
+// *****************************************************************************
+
+/* DISPLAY_GRAF_Barra()
+ * Barra horizontal de 'largura' clulas a partir de 'col', proporcional a
+ * valor/maximo, com resoluo de 1/5 de clula (100 passos em 20 clulas).
+ */
+void DISPLAY_GRAF_Barra(char *linha, uint8_t col, uint8_t largura,
+                        uint32_t valor, uint32_t maximo);
+
+/* DISPLAY_GRAF_Tendencia()
+ * Grfico de tendncia: uma clula por amostra (a mais antiga  esquerda),
+ * altura proporcional a amostra/maximo em 4 nveis (mais o vazio).
+ */
+void DISPLAY_GRAF_Tendencia(char *linha, uint8_t col, const uint16_t *amostras,
+                            uint8_t n, uint16_t maximo);
+
+/* DISPLAY_GRAF_Latin1()
+ * Troca, no lugar, os 'n' caracteres Latin-1 de 'linha' por cdigos da ROM
+ * A00: letras acentuadas sem acento (, , , , , ,  e  usam o
+ * caractere da ROM), '\\' e '~' ( e seta na ROM) por '/' e '-', e cdigos
+ * de controle por espao, para no cair nos glifos da CGRAM.
+ */
+void DISPLAY_GRAF_Latin1(char *linha, uint8_t n);
+
+//DOM-IGNORE-BEGIN
+#ifdef __cplusplus
+}
+#endif
+//DOM-IGNORE-END
+
+#endif /* _DISPLAY_GRAFICOS_H */
+
+/*******************************************************************************
+ End of File
+ */
@@ -0,0 +1,135 @@
+/*******************************************************************************
+  Formatao de nmeros para o LCD
+
+  File Name:
+    formata.c
+
+  Summary:
+    Formatao de inteiros e ponto fixo direto numa linha do LCD, sem snprintf.
+
+  Description:
+    Ver formata.h.
+ *******************************************************************************/
+
+// *****************************************************************************
+// *****************************************************************************
+// Section: Included Files
+// *****************************************************************************
+// *****************************************************************************
+
+#include <stdbool.h>
+#include "formata.h"
+
+// *****************************************************************************
+// *****************************************************************************
+// Section: Local Functions
+// *****************************************************************************
+// *****************************************************************************
+
+#define FORMATA_MAX_DIGITOS 10U     // 4294967295
+
+/* formata_numero()
+ * Monta o campo: [preenchimento][sinal][dgitos com separador decimal].
+ * Com preenchimento '0' o sinal vem antes dos zeros, como no printf.
+ */
+static char *formata_numero(char *dst, uint32_t valor, bool negativo,
+                            uint8_t decimais, uint8_t largura, char preenche)
+{
+    char digitos[FORMATA_MAX_DIGITOS];
+    uint8_t n = 0, total, i;
+
+    // Dgitos do menos para o mais significativo
+    do
+    {
+        digitos[n++] = (char)('0' + (valor % 10U));
+        valor /= 10U;
+    } while (valor != 0U);
+
+    // Ponto fixo: pelo menos um dgito antes do separador (0,045)
+    if (decimais >= FORMATA_MAX_DIGITOS)
+        decimais = FORMATA_MAX_DIGITOS - 1U;
+    while (n <= decimais)
+        digitos[n++] = '0';
+
+    total = (uint8_t)(n + (decimais ? 1U : 0U) + (negativo ? 1U : 0U));
+    if (largura == 0U)
+        largura = total;
+
+    if (total > largura)
+    {
+        for (i = 0; i < largura; i++)
+            *dst++ = FORMATA_ESTOURO;
+        return dst;
+    }
+
+    if (preenche == '0')
+    {
+        if (negativo)
+            *dst++ = '-';
+        for (i = total; i < largura; i++)
+            *dst++ = '0';
+    }
+    else
+    {
+        for (i = total; i < largura; i++)
+            *dst++ = ' ';
+        if (negativo)
+            *dst++ = '-';
+    }
+
+    while (n > 0U)
+    {
+        if (decimais && (n == decimais))
+            *dst++ = FORMATA_SEPARADOR;
+        *dst++ = digitos[--n];
+    }
+
+    return dst;
+}
+
+// *****************************************************************************
+// *****************************************************************************
+// Section: Interface Functions
+// *****************************************************************************
+// *****************************************************************************
+
+char *FORMATA_Texto(char *dst, const char *txt, uint8_t largura)
+{
+    uint8_t i = 0;
+
+    if (largura == 0U)
+    {
+        while (txt[i] != '\0')
+            *dst++ = txt[i++];
+        return dst;
+    }
+
+    for (; (i < largura) && (txt[i] != '\0'); i++)
+        *dst++ = txt[i];
+    for (; i < largura; i++)
+        *dst++ = ' ';
+
+    return dst;
+}
+
+char *FORMATA_Uint(char *dst, uint32_t valor, uint8_t largura, char preenche)
+{
+    return formata_numero(dst, valor, false, 0, largura, preenche);
+}
+
+char *FORMATA_Int(char *dst, int32_t valor, uint8_t largura)
+{
+    // 0 - valor em 32 bits sem sinal tambm cobre INT32_MIN
+    if (valor < 0)
+        return formata_numero(dst, 0U - (uint32_t)valor, true, 0, largura, ' ');
+    return formata_numero(dst, (uint32_t)valor, false, 0, largura, ' ');
+}
+
+char *FORMATA_Fixo(char *dst, uint32_t valor, uint8_t decimais, uint8_t largura)
+{
+    return formata_numero(dst, valor, false, decimais, largura, ' ');
+}
+
+/*******************************************************************************
+ End of File
+ */
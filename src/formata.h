@@ -0,0 +1,91 @@
+/*******************************************************************************
+  Formatao de nmeros para o LCD
+
+  File Name:
+    formata.h
+
+  Summary:
+    Formatao de inteiros e ponto fixo direto numa linha do LCD, sem snprintf.
+
+  Description:
+    As funes escrevem um campo de largura fixa a partir de 'dst' e devolvem
+    o ponteiro logo aps o campo, para encadear campos na mesma linha:
+
+        p = FORMATA_Texto(lcd[1], "A=", 0);
+        p = FORMATA_Fixo(p, corrente, 1, 4);    // A*10 -> "25,3"
+
+    No escrevem '\0' (as linhas do LCD so char[20] sem terminador), no usam
+    a pilha alm de poucos bytes e no alocam nada.
+    Largura 0 usa o tamanho exato do valor. Um valor que no cabe na largura
+    pedida vira uma sequncia de '*', como nos multmetros.
+*******************************************************************************/
+
+#ifndef _FORMATA_H
+#define _FORMATA_H
+
+// *****************************************************************************
+// *****************************************************************************
+// Section: Included Files
+// *****************************************************************************
+// *****************************************************************************
+
+#include <stdint.h>
+
+// DOM-IGNORE-BEGIN
+#ifdef __cplusplus  // Provide C++ Compatibility
+
+extern "C" {
+
+#endif
+// DOM-IGNORE-END
+
+// *****************************************************************************
+// *****************************************************************************
+// Section: Type Definitions
+// *****************************************************************************
+// *****************************************************************************
+
+#define FORMATA_SEPARADOR   ','     // separador decimal
+#define FORMATA_ESTOURO     '*'     // valor no cabe no campo
+
+// *****************************************************************************
+// *****************************************************************************
+// Section: Interface Functions
+// *****************************************************************************
+// *****************************************************************************
+
+/* FORMATA_Texto()
+ * Copia 'txt' alinhado  esquerda e completa com espaos at 'largura'
+ * (texto maior  cortado). Largura 0 copia o texto inteiro.
+ */
+char *FORMATA_Texto(char *dst, const char *txt, uint8_t largura);
+
+/* FORMATA_Uint()
+ * Inteiro sem sinal alinhado  direita, completado com 'preenche'
+ * (' ' ou '0'), equivalente a "%*u" / "%0*u".
+ */
+char *FORMATA_Uint(char *dst, uint32_t valor, uint8_t largura, char preenche);
+
+/* FORMATA_Int()
+ * Inteiro com sinal alinhado  direita, completado com espaos ("%*ld").
+ */
+char *FORMATA_Int(char *dst, int32_t valor, uint8_t largura);
+
+/* FORMATA_Fixo()
+ * Ponto fixo: 'valor' em unidades de 10^-decimais (ex.: mOhm com 3 casas,
+ * A*10 com 1 casa), alinhado  direita e completado com espaos.
+ * Ex.: FORMATA_Fixo(p, 253, 1, 5) -> " 25,3"; FORMATA_Fixo(p, 45, 3, 0) -> "0,045"
+ */
+char *FORMATA_Fixo(char *dst, uint32_t valor, uint8_t decimais, uint8_t largura);
+
+//DOM-IGNORE-BEGIN
+#ifdef __cplusplus
+}
+#endif
+//DOM-IGNORE-END
+
+#endif /* _FORMATA_H */
+
+/*******************************************************************************
+ End of File
+ */
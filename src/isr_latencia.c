@@ -0,0 +1,253 @@
+/*******************************************************************************
+  Prioridades e latncia das interrupes
+
+  File Name:
+    isr_latencia.c
+
+  Summary:
+    Esquema de prioridades das interrupes e medida de latncia por vetor.
+
+  Description:
+    Ver isr_latencia.h.
+ *******************************************************************************/
+
+// *****************************************************************************
+// *****************************************************************************
+// Section: Included Files
+// *****************************************************************************
+// *****************************************************************************
+
+#include <string.h>
+#include "isr_latencia.h"
+#include "definitions.h"
+
+// *****************************************************************************
+// *****************************************************************************
+// Section: Global Data Definitions
+// *****************************************************************************
+// *****************************************************************************
+
+// As ISRs acima de configMAX_SYSCALL_INTERRUPT_PRIORITY no podem usar o RTOS
+_Static_assert(ISR_PRIO_TMR6 > ISR_PRIO_ZERO_CROSS, "gate do TRIAC precisa ser o mais prioritrio");
+_Static_assert(ISR_PRIO_ZERO_CROSS > configMAX_SYSCALL_INTERRUPT_PRIORITY, "zero-cross no pode ser mascarado pelo kernel");
+_Static_assert(ISR_PRIO_AQUISICAO <= configMAX_SYSCALL_INTERRUPT_PRIORITY, "aquisio notifica task");
+_Static_assert(ISR_PRIO_USB <= configMAX_SYSCALL_INTERRUPT_PRIORITY, "USB usa o OSAL");
+_Static_assert(ISR_PRIO_CORE_TIMER <= configMAX_SYSCALL_INTERRUPT_PRIORITY, "SYS_TIME chama clientes");
+_Static_assert(ISR_PRIO_LCD <= configMAX_SYSCALL_INTERRUPT_PRIORITY, "LCD notifica task");
+_Static_assert(ISR_PRIO_BOTOES <= configMAX_SYSCALL_INTERRUPT_PRIORITY, "botes usam fila");
+_Static_assert(ISR_PRIO_UART2 <= configMAX_SYSCALL_INTERRUPT_PRIORITY, "console usa o OSAL");
+
+// Ticks do core timer por microssegundo
+#define ISR_LAT_TICKS_US    (CORE_TIMER_FREQUENCY / 1000000U)
+
+// Seo crtica contra todas as prioridades
+#define ISR_LAT_TRAVA()     uint32_t estado_ = __builtin_disable_interrupts()
+#define ISR_LAT_DESTRAVA()  do { if ((estado_ & 0x1U) != 0U) __builtin_enable_interrupts(); } while (0)
+
+static ISR_LAT_ESTAT g_estat[ISR_LAT_N_VETORES];
+
+// Fontes com prioridade diferente do esquema na inicializao
+static uint32_t g_prioridadesErradas = 0;
+
+typedef struct
+{
+    INT_SOURCE fonte;
+    uint8_t prioridade;
+} ISR_LAT_PRIORIDADE;
+
+// Prioridade esperada de cada fonte habilitada no projeto
+static const ISR_LAT_PRIORIDADE isr_prioridades[] =
+{
+    { INT_SOURCE_TIMER_6,          ISR_PRIO_TMR6       },
+    { INT_SOURCE_CHANGE_NOTICE_C,  ISR_PRIO_ZERO_CROSS },
+#if (AQUISICAO_GB_USA_DMA == 1)
+    // No modo TMR2 a aquisio no programa o IPC do DMA1
+    { INT_SOURCE_DMA1,             ISR_PRIO_AQUISICAO  },
+#endif
+    { INT_SOURCE_TIMER_2,          ISR_PRIO_AQUISICAO  },
+    { INT_SOURCE_USB_1,            ISR_PRIO_USB        },
+    { INT_SOURCE_CORE_TIMER,       ISR_PRIO_CORE_TIMER },
+    { INT_SOURCE_ADC_EOS,          ISR_PRIO_ADC_EOS    },
+    { INT_SOURCE_TIMER_7,          ISR_PRIO_LCD        },
+    { INT_SOURCE_TIMER_3,          ISR_PRIO_BOTOES     },
+    { INT_SOURCE_CHANGE_NOTICE_A,  ISR_PRIO_BOTOES     },
+    { INT_SOURCE_CHANGE_NOTICE_B,  ISR_PRIO_BOTOES     },
+    { INT_SOURCE_CHANGE_NOTICE_G,  ISR_PRIO_BOTOES     },
+    { INT_SOURCE_UART2_FAULT,      ISR_PRIO_UART2      },
+    { INT_SOURCE_UART2_RX,         ISR_PRIO_UART2      },
+    { INT_SOURCE_UART2_TX,         ISR_PRIO_UART2      },
+};
+
+// Nome e fonte (a primeira, nos vetores que juntam vrias) para o console
+static const struct
+{
+    const char *nome;
+    INT_SOURCE fonte;
+} isr_vetores[ISR_LAT_N_VETORES] =
+{
+    [ISR_LAT_TMR6]       = { "TMR6",     INT_SOURCE_TIMER_6         },
+    [ISR_LAT_ZERO_CROSS] = { "ZC",       INT_SOURCE_CHANGE_NOTICE_C },
+    [ISR_LAT_DMA1]       = { "DMA1",     INT_SOURCE_DMA1            },
+    [ISR_LAT_TMR2]       = { "TMR2",     INT_SOURCE_TIMER_2         },
+    [ISR_LAT_USB]        = { "USB",      INT_SOURCE_USB_1           },
+    [ISR_LAT_CORE_TIMER] = { "CORE_TMR", INT_SOURCE_CORE_TIMER      },
+    [ISR_LAT_ADC_EOS]    = { "ADC_EOS",  INT_SOURCE_ADC_EOS         },
+    [ISR_LAT_TMR7]       = { "TMR7",     INT_SOURCE_TIMER_7         },
+    [ISR_LAT_TMR3]       = { "TMR3",     INT_SOURCE_TIMER_3         },
+    [ISR_LAT_BOTOES]     = { "BOTOES",   INT_SOURCE_CHANGE_NOTICE_A },
+    [ISR_LAT_UART2]      = { "UART2",    INT_SOURCE_UART2_RX        },
+};
+
+// *****************************************************************************
+// *****************************************************************************
+// Section: Local Functions
+// *****************************************************************************
+// *****************************************************************************
+
+/* ISR_LAT_PrioridadeGet()
+ * Prioridade programada de uma fonte. Mesmo clculo de endereo de
+ * plib_evic.c, mas lendo os registradores IPCx.
+ */
+static uint32_t ISR_LAT_PrioridadeGet(INT_SOURCE fonte)
+{
+    volatile uint32_t *IPCx = (volatile uint32_t *)(&IPC0 + ((0x10U * (fonte / 4U)) / 4U));
+    uint32_t shift = 8U * ((uint32_t)fonte & 0x3U);
+
+    return (*IPCx >> (shift + 2U)) & 0x7U;
+}
+
+/* ISR_LAT_PrioridadesConfere()
+ * Compara a prioridade programada de cada fonte com isr_prioridades[].
+ * Retorna quantas esto erradas; com 'imprime', lista cada uma no console.
+ */
+static uint32_t ISR_LAT_PrioridadesConfere(bool imprime)
+{
+    uint32_t i, prioridade, erradas = 0;
+
+    for (i = 0; i < (sizeof(isr_prioridades) / sizeof(isr_prioridades[0])); i++)
+    {
+        prioridade = ISR_LAT_PrioridadeGet(isr_prioridades[i].fonte);
+        if (prioridade == isr_prioridades[i].prioridade)
+            continue;
+
+        erradas++;
+        if (imprime)
+            SYS_CONSOLE_PRINT("Fonte %3lu: IPL %lu, esperado %lu\r\n",
+                              (unsigned long)isr_prioridades[i].fonte,
+                              (unsigned long)prioridade,
+                              (unsigned long)isr_prioridades[i].prioridade);
+    }
+    return erradas;
+}
+
+// Ticks do core timer -> nanossegundos
+static uint32_t ISR_LAT_TicksNs(uint32_t ticks)
+{
+    return (uint32_t)(((uint64_t)ticks * 1000U) / ISR_LAT_TICKS_US);
+}
+
+// *****************************************************************************
+// *****************************************************************************
+// Section: Interface Functions
+// *****************************************************************************
+// *****************************************************************************
+
+void ISR_LAT_Initialize(void)
+{
+    ISR_LAT_Reset();
+
+    // configASSERT no est definido no FreeRTOSConfig.h: a diferena fica
+    // contada e aparece no comando "isr"
+    g_prioridadesErradas = ISR_LAT_PrioridadesConfere(false);
+}
+
+uint32_t ISR_LAT_PrioridadesErradasGet(void)
+{
+    return g_prioridadesErradas;
+}
+
+void ISR_LAT_Registra(ISR_LAT_VETOR vetor, uint32_t entrada, uint32_t latencia)
+{
+    // Um vetor no interrompe a si mesmo, ento cada entrada s  escrita
+    // por uma ISR de cada vez
+    ISR_LAT_ESTAT *e = &g_estat[vetor];
+    uint32_t execucao = ISR_LAT_AGORA() - entrada;
+
+    e->n++;
+    if (execucao < e->execucao_min)
+        e->execucao_min = execucao;
+    if (execucao > e->execucao_max)
+        e->execucao_max = execucao;
+
+    if (latencia != ISR_LAT_SEM_LATENCIA)
+    {
+        if (latencia < e->latencia_min)
+            e->latencia_min = latencia;
+        if (latencia > e->latencia_max)
+            e->latencia_max = latencia;
+    }
+}
+
+void ISR_LAT_Reset(void)
+{
+    uint32_t i;
+    ISR_LAT_TRAVA();
+
+    for (i = 0; i < ISR_LAT_N_VETORES; i++)
+    {
+        g_estat[i].n = 0;
+        g_estat[i].latencia_min = UINT32_MAX;
+        g_estat[i].latencia_max = 0;
+        g_estat[i].execucao_min = UINT32_MAX;
+        g_estat[i].execucao_max = 0;
+    }
+
+    ISR_LAT_DESTRAVA();
+}
+
+void ISR_LAT_EstatisticasGet(ISR_LAT_VETOR vetor, ISR_LAT_ESTAT *estat)
+{
+    ISR_LAT_TRAVA();
+    *estat = g_estat[vetor];
+    ISR_LAT_DESTRAVA();
+}
+
+void ISR_LAT_ImprimeConsole(void)
+{
+    ISR_LAT_ESTAT e;
+    uint32_t i, erradas;
+
+    // Confere de novo: algum mdulo pode ter mudado uma prioridade depois
+    erradas = ISR_LAT_PrioridadesConfere(false);
+    SYS_CONSOLE_PRINT("\r\nPrioridades erradas: %lu na inicializacao, %lu agora\r\n",
+                      (unsigned long)g_prioridadesErradas, (unsigned long)erradas);
+    if (erradas != 0U)
+        (void)ISR_LAT_PrioridadesConfere(true);
+
+    SYS_CONSOLE_PRINT("\r\nISR (ns)  IPL  lat min  lat max exec min exec max          n\r\n");
+    for (i = 0; i < ISR_LAT_N_VETORES; i++)
+    {
+        ISR_LAT_EstatisticasGet((ISR_LAT_VETOR)i, &e);
+        if (e.n == 0U)
+        {
+            SYS_CONSOLE_PRINT("%-9s   -\r\n", isr_vetores[i].nome);
+            continue;
+        }
+        if (e.latencia_min == UINT32_MAX)
+            SYS_CONSOLE_PRINT("%-9s %4lu        -        -", isr_vetores[i].nome,
+                              (unsigned long)ISR_LAT_PrioridadeGet(isr_vetores[i].fonte));
+        else
+            SYS_CONSOLE_PRINT("%-9s %4lu %8lu %8lu", isr_vetores[i].nome,
+                              (unsigned long)ISR_LAT_PrioridadeGet(isr_vetores[i].fonte),
+                              (unsigned long)ISR_LAT_TicksNs(e.latencia_min),
+                              (unsigned long)ISR_LAT_TicksNs(e.latencia_max));
+        SYS_CONSOLE_PRINT(" %8lu %8lu %10lu\r\n",
+                          (unsigned long)ISR_LAT_TicksNs(e.execucao_min),
+                          (unsigned long)ISR_LAT_TicksNs(e.execucao_max),
+                          (unsigned long)e.n);
+    }
+}
+
+/*******************************************************************************
+ End of File
+ */
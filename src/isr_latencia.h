@@ -0,0 +1,155 @@
+/*******************************************************************************
+  Prioridades e latncia das interrupes
+
+  File Name:
+    isr_latencia.h
+
+  Summary:
+    Esquema de prioridades das interrupes e medida de latncia por vetor.
+
+  Description:
+    Esquema de prioridades (IPL 1..7). O FreeRTOS s mascara at
+    configMAX_SYSCALL_INTERRUPT_PRIORITY (3): acima disso a ISR nunca 
+    atrasada pelo kernel nem por taskENTER_CRITICAL, mas tambm no pode
+    chamar nenhuma API do FreeRTOS (nem as FromISR).
+
+      7  TMR6        borda do gate do TRIAC (no chama o RTOS)
+      6  CN porta C  zero-cross em RC2: referncia de tempo do TMR6
+      ---------------- configMAX_SYSCALL_INTERRUPT_PRIORITY --------------
+      3  DMA1, TMR2  blocos da aquisio GB -> vTaskNotifyGiveFromISR
+      3  USB_1       driver USB (OSAL)
+      3  CORE_TIMER  SYS_TIME (callbacks dos clientes)
+      3  ADC_EOS     sem callback; s fica habilitada fora do ensaio
+      2  TMR7        escritor do LCD -> vTaskNotifyGiveFromISR
+      1  TMR3        debounce dos botes -> xQueueSendFromISR
+      1  CN A, B, G  botes
+      1  UART2       console
+
+    Os valores de plib_evic.c (e o do DMA1, ajustado em aquisicao_gb.c)
+    precisam bater com a tabela acima: ISR_LAT_Initialize confere os
+    registradores IPC na partida.
+
+    Cada handler de interrupts.c registra, com o core timer (SYSCLK/2):
+    - latncia: do evento at a entrada no handler. S existe para os
+      timers (o contador anda desde o "match") e para o core timer
+      (COUNT - COMPARE); nos outros vetores fica sem valor;
+    - execuo: da entrada  sada do handler.
+*******************************************************************************/
+
+#ifndef _ISR_LATENCIA_H
+#define _ISR_LATENCIA_H
+
+// *****************************************************************************
+// *****************************************************************************
+// Section: Included Files
+// *****************************************************************************
+// *****************************************************************************
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <stddef.h>
+
+// DOM-IGNORE-BEGIN
+#ifdef __cplusplus  // Provide C++ Compatibility
+
+extern "C" {
+
+#endif
+// DOM-IGNORE-END
+
+// *****************************************************************************
+// *****************************************************************************
+// Section: Type Definitions
+// *****************************************************************************
+// *****************************************************************************
+
+// Prioridades (ver Description)
+#define ISR_PRIO_TMR6           7U
+#define ISR_PRIO_ZERO_CROSS     6U
+#define ISR_PRIO_AQUISICAO      3U      // DMA1 e TMR2
+#define ISR_PRIO_USB            3U
+#define ISR_PRIO_CORE_TIMER     3U
+#define ISR_PRIO_ADC_EOS        3U
+#define ISR_PRIO_LCD            2U      // TMR7
+#define ISR_PRIO_BOTOES         1U      // TMR3 e CN A, B, G
+#define ISR_PRIO_UART2          1U
+
+// Vetores medidos
+typedef enum
+{
+    ISR_LAT_TMR6 = 0,
+    ISR_LAT_ZERO_CROSS,
+    ISR_LAT_DMA1,
+    ISR_LAT_TMR2,
+    ISR_LAT_USB,
+    ISR_LAT_CORE_TIMER,
+    ISR_LAT_ADC_EOS,
+    ISR_LAT_TMR7,
+    ISR_LAT_TMR3,
+    ISR_LAT_BOTOES,             // CN portas A, B e G
+    ISR_LAT_UART2,              // falha, RX e TX
+    ISR_LAT_N_VETORES
+} ISR_LAT_VETOR;
+
+// Latncia desconhecida (vetor sem contador de referncia)
+#define ISR_LAT_SEM_LATENCIA    0xFFFFFFFFU
+
+typedef struct
+{
+    uint32_t n;                 // interrupes atendidas
+    uint32_t latencia_min;      // ticks do core timer
+    uint32_t latencia_max;
+    uint32_t execucao_min;
+    uint32_t execucao_max;
+} ISR_LAT_ESTAT;
+
+// Instante de entrada do handler
+#define ISR_LAT_AGORA()         _CP0_GET_COUNT()
+
+// Ticks do core timer por tick dos timers com prescaler 1:8 (TMR6, TMR7)
+#define ISR_LAT_CORE_POR_TMR_DIV8   8U
+
+// *****************************************************************************
+// *****************************************************************************
+// Section: Interface Functions
+// *****************************************************************************
+// *****************************************************************************
+
+/* ISR_LAT_Initialize()
+ * Zera as estatsticas e confere as prioridades programadas no EVIC contra
+ * o esquema acima. Chamar depois de EVIC_Initialize.
+ */
+void ISR_LAT_Initialize(void);
+
+/* ISR_LAT_PrioridadesErradasGet()
+ * Quantas fontes estavam com prioridade diferente do esquema na
+ * inicializao. ISR_LAT_ImprimeConsole mostra este nmero, confere de
+ * novo e lista as fontes erradas.
+ */
+uint32_t ISR_LAT_PrioridadesErradasGet(void);
+
+/* ISR_LAT_Registra()
+ * Chamada no fim de cada handler de interrupts.c. 'entrada'  o
+ * ISR_LAT_AGORA() do incio do handler.
+ */
+void ISR_LAT_Registra(ISR_LAT_VETOR vetor, uint32_t entrada, uint32_t latencia);
+
+void ISR_LAT_Reset(void);
+void ISR_LAT_EstatisticasGet(ISR_LAT_VETOR vetor, ISR_LAT_ESTAT *estat);
+
+/* ISR_LAT_ImprimeConsole()
+ * Tabela de todos os vetores em microssegundos (min/max) no console.
+ */
+void ISR_LAT_ImprimeConsole(void);
+
+//DOM-IGNORE-BEGIN
+#ifdef __cplusplus
+}
+#endif
+//DOM-IGNORE-END
+
+#endif /* _ISR_LATENCIA_H */
+
+/*******************************************************************************
+ End of File
+ */
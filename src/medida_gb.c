@@ -36,21 +36,89 @@
 #include "task.h"
 #include "menu_display.h"   // para poder mudar estado do menu
 #include "utils.h"
+#include "aquisicao_gb.h"
+#include "diag_gb.h"
+#include <string.h>
 
 MEDIDA_GB_DATA medida_gbData;
 
-static volatile uint8_t  g_powerPercent   = 0;       // 0..100 %
+static volatile uint32_t g_powerMilli     = 0;       // 0..100000 milsimos de %
+static volatile uint16_t g_delayFracao    = TRIAC_FRACAO_UM;  // atraso em frao do semiciclo (Q15)
 static volatile uint32_t g_delayTicks     = 0;       // atraso at disparo (em ticks TMR6)
+static volatile uint32_t g_halfCycleTicks = HALF_CYCLE_TICKS_60HZ;  // semiciclo medido (ticks TMR6)
+static volatile uint32_t g_tmr6Restante   = 0;       // parte da espera que passa de 16 bits
+
+// Medida do semiciclo pelo zero-cross, em ticks do core timer
+static volatile uint32_t g_zcUltimo       = 0;       // instante do ltimo zero-cross
+static volatile uint32_t g_meioCicloCore  = CORE_TIMER_FREQUENCY / 120U;
+static volatile uint8_t  g_zcValidos      = 0;       // semiciclos vlidos seguidos
+static uint32_t g_coreParaTmr6 = 8U;                 // ticks do core timer por tick do TMR6
+static volatile uint32_t g_gatePrevisto   = 0;       // core timer previsto p/ o disparo
 
 // Macros para os canais do ADCHS
 #define MEDIDA_GB_CH_RB0   ADCHS_CH1
 #define MEDIDA_GB_CH_RA1   ADCHS_CH2
 
-// Define a quantidade de cilos pora leitura
-#define QUANT_CICLOS    127
+// Semiciclos aceitos como rede (45..70Hz). Fora disso  rudo no zero-cross
+#define ZC_MEIO_CICLO_MIN   (CORE_TIMER_FREQUENCY / 140U)
+#define ZC_MEIO_CICLO_MAX   (CORE_TIMER_FREQUENCY / 90U)
+// Acima deste semiciclo (55Hz) a rede  considerada 50Hz
+#define ZC_MEIO_CICLO_50HZ  (CORE_TIMER_FREQUENCY / 110U)
+// Semiciclos vlidos seguidos para considerar a frequncia detectada
+#define ZC_VALIDOS_TRAVA    4U
+
+// Maior perodo programvel no TMR6 (16 bits)
+#define TRIAC_TMR6_MAX      0xFFFFU
+
+
+// Anel de blocos de amostras (aquisio -> MEDIDA_GB_Tasks).
+// Um produtor (callback da aquisio, em ISR) e um consumidor (task): o
+// produtor s avana g_blocoEscrita e a task s avana g_blocoLeitura, por
+// isso no precisa de seo crtica.
+// MEDIDA_GB_QUANT_BLOCOS tem de ser potncia de 2.
+#define MEDIDA_GB_AMOSTRAS_BLOCO    AQUISICAO_GB_AMOSTRAS_BLOCO
+#define MEDIDA_GB_QUANT_BLOCOS      4U
+
+// Barreira de compilador: impede que a escrita/leitura do bloco seja
+// reordenada com a atualizao do ndice (ncleo nico, basta isso)
+#define MEDIDA_GB_BARREIRA()        __asm__ volatile ("" ::: "memory")
+
+typedef struct
+{
+    uint16_t tensao[MEDIDA_GB_AMOSTRAS_BLOCO];
+    uint16_t corrente[MEDIDA_GB_AMOSTRAS_BLOCO];
+} MEDIDA_GB_BLOCO;
+
+static MEDIDA_GB_BLOCO g_blocos[MEDIDA_GB_QUANT_BLOCOS];
+static volatile uint32_t g_blocoEscrita = 0;   // s a ISR altera
+static volatile uint32_t g_blocoLeitura = 0;   // s a task altera
+static volatile uint32_t g_blocosPerdidos = 0;
+
+// Pedido de ensaio: liga em MEDIDA_GB_IniciaEnsaio e desliga quando a task
+// do ensaio termina (enquanto ligado, novos pedidos so ignorados)
+static volatile bool g_ensaioPedido = false;
+
+// Canal de leituras: seqlock com um s escritor (MEDIDA_GB_Tasks). 'seq'
+// mpar = publicao em andamento.
+static volatile uint32_t g_leituraSeq = 0;
+static MEDIDA_GB_LEITURA g_leitura;
+
+#define MEDIDA_GB_LEITURA_TENTATIVAS  8U
+
+typedef struct
+{
+    MEDIDA_GB_ASSINANTE aviso;
+    uintptr_t context;
+    TickType_t periodo;
+    TickType_t ultimo;          // tick do ltimo aviso
+} MEDIDA_GB_ASSINATURA;
+
+static MEDIDA_GB_ASSINATURA g_assinantes[MEDIDA_GB_ASSINANTES_MAX];
+static volatile uint32_t g_nAssinantes = 0;
 
 // Prottipos dos callbacks
-static void MEDIDA_GB_TMR2Callback(uint32_t status, uintptr_t context);
+static void MEDIDA_GB_BlocoCallback(const uint16_t *tensao, const uint16_t *corrente,
+                                    uint32_t n, uintptr_t context);
 
 // Estado do Timer 6
 typedef enum
@@ -62,35 +130,198 @@ typedef enum
 
 static volatile TMR6_STATE_t g_tmr6State = TMR6_STATE_IDLE;
 
-// Converte porcentagem de potncia em atraso (em ticks)
-static uint32_t TRIAC_ComputeDelayTicks(uint8_t powerPercent)
+/*
+    triac_fracao_delay[]
+
+    Atraso de disparo (frao do semiciclo, Q15) que entrega a frao i/256
+    da potncia RMS mxima numa carga resistiva:
+        P(d) = 1 - d + sen(2*pi*d) / (2*pi),   d = atraso / semiciclo
+    Gerada invertendo P(d) numericamente. Como  normalizada pelo semiciclo,
+    serve para 50 e 60Hz: o atraso em ticks do TMR6  'frao * semiciclo
+    medido' (ver TRIAC_ComputeDelayTicks).
+ */
+static const uint16_t triac_fracao_delay[TRIAC_TABELA_PASSOS + 1U] =
+{
+	32768, 30001, 29272, 28757, 28343, 27992, 27684, 27406, 27152, 26918, 26699, 26493,
+	26299, 26114, 25938, 25769, 25606, 25450, 25299, 25153, 25011, 24873, 24739, 24609,
+	24482, 24357, 24236, 24117, 24001, 23886, 23774, 23664, 23556, 23450, 23345, 23242,
+	23141, 23041, 22943, 22845, 22749, 22655, 22561, 22469, 22377, 22287, 22198, 22109,
+	22022, 21935, 21849, 21764, 21680, 21597, 21514, 21432, 21351, 21270, 21190, 21110,
+	21032, 20953, 20876, 20798, 20722, 20645, 20570, 20494, 20419, 20345, 20271, 20197,
+	20124, 20051, 19979, 19907, 19835, 19764, 19693, 19622, 19552, 19481, 19412, 19342,
+	19273, 19204, 19135, 19066, 18998, 18930, 18862, 18794, 18727, 18660, 18593, 18526,
+	18459, 18393, 18326, 18260, 18194, 18128, 18062, 17997, 17931, 17866, 17801, 17736,
+	17671, 17606, 17541, 17476, 17411, 17347, 17282, 17218, 17153, 17089, 17025, 16961,
+	16896, 16832, 16768, 16704, 16640, 16576, 16512, 16448, 16384, 16320, 16256, 16192,
+	16128, 16064, 16000, 15936, 15872, 15807, 15743, 15679, 15615, 15550, 15486, 15421,
+	15357, 15292, 15227, 15162, 15097, 15032, 14967, 14902, 14837, 14771, 14706, 14640,
+	14574, 14508, 14442, 14375, 14309, 14242, 14175, 14108, 14041, 13974, 13906, 13838,
+	13770, 13702, 13633, 13564, 13495, 13426, 13356, 13287, 13216, 13146, 13075, 13004,
+	12933, 12861, 12789, 12717, 12644, 12571, 12497, 12423, 12349, 12274, 12198, 12123,
+	12046, 11970, 11892, 11815, 11736, 11658, 11578, 11498, 11417, 11336, 11254, 11171,
+	11088, 11004, 10919, 10833, 10746, 10659, 10570, 10481, 10391, 10299, 10207, 10113,
+	10019,  9923,  9825,  9727,  9627,  9526,  9423,  9318,  9212,  9104,  8994,  8882,
+	 8767,  8651,  8532,  8411,  8286,  8159,  8029,  7895,  7757,  7615,  7469,  7318,
+	 7162,  6999,  6830,  6654,  6469,  6275,  6069,  5850,  5616,  5362,  5084,  4776,
+	 4425,  4011,  3496,  2767,     0
+};
+
+/* TRIAC_FracaoDelay()
+ * Potncia (milsimos de %) -> atraso em frao do semiciclo (Q15), por
+ * interpolao linear na tabela (passos de 1/256 = 0,39% de potncia).
+ */
+static uint16_t TRIAC_FracaoDelay(uint32_t powerMilli)
+{
+    uint32_t f, idx, resto, a, b;
+
+    if (powerMilli > TRIAC_POWER_MAX_MILLI)
+        powerMilli = TRIAC_POWER_MAX_MILLI;
+
+    // Potncia em Q16: milli * 65536 / 100000 = milli * 2048 / 3125
+    f = (powerMilli * 2048U + 1562U) / 3125U;
+    idx = f >> 8;
+    if (idx >= TRIAC_TABELA_PASSOS)
+        return triac_fracao_delay[TRIAC_TABELA_PASSOS];
+    resto = f & 0xFFU;
+
+    // Tabela decrescente: a >= b
+    a = triac_fracao_delay[idx];
+    b = triac_fracao_delay[idx + 1U];
+    return (uint16_t)(a - (((a - b) * resto + 128U) >> 8));
+}
+
+// Converte a frao de atraso atual em ticks do semiciclo medido
+static uint32_t TRIAC_ComputeDelayTicks(void)
 {
-    if (powerPercent > TRIAC_POWER_MAX)
-        powerPercent = TRIAC_POWER_MAX;
-    if (powerPercent < TRIAC_POWER_MIN)
-        powerPercent = TRIAC_POWER_MIN;
+    uint32_t halfCycle = g_halfCycleTicks;
 
     // 100% => delay = 0 ticks (disparo no incio do semiciclo)
-    // 0%   => delay = HALF_CYCLE_TICKS (sem conduo)
-    uint32_t delay = (uint32_t)(100U - powerPercent) * HALF_CYCLE_TICKS / 100U;
+    // 0%   => delay = semiciclo (sem conduo)
+    // Q15 * 75000 (50Hz) ainda cabe em 32 bits
+    uint32_t delay = ((uint32_t)g_delayFracao * halfCycle) >> 15;
 
     // Evita delay to grande que no sobra tempo pra gate ligado
-    if (delay > (HALF_CYCLE_TICKS - (MIN_GATING_TICKS + SAFETY_TICKS_TO_ZERO)))
+    if (delay > (halfCycle - (MIN_GATING_TICKS + SAFETY_TICKS_TO_ZERO)))
     {
-        delay = HALF_CYCLE_TICKS - (MIN_GATING_TICKS + SAFETY_TICKS_TO_ZERO);
+        delay = halfCycle - (MIN_GATING_TICKS + SAFETY_TICKS_TO_ZERO);
     }
 
     return delay;
 }
 
+/* TRIAC_TMR6Programa()
+ * Programa a prxima interrupo do TMR6 daqui a 'ticks'. O TMR6  de 16 bits
+ * e o semiciclo de 50Hz (75000 ticks) no cabe, ento esperas maiores so
+ * feitas em etapas; o callback s avana o estado quando g_tmr6Restante zera.
+ */
+static void TRIAC_TMR6Programa(uint32_t ticks)
+{
+    uint32_t etapa = (ticks > TRIAC_TMR6_MAX) ? TRIAC_TMR6_MAX : ticks;
+
+    g_tmr6Restante = ticks - etapa;
+    TMR6_CounterSet(0);
+    TMR6_PeriodSet((uint16_t)etapa);
+}
+
+/* ZC_MedeSemiciclo()
+ * Mede o semiciclo pelo intervalo entre dois zero-cross (core timer) e
+ * atualiza a durao do semiciclo em ticks do TMR6 e a frequncia da rede.
+ * Intervalos fora de 45..70Hz (primeira borda, rudo) so descartados.
+ */
+static void ZC_MedeSemiciclo(uint32_t agora)
+{
+    uint32_t periodo = agora - g_zcUltimo;
+    uint32_t meio;
+
+    g_zcUltimo = agora;
+
+    if ((periodo < ZC_MEIO_CICLO_MIN) || (periodo > ZC_MEIO_CICLO_MAX))
+    {
+        g_zcValidos = 0;
+        return;
+    }
+
+    // Primeira medida vale direto, depois filtra (mdia exponencial de 1/8)
+    meio = g_meioCicloCore;
+    if (g_zcValidos == 0U)
+        meio = periodo;
+    else
+        meio = meio + (uint32_t)(((int32_t)(periodo - meio)) / 8);
+    g_meioCicloCore = meio;
+
+    if (g_zcValidos < ZC_VALIDOS_TRAVA)
+    {
+        g_zcValidos++;
+        return;
+    }
+
+    g_halfCycleTicks = meio / g_coreParaTmr6;
+    g_delayTicks = TRIAC_ComputeDelayTicks();
+    medida_gbData.freq_rede = (meio > ZC_MEIO_CICLO_50HZ) ? 50U : 60U;
+}
+
+/* MEDIDA_GB_AmostrasJanela()
+ * Nmero de amostras que cobre 'ciclos_janela' ciclos completos da rede, a
+ * partir do semiciclo medido pelo zero-cross (arredondado).
+ */
+static uint16_t MEDIDA_GB_AmostrasJanela(void)
+{
+    uint64_t ticks;
+
+    // Durao da janela em ticks do clock da amostragem
+    ticks = (uint64_t)g_meioCicloCore * (2U * medida_gbData.ciclos_janela) *
+            AQUISICAO_GB_CLOCK_HZ / CORE_TIMER_FREQUENCY;
+
+    return (uint16_t)((ticks + (AQUISICAO_GB_TICKS_AMOSTRA / 2U)) / AQUISICAO_GB_TICKS_AMOSTRA);
+}
+
 // ====== API pblica ======
 
+void MEDIDA_GB_JanelaSet(uint8_t ciclos)
+{
+    if (ciclos < 1U)
+        ciclos = 1U;
+    if (ciclos > MEDIDA_GB_CICLOS_JANELA_MAX)
+        ciclos = MEDIDA_GB_CICLOS_JANELA_MAX;
+
+    // Lido pela task no incio de cada janela (escrita de 8 bits  atmica)
+    medida_gbData.ciclos_janela = ciclos;
+}
+
+void MEDIDA_GB_CorrenteAlvoSet(uint32_t corrente)
+{
+    // Alvo no limite faria o sobressinal do regulador cortar o ensaio
+    if (corrente > REG_GB_ALVO_MAX)
+        corrente = REG_GB_ALVO_MAX;
+
+    medida_gbData.corrente_alvo = corrente;
+}
+
+void TRIAC_SetPowerMilli(uint32_t powerMilli)
+{
+    uint16_t fracao;
+    uint32_t estado;
+
+    if (powerMilli > TRIAC_POWER_MAX_MILLI)
+        powerMilli = TRIAC_POWER_MAX_MILLI;
+    fracao = TRIAC_FracaoDelay(powerMilli);
+
+    // taskENTER_CRITICAL no mascara o zero-cross nem o TMR6 (acima de
+    // configMAX_SYSCALL_INTERRUPT_PRIORITY): desabilita tudo por um instante
+    estado = __builtin_disable_interrupts();
+    g_powerMilli   = powerMilli;
+    g_delayFracao  = fracao;
+    g_delayTicks   = TRIAC_ComputeDelayTicks();
+    if ((estado & 0x1U) != 0U)
+        __builtin_enable_interrupts();
+}
+
 void TRIAC_SetPowerPercent(uint8_t percent)
 {
-    taskENTER_CRITICAL();
-    g_powerPercent = percent;
-    g_delayTicks   = TRIAC_ComputeDelayTicks(g_powerPercent);
-    taskEXIT_CRITICAL();
+    if (percent > TRIAC_POWER_MAX)
+        percent = TRIAC_POWER_MAX;
+
+    TRIAC_SetPowerMilli((uint32_t)percent * 1000U);
 }
 
 void TRIAC_Control_Initialize(void)
@@ -108,8 +339,11 @@ void TRIAC_Control_Initialize(void)
     TMR6_CallbackRegister(TMR6_Callback, (uintptr_t)NULL);
 
     g_tmr6State   = TMR6_STATE_IDLE;
-    g_powerPercent = 0;
-    g_delayTicks   = TRIAC_ComputeDelayTicks(g_powerPercent);
+    g_tmr6Restante = 0;
+    g_coreParaTmr6 = CORETIMER_FrequencyGet() / TMR6_FrequencyGet();
+    g_powerMilli   = 0;
+    g_delayFracao  = TRIAC_FRACAO_UM;
+    g_delayTicks   = TRIAC_ComputeDelayTicks();
 
     // Potncia inicial baixa
     TRIAC_SetPowerPercent(0);
@@ -119,10 +353,14 @@ void TRIAC_Control_Initialize(void)
 
 void ZC_InterruptHandler(GPIO_PIN pin, uintptr_t context)
 {
+    uint32_t agora = _CP0_GET_COUNT();
+
     // Foi detectado um zero-cross: novo semiciclo iniciando.
+    ZC_MedeSemiciclo(agora);
+    DIAG_GB_ZeroCross(agora);
 
     // Se potncia zero, no disparamos TRIAC
-    if (g_powerPercent == 0)
+    if (g_powerMilli == 0U)
     {
         PINO_TRIAC_GB_Clear();
         g_tmr6State = TMR6_STATE_IDLE;
@@ -133,10 +371,12 @@ void ZC_InterruptHandler(GPIO_PIN pin, uintptr_t context)
 
     uint32_t delay = g_delayTicks;
 
+    // Instante previsto do disparo, para medir o atraso real (diag_gb)
+    g_gatePrevisto = agora + delay * g_coreParaTmr6;
+
     // Programa Timer6 para esperar o atraso at o disparo
     TMR6_Stop();
-    TMR6_CounterSet(0);
-    TMR6_PeriodSet((uint16_t)delay);  // HALF_CYCLE_TICKS cabe em 16 bits
+    TRIAC_TMR6Programa(delay);
 
     g_tmr6State = TMR6_STATE_WAIT_DELAY;
     TMR6_InterruptEnable();
@@ -150,33 +390,41 @@ void TMR6_Callback(uint32_t status, uintptr_t context)
     (void)status;
     (void)context;
 
+    // Espera maior que 16 bits ainda no terminou
+    if ((g_tmr6Restante != 0U) && (g_tmr6State != TMR6_STATE_IDLE))
+    {
+        TRIAC_TMR6Programa(g_tmr6Restante);
+        return;
+    }
+
     switch (g_tmr6State)
     {
         case TMR6_STATE_WAIT_DELAY:
         {
             // Chegou a hora de disparar TRIAC
             PINO_TRIAC_GB_Set();
+            DIAG_GB_GateOn(_CP0_GET_COUNT(), g_gatePrevisto);
             g_tmr6State = TMR6_STATE_GATE_ON;
 
             // Calcula por quanto tempo manter o gate alto:
             // do ponto atual at prximo do zero-cross:
             uint32_t delay  = g_delayTicks;
+            uint32_t halfCycle = g_halfCycleTicks;
             uint32_t gateTicks;
 
-            if (delay >= HALF_CYCLE_TICKS)
+            if (delay >= halfCycle)
             {
                 gateTicks = MIN_GATING_TICKS;  // no deveria acontecer
             }
             else
             {
-                uint32_t maxGate = HALF_CYCLE_TICKS - delay - SAFETY_TICKS_TO_ZERO;
+                uint32_t maxGate = halfCycle - delay - SAFETY_TICKS_TO_ZERO;
                 if (maxGate < MIN_GATING_TICKS)
                     gateTicks = MIN_GATING_TICKS;
                 else
                     gateTicks = maxGate;
             }
-            TMR6_CounterSet(0);
-            TMR6_PeriodSet((uint16_t)gateTicks);
+            TRIAC_TMR6Programa(gateTicks);
             break;
         }
 
@@ -184,6 +432,7 @@ void TMR6_Callback(uint32_t status, uintptr_t context)
         {
             // Tempo de gate alto acabou, desliga gate
             PINO_TRIAC_GB_Clear();
+            DIAG_GB_GateOff(_CP0_GET_COUNT());
             g_tmr6State = TMR6_STATE_IDLE;
 
             // Timer s volta a ser usado no prximo zero-cross
@@ -208,113 +457,282 @@ void TMR6_Callback(uint32_t status, uintptr_t context)
     }
 }
 
-/*
-	i_gb_calcula()
-
-	A partir do ultimo valor de corrente RMS binrio medido, calcula a sada de aterramento em A*10.
-	O coeficiente  multiplicado por 1024 para podermos fazer uma multiplicao com numeros inteiros sem perder casas decimais, o
-	resultado  ento dividido por 8192 (2^13).
-
-	Ibin = Ia10 * (1/10) * (1/1000)  *    94     *  (18/33)  * (4096/2,5)
-		       A->A10     TC       Resistor      AMP	       ADC
-        Ibin=Ia10*8,4
-	Ia10=Ibin*(1/8,4)
-
-	Supondo um coeficiente que permita variar 0,1% do valor
-	Ia10=Ibin*(1/8,4)
-	Colocando os outros fatores numa potncia de 2, exceto o coeficiente (aproximando)
-	Ia10=Ibin*(975/2^13)
-*/
-uint32_t i_gb_calcula(uint32_t i_rms)
+/* MEDIDA_GB_Regula()
+ * Regulador da corrente do ensaio, chamado a cada janela RMS com a corrente
+ * medida. Integral pura (a corrente cresce com a potncia, sem inverso),
+ * com:
+ * - ganho e rampa escalados pelo alvo: numa carga resistiva a corrente vai
+ *   com a raiz da potncia, ento um alvo baixo pede pouca potncia e cada
+ *   milsimo de % rende mais corrente. KI escala com o alvo e a rampa com o
+ *   quadrado dele (relativos a REG_GB_CORRENTE_ALVO), para o sobressinal
+ *   no crescer quando o alvo cai;
+ * - soft-start: a sada sobe no mximo REG_GB_RAMPA_MAX por janela;
+ * - limite: acima de REG_GB_CORRENTE_LIMITE corta o TRIAC e para de regular;
+ * - assentamento: REG_GB_JANELAS_ESTAVEL janelas seguidas com erro dentro
+ *   de REG_GB_TOLERANCIA_PCT do alvo marcam a leitura como estvel.
+ */
+static void MEDIDA_GB_Regula(uint32_t corrente)
+{
+    int32_t erro, passo, saida, alvo, rampa;
+    uint32_t tolerancia;
+
+    if (corrente > REG_GB_CORRENTE_LIMITE)
+    {
+        medida_gbData.regulando = false;
+        medida_gbData.sobrecorrente = true;
+        medida_gbData.potencia_mp = 0;
+        TRIAC_SetPowerPercent(0);
+        return;
+    }
+
+    alvo = (int32_t)medida_gbData.corrente_alvo;
+    erro = alvo - (int32_t)corrente;
+
+    rampa = ((REG_GB_RAMPA_MAX * alvo) / (int32_t)REG_GB_CORRENTE_ALVO) * alvo /
+            (int32_t)REG_GB_CORRENTE_ALVO;
+    if (rampa > REG_GB_RAMPA_MAX)
+        rampa = REG_GB_RAMPA_MAX;
+    if (rampa < REG_GB_RAMPA_MIN)
+        rampa = REG_GB_RAMPA_MIN;
+
+    passo = (erro * REG_GB_KI * alvo) / (int32_t)REG_GB_CORRENTE_ALVO;
+    if (passo > rampa)
+        passo = rampa;
+
+    saida = medida_gbData.potencia_mp + passo;
+    if (saida < 0)
+        saida = 0;
+    if (saida > REG_GB_SAIDA_MAX)
+        saida = REG_GB_SAIDA_MAX;
+    medida_gbData.potencia_mp = saida;
+
+    // Potncia linearizada (tabela de ngulo de fase), sem arredondar p/ %
+    TRIAC_SetPowerMilli((uint32_t)saida);
+
+    tolerancia = (medida_gbData.corrente_alvo * REG_GB_TOLERANCIA_PCT) / 100U;
+    if (tolerancia == 0U)
+        tolerancia = 1U;
+
+    if ((uint32_t)((erro < 0) ? -erro : erro) <= tolerancia)
+    {
+        if (medida_gbData.janelas_estaveis < REG_GB_JANELAS_ESTAVEL)
+            medida_gbData.janelas_estaveis++;
+        if (medida_gbData.janelas_estaveis >= REG_GB_JANELAS_ESTAVEL)
+            medida_gbData.estavel = true;
+    }
+    else
+    {
+        medida_gbData.janelas_estaveis = 0;
+        medida_gbData.estavel = false;
+    }
+}
+
+/* MEDIDA_GB_Publica()
+ * Publica a leitura da janela que acabou de fechar e avisa os assinantes
+ * cujo intervalo j passou. Tambm acorda a task do ensaio quando a
+ * corrente assenta ou passa do limite, para ela encerrar sem esperar.
+ */
+static void MEDIDA_GB_Publica(void)
 {
-	unsigned int temp;	// Nmero de 32 bits para guardar a multiplicao de um numero de 12 bits (v_rms)
-				// com um de aproximadamente 10 bits (coeficiente)
+    TickType_t agora = xTaskGetTickCount();
+    uint32_t seq, i, n;
+
+    seq = g_leituraSeq + 1U;
+    g_leituraSeq = seq;                 // mpar: leitores esperam
+    __sync_synchronize();
+
+    g_leitura.seq           = (seq + 1U) >> 1;
+    g_leitura.resistencia   = medida_gbData.resistencia;
+    g_leitura.corrente      = medida_gbData.corrente;
+    g_leitura.tensao        = medida_gbData.tensao;
+    g_leitura.potencia_mp   = medida_gbData.potencia_mp;
+    g_leitura.estavel       = medida_gbData.estavel;
+    g_leitura.sobrecorrente = medida_gbData.sobrecorrente;
+
+    __sync_synchronize();
+    g_leituraSeq = seq + 1U;            // par: cpia inteira disponvel
+
+    n = g_nAssinantes;
+    for (i = 0; i < n; i++)
+    {
+        if ((agora - g_assinantes[i].ultimo) >= g_assinantes[i].periodo)
+        {
+            g_assinantes[i].ultimo = agora;
+            g_assinantes[i].aviso(g_leitura.seq, g_assinantes[i].context);
+        }
+    }
 
-	//temp = ((unsigned int)i_rms) * ((unsigned int)sistema_config.coef_aj_i_gb);
-	temp = ((unsigned int)i_rms) * 1129;
-	temp = temp >> 13;
+    if ((medida_gbData.estavel || medida_gbData.sobrecorrente) && g_ensaioPedido)
+        xTaskNotifyGive(xMEDIDA_GB_TesteTask);
+}
 
-	return(temp);
+bool MEDIDA_GB_LeituraGet(MEDIDA_GB_LEITURA *leitura)
+{
+    MEDIDA_GB_LEITURA copia;
+    uint32_t antes, i;
+
+    // O escritor  a MEDIDA_GB_Tasks (configMAX_PRIORITIES - 1), que s
+    // divide a prioridade com a MEDIDA_GB_TesteTask; as tasks USB ficam
+    // abaixo (tasks.c). Um leitor de prioridade menor nunca interrompe a
+    // publicao, ento as tentativas s cobrem o escritor publicar
+    // enquanto o leitor copia. Se as tentativas acabarem (troca por fatia
+    // de tempo no meio da publicao), volta false e o leitor fica com a
+    // cpia anterior.
+    for (i = 0; i < MEDIDA_GB_LEITURA_TENTATIVAS; i++)
+    {
+        antes = g_leituraSeq;
+        if ((antes == 0U) || (antes & 1U))
+        {
+            if (antes == 0U)
+                return false;       // nada publicado ainda
+            continue;
+        }
+        __sync_synchronize();
+        copia = g_leitura;
+        __sync_synchronize();
+        if (g_leituraSeq == antes)
+        {
+            *leitura = copia;
+            return true;
+        }
+    }
+    return false;
 }
 
-/*
-	r_gb_calcula()
-
-	A partir do ultimo valor de corrente RMS binrio medido, calcula a sada de aterramento em A*10.
-	
-	Vbin = V *   (1/3,3)   *  (4096/2,5)
-		       amp          ADC
-	V=Vbin*(1/496)
-
- 	Ibin = Ia10 * (1/1000)  *    94     *  (18/33)  * (4096/2,5)
-		         TC       Resistor      AMP	       ADC
-	I=Ibin*(1/84) (corrente em A)
-
-	Rreal = V/I = (Vbin/496) / (Ibin/84) = (Vbin/Ibin) * (84/496)
-	Esse resultado  em Ohms, mas queremos em mOhms , ento multiplicamos por 1000
-	Rreal = (Vbin/Ibin) * (84000/496) =  (Vbin/Ibin) * 169
-	
- 	Transformando o coeficiente para um inteiro dividido por uma potncia de 2:
-	Rreal = (Vbin/Ibin) * (1354/2^3)
-*/
-uint32_t r_gb_calcula(uint32_t v_rms, uint32_t i_rms)
+bool MEDIDA_GB_Assina(MEDIDA_GB_ASSINANTE aviso, uintptr_t context, TickType_t periodo)
 {
-	uint32_t temp;	// Nmero de 32 bits para guardar a multiplicao de um numero de 12 bits (v_rms)
-				// com um de aproximadamente 10 bits (coeficiente)
-
-	if (i_rms>0){
-		//temp = v_rms * ((unsigned int)sistema_config.coef_aj_r_gb);
-		temp = v_rms * 1335;
-		temp = temp / i_rms;
-		temp = temp>>3;
-
-		return(temp);
-	}else{
-		return(0xFFFFFFFF);
-	}
+    uint32_t n;
+    bool ok = false;
+
+    if (aviso == NULL)
+        return false;
+
+    taskENTER_CRITICAL();
+    n = g_nAssinantes;
+    if (n < MEDIDA_GB_ASSINANTES_MAX)
+    {
+        g_assinantes[n].aviso   = aviso;
+        g_assinantes[n].context = context;
+        g_assinantes[n].periodo = periodo;
+        g_assinantes[n].ultimo  = 0;
+        // S conta depois de preencher: a publicao l sem travar
+        __sync_synchronize();
+        g_nAssinantes = n + 1U;
+        ok = true;
+    }
+    taskEXIT_CRITICAL();
+
+    return ok;
 }
 
-static void MEDIDA_GB_TMR2Callback(uint32_t status, uintptr_t context)
+/* MEDIDA_GB_ProcessaAmostra()
+ * Processa um par de amostras (tenso, corrente) da medida GB.
+ * No acessa nenhum perifrico, apenas 'medida_gbData', para que a cadeia de
+ * medida possa ser alimentada tanto pelo ADCHS quanto por amostras sintticas.
+ * Roda no contexto da task MEDIDA_GB_Tasks, nunca na ISR.
+ */
+void MEDIDA_GB_ProcessaAmostra(uint32_t adc_v, uint32_t adc_i)
 {
-    uint32_t volatile adc_i, adc_v;
     uint32_t i_rms, v_rms;
 
-    // L os dois canais configurados no scan. Cada canal  12bits
-    adc_i  = ADCDATA2;
-    adc_v = ADCDATA1;
-    
-    medida_gbData.soma_quad_v += adc_v * adc_v;
-	medida_gbData.soma_quad_i += adc_i * adc_i;
-    
-    //medida_gbData.fl3 = medida_gbData.soma_quad_i;
+    // Incio de janela: ajusta o tamanho ao ciclo da rede medido at agora
+    if(medida_gbData.cont_ciclos == 0U)
+        medida_gbData.amostras_janela = MEDIDA_GB_AmostrasJanela();
+
+    // Cada quadrado cabe em 32 bits (12 bits ao quadrado); s a soma  de 64
+    medida_gbData.soma_quad_v += (uint32_t)(adc_v * adc_v);
+    medida_gbData.soma_quad_i += (uint32_t)(adc_i * adc_i);
+    medida_gbData.cont_ciclos++;
     
-    if(medida_gbData.cont_ciclos >= QUANT_CICLOS)
+    // Fecha a janela em ciclos completos da rede
+    if(medida_gbData.cont_ciclos >= medida_gbData.amostras_janela)
     {
-        medida_gbData.cont_ciclos = 0;
-        
-        v_rms = calcula_rms(medida_gbData.soma_quad_v);
-		i_rms = calcula_rms(medida_gbData.soma_quad_i);
+        v_rms = calcula_rms(medida_gbData.soma_quad_v, medida_gbData.cont_ciclos);
+        i_rms = calcula_rms(medida_gbData.soma_quad_i, medida_gbData.cont_ciclos);
         
+        medida_gbData.cont_ciclos = 0;
         medida_gbData.soma_quad_v = 0;
         medida_gbData.soma_quad_i = 0;
         
         // MEDIDA_GB
         medida_gbData.resistencia = r_gb_calcula(v_rms, i_rms);
         medida_gbData.corrente = i_gb_calcula(i_rms);
+        medida_gbData.tensao = v_rms;
+        
+        if(medida_gbData.regulando)
+            MEDIDA_GB_Regula(medida_gbData.corrente);
+
+        MEDIDA_GB_Publica();
     }
-    medida_gbData.cont_ciclos++;
-    // Dispara converso global para ler na prxima chamada do timer2
-    ADCHS_GlobalEdgeConversionStart();
 }
 
+/* MEDIDA_GB_BlocoCallback()
+ * Chamada pela interrupo da aquisio a cada bloco completo. Apenas copia o
+ * bloco para o anel e acorda a task de processamento (MEDIDA_GB_Tasks) por
+ * notificao direta. Toda a conta (quadrados, razes, diviso)  feita fora
+ * da interrupo.
+ */
+static void MEDIDA_GB_BlocoCallback(const uint16_t *tensao, const uint16_t *corrente,
+                                    uint32_t n, uintptr_t context)
+{
+    BaseType_t xHigherPriorityTaskWoken = pdFALSE;
+    MEDIDA_GB_BLOCO *bloco;
 
-void MEDIDA_GB_RunTestTask(void *pvParameters)
+    (void)context;
+
+    // S escreve se o anel tiver bloco livre. Caso contrrio o bloco 
+    // descartado (e contado) para no corromper o bloco que a task est lendo.
+    if ((uint32_t)(g_blocoEscrita - g_blocoLeitura) < MEDIDA_GB_QUANT_BLOCOS)
+    {
+        bloco = &g_blocos[g_blocoEscrita & (MEDIDA_GB_QUANT_BLOCOS - 1U)];
+
+        memcpy(bloco->tensao, tensao, n * sizeof(uint16_t));
+        memcpy(bloco->corrente, corrente, n * sizeof(uint16_t));
+
+        // Garante que o bloco foi escrito antes de ser publicado
+        MEDIDA_GB_BARREIRA();
+        g_blocoEscrita++;
+        vTaskNotifyGiveFromISR(xMEDIDA_GB_Tasks, &xHigherPriorityTaskWoken);
+    }
+    else
+    {
+        g_blocosPerdidos++;
+    }
+
+    portEND_SWITCHING_ISR(xHigherPriorityTaskWoken);
+}
+
+/* MEDIDA_GB_ConsomeBlocos()
+ * Chamada pela task de processamento. Consome todos os blocos publicados
+ * pela aquisio, passando cada par de amostras para MEDIDA_GB_ProcessaAmostra.
+ */
+static void MEDIDA_GB_ConsomeBlocos(void)
 {
-    const TickType_t testDuration = pdMS_TO_TICKS(5000);   // 5 segundos
-    const TickType_t samplePeriod = pdMS_TO_TICKS(100);     // l corrente a cada 100 ms
-    TickType_t startTick;
+    const MEDIDA_GB_BLOCO *bloco;
+    uint32_t n;
 
-    (void) pvParameters;
+    while (g_blocoLeitura != g_blocoEscrita)
+    {
+        bloco = &g_blocos[g_blocoLeitura & (MEDIDA_GB_QUANT_BLOCOS - 1U)];
+
+        for (n = 0; n < MEDIDA_GB_AMOSTRAS_BLOCO; n++)
+            MEDIDA_GB_ProcessaAmostra(bloco->tensao[n], bloco->corrente[n]);
+
+        // Libera o bloco para a ISR somente depois de lido
+        MEDIDA_GB_BARREIRA();
+        g_blocoLeitura++;
+    }
+}
+
+
+/* MEDIDA_GB_Ensaio()
+ * Um ensaio GB completo: liga rel/MUX/TRIAC e aquisio, espera at 5 s (ou
+ * a corrente assentar / sobrecorrente) e desliga tudo.
+ */
+static void MEDIDA_GB_Ensaio(void)
+{
+    const TickType_t testDuration = pdMS_TO_TICKS(5000);   // 5 segundos no mximo
+    TickType_t startTick, decorrido;
 
     // Estado inicial previsvel
     medida_gbData.correnteA = 0.0f;
@@ -322,6 +740,8 @@ void MEDIDA_GB_RunTestTask(void *pvParameters)
     medida_gbData.tensao = 0;
     medida_gbData.resistencia = 0;
     medida_gbData.cont_ciclos = 0;
+    medida_gbData.soma_quad_v = 0;
+    medida_gbData.soma_quad_i = 0;
     
     // Aciona rel 2, necessrios fazer isso antes de iniciar a medida
     PINO_RELE2_TAP_Set();
@@ -333,43 +753,52 @@ void MEDIDA_GB_RunTestTask(void *pvParameters)
     // Inicializa controle do TRIAC (timer, callback etc.)
     TRIAC_Control_Initialize();
 
-    // Potncia baixa fixa (ex.: 20%)
-    TRIAC_SetPowerPercent(20);
+    // Comea sem potncia; o regulador sobe em rampa at a corrente alvo
+    medida_gbData.potencia_mp = 0;
+    medida_gbData.janelas_estaveis = 0;
+    medida_gbData.estavel = false;
+    medida_gbData.sobrecorrente = false;
+    TRIAC_SetPowerPercent(0);
 
-    // Habilita zero-cross (comea a disparar TRIAC via TMR6)
+    // Habilita zero-cross (comea a disparar TRIAC via TMR6). A medida do
+    // semiciclo recomea: a primeira borda no tem referncia anterior
+    g_zcValidos = 0;
+    DIAG_GB_Reset();
     PINO_ZERO_CROSS_InterruptEnable();
 
-    // Dispara converso global de todos canais configurados no scan (ADCCSS)
-    ADCHS_GlobalEdgeConversionStart();
-    // Espera o sampling time de 500ns. Vamos esperar mais para garantir
-	DELAY_250NS();
-	DELAY_250NS();
-	DELAY_250NS();
-    
-    // === INCIO: habilita TMR2 para amostrar ADC ===
-    TMR2_Stop();
-    TMR2_CounterSet(0);
-    // PR2 j est 7811 (130,2 us), mas se quiser reforar:
-    // TMR2_PeriodSet(7811U);
-    TMR2_CallbackRegister(MEDIDA_GB_TMR2Callback, 0);
-    TMR2_InterruptEnable();
-    TMR2_Start();
-    // === FIM: habilita TMR2 ===
+    // === INCIO: amostragem de tenso/corrente ===
+    // Esvazia o anel de blocos (aquisio parada e MEDIDA_GB_Tasks ociosa)
+    g_blocoLeitura = g_blocoEscrita;
+    g_blocosPerdidos = 0;
+    AQUISICAO_GB_CallbackRegister(MEDIDA_GB_BlocoCallback, 0);
+    AQUISICAO_GB_Start();
+    // === FIM: amostragem de tenso/corrente ===
+
+    // Liga o regulador (roda em MEDIDA_GB_Tasks a cada janela RMS)
+    medida_gbData.regulando = true;
 
     // Marca incio do teste
     startTick = xTaskGetTickCount();
 
-    while ((xTaskGetTickCount() - startTick) < testDuration)
+    // Garante que o estado do display fica em ENSAIO_GB_STATE_ENSAIANDO.
+    // Daqui em diante quem atualiza o display  o canal de leituras.
+    menu_displayData.state = ENSAIO_GB_STATE_ENSAIANDO;
+    ACTION_SendEventFromTask(ACT_NONE, ACT_EVENT_DISPLAY_UPDATE);
+
+    // Termina no tempo mximo, quando a corrente assenta ou em sobrecorrente.
+    // Dorme at o fim do tempo; MEDIDA_GB_Publica acorda antes se assentar
+    // ou passar do limite.
+    (void)ulTaskNotifyTake(pdTRUE, 0);
+    for (;;)
     {
-        // Garante que o estado do display fica em ENSAIO_GB_STATE_ENSAIANDO
-        menu_displayData.state = ENSAIO_GB_STATE_ENSAIANDO;
-        // Como leu um novo valor de corrente, empilha a ao para atualizar o display
-        ACTION_SendEventFromTask(ACT_NONE, ACT_EVENT_DISPLAY_UPDATE);
-        // Delay com valor de 'samplePeriod'
-        vTaskDelay(samplePeriod);
+        decorrido = xTaskGetTickCount() - startTick;
+        if ((decorrido >= testDuration) || medida_gbData.estavel || medida_gbData.sobrecorrente)
+            break;
+        (void)ulTaskNotifyTake(pdTRUE, testDuration - decorrido);
     }
 
-    // Fim do teste: desabilita TRIAC e zero-cross
+    // Fim do teste: desliga o regulador, desabilita TRIAC e zero-cross
+    medida_gbData.regulando = false;
     TRIAC_SetPowerPercent(0);
     PINO_TRIAC_GB_Clear();
     TMR6_Stop();
@@ -383,20 +812,42 @@ void MEDIDA_GB_RunTestTask(void *pvParameters)
     // Desliga o rel 2 ao final do teste
     PINO_RELE2_TAP_Clear();
     
-    // === DESLIGA TMR2 ===
-    TMR2_Stop();
-    TMR2_InterruptDisable();
-    // Opcional: desregistrar callback se quiser
-    TMR2_CallbackRegister(NULL, 0);
+    // === DESLIGA AMOSTRAGEM ===
+    AQUISICAO_GB_Stop();
+    AQUISICAO_GB_CallbackRegister(NULL, 0);
     
     // Volta o menu para a tela GB
     menu_displayData.state = MENU_DISPLAY_STATE_GB;
     // Atualiza o display novamente para o menu GB
     ACTION_SendEventFromTask(ACT_NONE, ACT_EVENT_DISPLAY_UPDATE);
 
-    // Limpa handle e auto-destri a task (libera memria do stack)
-    xMEDIDA_GB_Tasks = NULL;
-    vTaskDelete(NULL);
+}
+
+void MEDIDA_GB_RunTestTask(void *pvParameters)
+{
+    (void) pvParameters;
+
+    for (;;)
+    {
+        // Dorme at o menu pedir um ensaio. Um aviso de leitura que chegue
+        // fora do ensaio (fim da ltima janela) s acorda e volta a dormir
+        (void)ulTaskNotifyTake(pdTRUE, portMAX_DELAY);
+        if (!g_ensaioPedido)
+            continue;
+
+        MEDIDA_GB_Ensaio();
+        g_ensaioPedido = false;
+    }
+}
+
+bool MEDIDA_GB_IniciaEnsaio(void)
+{
+    if (g_ensaioPedido || (xMEDIDA_GB_TesteTask == NULL))
+        return false;
+
+    g_ensaioPedido = true;
+    (void)xTaskNotifyGive(xMEDIDA_GB_TesteTask);
+    return true;
 }
 
 
@@ -424,6 +875,18 @@ void MEDIDA_GB_Initialize ( void )
     medida_gbData.adcRb0Raw = 0;
     medida_gbData.adcRa1Raw = 0;
     
+    medida_gbData.cont_ciclos = 0;
+    medida_gbData.amostras_janela = 0;
+    medida_gbData.ciclos_janela = MEDIDA_GB_CICLOS_JANELA;
+    
+    medida_gbData.corrente_alvo = REG_GB_CORRENTE_ALVO;
+    medida_gbData.potencia_mp = 0;
+    medida_gbData.janelas_estaveis = 0;
+    medida_gbData.regulando = false;
+    medida_gbData.estavel = false;
+    medida_gbData.sobrecorrente = false;
+    medida_gbData.freq_rede = 0;
+    
     GPIO_PinInterruptCallbackRegister(PINO_ZERO_CROSS_PIN, ZC_InterruptHandler, 0);
     PINO_ZERO_CROSS_InterruptDisable();
 }
@@ -457,7 +920,9 @@ void MEDIDA_GB_Tasks ( void )
 
         case MEDIDA_GB_STATE_SERVICE_TASKS:
         {
-
+            // Dorme at a aquisio publicar um ou mais blocos de amostras
+            (void)ulTaskNotifyTake(pdTRUE, portMAX_DELAY);
+            MEDIDA_GB_ConsomeBlocos();
             break;
         }
         default:
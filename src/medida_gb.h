@@ -97,12 +97,26 @@ typedef struct
     uint32_t resistencia;
     
     // Acumula os quadrados da tenso e corrente.
-    // O clculo da tenso e corrente  feito a cada 128 ciclos de interrupo
-    // do timer2 e usa a soma dos quadrados dos valores acumulados
-    uint32_t soma_quad_i;
-    uint32_t soma_quad_v;
+    // O clculo da tenso e corrente  feito a cada janela de 'amostras_janela'
+    // amostras ('ciclos_janela' ciclos completos da rede) e usa a soma dos
+    // quadrados. 64 bits para a janela poder ter vrios ciclos sem estourar
+    uint64_t soma_quad_i;
+    uint64_t soma_quad_v;
     
-    uint8_t cont_ciclos;
+    uint16_t cont_ciclos;       // amostras acumuladas na janela atual
+    uint16_t amostras_janela;   // tamanho da janela atual (amostras)
+    uint8_t  ciclos_janela;     // ciclos da rede por janela (MEDIDA_GB_JanelaSet)
+    
+    // Frequncia da rede detectada pelo zero-cross (50 ou 60, 0 = ainda no)
+    uint8_t freq_rede;
+    
+    // Regulao da corrente do ensaio (mesma unidade de 'corrente', A*10)
+    uint32_t corrente_alvo;
+    int32_t  potencia_mp;       // sada do regulador em milsimos de %
+    uint16_t janelas_estaveis;  // janelas seguidas dentro da tolerncia
+    bool regulando;
+    bool estavel;               // corrente assentou no alvo
+    bool sobrecorrente;         // passou de REG_GB_CORRENTE_LIMITE
     
     uint16_t teste;
     uint16_t fl1;
@@ -113,6 +127,37 @@ typedef struct
 // Torna o dado acessvel em outros mdulos
 extern MEDIDA_GB_DATA medida_gbData;
 
+// *****************************************************************************
+/* Canal de leituras do ensaio GB
+
+  Summary:
+    ltima leitura publicada pela cadeia de medida, para outras tasks.
+
+  Description:
+    A cada janela RMS a task MEDIDA_GB_Tasks publica uma cpia da leitura
+    protegida por seqlock: quem l com MEDIDA_GB_LeituraGet sempre recebe
+    resistncia, corrente e tenso da mesma janela, sem travar o produtor.
+    Quem quiser ser avisado assina com MEDIDA_GB_Assina, escolhendo o
+    intervalo mnimo entre avisos (ex.: display a cada 100 ms).
+*/
+
+typedef struct
+{
+    uint32_t seq;               // nmero da publicao (muda a cada janela)
+    uint32_t resistencia;       // mOhm (0xFFFFFFFF sem corrente)
+    uint32_t corrente;          // A*10
+    uint32_t tensao;            // RMS binrio
+    int32_t  potencia_mp;       // sada do regulador em milsimos de %
+    bool estavel;
+    bool sobrecorrente;
+} MEDIDA_GB_LEITURA;
+
+// Aviso de leitura nova. Roda na task MEDIDA_GB_Tasks: no pode bloquear
+// (ex.: xQueueSend com espera 0 ou xTaskNotifyGive)
+typedef void (*MEDIDA_GB_ASSINANTE)(uint32_t seq, uintptr_t context);
+
+#define MEDIDA_GB_ASSINANTES_MAX    4U
+
 /*
 typedef struct medida_gb
 {
@@ -142,17 +187,39 @@ typedef struct medida_gb
 } MEDIDA_GB;
 */
 
-// Config da rede
-#define MAINS_FREQ_HZ        60U
-#define HALF_CYCLE_TICKS     62500U   // ~8,33ms com TMR6 @ 7,5MHz
+// Config da rede. A frequncia (50/60Hz) e a durao do semiciclo so medidas
+// pelo zero-cross; os valores abaixo s valem at a primeira medida.
+#define HALF_CYCLE_TICKS_60HZ 62500U  // ~8,33ms com TMR6 @ 7,5MHz
+#define HALF_CYCLE_TICKS_50HZ 75000U  // 10ms, no cabe nos 16 bits do TMR6
 
 // Reservamos alguns ticks antes do zero pra desligar o gate
 #define SAFETY_TICKS_TO_ZERO 4000U    // ~0,53ms
 #define MIN_GATING_TICKS     1000U    // ~0,13ms
 
+// Janela RMS em ciclos completos da rede (padro e mximo)
+#define MEDIDA_GB_CICLOS_JANELA      1U
+#define MEDIDA_GB_CICLOS_JANELA_MAX  50U   // 1s a 50Hz (7680 amostras)
+
+// Regulador de corrente do ensaio GB. Corrente em A*10 (sada de
+// i_gb_calcula) e potncia em milsimos de %. Roda uma vez por janela RMS.
+#define REG_GB_CORRENTE_ALVO    250U      // 25,0A padro
+#define REG_GB_CORRENTE_LIMITE  400U      // 40,0A: acima disso corta o TRIAC
+#define REG_GB_ALVO_MAX         350U      // 35,0A: maior alvo, com margem at o corte
+#define REG_GB_KI               20        // milsimos de % por 0,1A de erro (no alvo padro)
+#define REG_GB_RAMPA_MAX        2000      // soft-start: sobe no mx. 2% por janela
+#define REG_GB_RAMPA_MIN        20        // rampa dos alvos mais baixos
+#define REG_GB_SAIDA_MAX        100000    // 100%
+#define REG_GB_TOLERANCIA_PCT   2U        // erro aceito como estvel (% do alvo)
+#define REG_GB_JANELAS_ESTAVEL  10U       // janelas seguidas dentro da tolerncia
+
 // Limites de potncia
 #define TRIAC_POWER_MIN      0U       // 0%
 #define TRIAC_POWER_MAX      100U     // 100%
+#define TRIAC_POWER_MAX_MILLI 100000U // 100% em milsimos de %
+
+// Tabela de ngulo de fase: 256 passos de potncia, atraso em Q15
+#define TRIAC_TABELA_PASSOS  256U
+#define TRIAC_FRACAO_UM      32768U   // atraso = semiciclo inteiro (Q15)
 
 // Inicializa perifricos e variveis do controle
 void TRIAC_Control_Initialize(void);
@@ -160,18 +227,49 @@ void TRIAC_Control_Initialize(void);
 // Ajusta potncia alvo (0..100%)
 void TRIAC_SetPowerPercent(uint8_t percent);
 
+// Ajusta potncia alvo em milsimos de % (0..100000). A potncia  RMS:
+// o atraso de disparo sai da tabela de ngulo de fase, no  linear
+void TRIAC_SetPowerMilli(uint32_t powerMilli);
+
 // Handler chamado pelo zero-cross (INTx)
 void ZC_InterruptHandler(GPIO_PIN pin, uintptr_t context);
 
 // Callback do Timer 6 (registrado no plib TMR6)
 void TMR6_Callback(uint32_t status, uintptr_t context);
 
-// Task de ensaio de corrente (5 segundos, "one-shot")
+// Processa um par de amostras (tenso, corrente) da medida GB.
+// Chamada pela task MEDIDA_GB_Tasks e no depende de nenhum perifrico.
+void MEDIDA_GB_ProcessaAmostra(uint32_t adc_v, uint32_t adc_i);
+
+// Ajusta a janela RMS em ciclos da rede (1..MEDIDA_GB_CICLOS_JANELA_MAX).
+// Vale a partir da prxima janela.
+void MEDIDA_GB_JanelaSet(uint8_t ciclos);
+
+// Ajusta a corrente alvo do ensaio (A*10). Vale no prximo ensaio.
+void MEDIDA_GB_CorrenteAlvoSet(uint32_t corrente);
+
+// Cpia consistente da ltima leitura publicada. Retorna false se ainda
+// no houve leitura ou se no conseguiu uma cpia inteira (o produtor
+// publicou no meio de vrias tentativas); nesse caso 'leitura' no muda.
+bool MEDIDA_GB_LeituraGet(MEDIDA_GB_LEITURA *leitura);
+
+// Assina o canal de leituras: 'aviso'  chamado a cada publicao, no
+// mximo uma vez por 'periodo' ticks. Retorna false se a tabela est cheia.
+bool MEDIDA_GB_Assina(MEDIDA_GB_ASSINANTE aviso, uintptr_t context, TickType_t periodo);
+
+// Task do ensaio de corrente. Fica criada o tempo todo e dorme at
+// MEDIDA_GB_IniciaEnsaio; cada ensaio dura at 5 segundos.
 void MEDIDA_GB_RunTestTask(void *pvParameters);
 
-// Handle da task (declarado em tasks.c)
+// Acorda a task do ensaio. Retorna false se j h um ensaio rodando.
+bool MEDIDA_GB_IniciaEnsaio(void);
+
+// Handle da task de processamento das amostras (declarado em tasks.c)
 extern TaskHandle_t xMEDIDA_GB_Tasks;
 
+// Handle da task do ensaio (declarado em tasks.c)
+extern TaskHandle_t xMEDIDA_GB_TesteTask;
+
 void MEDIDA_GB_Initialize ( void );
 void MEDIDA_GB_Tasks( void );
 
@@ -27,12 +27,14 @@
 // *****************************************************************************
 // *****************************************************************************
 #include <string.h>
-#include <stdio.h>  // no topo do arquivo, se ainda no tiver
 #include "menu_display.h"
 #include "app_display.h"     // atualiza_lcd()
 #include "definitions.h"
 #include "medida_gb.h"
 #include "app_usb.h"
+#include "diag_gb.h"
+#include "display_graficos.h"
+#include "formata.h"
 
 // *****************************************************************************
 // *****************************************************************************
@@ -58,8 +60,12 @@ extern APP_USB_DATA app_usbData;
 MENU_DISPLAY_DATA menu_displayData;
 
 
-// Fila de eventos para o menu
+// Fila de eventos para o menu (memria esttica, no usa o heap)
+#define MENU_DISPLAY_FILA_EVENTOS   16U
+
 QueueHandle_t xActionEventQueue = NULL;
+static StaticQueue_t g_filaEventosBuffer;
+static uint8_t g_filaEventosArea[MENU_DISPLAY_FILA_EVENTOS * sizeof(ACTION_EVENT)];
 
 #define BTN_DEBOUNCE_MS     15
 #define BTN_LONGPRESS_MS    500   // tempo segurando para comear auto-repeat
@@ -75,6 +81,22 @@ static volatile uint16_t g_debounceCounter = 0;
 static volatile uint16_t g_holdMs[BTN_COUNT];
 static volatile bool     g_repeatActive[BTN_COUNT];
 
+// Tendncia da corrente na tela do ensaio GB: uma amostra por aviso do
+// canal de leituras (~100 ms), escrita por MENU_DISPLAY_AvisoMedida na task
+// de medida. A amostra k fica em [k % colunas]; g_tendenciaN conta as
+// amostras do ensaio atual. Redesenhos (botes) no mexem aqui.
+static uint16_t g_tendenciaCorrente[DISPLAY_GRAF_COLUNAS_LCD];
+static volatile uint32_t g_tendenciaN;
+
+// ltima leitura do ensaio GB recebida pelo canal de medidas e nmero da
+// ltima publicao antes do ensaio atual (as anteriores no aparecem)
+static MEDIDA_GB_LEITURA g_leituraGB;
+static uint32_t g_seqInicioGB;
+
+// Verso do modelo j desenhada e ltimo quadro entregue ao display
+static uint32_t g_versaoDesenhada;
+static char g_quadroEnviado[4][20];
+
 
 /* static inline uint8_t BUTTONS_ReadRawMask(void)
  * Funo rpida para ler o estado atual dos pinos em forma de mscara
@@ -266,6 +288,36 @@ void TMR3_Callback(uint32_t status, uintptr_t context)  // ou TMR3_InterruptHand
 
 
 
+/* MENU_DISPLAY_AvisoMedida()
+ * Assinante do canal de leituras do ensaio GB. Roda na task de medida, logo
+ * depois da publicao 'seq': guarda a corrente na tendncia (uma amostra
+ * por aviso, mesmo que o evento abaixo se perca) e pe o evento na fila,
+ * sem esperar; se a fila estiver cheia o prximo aviso traz a leitura mais
+ * nova de qualquer jeito.
+ */
+static void MENU_DISPLAY_AvisoMedida(uint32_t seq, uintptr_t context)
+{
+    MEDIDA_GB_LEITURA leitura;
+    ACTION_EVENT ev;
+    uint32_t n;
+
+    (void)context;
+
+    // S leituras deste ensaio; quem publica  esta task, ento a cpia
+    //  a da publicao 'seq'
+    if ((seq > g_seqInicioGB) && MEDIDA_GB_LeituraGet(&leitura) && (leitura.seq == seq))
+    {
+        n = g_tendenciaN;
+        g_tendenciaCorrente[n % DISPLAY_GRAF_COLUNAS_LCD] =
+            (leitura.corrente > 0xFFFFU) ? 0xFFFFU : (uint16_t)leitura.corrente;
+        g_tendenciaN = n + 1U;
+    }
+
+    ev.id   = ACT_NONE;
+    ev.type = ACT_EVENT_DISPLAY_UPDATE;
+    (void)xQueueSend(xActionEventQueue, &ev, 0);
+}
+
 /* void MENU_DISPLAY_Initialize ( void )
  * Inicia as variveis e drives necessrios para controle do display lcd
  */
@@ -278,8 +330,16 @@ void MENU_DISPLAY_Initialize ( void )
     menu_displayData.debug1 = 0;
     menu_displayData.debug2 = 0;
 
+    // Fora o desenho da primeira tela
+    menu_displayData.versao = 1;
+    menu_displayData.quadros_desenhados = 0;
+    menu_displayData.quadros_suprimidos = 0;
+    g_versaoDesenhada = 0;
+    memset(g_quadroEnviado, 0, sizeof(g_quadroEnviado));
+
     // cria fila de eventos
-    xActionEventQueue = xQueueCreate(16, sizeof(ACTION_EVENT));
+    xActionEventQueue = xQueueCreateStatic(MENU_DISPLAY_FILA_EVENTOS, sizeof(ACTION_EVENT),
+                                           g_filaEventosArea, &g_filaEventosBuffer);
     configASSERT(xActionEventQueue != NULL);
 
     g_stableMask = 0;
@@ -287,6 +347,10 @@ void MENU_DISPLAY_Initialize ( void )
     memset((void*)g_holdMs, 0, sizeof(g_holdMs));
     memset((void*)g_repeatActive, 0, sizeof(g_repeatActive));
     
+    // Leituras do ensaio GB: atualiza a tela no mximo a cada 100 ms
+    memset(&g_leituraGB, 0, sizeof(g_leituraGB));
+    (void)MEDIDA_GB_Assina(MENU_DISPLAY_AvisoMedida, 0, pdMS_TO_TICKS(100));
+
     // *** REGISTRA O CALLBACK DO TIMER 3 ***
     TMR3_CallbackRegister(TMR3_Callback, 0);
 
@@ -300,177 +364,196 @@ void MENU_DISPLAY_Initialize ( void )
 
 // *** A partir daqui so as funes que tratam os eventos de ao (xActionEventQueue) *** //
 
-/* void MENU_DISPLAY_STATE_INIT_DetectEvent(const ACTION_EVENT *ev)
- * Funo que trata aes enquando equipamento no menu iniciar.
+/* MENU_DISPLAY_VaiPara()
+ * Troca de tela e chama o hook de entrada da tela nova.
  */
-void MENU_DISPLAY_STATE_INIT_DetectEvent(const ACTION_EVENT *ev)
+static void MENU_DISPLAY_VaiPara(MENU_DISPLAY_STATES destino);
+
+/* Aes de ENTER e hooks de entrada usados na tabela de telas */
+static void MENU_DISPLAY_TecladoEnter(void)
 {
-    switch (ev->id)
-    {
-        case BTN_CIMA:
-        {
-            if (ev->type == BTN_EVENT_PRESS || ev->type == BTN_EVENT_REPEAT)
-            {
-                if (menu_displayData.currentItem > 1)
-                    menu_displayData.currentItem--;
-                else
-                    menu_displayData.currentItem = 4;
-            }
-            break;
-        }
-        case BTN_BAIXO:
-        {
-            if (ev->type == BTN_EVENT_PRESS || ev->type == BTN_EVENT_REPEAT)
-            {
-                if (menu_displayData.currentItem < 4)
-                    menu_displayData.currentItem++;
-                else
-                    menu_displayData.currentItem = 1;
-            }
-            break;
-        }
-        case BTN_ENTER:
-        {
-            if (ev->type == BTN_EVENT_PRESS)
-            {
-                if (menu_displayData.currentItem == 1) menu_displayData.state = MENU_DISPLAY_STATE_TECLADO;
-                else if (menu_displayData.currentItem == 2) menu_displayData.state = MENU_DISPLAY_STATE_HP;
-                else if (menu_displayData.currentItem == 3) menu_displayData.state = MENU_DISPLAY_STATE_GB;
-                else if (menu_displayData.currentItem == 4) menu_displayData.state = MENU_DISPLAY_STATE_TF;
-            }
-            break;
-        }
-        case BTN_BACK:
-        {
-            // Faz nada
-            if (ev->type == BTN_EVENT_PRESS)
-            {
-                
-            }
-            break;
-        }
-        default:
-        {
-            break;
-        }  
-    }
+    menu_displayData.debug1 += 1;
 }
 
-/* void MENU_DISPLAY_STATE_TECLADO_DetectEvent(const ACTION_EVENT *ev)
- * Funo que trata aes enquando equipamento no menu ensaio HP.
- */
-void MENU_DISPLAY_STATE_TECLADO_DetectEvent(const ACTION_EVENT *ev)
+static void MENU_DISPLAY_GBEnter(void)
 {
-    switch (ev->id)
-    {
-        case BTN_BACK:
-        {
-            // Volta ao menu inicial
-            if (ev->type == BTN_EVENT_PRESS)
-            {
-                menu_displayData.state = MENU_DISPLAY_STATE_INIT;
-                menu_displayData.currentItem = 0;
-            }
-            break;
-        }
-        case BTN_ENTER:
-        {
-            if (ev->type == BTN_EVENT_PRESS)
-            {
-                menu_displayData.debug1 += 1;
-            }
-            break;
-        }
-        default:
-        {
-            break;
-        }  
-    }
+    MENU_DISPLAY_VaiPara(ENSAIO_GB_STATE_ENSAIANDO);
+
+    // Acorda a task do ensaio (ignorado se j h um ensaio rodando)
+    (void)MEDIDA_GB_IniciaEnsaio();
 }
 
-/* void MENU_DISPLAY_STATE_HP_DetectEvent(const ACTION_EVENT *ev)
- * Funo que trata aes enquando equipamento no menu ensaio HP.
+static void MENU_DISPLAY_DiagEnter(void)
+{
+    DIAG_GB_ImprimeConsole();
+    ISR_LAT_ImprimeConsole();
+}
+
+static void MENU_DISPLAY_EnsaiandoEntra(void)
+{
+    uint32_t seqInicio = 0;
+
+    // Comea zerado at chegar a primeira leitura deste ensaio
+    memset(&g_leituraGB, 0, sizeof(g_leituraGB));
+    if (MEDIDA_GB_LeituraGet(&g_leituraGB))
+        seqInicio = g_leituraGB.seq;
+    memset(&g_leituraGB, 0, sizeof(g_leituraGB));
+
+    // A tendncia  escrita pela task de medida (prioridade maior)
+    taskENTER_CRITICAL();
+    g_seqInicioGB = seqInicio;
+    g_tendenciaN = 0;
+    memset(g_tendenciaCorrente, 0, sizeof(g_tendenciaCorrente));
+    taskEXIT_CRITICAL();
+}
+
+static uint32_t MENU_DISPLAY_CorrenteAlvoGet(void)
+{
+    return medida_gbData.corrente_alvo;
+}
+
+// Itens da tela inicial. O item 0  o ttulo: no  selecionvel.
+static const MENU_DISPLAY_ITEM menu_itensHome[] =
+{
+    { "   HGF148 - Teste", MENU_DISPLAY_STATE_INIT    },
+    { "Teste teclado",     MENU_DISPLAY_STATE_TECLADO },
+    { "Ensaio HP",         MENU_DISPLAY_STATE_HP      },
+    { "Ensaio GB",         MENU_DISPLAY_STATE_GB      },
+    { "Ensaio TF",         MENU_DISPLAY_STATE_TF      },
+    { "Diagnostico GB",    MENU_DISPLAY_STATE_DIAG_GB },
+};
+
+// Corrente do ensaio GB (A*10), ajustada com CIMA/BAIXO antes do ENTER
+static const MENU_DISPLAY_PARAMETRO menu_paramCorrenteGB =
+{
+    "Alvo:", " A", 1, 10U, REG_GB_ALVO_MAX, 5U,
+    MENU_DISPLAY_CorrenteAlvoGet, MEDIDA_GB_CorrenteAlvoSet
+};
+
+/* menu_telas[]
+ * rvore do menu, indexada pelo estado. Tela nova = uma entrada aqui.
+ * Campos: ttulo, itens, n de itens, parmetro, desenho prprio,
+ * hook de entrada, ao do ENTER, BACK volta ao incio.
  */
-void MENU_DISPLAY_STATE_HP_DetectEvent(const ACTION_EVENT *ev)
+static const MENU_DISPLAY_TELA menu_telas[] =
 {
-    switch (ev->id)
+    [MENU_DISPLAY_STATE_INIT] =
+        { NULL, menu_itensHome, sizeof(menu_itensHome) / sizeof(menu_itensHome[0]),
+          NULL, NULL, NULL, NULL, false },
+    [MENU_DISPLAY_STATE_TECLADO] =
+        { "     Teclado", NULL, 0,
+          NULL, MENU_DISPLAY_DrawTeclado, NULL, MENU_DISPLAY_TecladoEnter, true },
+    [MENU_DISPLAY_STATE_HP] =
+        { "     Ensaio HP", NULL, 0,
+          NULL, NULL, NULL, NULL, true },
+    [MENU_DISPLAY_STATE_GB] =
+        { "     Ensaio GB", NULL, 0,
+          &menu_paramCorrenteGB, NULL, NULL, MENU_DISPLAY_GBEnter, true },
+    [MENU_DISPLAY_STATE_TF] =
+        { "     Ensaio TF", NULL, 0,
+          NULL, NULL, NULL, NULL, true },
+    // Durante o ensaio os botes no fazem nada: quem sai  a task do ensaio
+    [ENSAIO_GB_STATE_ENSAIANDO] =
+        { NULL, NULL, 0,
+          NULL, ENSAIO_GB_DrawEnsaiando, MENU_DISPLAY_EnsaiandoEntra, NULL, false },
+    // ENTER redesenha a tela (com valores novos) e manda tudo pro console,
+    // junto com a latncia das interrupes
+    [MENU_DISPLAY_STATE_DIAG_GB] =
+        { NULL, NULL, 0,
+          NULL, MENU_DISPLAY_DrawDiagGB, NULL, MENU_DISPLAY_DiagEnter, true },
+};
+
+#define MENU_DISPLAY_N_TELAS    (sizeof(menu_telas) / sizeof(menu_telas[0]))
+
+/* MENU_DISPLAY_TelaAtual()
+ * Entrada da tabela do estado atual. Em teoria o estado  sempre vlido,
+ * mas o ideal  pecar pelo excesso: estado desconhecido volta ao incio.
+ */
+static const MENU_DISPLAY_TELA *MENU_DISPLAY_TelaAtual(void)
+{
+    if ((uint32_t)menu_displayData.state >= MENU_DISPLAY_N_TELAS)
     {
-        case BTN_BACK:
-        {
-            // Volta ao menu inicial
-            if (ev->type == BTN_EVENT_PRESS)
-            {
-                menu_displayData.state = MENU_DISPLAY_STATE_INIT;
-                menu_displayData.currentItem = 0;
-            }
-            break;
-        }
-        default:
-        {
-            break;
-        }  
+        menu_displayData.state = MENU_DISPLAY_STATE_INIT;
+        menu_displayData.currentItem = 0;
     }
+    return &menu_telas[menu_displayData.state];
 }
 
-/* void MENU_DISPLAY_STATE_GB_DetectEvent(const ACTION_EVENT *ev)
- * Funo que trata aes enquando equipamento no menu ensaio GB.
+static void MENU_DISPLAY_VaiPara(MENU_DISPLAY_STATES destino)
+{
+    menu_displayData.state = destino;
+    if (MENU_DISPLAY_TelaAtual()->aoEntrar != NULL)
+        MENU_DISPLAY_TelaAtual()->aoEntrar();
+}
+
+/* static void MENU_DISPLAY_HandleActionEvent(const ACTION_EVENT *ev)
+ * Funo usada em 'void MENU_DISPLAY_Tasks ( void ).
+ * Ela  chamada assim que uma ao  inserida na pilha xActionEventQueue.
+ * O que cada boto faz vem da tela atual (menu_telas):
+ * - CIMA/BAIXO: move o cursor da lista ou ajusta o parmetro (aceita repeat);
+ * - ENTER: entra no item selecionado ou chama a ao da tela;
+ * - BACK: volta ao menu inicial, se a tela permitir.
  */
-void MENU_DISPLAY_STATE_GB_DetectEvent(const ACTION_EVENT *ev)
+static void MENU_DISPLAY_HandleActionEvent(const ACTION_EVENT *ev)
 {
+    const MENU_DISPLAY_TELA *tela = MENU_DISPLAY_TelaAtual();
+    const MENU_DISPLAY_PARAMETRO *param = tela->parametro;
+    bool aperto = (ev->type == BTN_EVENT_PRESS);
+    bool repete = aperto || (ev->type == BTN_EVENT_REPEAT);
+    uint32_t valor;
+
+    // Soltar um boto no muda nada na tela. Qualquer outro evento (aperto,
+    // repeat ou aviso de outra task) pode ter mudado o modelo.
+    if (ev->type != BTN_EVENT_RELEASE)
+        menu_displayData.versao++;
+
     switch (ev->id)
     {
-        case BTN_ENTER:
+        case BTN_CIMA:
+        case BTN_BAIXO:
         {
-            if (ev->type == BTN_EVENT_PRESS)
-            {
-                menu_displayData.state = ENSAIO_GB_STATE_ENSAIANDO;
+            if (!repete)
+                break;
 
-                // Garante que no cria duas tasks ao mesmo tempo
-                if (xMEDIDA_GB_Tasks == NULL)
-                {
-                    // Cria uma task one-shot que existir somente durante a
-                    // execuo do ensaio GB.
-                    xTaskCreate(
-                        MEDIDA_GB_RunTestTask,   // nossa task one-shot
-                        "MEDIDA_GB",
-                        1024,
-                        NULL,
-                        7U,
-                        &xMEDIDA_GB_Tasks);
-                }
+            if (tela->itens != NULL)
+            {
+                // Cursor de 1 a n_itens-1, dando a volta nas pontas
+                if (ev->id == BTN_CIMA)
+                    menu_displayData.currentItem = (menu_displayData.currentItem > 1) ?
+                        (uint8_t)(menu_displayData.currentItem - 1U) : (uint8_t)(tela->n_itens - 1U);
+                else
+                    menu_displayData.currentItem = (menu_displayData.currentItem < (tela->n_itens - 1U)) ?
+                        (uint8_t)(menu_displayData.currentItem + 1U) : 1U;
             }
-            break;
-        }
-        case BTN_BACK:
-        {
-            // Volta ao menu inicial
-            if (ev->type == BTN_EVENT_PRESS)
+            else if (param != NULL)
             {
-                menu_displayData.state = MENU_DISPLAY_STATE_INIT;
-                menu_displayData.currentItem = 0;
+                valor = param->le();
+                if (ev->id == BTN_CIMA)
+                    valor = ((valor + param->passo) > param->maximo) ? param->maximo : (valor + param->passo);
+                else
+                    valor = (valor < (param->minimo + param->passo)) ? param->minimo : (valor - param->passo);
+                param->grava(valor);
             }
             break;
         }
-        default:
+        case BTN_ENTER:
         {
+            if (!aperto)
+                break;
+
+            if ((tela->itens != NULL) && (menu_displayData.currentItem > 0U)
+                && (menu_displayData.currentItem < tela->n_itens))
+                MENU_DISPLAY_VaiPara(tela->itens[menu_displayData.currentItem].destino);
+            else if (tela->enter != NULL)
+                tela->enter();
             break;
-        }  
-    }
-}
-
-/* void MENU_DISPLAY_STATE_TF_DetectEvent(const ACTION_EVENT *ev)
- * Funo que trata aes enquando equipamento no menu ensaio TF.
- */
-void MENU_DISPLAY_STATE_TF_DetectEvent(const ACTION_EVENT *ev)
-{
-    switch (ev->id)
-    {
+        }
         case BTN_BACK:
         {
             // Volta ao menu inicial
-            if (ev->type == BTN_EVENT_PRESS)
+            if (aperto && tela->back)
             {
-                menu_displayData.state = MENU_DISPLAY_STATE_INIT;
+                MENU_DISPLAY_VaiPara(MENU_DISPLAY_STATE_INIT);
                 menu_displayData.currentItem = 0;
             }
             break;
@@ -482,107 +565,82 @@ void MENU_DISPLAY_STATE_TF_DetectEvent(const ACTION_EVENT *ev)
     }
 }
 
-/* static void MENU_DISPLAY_HandleActionEvent(const ACTION_EVENT *ev)
- * Funo usada em 'void MENU_DISPLAY_Tasks ( void ).
- * Ela  chamada assim que uma ao  inserida na pilha xActionEventQueue
+/* MENU_DISPLAY_Desenha()
+ * Escreve a tela em 'menu_displayData.lcd'. Telas com desenho prprio
+ * chamam a sua funo; as demais so montadas a partir da tabela:
+ * - lista: 4 itens por pgina, cursor '<' na coluna 19;
+ * - tela simples: ttulo, parmetro na linha 2 e rodap com os botes.
  */
-static void MENU_DISPLAY_HandleActionEvent(const ACTION_EVENT *ev)
+static void MENU_DISPLAY_Desenha(const MENU_DISPLAY_TELA *tela)
 {
-    switch (menu_displayData.state)
+    const MENU_DISPLAY_PARAMETRO *param = tela->parametro;
+    uint8_t pagina, i;
+    char *p;
+
+    if (tela->desenha != NULL)
     {
-        case MENU_DISPLAY_STATE_INIT:
-        {
-            MENU_DISPLAY_STATE_INIT_DetectEvent(ev);
-            break;
-        }
-        case MENU_DISPLAY_STATE_TECLADO:
-        {
-            MENU_DISPLAY_STATE_TECLADO_DetectEvent(ev);
-            break;
-        }
-        case MENU_DISPLAY_STATE_HP:
-        {
-            MENU_DISPLAY_STATE_HP_DetectEvent(ev);
-            break;
-        }
-        case MENU_DISPLAY_STATE_GB:
-        {
-            MENU_DISPLAY_STATE_GB_DetectEvent(ev);
-            break;
-        }
-        case MENU_DISPLAY_STATE_TF:
-        {
-            MENU_DISPLAY_STATE_TF_DetectEvent(ev);
-            break;
-        }
-        case ENSAIO_GB_STATE_ENSAIANDO:
-        {
-            break;
-        }
-        default:
-        {
-            // Em teoria nunca cai aqui, mas o ideal  pecar pelo excesso
-            // Garantir que no ha ensaio sendo executado.
-            // Forar o menu para o inicio
-            menu_displayData.state = MENU_DISPLAY_STATE_INIT;
-            menu_displayData.currentItem = 0;
-            break;
-        }  
+        tela->desenha();
+        return;
     }
+
+    // Limpa o buffer
+    memset(menu_displayData.lcd, ' ', sizeof(menu_displayData.lcd));
+
+    if (tela->itens != NULL)
+    {
+        pagina = (uint8_t)(menu_displayData.currentItem & ~3U);
+        for (i = 0; (i < 4U) && ((pagina + i) < tela->n_itens); i++)
+            FORMATA_Texto(menu_displayData.lcd[i], tela->itens[pagina + i].texto, 19);
+        menu_displayData.lcd[menu_displayData.currentItem - pagina][19] = '<';
+        return;
+    }
+
+    if (tela->titulo != NULL)
+        FORMATA_Texto(menu_displayData.lcd[0], tela->titulo, 20);
+
+    if (param != NULL)
+    {
+        p = FORMATA_Texto(menu_displayData.lcd[1], param->nome, 0);
+        p = FORMATA_Fixo(p, param->le(), param->decimais, 6);
+        FORMATA_Texto(p, param->unidade, 0);
+    }
+
+    if (tela->back)
+        memcpy(menu_displayData.lcd[3], "<BACK>       <ENTER>", 20);
 }
 
 /* void MENU_DISPLAY_Tasks ( void )
  * Funo de atualizao das aes e do display.
- * Cada tela do display  um estado. Para cada estado crio uma funo que
- * apenas escreve em 'menu_displayData.lcd' o que aparecer no display.
- * Aps tem de chamar a funo 'atualiza_lcd((char*)menu_displayData.lcd)'
- * que vai empilhar o escrito em uma lista de eventos para ser consumido
- * pela task de atualizao do display.
+ * Cada tela do display  um estado, descrito em 'menu_telas'. A tela 
+ * escrita em 'menu_displayData.lcd' e depois 'atualiza_lcd' entrega o
+ * quadro para a task de atualizao do display.
+ * S desenha quando a verso do modelo mudou, e s entrega o quadro se
+ * ele for diferente do ltimo entregue (ex.: BACK na tela inicial, ou
+ * uma medida nova com o mesmo valor na tela).
  */
 void MENU_DISPLAY_Tasks ( void )
 {
-    switch (menu_displayData.state)
+    if (menu_displayData.versao != g_versaoDesenhada)
     {
-        case MENU_DISPLAY_STATE_INIT:
-        {
-            MENU_DISPLAY_DrawHome();
-            atualiza_lcd((char*)menu_displayData.lcd);
-            break;
-        }
-        case MENU_DISPLAY_STATE_TECLADO:
-        {
-            MENU_DISPLAY_DrawTeclado();
-            atualiza_lcd((char*)menu_displayData.lcd);
-            break;
-        }
-        case MENU_DISPLAY_STATE_HP:
-        {
-            MENU_DISPLAY_DrawHP();
-            atualiza_lcd((char*)menu_displayData.lcd);
-            break;
-        }
-        case MENU_DISPLAY_STATE_GB:
-        {
-            MENU_DISPLAY_DrawGB();
-            atualiza_lcd((char*)menu_displayData.lcd);
-            break;
-        }
-        case MENU_DISPLAY_STATE_TF:
+        g_versaoDesenhada = menu_displayData.versao;
+        MENU_DISPLAY_Desenha(MENU_DISPLAY_TelaAtual());
+
+        if (memcmp(g_quadroEnviado, menu_displayData.lcd, sizeof(g_quadroEnviado)) != 0)
         {
-            MENU_DISPLAY_DrawTF();
+            memcpy(g_quadroEnviado, menu_displayData.lcd, sizeof(g_quadroEnviado));
             atualiza_lcd((char*)menu_displayData.lcd);
-            break;
+            menu_displayData.quadros_desenhados++;
         }
-        case ENSAIO_GB_STATE_ENSAIANDO:
+        else
         {
-            ENSAIO_GB_DrawEnsaiando();
-            atualiza_lcd((char*)menu_displayData.lcd);
-            break;
+            menu_displayData.quadros_suprimidos++;
         }
-        default:
-            menu_displayData.state = MENU_DISPLAY_STATE_INIT;
-            break;
     }
+    else
+    {
+        menu_displayData.quadros_suprimidos++;
+    }
+
     ACTION_EVENT ev;
     // Bloqueia esperando evento de ao
     // O evento de ao pode entrar por 2 caminhos:
@@ -593,74 +651,101 @@ void MENU_DISPLAY_Tasks ( void )
 }
 // ************** Daqui para baixo so as funes que atualizam o texto conforme o menu para o display ************** //
 
-void MENU_DISPLAY_DrawHome(void)
-{
-    // Limpa o buffer
-    memset(menu_displayData.lcd, ' ', sizeof(menu_displayData.lcd));
-    
-    if (menu_displayData.currentItem < 4)
-    {
-        snprintf(menu_displayData.lcd[0], 20, "   HGF148 - Teste");
-        snprintf(menu_displayData.lcd[1], 20, "Teste teclado");
-        snprintf(menu_displayData.lcd[2], 20, "Ensaio HP");
-        snprintf(menu_displayData.lcd[3], 20, "Ensaio GB");
-        menu_displayData.lcd[menu_displayData.currentItem][19] = '<';
-    }
-    else
-    {
-        snprintf(menu_displayData.lcd[0], 20, "Ensaio TF");
-        menu_displayData.lcd[menu_displayData.currentItem - 4][19] = '<';
-    }
-}
-
 void MENU_DISPLAY_DrawTeclado(void)
 {
-    // Limpa o buffer
-    memset(menu_displayData.lcd, ' ', sizeof(menu_displayData.lcd));
-    memcpy(menu_displayData.lcd[0], "     Teclado", 14);
-    snprintf(menu_displayData.lcd[1], 20, "%s", app_usbData.string);
-    snprintf(menu_displayData.lcd[2], 20, "%d %d", menu_displayData.debug1, menu_displayData.debug2);
-    memcpy(menu_displayData.lcd[3], "<BACK>       <ENTER>", 20);
-}
+    char *p;
 
-void MENU_DISPLAY_DrawHP(void)
-{
     // Limpa o buffer
     memset(menu_displayData.lcd, ' ', sizeof(menu_displayData.lcd));
-    memcpy(menu_displayData.lcd[0], "     Ensaio HP", 14);
+    FORMATA_Texto(menu_displayData.lcd[0], "     Teclado", 20);
+    FORMATA_Texto(menu_displayData.lcd[1], (const char *)app_usbData.string, 20);
+    // A linha lida  Latin-1; o LCD usa a ROM A00
+    DISPLAY_GRAF_Latin1(menu_displayData.lcd[1], 20);
+    p = FORMATA_Int(menu_displayData.lcd[2], menu_displayData.debug1, 0);
+    p = FORMATA_Texto(p, " ", 0);
+    FORMATA_Int(p, menu_displayData.debug2, 0);
     memcpy(menu_displayData.lcd[3], "<BACK>       <ENTER>", 20);
 }
 
-void MENU_DISPLAY_DrawGB(void)
+void ENSAIO_GB_DrawEnsaiando(void)
 {
-    // Limpa o buffer
+    MEDIDA_GB_LEITURA leitura;
+    uint16_t tendencia[DISPLAY_GRAF_COLUNAS_LCD];
+    uint32_t corrente, alvo = medida_gbData.corrente_alvo, n, i;
+    char *p;
+
+    // Resistncia, corrente e tenso sempre da mesma janela RMS. Se no
+    // conseguir uma cpia nova, mostra a anterior.
+    if (MEDIDA_GB_LeituraGet(&leitura) && (leitura.seq > g_seqInicioGB))
+        g_leituraGB = leitura;
+    corrente = g_leituraGB.corrente;
+
     memset(menu_displayData.lcd, ' ', sizeof(menu_displayData.lcd));
-    memcpy(menu_displayData.lcd[0], "     Ensaio GB", 14);
-    memcpy(menu_displayData.lcd[3], "<BACK>       <ENTER>", 20);
+
+    //memcpy(menu_displayData.lcd[0], "  Ensaio GB 5 s  ", 18);
+
+    // Linha 1: resistncia (mOhm -> Ohm com 3 casas; sem corrente vira "*")
+    p = FORMATA_Texto(menu_displayData.lcd[0], "R = ", 0);
+    p = FORMATA_Fixo(p, g_leituraGB.resistencia, 3, 6);
+    FORMATA_Texto(p, " Ohm", 0);
+
+    // Linha 2: corrente (A*10) e tenso
+    p = FORMATA_Texto(menu_displayData.lcd[1], "A=", 0);
+    p = FORMATA_Fixo(p, corrente, 1, 4);
+    p = FORMATA_Texto(p, " V=", 0);
+    FORMATA_Uint(p, g_leituraGB.tensao, 3, ' ');
+
+    // Linha 3: corrente em relao ao alvo (barra cheia = alvo)
+    menu_displayData.lcd[2][0] = 'I';
+    DISPLAY_GRAF_Barra(menu_displayData.lcd[2], 2, DISPLAY_GRAF_COLUNAS_LCD - 2U,
+                       corrente, alvo);
+
+    // Linha 4: tendncia da corrente nos ltimos ~2 s, na mesma escala, a
+    // mais antiga  esquerda. Antes de 20 amostras, vazio  esquerda.
+    taskENTER_CRITICAL();
+    n = g_tendenciaN;
+    for (i = 0; i < DISPLAY_GRAF_COLUNAS_LCD; i++)
+    {
+        if ((n + i) < DISPLAY_GRAF_COLUNAS_LCD)
+            tendencia[i] = 0;
+        else
+            tendencia[i] = g_tendenciaCorrente[(n + i) % DISPLAY_GRAF_COLUNAS_LCD];
+    }
+    taskEXIT_CRITICAL();
+    DISPLAY_GRAF_Tendencia(menu_displayData.lcd[3], 0, tendencia,
+                           DISPLAY_GRAF_COLUNAS_LCD,
+                           (alvo > 0xFFFFU) ? 0xFFFFU : (uint16_t)alvo);
 }
 
-void MENU_DISPLAY_DrawTF(void)
+/* MENU_DISPLAY_LinhaDiag()
+ * Uma linha da tela de diagnstico: "XX  min   med   max" em microssegundos.
+ */
+static void MENU_DISPLAY_LinhaDiag(char *linha, const char *nome, const DIAG_GB_ESTAT *estat)
 {
-    // Limpa o buffer
-    memset(menu_displayData.lcd, ' ', sizeof(menu_displayData.lcd));
-    memcpy(menu_displayData.lcd[0], "     Ensaio TF", 14);
-    memcpy(menu_displayData.lcd[3], "<BACK>       <ENTER>", 20);
+    char *p;
+
+    p = FORMATA_Texto(linha, nome, 2);
+    p = FORMATA_Int(p, DIAG_GB_TicksUs(estat->min), 5);
+    p = FORMATA_Texto(p, " ", 0);
+    p = FORMATA_Int(p, DIAG_GB_MediaUs(estat), 5);
+    p = FORMATA_Texto(p, " ", 0);
+    FORMATA_Int(p, DIAG_GB_TicksUs(estat->max), 5);
 }
 
-void ENSAIO_GB_DrawEnsaiando(void)
+void MENU_DISPLAY_DrawDiagGB(void)
 {
-    memset(menu_displayData.lcd, ' ', sizeof(menu_displayData.lcd));
+    DIAG_GB_ESTATISTICAS estat;
 
-    //memcpy(menu_displayData.lcd[0], "  Ensaio GB 5 s  ", 18);
+    DIAG_GB_EstatisticasGet(&estat);
 
-    // Linha 1: corrente "processada" (placeholder em volts, trocar para A depois)
-    snprintf(menu_displayData.lcd[0], 20, "R = %3u", medida_gbData.resistencia);
-
-    // Linha 2: valores brutos dos ADCs em RA1 e RB0
-    snprintf(menu_displayData.lcd[1], 20, "A=%3u V=%3u", medida_gbData.corrente, medida_gbData.tensao);
+    // Limpa o buffer
+    memset(menu_displayData.lcd, ' ', sizeof(menu_displayData.lcd));
+    memcpy(menu_displayData.lcd[0], "us   min   med   max", 20);
 
-    // Linha 3: status
-    snprintf(menu_displayData.lcd[2], 20, "%d %d %d", medida_gbData.fl1, medida_gbData.fl2, medida_gbData.fl3);
+    // Semiciclo, atraso do gate e folga ao zero (microssegundos)
+    MENU_DISPLAY_LinhaDiag(menu_displayData.lcd[1], "SC", &estat.semiciclo);
+    MENU_DISPLAY_LinhaDiag(menu_displayData.lcd[2], "AG", &estat.atraso_gate);
+    MENU_DISPLAY_LinhaDiag(menu_displayData.lcd[3], "FZ", &estat.folga_zero);
 }
 
 /*******************************************************************************
@@ -68,6 +68,7 @@ typedef enum
     MENU_DISPLAY_STATE_GB,
     MENU_DISPLAY_STATE_TF,
     ENSAIO_GB_STATE_ENSAIANDO,
+    MENU_DISPLAY_STATE_DIAG_GB,
 //    MENU_DISPLAY_STATE_SERVICE_TASKS,
     /* TODO: Define states used by the application state machine. */
 
@@ -104,6 +105,13 @@ typedef struct
     uint8_t currentItem;         // item selecionado na tela
 
     char lcd[4][20];             // buffer 4x20 prprio do menu
+
+    // Modelo da tela: 'versao' muda a cada evento que pode alterar o que
+    // aparece (estado, cursor, parmetros ou medidas). S a task do menu
+    // escreve aqui; as outras tasks avisam com ACT_EVENT_DISPLAY_UPDATE.
+    uint32_t versao;
+    uint32_t quadros_desenhados;    // quadros entregues ao atualiza_lcd
+    uint32_t quadros_suprimidos;    // eventos que no mudaram a tela
     
     char debug1;
     char debug2;
@@ -138,6 +146,50 @@ typedef struct
     ACTION_EVENT_TYPE type;
 } ACTION_EVENT;
 
+// *****************************************************************************
+/* Tabela de telas do menu
+
+  Summary:
+    Descrio de cada tela, lida pela mquina genrica de menu_display.c.
+
+  Description:
+    Cada estado de MENU_DISPLAY_STATES tem uma entrada constante (em flash).
+    Uma tela pode ser:
+    - lista de itens (CIMA/BAIXO move o cursor, ENTER entra no destino);
+    - tela simples com ttulo, um parmetro opcional (CIMA/BAIXO ajusta) e
+      uma ao de ENTER;
+    - tela com desenho prprio ('desenha' diferente de NULL).
+*/
+
+typedef struct
+{
+    const char *texto;
+    MENU_DISPLAY_STATES destino;    // tela aberta pelo ENTER
+} MENU_DISPLAY_ITEM;
+
+typedef struct
+{
+    const char *nome;               // texto antes do valor, ex. "Alvo:"
+    const char *unidade;            // texto depois do valor, ex. " A"
+    uint8_t decimais;               // valor em unidades de 10^-decimais
+    uint32_t minimo;
+    uint32_t maximo;
+    uint32_t passo;                 // por aperto (ou repeat) de CIMA/BAIXO
+    uint32_t (*le)(void);
+    void (*grava)(uint32_t valor);
+} MENU_DISPLAY_PARAMETRO;
+
+typedef struct
+{
+    const char *titulo;                     // linha 1 da tela simples
+    const MENU_DISPLAY_ITEM *itens;         // lista (item 0 = ttulo) ou NULL
+    uint8_t n_itens;
+    const MENU_DISPLAY_PARAMETRO *parametro;// ajustado com CIMA/BAIXO ou NULL
+    void (*desenha)(void);                  // desenho prprio ou NULL
+    void (*aoEntrar)(void);                 // hook ao entrar na tela ou NULL
+    void (*enter)(void);                    // ao do ENTER ou NULL
+    bool back;                              // BACK volta ao menu inicial
+} MENU_DISPLAY_TELA;
 
 /* MENU_DISPLAY_Initialize()
  * Define os parmetros iniciais do MENU display e inicia variveis.
@@ -146,12 +198,9 @@ void MENU_DISPLAY_Initialize ( void );
 void MENU_DISPLAY_Tasks( void );
 
 /************** Daqui para baixo so os estados e funes de impresso no display **************/
-void MENU_DISPLAY_DrawHome(void);
 void MENU_DISPLAY_DrawTeclado(void);
-void MENU_DISPLAY_DrawHP(void);
-void MENU_DISPLAY_DrawGB(void);
-void MENU_DISPLAY_DrawTF(void);
 void ENSAIO_GB_DrawEnsaiando(void);
+void MENU_DISPLAY_DrawDiagGB(void);
 void ACTION_SendEventFromTask(ACTION_ID id, ACTION_EVENT_TYPE type);
 
 //DOM-IGNORE-BEGIN
@@ -0,0 +1,352 @@
+/*******************************************************************************
+  Traduo de teclas do teclado USB
+
+  File Name:
+    teclado.c
+
+  Summary:
+    Tabelas de layout (US e ABNT2) do cdigo de uso HID para caractere.
+
+  Description:
+    Ver teclado.h.
+ *******************************************************************************/
+
+// *****************************************************************************
+// *****************************************************************************
+// Section: Included Files
+// *****************************************************************************
+// *****************************************************************************
+
+#include "teclado.h"
+
+// *****************************************************************************
+// *****************************************************************************
+// Section: Global Data Definitions
+// *****************************************************************************
+// *****************************************************************************
+
+// Acentos mortos: cdigos abaixo de ' ' que no so controle de verdade
+#define TECLADO_MORTO_AGUDO         0x01U
+#define TECLADO_MORTO_CRASE         0x02U
+#define TECLADO_MORTO_TIL           0x03U
+#define TECLADO_MORTO_CIRCUNFLEXO   0x04U
+#define TECLADO_MORTO_TREMA         0x05U
+#define TECLADO_MORTO_QUANT         5U
+
+#define TECLADO_E_MORTO(c)          (((c) >= TECLADO_MORTO_AGUDO) && ((c) <= TECLADO_MORTO_TREMA))
+
+// Teclas iguais nos dois layouts: letras, nmeros, controle, espao e
+// teclado numrico (sempre nmeros, independente do NUM LOCK)
+#define TECLAS_CONTROLE \
+    [0x28] = TECLADO_ENTER, [0x29] = TECLADO_ESC, [0x2A] = TECLADO_BACKSPACE, \
+    [0x2B] = TECLADO_TAB,   [0x2C] = ' ', \
+    [0x54] = '/', [0x55] = '*', [0x56] = '-', [0x57] = '+', [0x58] = TECLADO_ENTER, \
+    [0x59] = '1', [0x5A] = '2', [0x5B] = '3', [0x5C] = '4', [0x5D] = '5', \
+    [0x5E] = '6', [0x5F] = '7', [0x60] = '8', [0x61] = '9', [0x62] = '0'
+
+#define TECLAS_BASE_NORMAL \
+    [0x04] = 'a', [0x05] = 'b', [0x06] = 'c', [0x07] = 'd', [0x08] = 'e', \
+    [0x09] = 'f', [0x0A] = 'g', [0x0B] = 'h', [0x0C] = 'i', [0x0D] = 'j', \
+    [0x0E] = 'k', [0x0F] = 'l', [0x10] = 'm', [0x11] = 'n', [0x12] = 'o', \
+    [0x13] = 'p', [0x14] = 'q', [0x15] = 'r', [0x16] = 's', [0x17] = 't', \
+    [0x18] = 'u', [0x19] = 'v', [0x1A] = 'w', [0x1B] = 'x', [0x1C] = 'y', \
+    [0x1D] = 'z', \
+    [0x1E] = '1', [0x1F] = '2', [0x20] = '3', [0x21] = '4', [0x22] = '5', \
+    [0x23] = '6', [0x24] = '7', [0x25] = '8', [0x26] = '9', [0x27] = '0', \
+    TECLAS_CONTROLE,
+
+#define TECLAS_BASE_SHIFT \
+    [0x04] = 'A', [0x05] = 'B', [0x06] = 'C', [0x07] = 'D', [0x08] = 'E', \
+    [0x09] = 'F', [0x0A] = 'G', [0x0B] = 'H', [0x0C] = 'I', [0x0D] = 'J', \
+    [0x0E] = 'K', [0x0F] = 'L', [0x10] = 'M', [0x11] = 'N', [0x12] = 'O', \
+    [0x13] = 'P', [0x14] = 'Q', [0x15] = 'R', [0x16] = 'S', [0x17] = 'T', \
+    [0x18] = 'U', [0x19] = 'V', [0x1A] = 'W', [0x1B] = 'X', [0x1C] = 'Y', \
+    [0x1D] = 'Z', \
+    TECLAS_CONTROLE,
+
+// Layout US
+static const uint8_t teclasUS[3][256] =
+{
+    {   // sem modificador
+        TECLAS_BASE_NORMAL
+        [0x2D] = '-',
+        [0x2E] = '=',
+        [0x2F] = '[',
+        [0x30] = ']',
+        [0x31] = '\\',
+        [0x32] = '#',
+        [0x33] = ';',
+        [0x34] = '\'',
+        [0x35] = '`',
+        [0x36] = ',',
+        [0x37] = '.',
+        [0x38] = '/',
+        [0x63] = '.',
+        [0x64] = '\\',
+    },
+    {   // SHIFT
+        TECLAS_BASE_SHIFT
+        [0x1E] = '!',
+        [0x1F] = '@',
+        [0x20] = '#',
+        [0x21] = '$',
+        [0x22] = '%',
+        [0x23] = '^',
+        [0x24] = '&',
+        [0x25] = '*',
+        [0x26] = '(',
+        [0x27] = ')',
+        [0x2D] = '_',
+        [0x2E] = '+',
+        [0x2F] = '{',
+        [0x30] = '}',
+        [0x31] = '|',
+        [0x32] = '~',
+        [0x33] = ':',
+        [0x34] = '"',
+        [0x35] = '~',
+        [0x36] = '<',
+        [0x37] = '>',
+        [0x38] = '?',
+        [0x63] = '.',
+        [0x64] = '|',
+    },
+    {   // AltGr: nada
+        0
+    }
+};
+
+// Layout ABNT2 (teclado brasileiro)
+static const uint8_t teclasABNT2[3][256] =
+{
+    {   // sem modificador
+        TECLAS_BASE_NORMAL
+        [0x2D] = '-',
+        [0x2E] = '=',
+        [0x2F] = TECLADO_MORTO_AGUDO,
+        [0x30] = '[',
+        [0x31] = ']',
+        [0x32] = ']',
+        [0x33] = 0xE7,                  // 
+        [0x34] = TECLADO_MORTO_TIL,
+        [0x35] = '\'',
+        [0x36] = ',',
+        [0x37] = '.',
+        [0x38] = ';',
+        [0x63] = ',',
+        [0x64] = '\\',
+        [0x85] = '.',
+        [0x87] = '/',
+    },
+    {   // SHIFT
+        TECLAS_BASE_SHIFT
+        [0x1E] = '!',
+        [0x1F] = '@',
+        [0x20] = '#',
+        [0x21] = '$',
+        [0x22] = '%',
+        [0x23] = TECLADO_MORTO_TREMA,
+        [0x24] = '&',
+        [0x25] = '*',
+        [0x26] = '(',
+        [0x27] = ')',
+        [0x2D] = '_',
+        [0x2E] = '+',
+        [0x2F] = TECLADO_MORTO_CRASE,
+        [0x30] = '{',
+        [0x31] = '}',
+        [0x32] = '}',
+        [0x33] = 0xC7,                  // 
+        [0x34] = TECLADO_MORTO_CIRCUNFLEXO,
+        [0x35] = '"',
+        [0x36] = '<',
+        [0x37] = '>',
+        [0x38] = ':',
+        [0x63] = ',',
+        [0x64] = '|',
+        [0x85] = '.',
+        [0x87] = '?',
+    },
+    {   // AltGr
+        [0x08] = 0xB0,                  // 
+        [0x14] = '/',
+        [0x1A] = '?',
+        [0x1E] = 0xB9,                  // 
+        [0x1F] = 0xB2,                  // 
+        [0x20] = 0xB3,                  // 
+        [0x21] = 0xA3,                  // 
+        [0x22] = 0xA2,                  // 
+        [0x23] = 0xAC,                  // 
+        [0x2E] = 0xA7,                  // 
+        [0x30] = 0xAA,                  // 
+        [0x31] = 0xBA,                  // 
+        [0x32] = 0xBA,                  // 
+        [0x87] = 0xB0,                  // 
+    }
+};
+
+static const uint8_t (* const teclado_tabelas[TECLADO_LAYOUT_QUANT])[256] =
+{
+    teclasUS,
+    teclasABNT2
+};
+
+static const char * const teclado_nomes[TECLADO_LAYOUT_QUANT] =
+{
+    "us",
+    "abnt2"
+};
+
+// Combinaes dos acentos mortos (Latin-1). 'sozinho'  o acento que sai
+// quando a tecla seguinte no combina.
+typedef struct
+{
+    uint8_t sozinho;
+    const char *base;
+    const char *composto;
+} TECLADO_ACENTO;
+
+static const TECLADO_ACENTO teclado_acentos[TECLADO_MORTO_QUANT] =
+{
+    //  :            
+    { 0xB4U, "aeiouyAEIOUY", "\xE1\xE9\xED\xF3\xFA\xFD\xC1\xC9\xCD\xD3\xDA\xDD" },
+    // ` :          
+    { '`',   "aeiouAEIOU",   "\xE0\xE8\xEC\xF2\xF9\xC0\xC8\xCC\xD2\xD9" },
+    // ~ :      
+    { '~',   "aonAON",       "\xE3\xF5\xF1\xC3\xD5\xD1" },
+    // ^ :          
+    { '^',   "aeiouAEIOU",   "\xE2\xEA\xEE\xF4\xFB\xC2\xCA\xCE\xD4\xDB" },
+    //  :           
+    { 0xA8U, "aeiouyAEIOU",  "\xE4\xEB\xEF\xF6\xFC\xFF\xC4\xCB\xCF\xD6\xDC" },
+};
+
+static TECLADO_LAYOUT g_layout = TECLADO_LAYOUT_PADRAO;
+static uint8_t g_morto = 0;     // acento morto pendente (0 = nenhum)
+
+// *****************************************************************************
+// *****************************************************************************
+// Section: Local Functions
+// *****************************************************************************
+// *****************************************************************************
+
+/* TECLADO_Letra()
+ * Letra sujeita ao CAPS LOCK (a..z e ).
+ */
+static bool TECLADO_Letra(uint8_t c)
+{
+    return ((c >= (uint8_t)'a') && (c <= (uint8_t)'z')) || (c == 0xE7U);
+}
+
+/* TECLADO_Compoe()
+ * Acento pendente + caractere: o composto, ou 0 se no combinam.
+ */
+static uint8_t TECLADO_Compoe(uint8_t morto, uint8_t c)
+{
+    const TECLADO_ACENTO *acento = &teclado_acentos[morto - TECLADO_MORTO_AGUDO];
+    uint32_t i;
+
+    for (i = 0; acento->base[i] != '\0'; i++)
+    {
+        if ((uint8_t)acento->base[i] == c)
+            return (uint8_t)acento->composto[i];
+    }
+    return 0;
+}
+
+// *****************************************************************************
+// *****************************************************************************
+// Section: Interface Functions
+// *****************************************************************************
+// *****************************************************************************
+
+void TECLADO_LayoutSet(TECLADO_LAYOUT layout)
+{
+    if ((uint32_t)layout >= (uint32_t)TECLADO_LAYOUT_QUANT)
+        return;
+    g_layout = layout;
+    g_morto = 0;
+}
+
+TECLADO_LAYOUT TECLADO_LayoutGet(void)
+{
+    return g_layout;
+}
+
+const char *TECLADO_LayoutNome(TECLADO_LAYOUT layout)
+{
+    if ((uint32_t)layout >= (uint32_t)TECLADO_LAYOUT_QUANT)
+        return "?";
+    return teclado_nomes[layout];
+}
+
+void TECLADO_Reset(void)
+{
+    g_morto = 0;
+}
+
+uint32_t TECLADO_Traduz(uint8_t keyCode, uint8_t modificadores, bool capsLock,
+                        char saida[TECLADO_CARACTERES_MAX])
+{
+    const uint8_t (*tabela)[256] = teclado_tabelas[g_layout];
+    uint8_t c, composto, morto;
+
+    if ((modificadores & TECLADO_MOD_ALTGR) != 0U)
+    {
+        c = tabela[2][keyCode];
+    }
+    else
+    {
+        bool shift = ((modificadores & TECLADO_MOD_SHIFT) != 0U);
+
+        // CAPS LOCK inverte o SHIFT s nas letras
+        if (capsLock && TECLADO_Letra(tabela[0][keyCode]))
+            shift = !shift;
+        c = tabela[shift ? 1 : 0][keyCode];
+    }
+
+    if (c == 0U)
+        return 0;
+
+    morto = g_morto;
+    if (TECLADO_E_MORTO(c))
+    {
+        g_morto = c;
+        if (morto == 0U)
+            return 0;
+        // Dois acentos seguidos: sai o primeiro, o segundo fica pendente
+        saida[0] = (char)teclado_acentos[morto - TECLADO_MORTO_AGUDO].sozinho;
+        return 1;
+    }
+
+    if (morto == 0U)
+    {
+        saida[0] = (char)c;
+        return 1;
+    }
+    g_morto = 0;
+
+    // Controle (ENTER, BACKSPACE...) descarta o acento
+    if (c < (uint8_t)' ')
+    {
+        saida[0] = (char)c;
+        return 1;
+    }
+    if (c == (uint8_t)' ')
+    {
+        saida[0] = (char)teclado_acentos[morto - TECLADO_MORTO_AGUDO].sozinho;
+        return 1;
+    }
+    composto = TECLADO_Compoe(morto, c);
+    if (composto != 0U)
+    {
+        saida[0] = (char)composto;
+        return 1;
+    }
+    saida[0] = (char)teclado_acentos[morto - TECLADO_MORTO_AGUDO].sozinho;
+    saida[1] = (char)c;
+    return 2;
+}
+
+/*******************************************************************************
+ End of File
+ */
@@ -0,0 +1,112 @@
+/*******************************************************************************
+  Traduo de teclas do teclado USB
+
+  File Name:
+    teclado.h
+
+  Summary:
+    Tabelas de layout (US e ABNT2) do cdigo de uso HID para caractere.
+
+  Description:
+    Cada layout tem trs tabelas constantes (em flash) de 256 entradas,
+    indexadas pelo cdigo de uso HID da tecla: sem modificador, com SHIFT e
+    com AltGr (ALT direito). A entrada  o caractere em Latin-1, um cdigo de
+    controle (ENTER, BACKSPACE, TAB, ESC), um acento morto ou 0 (a tecla no
+    gera texto). Traduzir uma tecla custa um ndice na tabela.
+
+    Acentos mortos (ABNT2:  ` ~ ^ ) no geram caractere na hora: ficam
+    guardados e se combinam com a tecla seguinte ("~" + "a" = ""). Se a
+    tecla seguinte no combina, saem os dois caracteres; com espao sai s o
+    acento.
+
+    CAPS LOCK troca as tabelas sem modificador e com SHIFT s nas letras
+    (inclusive "").
+
+    O layout  escolhido em tempo de execuo (TECLADO_LayoutSet) e vale
+    para o teclado e para o leitor de cdigo de barras.
+*******************************************************************************/
+
+#ifndef _TECLADO_H
+#define _TECLADO_H
+
+// *****************************************************************************
+// *****************************************************************************
+// Section: Included Files
+// *****************************************************************************
+// *****************************************************************************
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <stddef.h>
+
+// DOM-IGNORE-BEGIN
+#ifdef __cplusplus  // Provide C++ Compatibility
+
+extern "C" {
+
+#endif
+// DOM-IGNORE-END
+
+// *****************************************************************************
+// *****************************************************************************
+// Section: Type Definitions
+// *****************************************************************************
+// *****************************************************************************
+
+typedef enum
+{
+    TECLADO_LAYOUT_US = 0,
+    TECLADO_LAYOUT_ABNT2,
+    TECLADO_LAYOUT_QUANT
+
+} TECLADO_LAYOUT;
+
+#define TECLADO_LAYOUT_PADRAO   TECLADO_LAYOUT_ABNT2
+
+// Modificadores (combinao de bits)
+#define TECLADO_MOD_SHIFT       0x01U   // SHIFT esquerdo ou direito
+#define TECLADO_MOD_ALTGR       0x02U   // ALT direito
+
+// Cdigos de controle devolvidos pela traduo
+#define TECLADO_ENTER           '\r'
+#define TECLADO_BACKSPACE       '\b'
+#define TECLADO_TAB             '\t'
+#define TECLADO_ESC             '\x1B'
+
+// Caracteres gerados por uma tecla (acento morto que no combinou + tecla)
+#define TECLADO_CARACTERES_MAX  2U
+
+// *****************************************************************************
+// *****************************************************************************
+// Section: Interface Functions
+// *****************************************************************************
+// *****************************************************************************
+
+// Escolhe o layout (ignora valores invlidos). Descarta acento pendente.
+void TECLADO_LayoutSet(TECLADO_LAYOUT layout);
+TECLADO_LAYOUT TECLADO_LayoutGet(void);
+
+// Nome curto do layout ("us", "abnt2")
+const char *TECLADO_LayoutNome(TECLADO_LAYOUT layout);
+
+// Descarta acento morto pendente (ex.: teclado removido)
+void TECLADO_Reset(void);
+
+// Traduz uma tecla apertada. 'saida' recebe at TECLADO_CARACTERES_MAX
+// caracteres (Latin-1 ou cdigos de controle); retorna quantos. Retorna 0
+// para teclas sem texto e para o acento morto, que fica pendente.
+// S uma task pode chamar (o acento pendente  nico).
+uint32_t TECLADO_Traduz(uint8_t keyCode, uint8_t modificadores, bool capsLock,
+                        char saida[TECLADO_CARACTERES_MAX]);
+
+//DOM-IGNORE-BEGIN
+#ifdef __cplusplus
+}
+#endif
+//DOM-IGNORE-END
+
+#endif /* _TECLADO_H */
+
+/*******************************************************************************
+ End of File
+ */
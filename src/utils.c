@@ -1,46 +1,188 @@
 #include "utils.h"
 
+/*
+	isqrt32_semente[]
+
+	Semente da raiz quadrada: isqrt32_semente[i] = floor(sqrt(i * 256)),
+	ou seja, a raiz de 'i' com 4 bits fracionrios (16 * sqrt(i)).
+ */
+static const uint8_t isqrt32_semente[256] =
+{
+	  0,  16,  22,  27,  32,  35,  39,  42,  45,  48,  50,  53,  55,  57,  59,  61,
+	 64,  65,  67,  69,  71,  73,  75,  76,  78,  80,  81,  83,  84,  86,  87,  89,
+	 90,  91,  93,  94,  96,  97,  98,  99, 101, 102, 103, 104, 106, 107, 108, 109,
+	110, 112, 113, 114, 115, 116, 117, 118, 119, 120, 121, 122, 123, 124, 125, 126,
+	128, 128, 129, 130, 131, 132, 133, 134, 135, 136, 137, 138, 139, 140, 141, 142,
+	143, 144, 144, 145, 146, 147, 148, 149, 150, 150, 151, 152, 153, 154, 155, 155,
+	156, 157, 158, 159, 160, 160, 161, 162, 163, 163, 164, 165, 166, 167, 167, 168,
+	169, 170, 170, 171, 172, 173, 173, 174, 175, 176, 176, 177, 178, 178, 179, 180,
+	181, 181, 182, 183, 183, 184, 185, 185, 186, 187, 187, 188, 189, 189, 190, 191,
+	192, 192, 193, 193, 194, 195, 195, 196, 197, 197, 198, 199, 199, 200, 201, 201,
+	202, 203, 203, 204, 204, 205, 206, 206, 207, 208, 208, 209, 209, 210, 211, 211,
+	212, 212, 213, 214, 214, 215, 215, 216, 217, 217, 218, 218, 219, 219, 220, 221,
+	221, 222, 222, 223, 224, 224, 225, 225, 226, 226, 227, 227, 228, 229, 229, 230,
+	230, 231, 231, 232, 232, 233, 234, 234, 235, 235, 236, 236, 237, 237, 238, 238,
+	239, 240, 240, 241, 241, 242, 242, 243, 243, 244, 244, 245, 245, 246, 246, 247,
+	247, 248, 248, 249, 249, 250, 250, 251, 251, 252, 252, 253, 253, 254, 254, 255
+};
+
 /*
 	isqrt32()
 
-	Funop pra calcular um raiz inteira de um nmero inteiro.
-	Baseada em:
-	www.quora.com/Which-is-the-fastest-algorithm-to-compute-integer-square-root-of-a-number
-	www.codecodex.com/wiki/Calculate_an_integer_square_root
+	Funo pra calcular um raiz inteira de um nmero inteiro.
+	A verso anterior era bit a bit (at 12 iteraes). Agora a semente vem
+	da tabela acima, indexada pelos 7-8 bits mais significativos de 'n'
+	(posio achada com a instruo CLZ), seguida de uma iterao de Newton
+	e de uma correo final de +-1, o que garante o resultado exato.
+
+	Mantm o mesmo comportamento da verso bit a bit, que satura em 4095
+	para n >= 2^24 (a raiz de um valor de 12 bits ao quadrado nunca passa
+	disso).
  */
 uint32_t isqrt32(uint32_t n)
 {
-	uint32_t root, remainder, place;
-
-	root = 0;
-	remainder = n;
-	place = 0x400000;
-
-	while (place > remainder)
-		place = place >> 2;
-    
-	while (place)
-    {
-		if (remainder >= root + place)
-        {
-			remainder = remainder - root - place;
-			root = root + (place << 1);
-		}
-		root = root >> 1;
-		place = place >> 2;
-	}
+	uint32_t root, shift;
+
+	if (n < 256U)
+		return (uint32_t)isqrt32_semente[n] >> 4;
+
+	if (n >= 0x1000000U)
+		return 4095U;
+
+	// Expoente par para que a raiz da parte alta seja exata em potncia de 2
+	shift = (uint32_t)(32 - __builtin_clz(n) - 7) & ~1U;
+	root = ((uint32_t)isqrt32_semente[n >> shift] << (shift >> 1)) >> 4;
+
+	// Uma iterao de Newton
+	root = (root + n / root) >> 1;
+
+	// Correo final (no mximo um passo em cada sentido)
+	while (root * root > n)
+		root--;
+	while ((root + 1U) * (root + 1U) <= n)
+		root++;
+
 	return root;
 }
 
-uint32_t calcula_rms(uint32_t valor)
+/*
+	isqrt64()
+
+	Raiz inteira (truncada) de um nmero de 64 bits.
+	At 2^24 usa isqrt32, que  exata nessa faixa. Acima disso, 'n' 
+	deslocado de um nmero par de bits at caber em 24 bits; a raiz dessa
+	parte (+1, deslocada de volta)  uma semente maior ou igual  raiz, e as
+	iteraes de Newton descem at o resultado exato (2 ou 3 iteraes).
+ */
+uint32_t isqrt64(uint64_t n)
 {
-    uint32_t soma=0;
+	uint64_t x, y;
+	uint32_t k;
+
+	if (n < 0x1000000ULL)
+		return isqrt32((uint32_t)n);
+
+	// Deslocamento 2k que deixa n com no mximo 24 bits
+	k = (uint32_t)(64 - __builtin_clzll(n) - 23) >> 1;
+	x = ((uint64_t)isqrt32((uint32_t)(n >> (2U * k))) + 1U) << k;
+
+	// Newton a partir de uma semente por excesso: decresce at a raiz
+	for (;;)
+	{
+		y = (x + n / x) >> 1;
+		if (y >= x)
+			break;
+		x = y;
+	}
+
+	return (uint32_t)x;
+}
+
+/*
+	calcula_rms()
 
+	RMS de uma janela de 'n' amostras a partir da soma dos quadrados.
+	A soma  de 64 bits: com amostras de 12 bits cabem mais de 10^12
+	amostras, ento a janela pode ter vrios ciclos da rede.
+ */
+uint32_t calcula_rms(uint64_t valor, uint32_t n)
+{
+    uint64_t soma=0;
+
+	// Janela vazia no tem mdia
+	if(n == 0)
+		return 0;
 	soma = valor;	
-	// Divide por 128
-	soma = soma >> 7;
+	// Divide pelo nmero de amostras da janela
+	soma = soma / n;
 	// Se for 0 nem perde tempo
 	if(soma)
-		soma = isqrt32(soma);
-	return soma;
-}
\ No newline at end of file
+		soma = isqrt64(soma);
+	return (uint32_t)soma;
+}
+
+/*
+	i_gb_calcula()
+
+	A partir do ultimo valor de corrente RMS binrio medido, calcula a sada de aterramento em A*10.
+	O coeficiente  multiplicado por 1024 para podermos fazer uma multiplicao com numeros inteiros sem perder casas decimais, o
+	resultado  ento dividido por 8192 (2^13).
+
+	Ibin = Ia10 * (1/10) * (1/1000)  *    94     *  (18/33)  * (4096/2,5)
+		       A->A10     TC       Resistor      AMP	       ADC
+        Ibin=Ia10*8,4
+	Ia10=Ibin*(1/8,4)
+
+	Supondo um coeficiente que permita variar 0,1% do valor
+	Ia10=Ibin*(1/8,4)
+	Colocando os outros fatores numa potncia de 2, exceto o coeficiente (aproximando)
+	Ia10=Ibin*(975/2^13)
+*/
+uint32_t i_gb_calcula(uint32_t i_rms)
+{
+	unsigned int temp;	// Nmero de 32 bits para guardar a multiplicao de um numero de 12 bits (v_rms)
+				// com um de aproximadamente 10 bits (coeficiente)
+
+	//temp = ((unsigned int)i_rms) * ((unsigned int)sistema_config.coef_aj_i_gb);
+	temp = ((unsigned int)i_rms) * 1129;
+	temp = temp >> 13;
+
+	return(temp);
+}
+
+/*
+	r_gb_calcula()
+
+	A partir do ultimo valor de corrente RMS binrio medido, calcula a sada de aterramento em A*10.
+	
+	Vbin = V *   (1/3,3)   *  (4096/2,5)
+		       amp          ADC
+	V=Vbin*(1/496)
+
+ 	Ibin = Ia10 * (1/1000)  *    94     *  (18/33)  * (4096/2,5)
+		         TC       Resistor      AMP	       ADC
+	I=Ibin*(1/84) (corrente em A)
+
+	Rreal = V/I = (Vbin/496) / (Ibin/84) = (Vbin/Ibin) * (84/496)
+	Esse resultado  em Ohms, mas queremos em mOhms , ento multiplicamos por 1000
+	Rreal = (Vbin/Ibin) * (84000/496) =  (Vbin/Ibin) * 169
+	
+ 	Transformando o coeficiente para um inteiro dividido por uma potncia de 2:
+	Rreal = (Vbin/Ibin) * (1354/2^3)
+*/
+uint32_t r_gb_calcula(uint32_t v_rms, uint32_t i_rms)
+{
+	uint32_t temp;	// Nmero de 32 bits para guardar a multiplicao de um numero de 12 bits (v_rms)
+				// com um de aproximadamente 10 bits (coeficiente)
+
+	if (i_rms>0){
+		//temp = v_rms * ((unsigned int)sistema_config.coef_aj_r_gb);
+		temp = v_rms * 1335;
+		temp = temp / i_rms;
+		temp = temp>>3;
+
+		return(temp);
+	}else{
+		return(0xFFFFFFFF);
+	}
+}
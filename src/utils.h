@@ -4,6 +4,11 @@
 #include <stdint.h>
 
 uint32_t isqrt32(uint32_t n);
-uint32_t calcula_rms(uint32_t valor);
+uint32_t isqrt64(uint64_t n);
+uint32_t calcula_rms(uint64_t valor, uint32_t n);
 
-#endif // UTILS_H
\ No newline at end of file
+// Conversões da medida GB (valores binários RMS -> unidades de engenharia)
+uint32_t i_gb_calcula(uint32_t i_rms);
+uint32_t r_gb_calcula(uint32_t v_rms, uint32_t i_rms);
+
+#endif // UTILS_H